@@ -36,6 +36,10 @@ while total != t.nvals:
 
 print(a, t, sep="\n")
 
+t = a.transitive_closure()              # Same closure, iterations are evaluated inside the library
+
+print(t)
+
 #
 # Export matrices set to graph viz graph
 #
@@ -15,13 +15,17 @@ import ctypes
 __all__ = [
     "load_and_configure",
     "get_init_hints",
+    "get_new_hints",
     "get_build_hints",
     "get_sub_matrix_hints",
     "get_transpose_hints",
     "get_reduce_hints",
+    "get_transitive_closure_hints",
     "get_kronecker_hints",
     "get_mxm_hints",
     "get_ewiseadd_hints",
+    "operation_names",
+    "OperationStats",
     "check"
 ]
 
@@ -38,13 +42,42 @@ _hint_log_warning = 256
 _hint_log_all = 512
 _hint_no_duplicates = 1024
 _hint_time_check = 2048
+_hint_cpu_parallel_backend = 4096
+_hint_mask_complement = 8192
+_hint_log_async = 16384
+_hint_deferred = 32768
+_hint_transpose_left = 65536
+_hint_transpose_right = 131072
+_hint_keep_transposed = 262144
+
+# Names of spbla_Operation kinds in the order of its values
+operation_names = [
+    "build",
+    "extract",
+    "extract_sub_matrix",
+    "duplicate",
+    "transpose",
+    "reduce",
+    "mxm",
+    "mxm_masked",
+    "kronecker",
+    "ewise_add",
+    "ewise_mult",
+    "ewise_diff",
+    "transitive_closure",
+    "mxv",
+    "vxm",
+    "load",
+    "save"
+]
 
 _backend_name_cpu = "cpu"
+_backend_name_cpu_parallel = "cpu-parallel"
 _backend_name_cuda = "cuda"
 _backend_name_opencl = "opencl"
 
 
-def get_log_hints(default=True, error=False, warning=False):
+def get_log_hints(default=True, error=False, warning=False, asynchronous=False):
     hints = _hint_no
 
     if default:
@@ -53,17 +86,24 @@ def get_log_hints(default=True, error=False, warning=False):
         hints |= _hint_log_error
     if warning:
         hints |= _hint_log_warning
+    if asynchronous:
+        hints |= _hint_log_async
 
     return hints
 
 
-def get_init_hints(backend_type: str):
+def get_init_hints(backend_type: str, deferred=False):
     assert backend_type
 
     hints = _hint_relaxed_release
 
+    if deferred:
+        hints |= _hint_deferred
+
     if backend_type == _backend_name_cpu:
         hints |= _hint_cpu_backend
+    elif backend_type == _backend_name_cpu_parallel:
+        hints |= _hint_cpu_parallel_backend
     elif backend_type == _backend_name_cuda:
         hints |= _hint_cuda_backend
     elif backend_type == _backend_name_opencl:
@@ -99,6 +139,15 @@ def get_reduce_hints(time_check):
     return hints
 
 
+def get_transitive_closure_hints(time_check):
+    hints = _hint_no
+
+    if time_check:
+        hints |= _hint_time_check
+
+    return hints
+
+
 def get_kronecker_hints(time_check):
     hints = _hint_no
 
@@ -108,11 +157,17 @@ def get_kronecker_hints(time_check):
     return hints
 
 
-def get_mxm_hints(is_accumulated, time_check):
+def get_mxm_hints(is_accumulated, time_check, is_complement=False, transpose_left=False, transpose_right=False):
     hints = _hint_no
 
     if is_accumulated:
         hints |= _hint_accumulate
+    if is_complement:
+        hints |= _hint_mask_complement
+    if transpose_left:
+        hints |= _hint_transpose_left
+    if transpose_right:
+        hints |= _hint_transpose_right
     if time_check:
         hints |= _hint_time_check
 
@@ -128,6 +183,24 @@ def get_ewiseadd_hints(time_check):
     return hints
 
 
+def get_load_hints(time_check):
+    hints = _hint_no
+
+    if time_check:
+        hints |= _hint_time_check
+
+    return hints
+
+
+def get_new_hints(keep_transposed):
+    hints = _hint_no
+
+    if keep_transposed:
+        hints |= _hint_keep_transposed
+
+    return hints
+
+
 def get_build_hints(is_sorted, no_duplicates):
     hints = _hint_no
 
@@ -139,6 +212,34 @@ def get_build_hints(is_sorted, no_duplicates):
     return hints
 
 
+# Kinds of spbla_Generator
+generator_erdos_renyi = 0
+generator_rmat = 1
+generator_power_law = 2
+
+
+class GeneratorParams(ctypes.Structure):
+    _fields_ = [
+        ("rmat_a", ctypes.c_float),
+        ("rmat_b", ctypes.c_float),
+        ("rmat_c", ctypes.c_float),
+        ("power_law_exponent", ctypes.c_float)
+    ]
+
+
+class OperationStats(ctypes.Structure):
+    _fields_ = [
+        ("calls", ctypes.c_uint64),
+        ("time_total_ns", ctypes.c_uint64),
+        ("time_min_ns", ctypes.c_uint64),
+        ("time_max_ns", ctypes.c_uint64),
+        ("nnz_in", ctypes.c_uint64),
+        ("nnz_out", ctypes.c_uint64),
+        ("flops", ctypes.c_uint64),
+        ("bytes_allocated", ctypes.c_uint64)
+    ]
+
+
 def load_and_configure(cubool_lib_path: str):
     lib = ctypes.cdll.LoadLibrary(cubool_lib_path)
 
@@ -154,6 +255,29 @@ def load_and_configure(cubool_lib_path: str):
         hints_t
     ]
 
+    lib.spbla_GetStats.restype = status_t
+    lib.spbla_GetStats.argtypes = [
+        ctypes.POINTER(OperationStats),
+        ctypes.c_uint
+    ]
+
+    lib.spbla_SetupTracing.restype = status_t
+    lib.spbla_SetupTracing.argtypes = [
+        ctypes.POINTER(ctypes.c_char),
+        hints_t
+    ]
+
+    lib.spbla_ResetStats.restype = status_t
+    lib.spbla_ResetStats.argtypes = []
+
+    lib.spbla_Wait.restype = status_t
+    lib.spbla_Wait.argtypes = []
+
+    lib.spbla_SetNumThreads.restype = status_t
+    lib.spbla_SetNumThreads.argtypes = [
+        index_t
+    ]
+
     lib.spbla_Initialize.restype = status_t
     lib.spbla_Initialize.argtypes = [
         hints_t
@@ -169,6 +293,19 @@ def load_and_configure(cubool_lib_path: str):
         ctypes.c_uint
     ]
 
+    lib.spbla_Matrix_NewWithHints.restype = status_t
+    lib.spbla_Matrix_NewWithHints.argtypes = [
+        p_to_matrix_p,
+        ctypes.c_uint,
+        ctypes.c_uint,
+        hints_t
+    ]
+
+    lib.spbla_Matrix_Wait.restype = status_t
+    lib.spbla_Matrix_Wait.argtypes = [
+        matrix_p
+    ]
+
     lib.spbla_Matrix_Free.restype = status_t
     lib.spbla_Matrix_Free.argtypes = [
         matrix_p
@@ -183,6 +320,15 @@ def load_and_configure(cubool_lib_path: str):
         hints_t
     ]
 
+    lib.spbla_Matrix_BuildCsr.restype = status_t
+    lib.spbla_Matrix_BuildCsr.argtypes = [
+        matrix_p,
+        ctypes.POINTER(ctypes.c_uint),
+        ctypes.POINTER(ctypes.c_uint),
+        ctypes.c_uint,
+        hints_t
+    ]
+
     lib.spbla_Matrix_SetElement.restype = status_t
     lib.spbla_Matrix_SetElement.argtypes = [
         matrix_p,
@@ -211,6 +357,50 @@ def load_and_configure(cubool_lib_path: str):
         ctypes.POINTER(ctypes.c_uint)
     ]
 
+    lib.spbla_Matrix_ExtractCsr.restype = status_t
+    lib.spbla_Matrix_ExtractCsr.argtypes = [
+        matrix_p,
+        ctypes.POINTER(ctypes.POINTER(ctypes.c_uint)),
+        ctypes.POINTER(ctypes.POINTER(ctypes.c_uint)),
+        ctypes.POINTER(ctypes.c_uint)
+    ]
+
+    lib.spbla_Matrix_Save.restype = status_t
+    lib.spbla_Matrix_Save.argtypes = [
+        matrix_p,
+        ctypes.POINTER(ctypes.c_char)
+    ]
+
+    lib.spbla_Matrix_Load.restype = status_t
+    lib.spbla_Matrix_Load.argtypes = [
+        ctypes.POINTER(ctypes.c_char),
+        p_to_matrix_p,
+        hints_t
+    ]
+
+    lib.spbla_Matrix_ExportMtx.restype = status_t
+    lib.spbla_Matrix_ExportMtx.argtypes = [
+        matrix_p,
+        ctypes.POINTER(ctypes.c_char)
+    ]
+
+    lib.spbla_Matrix_ImportMtx.restype = status_t
+    lib.spbla_Matrix_ImportMtx.argtypes = [
+        ctypes.POINTER(ctypes.c_char),
+        p_to_matrix_p,
+        hints_t
+    ]
+
+    lib.spbla_Matrix_Generate.restype = status_t
+    lib.spbla_Matrix_Generate.argtypes = [
+        matrix_p,
+        ctypes.c_uint,
+        index_t,
+        ctypes.c_uint64,
+        ctypes.POINTER(GeneratorParams),
+        hints_t
+    ]
+
     lib.spbla_Matrix_ExtractSubMatrix.restype = status_t
     lib.spbla_Matrix_ExtractSubMatrix.argtypes = [
         matrix_p,
@@ -260,6 +450,13 @@ def load_and_configure(cubool_lib_path: str):
         hints_t
     ]
 
+    lib.spbla_Matrix_TransitiveClosure.restype = status_t
+    lib.spbla_Matrix_TransitiveClosure.argtypes = [
+        matrix_p,
+        matrix_p,
+        hints_t
+    ]
+
     lib.spbla_Matrix_EWiseAdd.restype = status_t
     lib.spbla_Matrix_EWiseAdd.argtypes = [
         matrix_p,
@@ -268,6 +465,22 @@ def load_and_configure(cubool_lib_path: str):
         hints_t
     ]
 
+    lib.spbla_Matrix_EWiseMult.restype = status_t
+    lib.spbla_Matrix_EWiseMult.argtypes = [
+        matrix_p,
+        matrix_p,
+        matrix_p,
+        hints_t
+    ]
+
+    lib.spbla_Matrix_EWiseDiff.restype = status_t
+    lib.spbla_Matrix_EWiseDiff.argtypes = [
+        matrix_p,
+        matrix_p,
+        matrix_p,
+        hints_t
+    ]
+
     lib.spbla_MxM.restype = status_t
     lib.spbla_MxM.argtypes = [
         matrix_p,
@@ -276,6 +489,15 @@ def load_and_configure(cubool_lib_path: str):
         hints_t
     ]
 
+    lib.spbla_MxM_Masked.restype = status_t
+    lib.spbla_MxM_Masked.argtypes = [
+        matrix_p,
+        matrix_p,
+        matrix_p,
+        matrix_p,
+        hints_t
+    ]
+
     lib.spbla_Kronecker.restype = status_t
     lib.spbla_Kronecker.argtypes = [
         matrix_p,
@@ -316,6 +538,9 @@ SPBLA_STATUS_BACKEND_ERROR
 
 /** Some library feature is not implemented */
 SPBLA_STATUS_NOT_IMPLEMENTED
+
+/** Result of the operation does not fit spbla_Index */
+SPBLA_STATUS_INDEX_OVERFLOW
 """
 _status_codes_mappings = {
     0: "SPBLA_STATUS_SUCCESS",
@@ -326,7 +551,8 @@ _status_codes_mappings = {
     5: "SPBLA_STATUS_INVALID_ARGUMENT",
     6: "SPBLA_STATUS_INVALID_STATE",
     7: "SPBLA_STATUS_BACKEND_ERROR",
-    8: "SPBLA_STATUS_NOT_IMPLEMENTED"
+    8: "SPBLA_STATUS_NOT_IMPLEMENTED",
+    9: "SPBLA_STATUS_INDEX_OVERFLOW"
 }
 
 _success = 0
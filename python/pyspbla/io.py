@@ -1,22 +1,31 @@
 """
 IO operations for exporting/importing mtx data.
-Provides features to import/export data or pyspbla matrix in mtx format.
+Provides features to import/export data or pyspbla matrix in mtx format,
+and to save/load pyspbla matrix in library binary format.
 """
 
+import ctypes
+
 from . import Matrix
+from . import wrapper
+from . import bridge
 
 
 __all__ = [
     "read_mtx_file",
     "write_mtx_file",
     "import_matrix_from_mtx",
-    "export_matrix_to_mtx"
+    "export_matrix_to_mtx",
+    "save_matrix",
+    "load_matrix"
 ]
 
 
 def read_mtx_file(path: str):
     """
     Reads mtx file data.
+    File with `%%MatrixMarket` banner uses 1-based indices and its symmetric entries are expanded.
+    File without banner is read as legacy pyspbla file with 0-based indices.
 
     :param path: Path and name of the file with data
     :return: shape of the matrix, rows data, columns data, number of values
@@ -24,22 +33,36 @@ def read_mtx_file(path: str):
 
     with open(str(path), 'r') as file:
         line = file.readline()
-        while line[0].startswith("#"):
+        base = 0
+        symmetric = False
+
+        if line.startswith("%%MatrixMarket"):
+            banner = line.lower().split()
+            base = 1
+            symmetric = len(banner) > 4 and banner[4] in ("symmetric", "skew-symmetric", "hermitian")
+            line = file.readline()
+
+        while not line.strip() or line.startswith("#") or line.startswith("%"):
             line = file.readline()
 
-        m, n, nvals = map(int, line.split())
+        m, n, nentries = map(int, line.split()[:3])
         rows = list()
         cols = list()
-        for k in range(nvals):
+        k = 0
+        while k < nentries:
             line = file.readline()
-            if line.startswith("#"):
+            if not line.strip() or line.startswith("#") or line.startswith("%"):
                 continue
 
-            i, j = map(int, line.split())
-            rows.append(i)
-            cols.append(j)
+            i, j = map(int, line.split()[:2])
+            rows.append(i - base)
+            cols.append(j - base)
+            if symmetric and i != j:
+                rows.append(j - base)
+                cols.append(i - base)
+            k += 1
 
-    return (m, n), rows, cols, nvals
+    return (m, n), rows, cols, len(rows)
 
 
 def write_mtx_file(path: str, shape, rows, cols, nvals):
@@ -64,28 +87,76 @@ def write_mtx_file(path: str, shape, rows, cols, nvals):
             file.write(f"{rows[i]} {cols[i]}\n")
 
 
-def import_matrix_from_mtx(path: str):
+def import_matrix_from_mtx(path: str, time_check=False):
     """
     Read matrix from file in the mtx format.
+    File is parsed by the library natively in parallel (see `read_mtx_file` for supported formats).
 
     :param path: Path and name of the file with matrix
+    :param time_check: Pass True to measure and log elapsed time of the operation
     :return: Matrix created from data
     """
 
-    shape, rows, cols, nvals = read_mtx_file(path)
-    return Matrix.from_lists(shape=shape, rows=rows, cols=cols, is_sorted=False, no_duplicates=False)
+    hnd = ctypes.c_void_p(0)
+
+    status = wrapper.loaded_dll.spbla_Matrix_ImportMtx(
+        str(path).encode("utf-8"), ctypes.byref(hnd),
+        ctypes.c_uint(bridge.get_load_hints(time_check))
+    )
+
+    bridge.check(status)
+    return Matrix(hnd)
 
 
 def export_matrix_to_mtx(path: str, matrix: Matrix):
     """
-    Save matrix to mtx file.
+    Save matrix to mtx file as general pattern matrix with 1-based indices.
 
     :param path: Path and file name of the file to save data
     :param matrix: Matrix to export
     :return: None
     """
 
-    rows, cols = matrix.to_lists()
-    nvals = matrix.nvals
-    shape = matrix.shape
-    write_mtx_file(path=path, shape=shape, rows=rows, cols=cols, nvals=nvals)
\ No newline at end of file
+    status = wrapper.loaded_dll.spbla_Matrix_ExportMtx(
+        matrix.hnd, str(path).encode("utf-8")
+    )
+
+    bridge.check(status)
+
+
+def save_matrix(path: str, matrix: Matrix):
+    """
+    Save matrix to the binary file.
+
+    :param path: Path and file name of the file to save data
+    :param matrix: Matrix to save
+    :return: None
+    """
+
+    status = wrapper.loaded_dll.spbla_Matrix_Save(
+        matrix.hnd, str(path).encode("utf-8")
+    )
+
+    bridge.check(status)
+
+
+def load_matrix(path: str, time_check=False):
+    """
+    Load matrix from the binary file, saved by `save_matrix`.
+    File sections are validated and copied into matrix storage without parsing,
+    so it is much faster than mtx import.
+
+    :param path: Path and name of the file with matrix
+    :param time_check: Pass True to measure and log elapsed time of the operation
+    :return: Matrix loaded from file
+    """
+
+    hnd = ctypes.c_void_p(0)
+
+    status = wrapper.loaded_dll.spbla_Matrix_Load(
+        str(path).encode("utf-8"), ctypes.byref(hnd),
+        ctypes.c_uint(bridge.get_load_hints(time_check))
+    )
+
+    bridge.check(status)
+    return Matrix(hnd)
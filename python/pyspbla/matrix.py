@@ -31,6 +31,7 @@ class Matrix:
     - ewiseadd
     - kronecker
     - reduce
+    - transitive closure
     - transpose
     - matrix extraction
 
@@ -52,11 +53,15 @@ class Matrix:
         bridge.check(wrapper.loaded_dll.spbla_Matrix_Free(self.hnd))
 
     @classmethod
-    def empty(cls, shape):
+    def empty(cls, shape, keep_transposed=False):
         """
         Creates empty matrix of specified `shape`.
 
+        Pass `keep_transposed`=True to keep transposed storage of the matrix (Cpu backends),
+        what speeds up transpose, columns extraction and multiplication by transposed matrix.
+
         :param shape: Pair with two values with rows and cols count of the matrix
+        :param keep_transposed: Set in true to keep transposed storage of the matrix
         :return: Created empty matrix
         """
 
@@ -65,8 +70,9 @@ class Matrix:
         nrows = shape[0]
         ncols = shape[1]
 
-        status = wrapper.loaded_dll.spbla_Matrix_New(
-            ctypes.byref(hnd), ctypes.c_uint(nrows), ctypes.c_uint(ncols)
+        status = wrapper.loaded_dll.spbla_Matrix_NewWithHints(
+            ctypes.byref(hnd), ctypes.c_uint(nrows), ctypes.c_uint(ncols),
+            ctypes.c_uint(bridge.get_new_hints(keep_transposed=keep_transposed))
         )
 
         bridge.check(status)
@@ -101,6 +107,34 @@ class Matrix:
         out.build(rows, cols, is_sorted=is_sorted, no_duplicates=no_duplicates)
         return out
 
+    @classmethod
+    def from_csr(cls, shape, row_offsets, cols, is_sorted=False, no_duplicates=False):
+        """
+        Build matrix from provided `shape` and compressed sparse row data.
+
+        >>> matrix = Matrix.from_csr((4, 4), [0, 1, 2, 3, 4], [0, 1, 2, 0], is_sorted=True, no_duplicates=True)
+        >>> print(matrix)
+        '
+                0   1   2   3
+          0 |   1   .   .   . |   0
+          1 |   .   1   .   . |   1
+          2 |   .   .   1   . |   2
+          3 |   1   .   .   . |   3
+                0   1   2   3
+        '
+
+        :param shape: Matrix shape
+        :param row_offsets: List with nrows + 1 row offsets
+        :param cols: List with column indices
+        :param is_sorted: True if column indices are sorted within rows
+        :param no_duplicates: True if rows have no duplicated column indices
+        :return: Created matrix filled with data
+        """
+
+        out = cls.empty(shape)
+        out.build_csr(row_offsets, cols, is_sorted=is_sorted, no_duplicates=no_duplicates)
+        return out
+
     @classmethod
     def generate(cls, shape, density: float):
         """
@@ -126,14 +160,82 @@ class Matrix:
         nvals_max = shape[0] * shape[1]
         nvals_to_gen = int(nvals_max * density)
 
-        m, n = shape
-        rows, cols = list(), list()
+        return cls.generate_erdos_renyi(shape, nvals_to_gen)
 
-        for i in range(nvals_to_gen):
-            rows.append(random.randrange(0, m))
-            cols.append(random.randrange(0, n))
+    @classmethod
+    def generate_erdos_renyi(cls, shape, nvals: int, seed=None):
+        """
+        Generate uniform random matrix of the specified shape with exactly `nvals` values (G(n, m) graph).
+        Generation is done natively in O(nvals) time, the same seed gives the same matrix.
+
+        >>> matrix = Matrix.generate_erdos_renyi(shape=(1000, 1000), nvals=5000, seed=1)
+
+        :param shape: Matrix shape to generate
+        :param nvals: Number of values to generate
+        :param seed: Seed of the generator (if None, taken from python `random` module)
+        :return: Generated matrix
+        """
+
+        return cls._generate(shape, bridge.generator_erdos_renyi, nvals, seed, None)
+
+    @classmethod
+    def generate_rmat(cls, shape, nvals: int, seed=None, a=0.57, b=0.19, c=0.19):
+        """
+        Generate R-MAT (recursive matrix) graph of the specified shape.
+        Each value is placed by recursive descent into one of four quadrants
+        with probabilities `a`, `b`, `c` and `1 - a - b - c`, so graph has skewed degrees.
+        Samples `nvals` values, so result has less values if some of them are sampled several times.
+
+        >>> matrix = Matrix.generate_rmat(shape=(1024, 1024), nvals=10000, seed=1)
+
+        :param shape: Matrix shape to generate
+        :param nvals: Number of values to sample
+        :param seed: Seed of the generator (if None, taken from python `random` module)
+        :param a: Probability of top-left quadrant
+        :param b: Probability of top-right quadrant
+        :param c: Probability of bottom-left quadrant
+        :return: Generated matrix
+        """
+
+        params = bridge.GeneratorParams(a, b, c, 2.1)
+        return cls._generate(shape, bridge.generator_rmat, nvals, seed, params)
+
+    @classmethod
+    def generate_power_law(cls, shape, nvals: int, seed=None, exponent=2.1):
+        """
+        Generate graph with power-law expected degrees of rows and columns (Chung-Lu model).
+        Samples `nvals` values, so result has less values if some of them are sampled several times.
+
+        >>> matrix = Matrix.generate_power_law(shape=(1000, 1000), nvals=10000, seed=1, exponent=2.5)
+
+        :param shape: Matrix shape to generate
+        :param nvals: Number of values to sample
+        :param seed: Seed of the generator (if None, taken from python `random` module)
+        :param exponent: Exponent of the degrees distribution, must be greater than 1
+        :return: Generated matrix
+        """
 
-        return Matrix.from_lists(shape=shape, rows=rows, cols=cols, is_sorted=False, no_duplicates=False)
+        params = bridge.GeneratorParams(0.57, 0.19, 0.19, exponent)
+        return cls._generate(shape, bridge.generator_power_law, nvals, seed, params)
+
+    @classmethod
+    def _generate(cls, shape, generator, nvals, seed, params):
+        if seed is None:
+            seed = random.getrandbits(64)
+
+        out = cls.empty(shape)
+
+        status = wrapper.loaded_dll.spbla_Matrix_Generate(
+            out.hnd,
+            ctypes.c_uint(generator),
+            ctypes.c_uint(nvals),
+            ctypes.c_uint64(seed),
+            ctypes.byref(params) if params is not None else None,
+            ctypes.c_uint(0)
+        )
+
+        bridge.check(status)
+        return out
 
     def build(self, rows, cols, is_sorted=False, no_duplicates=False):
         """
@@ -173,6 +275,44 @@ class Matrix:
 
         bridge.check(status)
 
+    def build_csr(self, row_offsets, cols, is_sorted=False, no_duplicates=False):
+        """
+        Build sparse matrix of boolean values from provided compressed sparse row arrays.
+
+        >>> matrix = Matrix.empty(shape=(4,4))
+        >>> matrix.build_csr([0, 2, 2, 3, 3], [3, 1, 2], is_sorted=False, no_duplicates=True)
+        >>> print(matrix)
+        '
+                0   1   2   3
+          0 |   .   1   .   1 |   0
+          1 |   .   .   .   . |   1
+          2 |   .   .   1   . |   2
+          3 |   .   .   .   . |   3
+                0   1   2   3
+        '
+
+        :param row_offsets: Array of nrows + 1 row offsets
+        :param cols: Array of values column indices
+        :param is_sorted: True if column indices are sorted within rows
+        :param no_duplicates: True if rows have no duplicated column indices
+        :return:
+        """
+
+        if len(row_offsets) != self.nrows + 1:
+            raise Exception("Row offsets array must have nrows + 1 size")
+
+        nvals = len(cols)
+        t_row_offsets = (ctypes.c_uint * len(row_offsets))(*row_offsets)
+        t_cols = (ctypes.c_uint * len(cols))(*cols)
+
+        status = wrapper.loaded_dll.spbla_Matrix_BuildCsr(
+            self.hnd, t_row_offsets, t_cols,
+            ctypes.c_uint(nvals),
+            ctypes.c_uint(bridge.get_build_hints(is_sorted, no_duplicates))
+        )
+
+        bridge.check(status)
+
     def dup(self):
         """
         Creates new matrix instance, the exact copy of the `self`
@@ -358,6 +498,18 @@ class Matrix:
 
         return self.nrows, self.ncols
 
+    def wait(self):
+        """
+        Evaluate pending operations of the `self` matrix.
+        Operations are pending only if library is loaded with `SPBLA_DEFERRED=1` environment variable,
+        otherwise this function does nothing.
+
+        :return: None
+        """
+
+        status = wrapper.loaded_dll.spbla_Matrix_Wait(self.hnd)
+        bridge.check(status)
+
     def to_lists(self):
         """
         Read matrix data as lists of `rows` and `clos` indices.
@@ -388,6 +540,35 @@ class Matrix:
 
         return rows, cols
 
+    def to_csr(self):
+        """
+        Read matrix data as lists of `row_offsets` and `cols` indices.
+
+        >>> a = Matrix.empty(shape=(4, 4))
+        >>> a[0, 0] = True
+        >>> a[1, 3] = True
+        >>> a[1, 0] = True
+        >>> a[2, 2] = True
+        >>> row_offsets, cols = a.to_csr()
+        >>> print(row_offsets, cols)
+        '[0, 1, 3, 4, 4] [0, 0, 3, 2]'
+
+        :return: Pair with `row_offsets` and `cols` lists
+        """
+
+        row_offsets = ctypes.POINTER(ctypes.c_uint)()
+        cols = ctypes.POINTER(ctypes.c_uint)()
+        nvals = ctypes.c_uint(0)
+
+        status = wrapper.loaded_dll.spbla_Matrix_ExtractCsr(
+            self.hnd, ctypes.byref(row_offsets), ctypes.byref(cols), ctypes.byref(nvals)
+        )
+
+        bridge.check(status)
+
+        # Arrays are owned by the matrix, so copy them
+        return row_offsets[:self.nrows + 1], cols[:nvals.value]
+
     def to_list(self):
         """
         Read matrix values as list of (i,j) pairs.
@@ -491,13 +672,18 @@ class Matrix:
         bridge.check(status)
         return out
 
-    def mxm(self, other, out=None, accumulate=False, time_check=False):
+    def mxm(self, other, out=None, accumulate=False, mask=None, complement=False,
+            transpose_left=False, transpose_right=False, time_check=False):
         """
         Matrix-matrix multiplication in boolean semiring with "x = and" and "+ = or" operations.
         Returns `self` multiplied to `other` matrix.
 
         Pass optional `out` matrix to store result.
         Pass `accumulate`=True to sum the multiplication result with `out` matrix.
+        Pass `mask` matrix to keep only values of the result present in the mask,
+        or `complement`=True to keep only values not present in the mask.
+        Pass `transpose_left` or `transpose_right` to multiply by transposed operand
+        without explicit transpose (not supported with mask).
 
         >>> a = Matrix.from_lists((4, 4), [0, 1, 2], [2, 3, 0])
         >>> b = Matrix.from_lists((4, 4), [0, 1, 3], [2, 3, 0])
@@ -514,20 +700,41 @@ class Matrix:
         :param other: Input matrix for multiplication
         :param out: Optional out matrix to store result
         :param accumulate: Set in true to accumulate the result with `out` matrix
+        :param mask: Optional mask matrix to filter values of the result
+        :param complement: Set in true to use structural complement of the `mask`
+        :param transpose_left: Set in true to use transposed `self` in the product
+        :param transpose_right: Set in true to use transposed `other` in the product
         :param time_check: Pass True to measure and log elapsed time of the operation
         :return: Matrix-matrix multiplication result (with possible accumulation to `out` if provided)
         """
 
         if out is None:
-            shape = (self.nrows, other.ncols)
+            shape = (self.ncols if transpose_left else self.nrows, other.nrows if transpose_right else other.ncols)
             out = Matrix.empty(shape)
             accumulate = False
 
+        if mask is not None:
+            if transpose_left or transpose_right:
+                raise Exception("Transposed operands are not supported by masked multiplication")
+
+            status = wrapper.loaded_dll.spbla_MxM_Masked(
+                out.hnd,
+                mask.hnd,
+                self.hnd,
+                other.hnd,
+                ctypes.c_uint(bridge.get_mxm_hints(is_accumulated=accumulate, time_check=time_check,
+                                                   is_complement=complement))
+            )
+
+            bridge.check(status)
+            return out
+
         status = wrapper.loaded_dll.spbla_MxM(
             out.hnd,
             self.hnd,
             other.hnd,
-            ctypes.c_uint(bridge.get_mxm_hints(is_accumulated=accumulate, time_check=time_check))
+            ctypes.c_uint(bridge.get_mxm_hints(is_accumulated=accumulate, time_check=time_check,
+                                               transpose_left=transpose_left, transpose_right=transpose_right))
         )
 
         bridge.check(status)
@@ -608,6 +815,76 @@ class Matrix:
         bridge.check(status)
         return out
 
+    def ewisemult(self, other, time_check=False):
+        """
+        Element-wise matrix-matrix multiplication with boolean "* = and" operation.
+        Returns element-wise intersection of `self` and `other` matrix.
+
+        >>> a = Matrix.from_lists((4, 4), [0, 1, 2], [2, 3, 0])
+        >>> b = Matrix.from_lists((4, 4), [0, 1, 3], [2, 3, 0])
+        >>> print(a.ewisemult(b))
+        '
+                0   1   2   3
+          0 |   .   .   1   . |   0
+          1 |   .   .   .   1 |   1
+          2 |   .   .   .   . |   2
+          3 |   .   .   .   . |   3
+                0   1   2   3
+        '
+
+        :param other: Input matrix to multiply
+        :param time_check: Pass True to measure and log elapsed time of the operation
+        :return: Element-wise matrix-matrix product
+        """
+
+        shape = (self.nrows, self.ncols)
+        out = Matrix.empty(shape)
+
+        status = wrapper.loaded_dll.spbla_Matrix_EWiseMult(
+            out.hnd,
+            self.hnd,
+            other.hnd,
+            ctypes.c_uint(bridge.get_ewiseadd_hints(time_check=time_check))
+        )
+
+        bridge.check(status)
+        return out
+
+    def ewisediff(self, other, time_check=False):
+        """
+        Element-wise matrix-matrix difference with boolean "and not" operation.
+        Returns values of `self`, which are not present in `other` matrix.
+
+        >>> a = Matrix.from_lists((4, 4), [0, 1, 2], [2, 3, 0])
+        >>> b = Matrix.from_lists((4, 4), [0, 1, 3], [2, 3, 0])
+        >>> print(a.ewisediff(b))
+        '
+                0   1   2   3
+          0 |   .   .   .   . |   0
+          1 |   .   .   .   . |   1
+          2 |   1   .   .   . |   2
+          3 |   .   .   .   . |   3
+                0   1   2   3
+        '
+
+        :param other: Input matrix of values to exclude
+        :param time_check: Pass True to measure and log elapsed time of the operation
+        :return: Element-wise matrix-matrix difference
+        """
+
+        shape = (self.nrows, self.ncols)
+        out = Matrix.empty(shape)
+
+        status = wrapper.loaded_dll.spbla_Matrix_EWiseDiff(
+            out.hnd,
+            self.hnd,
+            other.hnd,
+            ctypes.c_uint(bridge.get_ewiseadd_hints(time_check=time_check))
+        )
+
+        bridge.check(status)
+        return out
+
     def reduce(self, time_check=False):
         """
         Reduce matrix to vector with boolean "+ = or" operation.
@@ -640,6 +917,40 @@ class Matrix:
         bridge.check(status)
         return out
 
+    def transitive_closure(self, out=None, time_check=False):
+        """
+        Evaluate transitive closure of the square matrix (adjacency matrix of the graph).
+        Returns matrix of all pairs of vertices connected by a path.
+        Iterations are evaluated inside the library only on newly discovered pairs.
+
+        >>> matrix = Matrix.from_lists((4, 4), [0, 1, 2], [1, 2, 3])
+        >>> print(matrix.transitive_closure())
+        '
+                0   1   2   3
+          0 |   .   1   1   1 |   0
+          1 |   .   .   1   1 |   1
+          2 |   .   .   .   1 |   2
+          3 |   .   .   .   . |   3
+                0   1   2   3
+        '
+
+        :param out: Optional out matrix to store result (may be `self`)
+        :param time_check: Pass True to measure and log elapsed time of the operation
+        :return: Transitive closure matrix
+        """
+
+        if out is None:
+            out = Matrix.empty(self.shape)
+
+        status = wrapper.loaded_dll.spbla_Matrix_TransitiveClosure(
+            out.hnd,
+            self.hnd,
+            ctypes.c_uint(bridge.get_transitive_closure_hints(time_check=time_check))
+        )
+
+        bridge.check(status)
+        return out
+
     def equals(self, other) -> bool:
         """
         Compare two matrices. Returns true if they are equal.
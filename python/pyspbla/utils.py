@@ -5,6 +5,8 @@ Features:
 - Allows to setup logging to custom file with filter settings
 - Allows to setup default log
 - Allows to create default log file name (for user purposes)
+- Allows to query and reset per operation performance counters
+- Allows to trace library operations into chrome trace file
 """
 
 from . import wrapper
@@ -16,7 +18,11 @@ import datetime
 __all__ = [
     "setup_logger",
     "setup_default_logger",
-    "get_default_log_name"
+    "setup_tracing",
+    "get_default_log_name",
+    "get_stats",
+    "reset_stats",
+    "wait"
 ]
 
 
@@ -29,7 +35,7 @@ def get_default_log_name():
     return "spbla-" + datetime.datetime.now().strftime("%d-%m-%y--%H-%M-%S") + ".textlog"
 
 
-def setup_logger(file_path: str, default=True, error=False, warning=False):
+def setup_logger(file_path: str, default=True, error=False, warning=False, asynchronous=False):
     """
     Allows to setup logging into user defined logging file.
 
@@ -37,12 +43,13 @@ def setup_logger(file_path: str, default=True, error=False, warning=False):
     :param default: Set in true to use default (all) log filter
     :param error: Set in true to log errors
     :param warning: Set in true to log warnings
+    :param asynchronous: Set in true to write log on the background thread (bounded queue, batched flushes)
     :return: None
     """
 
     status = wrapper.loaded_dll.spbla_SetupLogging(
         file_path.encode("utf-8"),
-        ctypes.c_uint(bridge.get_log_hints(default, error, warning))
+        ctypes.c_uint(bridge.get_log_hints(default, error, warning, asynchronous))
     )
 
     bridge.check(status)
@@ -60,3 +67,67 @@ def setup_default_logger():
     log_path = here / get_default_log_name()
 
     setup_logger(str(log_path), default=True)
+
+
+def setup_tracing(file_path: str):
+    """
+    Allows to trace library operations and phases of its kernels into user defined file.
+    Trace is written in chrome trace event json format on library finalize,
+    use chrome://tracing or Perfetto UI to view it.
+
+    :param file_path: Full/relative path to the file to save trace
+    :return: None
+    """
+
+    status = wrapper.loaded_dll.spbla_SetupTracing(
+        file_path.encode("utf-8"),
+        ctypes.c_uint(0)
+    )
+
+    bridge.check(status)
+
+
+def get_stats():
+    """
+    Query performance counters of the library operations.
+    Counters are collected since the library is loaded or since the last `reset_stats` call.
+
+    Counters of each operation: calls, time_total_ns, time_min_ns, time_max_ns,
+    nnz_in, nnz_out, flops (estimated, zero for operations without multiplication), bytes_allocated (estimated).
+
+    :return: Dict of operation name to dict of its counters
+    """
+
+    count = len(bridge.operation_names)
+    stats = (bridge.OperationStats * count)()
+
+    status = wrapper.loaded_dll.spbla_GetStats(stats, ctypes.c_uint(count))
+    bridge.check(status)
+
+    return {
+        name: {field: getattr(stats[i], field) for field, _ in bridge.OperationStats._fields_}
+        for i, name in enumerate(bridge.operation_names)
+    }
+
+
+def reset_stats():
+    """
+    Reset performance counters of all library operations.
+
+    :return: None
+    """
+
+    status = wrapper.loaded_dll.spbla_ResetStats()
+    bridge.check(status)
+
+
+def wait():
+    """
+    Evaluate pending operations of all matrices.
+    Operations are pending only if library is loaded with `SPBLA_DEFERRED=1` environment variable.
+
+    :return: None
+    """
+
+    status = wrapper.loaded_dll.spbla_Wait()
+    bridge.check(status)
@@ -45,6 +45,7 @@ class Wrapper:
     def __init__(self):
         self.loaded_dll = None
         self.backend = "default"
+        self.deferred = False
 
         try:
             if os.environ["SPBLA_DOCS_ONLY"]:
@@ -66,6 +67,12 @@ class Wrapper:
         except KeyError:
             pass
 
+        try:
+            # Check, if user wants operations to be evaluated on demand
+            self.deferred = str(os.environ["SPBLA_DEFERRED"]).lower() in ("1", "true", "on")
+        except KeyError:
+            pass
+
         assert self.load_path
         assert self.backend
 
@@ -76,7 +83,7 @@ class Wrapper:
         self.__release_library()
 
     def __setup_library(self):
-        status = self.loaded_dll.spbla_Initialize(ctypes.c_uint(bridge.get_init_hints(self.backend)))
+        status = self.loaded_dll.spbla_Initialize(ctypes.c_uint(bridge.get_init_hints(self.backend, self.deferred)))
         bridge.check(status)
 
     def __release_library(self):
@@ -0,0 +1,6 @@
+# Runs operations benchmarks and exports results into json file
+# Invoke this script within build directory (configured with -DSPBLA_BUILD_BENCHMARKS=ON)
+# Usage: run_benchmarks.sh [output json file] [extra google benchmark args]
+OUTPUT=${1:-spbla-benchmarks.json}
+shift
+./spbla/benchmarks/spbla_benchmarks --benchmark_out="$OUTPUT" --benchmark_out_format=json "$@"
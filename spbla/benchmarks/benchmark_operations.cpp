@@ -0,0 +1,462 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <spbla/spbla.h>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <tuple>
+#include <vector>
+
+// Benchmarks of the C API operations.
+//
+// Each benchmark is parametrized by backend, matrix size N and density (in 1/10000 units),
+// graph benchmarks use R-MAT graphs with 2^scale vertices and given average degree.
+// Reported counters: nnz/s - input values processed per second, flops/s - estimated boolean
+// flops per second (number of a(i,k) * b(k,j) products, reported for multiplications only).
+//
+// Json export for regression tracking:
+//   ./spbla_benchmarks --benchmark_out=results.json --benchmark_out_format=json
+
+namespace {
+
+    enum Backend {
+        BACKEND_CPU = 0,
+        BACKEND_CPU_PARALLEL = 1,
+        BACKEND_CUDA = 2,
+        BACKEND_OPENCL = 3
+    };
+
+    const char* getBackendName(int64_t backend) {
+        switch (backend) {
+            case BACKEND_CPU:
+                return "cpu";
+            case BACKEND_CPU_PARALLEL:
+                return "cpu_parallel";
+            case BACKEND_CUDA:
+                return "cuda";
+            default:
+                return "opencl";
+        }
+    }
+
+    spbla_Hints getBackendHints(int64_t backend) {
+        switch (backend) {
+            case BACKEND_CPU:
+                return SPBLA_HINT_CPU_BACKEND;
+            case BACKEND_CPU_PARALLEL:
+                return SPBLA_HINT_CPU_PARALLEL_BACKEND;
+            case BACKEND_CUDA:
+                return SPBLA_HINT_CUDA_BACKEND;
+            default:
+                return SPBLA_HINT_OPENCL_BACKEND;
+        }
+    }
+
+    bool isBackendCompiled(int64_t backend) {
+        switch (backend) {
+            case BACKEND_CPU:
+#ifdef SPBLA_WITH_SEQUENTIAL
+                return true;
+#else
+                return false;
+#endif
+            case BACKEND_CPU_PARALLEL:
+#ifdef SPBLA_WITH_PARALLEL
+                return true;
+#else
+                return false;
+#endif
+            case BACKEND_CUDA:
+#ifdef SPBLA_WITH_CUDA
+                return true;
+#else
+                return false;
+#endif
+            default:
+#ifdef SPBLA_WITH_OPENCL
+                return true;
+#else
+                return false;
+#endif
+        }
+    }
+
+    struct Data {
+        size_t nrows = 0;
+        size_t ncols = 0;
+        std::vector<spbla_Index> rows;
+        std::vector<spbla_Index> cols;
+        std::vector<size_t> rowNvals;
+    };
+
+    // Data is generated with fixed seed, so results of different runs are comparable
+    const Data& getData(size_t nrows, size_t ncols, int64_t density, uint32_t seed) {
+        static std::map<std::tuple<size_t, size_t, int64_t, uint32_t>, Data> cache;
+
+        auto key = std::make_tuple(nrows, ncols, density, seed);
+        auto found = cache.find(key);
+
+        if (found != cache.end())
+            return found->second;
+
+        std::mt19937_64 engine(seed);
+        std::uniform_int_distribution<uint64_t> dist(0, (uint64_t) nrows * ncols - 1);
+        auto count = (size_t) ((double) nrows * (double) ncols * (double) density / 10000.0);
+
+        std::vector<uint64_t> keys(count);
+        for (auto& k: keys)
+            k = dist(engine);
+
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        Data& data = cache[key];
+        data.nrows = nrows;
+        data.ncols = ncols;
+        data.rows.reserve(keys.size());
+        data.cols.reserve(keys.size());
+        data.rowNvals.resize(nrows, 0);
+
+        for (auto k: keys) {
+            auto i = (spbla_Index) (k / ncols);
+            data.rows.push_back(i);
+            data.cols.push_back((spbla_Index) (k % ncols));
+            data.rowNvals[i] += 1;
+        }
+
+        return data;
+    }
+
+    spbla_Matrix makeMatrix(const Data& data) {
+        spbla_Matrix matrix = nullptr;
+        spbla_Matrix_New(&matrix, (spbla_Index) data.nrows, (spbla_Index) data.ncols);
+        spbla_Matrix_Build(matrix, data.rows.data(), data.cols.data(), (spbla_Index) data.rows.size(),
+                           SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES);
+        return matrix;
+    }
+
+    // Number of a(i,k) * b(k,j) products, evaluated by a x b
+    double countMultiplyFlops(const Data& a, const Data& b) {
+        double flops = 0;
+        for (auto k: a.cols)
+            flops += (double) b.rowNvals[k];
+        return flops;
+    }
+
+    /** Library setup for a single benchmark run */
+    class Session {
+    public:
+        explicit Session(benchmark::State& state) {
+            auto backend = state.range(0);
+
+            if (!isBackendCompiled(backend)) {
+                state.SkipWithError("Backend is not compiled");
+                return;
+            }
+
+            if (spbla_Initialize(getBackendHints(backend)) != SPBLA_STATUS_SUCCESS) {
+                state.SkipWithError("Failed to initialize library");
+                return;
+            }
+
+            mInitialized = true;
+
+            // Library silently falls back to cpu, if gpu is not available
+            spbla_DeviceCaps caps;
+            spbla_GetDeviceCaps(&caps);
+
+            if ((backend == BACKEND_CUDA && !caps.cudaSupported) ||
+                (backend == BACKEND_OPENCL && !caps.openclSupported)) {
+                state.SkipWithError("Backend is not available");
+                return;
+            }
+
+            state.SetLabel(getBackendName(backend));
+            mReady = true;
+        }
+
+        ~Session() {
+            for (auto m: mMatrices)
+                spbla_Matrix_Free(m);
+            if (mInitialized)
+                spbla_Finalize();
+        }
+
+        spbla_Matrix track(spbla_Matrix matrix) {
+            mMatrices.push_back(matrix);
+            return matrix;
+        }
+
+        spbla_Matrix create(spbla_Index nrows, spbla_Index ncols) {
+            spbla_Matrix matrix = nullptr;
+            spbla_Matrix_New(&matrix, nrows, ncols);
+            return track(matrix);
+        }
+
+        bool isReady() const { return mReady; }
+
+    private:
+        std::vector<spbla_Matrix> mMatrices;
+        bool mInitialized = false;
+        bool mReady = false;
+    };
+
+    void setCounters(benchmark::State& state, double nnz, double flops) {
+        auto iterations = (double) state.iterations();
+        state.counters["nnz/s"] = benchmark::Counter(nnz * iterations, benchmark::Counter::kIsRate);
+
+        if (flops > 0)
+            state.counters["flops/s"] = benchmark::Counter(flops * iterations, benchmark::Counter::kIsRate);
+
+        state.counters["nnz"] = nnz;
+    }
+
+    void checkStatus(benchmark::State& state, spbla_Status status) {
+        if (status != SPBLA_STATUS_SUCCESS)
+            state.SkipWithError("Operation failed");
+    }
+
+    size_t getN(const benchmark::State& state) { return (size_t) state.range(1); }
+    int64_t getDensity(const benchmark::State& state) { return state.range(2); }
+
+}
+
+static void BM_MatrixBuild(benchmark::State& state) {
+    Session session(state);
+    if (!session.isReady()) return;
+
+    auto n = getN(state);
+    auto& data = getData(n, n, getDensity(state), 1);
+    auto matrix = session.create(n, n);
+    auto nvals = (spbla_Index) data.rows.size();
+
+    for (auto _: state)
+        checkStatus(state, spbla_Matrix_Build(matrix, data.rows.data(), data.cols.data(), nvals, SPBLA_HINT_NO));
+
+    setCounters(state, (double) nvals, 0);
+}
+
+static void BM_MxM(benchmark::State& state, bool accumulate) {
+    Session session(state);
+    if (!session.isReady()) return;
+
+    auto n = getN(state);
+    auto& da = getData(n, n, getDensity(state), 1);
+    auto& db = getData(n, n, getDensity(state), 2);
+    auto a = session.track(makeMatrix(da));
+    auto b = session.track(makeMatrix(db));
+    auto r = session.create(n, n);
+    auto hints = accumulate? SPBLA_HINT_ACCUMULATE: SPBLA_HINT_NO;
+
+    // Accumulated result reaches fixed point after the first product
+    if (accumulate)
+        checkStatus(state, spbla_MxM(r, a, b, SPBLA_HINT_NO));
+
+    for (auto _: state)
+        checkStatus(state, spbla_MxM(r, a, b, hints));
+
+    setCounters(state, (double) (da.rows.size() + db.rows.size()), countMultiplyFlops(da, db));
+}
+
+static void BM_EWiseAdd(benchmark::State& state) {
+    Session session(state);
+    if (!session.isReady()) return;
+
+    auto n = getN(state);
+    auto& da = getData(n, n, getDensity(state), 1);
+    auto& db = getData(n, n, getDensity(state), 2);
+    auto a = session.track(makeMatrix(da));
+    auto b = session.track(makeMatrix(db));
+    auto r = session.create(n, n);
+    auto nnz = (double) (da.rows.size() + db.rows.size());
+
+    for (auto _: state)
+        checkStatus(state, spbla_Matrix_EWiseAdd(r, a, b, SPBLA_HINT_NO));
+
+    setCounters(state, nnz, 0);
+}
+
+static void BM_Transpose(benchmark::State& state) {
+    Session session(state);
+    if (!session.isReady()) return;
+
+    auto n = getN(state);
+    auto& da = getData(n, n, getDensity(state), 1);
+    auto a = session.track(makeMatrix(da));
+    auto r = session.create(n, n);
+    auto nnz = (double) da.rows.size();
+
+    for (auto _: state)
+        checkStatus(state, spbla_Matrix_Transpose(r, a, SPBLA_HINT_NO));
+
+    setCounters(state, nnz, 0);
+}
+
+static void BM_Reduce(benchmark::State& state) {
+    Session session(state);
+    if (!session.isReady()) return;
+
+    auto n = getN(state);
+    auto& da = getData(n, n, getDensity(state), 1);
+    auto a = session.track(makeMatrix(da));
+    auto r = session.create(n, 1);
+    auto nnz = (double) da.rows.size();
+
+    for (auto _: state)
+        checkStatus(state, spbla_Matrix_Reduce(r, a, SPBLA_HINT_NO));
+
+    setCounters(state, nnz, 0);
+}
+
+static void BM_Kronecker(benchmark::State& state) {
+    Session session(state);
+    if (!session.isReady()) return;
+
+    // Result has N^2 x N^2 dimension, so operands are kept small
+    auto n = getN(state);
+    auto& da = getData(n, n, getDensity(state), 1);
+    auto& db = getData(n, n, getDensity(state), 2);
+    auto a = session.track(makeMatrix(da));
+    auto b = session.track(makeMatrix(db));
+    auto r = session.create(n * n, n * n);
+
+    for (auto _: state)
+        checkStatus(state, spbla_Kronecker(r, a, b, SPBLA_HINT_NO));
+
+    setCounters(state, (double) (da.rows.size() + db.rows.size()), (double) da.rows.size() * (double) db.rows.size());
+}
+
+static void BM_ExtractSubMatrix(benchmark::State& state) {
+    Session session(state);
+    if (!session.isReady()) return;
+
+    // Central block with half of the rows and columns
+    auto n = getN(state);
+    auto& da = getData(n, n, getDensity(state), 1);
+    auto a = session.track(makeMatrix(da));
+    auto r = session.create(n / 2, n / 2);
+    auto nnz = (double) da.rows.size();
+
+    for (auto _: state)
+        checkStatus(state, spbla_Matrix_ExtractSubMatrix(r, a, n / 4, n / 4, n / 2, n / 2, SPBLA_HINT_NO));
+
+    setCounters(state, nnz, 0);
+}
+
+static void BM_ExtractPairs(benchmark::State& state) {
+    Session session(state);
+    if (!session.isReady()) return;
+
+    auto n = getN(state);
+    auto& da = getData(n, n, getDensity(state), 1);
+    auto a = session.track(makeMatrix(da));
+    std::vector<spbla_Index> rows(da.rows.size());
+    std::vector<spbla_Index> cols(da.cols.size());
+    auto nnz = (double) da.rows.size();
+
+    for (auto _: state) {
+        auto nvals = (spbla_Index) rows.size();
+        checkStatus(state, spbla_Matrix_ExtractPairs(a, rows.data(), cols.data(), &nvals));
+        benchmark::DoNotOptimize(rows.data());
+    }
+
+    setCounters(state, nnz, 0);
+}
+
+static void BM_MxMGraph(benchmark::State& state) {
+    Session session(state);
+    if (!session.isReady()) return;
+
+    // R-MAT graph with 2^scale vertices and given average degree, squared
+    auto n = (spbla_Index) 1 << (spbla_Index) state.range(1);
+    auto nvals = n * (spbla_Index) state.range(2);
+    auto a = session.create(n, n);
+    auto r = session.create(n, n);
+
+    checkStatus(state, spbla_Matrix_Generate(a, SPBLA_GENERATOR_RMAT, nvals, 1, nullptr, SPBLA_HINT_NO));
+    checkStatus(state, spbla_Matrix_Nvals(a, &nvals));
+
+    Data data;
+    data.rows.resize(nvals);
+    data.cols.resize(nvals);
+    data.rowNvals.resize(n, 0);
+    checkStatus(state, spbla_Matrix_ExtractPairs(a, data.rows.data(), data.cols.data(), &nvals));
+
+    for (auto i: data.rows)
+        data.rowNvals[i] += 1;
+
+    for (auto _: state)
+        checkStatus(state, spbla_MxM(r, a, a, SPBLA_HINT_NO));
+
+    setCounters(state, 2.0 * (double) nvals, countMultiplyFlops(data, data));
+}
+
+static void OperationArgs(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"backend", "n", "density"});
+    benchmark->ArgsProduct({
+        {BACKEND_CPU, BACKEND_CPU_PARALLEL, BACKEND_CUDA, BACKEND_OPENCL},
+        {1024, 4096, 16384},
+        {10, 100}
+    });
+    benchmark->Unit(benchmark::kMillisecond);
+    benchmark->UseRealTime();
+}
+
+static void KroneckerArgs(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"backend", "n", "density"});
+    benchmark->ArgsProduct({
+        {BACKEND_CPU, BACKEND_CPU_PARALLEL, BACKEND_CUDA, BACKEND_OPENCL},
+        {64, 256},
+        {100, 1000}
+    });
+    benchmark->Unit(benchmark::kMillisecond);
+    benchmark->UseRealTime();
+}
+
+static void GraphArgs(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"backend", "scale", "degree"});
+    benchmark->ArgsProduct({
+        {BACKEND_CPU, BACKEND_CPU_PARALLEL, BACKEND_CUDA, BACKEND_OPENCL},
+        {12, 16},
+        {8, 16}
+    });
+    benchmark->Unit(benchmark::kMillisecond);
+    benchmark->UseRealTime();
+}
+
+BENCHMARK(BM_MatrixBuild)->Apply(OperationArgs);
+BENCHMARK_CAPTURE(BM_MxM, no_accumulate, false)->Apply(OperationArgs);
+BENCHMARK_CAPTURE(BM_MxM, accumulate, true)->Apply(OperationArgs);
+BENCHMARK(BM_MxMGraph)->Apply(GraphArgs);
+BENCHMARK(BM_EWiseAdd)->Apply(OperationArgs);
+BENCHMARK(BM_Transpose)->Apply(OperationArgs);
+BENCHMARK(BM_Reduce)->Apply(OperationArgs);
+BENCHMARK(BM_Kronecker)->Apply(KroneckerArgs);
+BENCHMARK(BM_ExtractSubMatrix)->Apply(OperationArgs);
+BENCHMARK(BM_ExtractPairs)->Apply(OperationArgs);
+
+BENCHMARK_MAIN();
@@ -89,7 +89,9 @@ typedef enum spbla_Status {
     /** Failed to select supported backend for computations */
     SPBLA_STATUS_BACKEND_ERROR = 7,
     /** Some library feature is not implemented */
-    SPBLA_STATUS_NOT_IMPLEMENTED = 8
+    SPBLA_STATUS_NOT_IMPLEMENTED = 8,
+    /** Result of the operation does not fit spbla_Index (consider SPBLA_WITH_INDEX64 build) */
+    SPBLA_STATUS_INDEX_OVERFLOW = 9
 } spbla_Status;
 
 /** Generic lib hits for matrix processing */
@@ -119,18 +121,124 @@ typedef enum spbla_Hint {
     /** No duplicates in the build data */
     SPBLA_HINT_NO_DUPLICATES = 1024,
     /** Performs time measurement and logs elapsed operation time */
-    SPBLA_HINT_TIME_CHECK = 2048
+    SPBLA_HINT_TIME_CHECK = 2048,
+    /** Force Cpu based multithreaded backend usage */
+    SPBLA_HINT_CPU_PARALLEL_BACKEND = 4096,
+    /** Use structural complement of the mask (values not present in the mask) */
+    SPBLA_HINT_MASK_COMPLEMENT = 8192,
+    /** Logging hint: write log on the background thread through bounded message queue */
+    SPBLA_HINT_LOG_ASYNC = 16384,
+    /** Init hint: record matrix operations and evaluate them when result is read */
+    SPBLA_HINT_DEFERRED = 32768,
+    /** Use transposed left operand of the multiplication (transpose is not materialized) */
+    SPBLA_HINT_TRANSPOSE_LEFT = 65536,
+    /** Use transposed right operand of the multiplication (transpose is not materialized) */
+    SPBLA_HINT_TRANSPOSE_RIGHT = 131072,
+    /** Matrix hint: keep transposed (csc) storage of the matrix, built on first use and dropped on write */
+    SPBLA_HINT_KEEP_TRANSPOSED = 262144
 } spbla_Hint;
 
+/** Kinds of the operations with performance counters */
+typedef enum spbla_Operation {
+    /** Matrix build from pairs or csr arrays */
+    SPBLA_OPERATION_BUILD = 0,
+    /** Matrix values extraction */
+    SPBLA_OPERATION_EXTRACT = 1,
+    /** Sub-matrix extraction */
+    SPBLA_OPERATION_EXTRACT_SUB_MATRIX = 2,
+    /** Matrix duplication */
+    SPBLA_OPERATION_DUPLICATE = 3,
+    /** Matrix transpose */
+    SPBLA_OPERATION_TRANSPOSE = 4,
+    /** Matrix reduce to vector */
+    SPBLA_OPERATION_REDUCE = 5,
+    /** Matrix-matrix multiplication */
+    SPBLA_OPERATION_MXM = 6,
+    /** Masked matrix-matrix multiplication */
+    SPBLA_OPERATION_MXM_MASKED = 7,
+    /** Kronecker product */
+    SPBLA_OPERATION_KRONECKER = 8,
+    /** Element-wise addition */
+    SPBLA_OPERATION_EWISE_ADD = 9,
+    /** Element-wise multiplication */
+    SPBLA_OPERATION_EWISE_MULT = 10,
+    /** Element-wise difference */
+    SPBLA_OPERATION_EWISE_DIFF = 11,
+    /** Transitive closure */
+    SPBLA_OPERATION_TRANSITIVE_CLOSURE = 12,
+    /** Matrix-vector multiplication */
+    SPBLA_OPERATION_MXV = 13,
+    /** Vector-matrix multiplication */
+    SPBLA_OPERATION_VXM = 14,
+    /** Matrix load from binary or mtx file */
+    SPBLA_OPERATION_LOAD = 15,
+    /** Matrix save to binary or mtx file */
+    SPBLA_OPERATION_SAVE = 16,
+    /** Number of operation kinds */
+    SPBLA_OPERATION_COUNT = 17
+} spbla_Operation;
+
+/** Kinds of the synthetic matrices generators */
+typedef enum spbla_Generator {
+    /** Uniform random matrix G(n, m) with exactly requested number of values */
+    SPBLA_GENERATOR_ERDOS_RENYI = 0,
+    /** R-MAT (recursive matrix, Kronecker graph) with skewed degrees and community structure */
+    SPBLA_GENERATOR_RMAT = 1,
+    /** Chung-Lu graph with power-law expected degrees of rows and columns */
+    SPBLA_GENERATOR_POWER_LAW = 2
+} spbla_Generator;
+
+/** Parameters of the synthetic matrices generators */
+typedef struct spbla_GeneratorParams {
+    /** R-MAT probability of the top-left quadrant (default 0.57) */
+    float rmatA;
+    /** R-MAT probability of the top-right quadrant (default 0.19) */
+    float rmatB;
+    /** R-MAT probability of the bottom-left quadrant (default 0.19), bottom-right gets the rest */
+    float rmatC;
+    /** Exponent of the power-law degrees distribution, must be greater than 1 (default 2.1) */
+    float powerLawExponent;
+} spbla_GeneratorParams;
+
 /** Hit mask */
 typedef uint32_t spbla_Hints;
 
-/** Alias integer type for indexing operations */
+/**
+ * Alias integer type for indexing operations.
+ * Library built with SPBLA_WITH_INDEX64 uses 64-bit indices (clients must define it as well).
+ */
+#ifdef SPBLA_WITH_INDEX64
+typedef uint64_t spbla_Index;
+#else
 typedef uint32_t spbla_Index;
+#endif
 
 /** Cubool sparse boolean matrix handle */
 typedef struct spbla_Matrix_t* spbla_Matrix;
 
+/** Sparse boolean vector handle */
+typedef struct spbla_Vector_t* spbla_Vector;
+
+/** Performance counters of the single operation kind */
+typedef struct spbla_OperationStats {
+    /** Number of completed calls */
+    uint64_t calls;
+    /** Total time of all calls in nanoseconds */
+    uint64_t timeTotalNs;
+    /** Min time of the single call in nanoseconds (0 if no calls) */
+    uint64_t timeMinNs;
+    /** Max time of the single call in nanoseconds */
+    uint64_t timeMaxNs;
+    /** Total number of values in input operands */
+    uint64_t nnzIn;
+    /** Total number of values in results */
+    uint64_t nnzOut;
+    /** Estimated number of boolean multiply-add operations (zero for operations without multiplication) */
+    uint64_t flops;
+    /** Estimated number of bytes allocated for results storage */
+    uint64_t bytesAllocated;
+} spbla_OperationStats;
+
 /** Device capabilities */
 typedef struct spbla_DeviceCaps {
     char name[256];
@@ -187,6 +295,9 @@ SPBLA_EXPORT SPBLA_API spbla_Status spbla_GetVersion(
  * @note Pass `SPBLA_HINT_LOG_ERROR` to include error messages into log
  * @note Pass `SPBLA_HINT_LOG_WARNING` to include warning messages into log
  * @note Pass `SPBLA_HINT_LOG_ALL` to include all messages into log
+ * @note Pass `SPBLA_HINT_LOG_ASYNC` to write log on the background thread with batched flushes.
+ *       Messages are queued into bounded buffer; if it overflows, messages are dropped
+ *       and the number of dropped messages is logged. Queued messages are written on finalize.
  *
  * @param logFileName UTF-8 encoded null-terminated file name and path string.
  * @param hints Logging hints to filter messages.
@@ -198,12 +309,66 @@ SPBLA_EXPORT SPBLA_API spbla_Status spbla_SetupLogging(
     spbla_Hints hints
 );
 
+/**
+ * Allows to setup tracing file for all operations, invoked after this function call.
+ * Library records timeline of matrix operations, cache commits and backend kernels phases
+ * with matrix markers and nnz as arguments. Timeline is written to the file
+ * in Chrome trace json format (see chrome://tracing or Perfetto) on library finalize.
+ *
+ * @note It is safe to call this function before the library is initialized.
+ * @note Tracing file of the previous setup call (if any) is written immediately.
+ *
+ * @param traceFileName UTF-8 encoded null-terminated file name and path string.
+ * @param hints Reserved for future use, pass `SPBLA_HINT_NO`.
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_SetupTracing(
+    const char* traceFileName,
+    spbla_Hints hints
+);
+
+/**
+ * Evaluates pending values of all matrices, created within this library instance.
+ *
+ * @note Does nothing, if library is not initialized with `SPBLA_HINT_DEFERRED`.
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Wait(
+);
+
+/**
+ * Sets number of threads used by the Cpu multithreaded backend.
+ * If this function is not called, the value of the `SPBLA_NUM_THREADS` environment variable is used,
+ * otherwise the number of hardware threads in the system.
+ *
+ * @note It is safe to call this function before the library is initialized.
+ * @note Pass 0 to use default number of threads.
+ *
+ * @param numThreads Total number of threads (including the caller thread)
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_SetNumThreads(
+    spbla_Index numThreads
+);
+
 /**
  * Initialize library instance object, which provides context to all library operations and primitives.
  * This function must be called before any other library function is called,
  * except first get-info functions.
  *
  * @note Pass `SPBLA_HINT_RELAXED_FINALIZE` for library setup within python.
+ * @note Pass `SPBLA_HINT_CPU_BACKEND` to force Cpu sequential backend.
+ * @note Pass `SPBLA_HINT_CPU_PARALLEL_BACKEND` to force Cpu multithreaded backend.
+ * @note Pass `SPBLA_HINT_DEFERRED` to enable deferred execution mode. In this mode transpose,
+ *       reduce, sub-matrix extraction, element-wise addition and not masked multiplication only record
+ *       pending value of the result matrix. Pending values are evaluated, when the matrix is read
+ *       (nvals, extract, save, used by not deferred operation) or on `spbla_Wait` call.
+ *       Operations over pending values are fused: transposed argument of the multiplication,
+ *       reduce of the product, sub-matrix of the product and chains of additions are evaluated
+ *       without intermediate matrices. Errors of the evaluation are reported by the call, which reads the matrix.
  *
  * @param hints Init hints.
  *
@@ -237,6 +402,33 @@ SPBLA_EXPORT SPBLA_API spbla_Status spbla_GetDeviceCaps(
     spbla_DeviceCaps* deviceCaps
 );
 
+/**
+ * Query performance counters of the operations, collected since the library
+ * was loaded or since the last `spbla_ResetStats` call.
+ * Counters of the operation kind `op` are stored in `stats[op]`.
+ *
+ * @note It is safe to call this function before the library is initialized.
+ *
+ * @param stats Pointer to array of `count` elements to store counters
+ * @param count Number of elements in the array; only first min(count, SPBLA_OPERATION_COUNT) kinds are queried
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_GetStats(
+    spbla_OperationStats* stats,
+    uint32_t count
+);
+
+/**
+ * Reset performance counters of all operations.
+ *
+ * @note It is safe to call this function before the library is initialized.
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_ResetStats(
+);
+
 /**
  * Creates new sparse matrix with specified size.
  *
@@ -252,6 +444,28 @@ SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_New(
     spbla_Index ncols
 );
 
+/**
+ * Creates new sparse matrix with specified size and storage hints.
+ *
+ * @note Pass `SPBLA_HINT_KEEP_TRANSPOSED` to keep transposed (csc) storage of the matrix on Cpu backends.
+ *       It is built on first use and dropped, when the matrix is modified. Transpose, extraction of the
+ *       narrow columns range, pull-direction matrix-vector products and multiplication by transposed
+ *       matrix use this storage instead of sorting values of the matrix again.
+ *
+ * @param matrix Pointer where to store created matrix handle
+ * @param nrows Matrix rows count
+ * @param ncols Matrix columns count
+ * @param hints Hints for the matrix storage
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_NewWithHints(
+    spbla_Matrix* matrix,
+    spbla_Index nrows,
+    spbla_Index ncols,
+    spbla_Hints hints
+);
+
 /**
  * Build sparse matrix from provided pairs array. Pairs are supposed to be stored
  * as (rows[i],cols[i]) for pair with i-th index.
@@ -276,6 +490,31 @@ SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_Build(
     spbla_Hints hints
 );
 
+/**
+ * Build sparse matrix from provided compressed sparse row arrays.
+ * Column indices of the i-th row are stored in colIndices[rowOffsets[i]..rowOffsets[i+1]).
+ *
+ * @note This function automatically sorts rows and reduces duplicates
+ * @note Pass `SPBLA_HINT_VALUES_SORTED` if column indices are sorted within rows.
+ * @note Pass `SPBLA_HINT_NO_DUPLICATES` if rows has no duplicated column indices.
+ *       If both hints are passed, data is trusted and stored as is (column bounds are not checked).
+ *
+ * @param matrix Matrix handle to perform operation on
+ * @param rowOffsets Array of nrows + 1 row offsets
+ * @param colIndices Array of column indices
+ * @param nvals Number of the column indices passed
+ * @param hints Hits flags for processing.
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_BuildCsr(
+    spbla_Matrix matrix,
+    const spbla_Index* rowOffsets,
+    const spbla_Index* colIndices,
+    spbla_Index nvals,
+    spbla_Hints hints
+);
+
 /**
  * Sets specified (i, j) value of the matrix to True.
  *
@@ -348,6 +587,128 @@ SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_ExtractPairs(
     spbla_Index* nvals
 );
 
+/**
+ * Gives read-only access to the matrix data in compressed sparse row format without copying.
+ * Column indices of the i-th row are stored in colIndices[rowOffsets[i]..rowOffsets[i+1]) in ascending order.
+ *
+ * @note Returned arrays are owned by the matrix and remain valid
+ *       until the matrix is modified or released.
+ *
+ * @param matrix Matrix handle to perform operation on
+ * @param[out] rowOffsets Where to store pointer to nrows + 1 row offsets
+ * @param[out] colIndices Where to store pointer to column indices
+ * @param[out] nvals Where to store number of the column indices
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_ExtractCsr(
+    spbla_Matrix matrix,
+    const spbla_Index** rowOffsets,
+    const spbla_Index** colIndices,
+    spbla_Index* nvals
+);
+
+/**
+ * Saves matrix to the binary file.
+ *
+ * File stores matrix in csr format: header with format version, matrix size and checksum,
+ * followed by row offsets and column indices sections, each aligned on 64 bytes.
+ *
+ * @param matrix Matrix handle to save
+ * @param path UTF-8 encoded null-terminated path to the file (overwritten if exists)
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_Save(
+    spbla_Matrix matrix,
+    const char* path
+);
+
+/**
+ * Loads matrix from the binary file, created by `spbla_Matrix_Save`.
+ * File is memory mapped (where supported), its sections are validated with
+ * checksum and copied into matrix storage as is (values are not parsed or sorted).
+ *
+ * @note Pass `SPBLA_HINT_TIME_CHECK` hint to measure operation time
+ *
+ * @param path UTF-8 encoded null-terminated path to the file
+ * @param matrix Pointer where to store created matrix handle
+ * @param hints Hints flags for processing.
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_Load(
+    const char* path,
+    spbla_Matrix* matrix,
+    spbla_Hints hints
+);
+
+/**
+ * Exports matrix to the text file in Matrix Market coordinate format.
+ * Matrix is written as `pattern general` matrix with 1-based indices.
+ *
+ * @param matrix Matrix handle to export
+ * @param path UTF-8 encoded null-terminated path to the file (overwritten if exists)
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_ExportMtx(
+    spbla_Matrix matrix,
+    const char* path
+);
+
+/**
+ * Imports matrix from the text file in Matrix Market coordinate format.
+ * Values of the entries are ignored. Symmetric, skew-symmetric and hermitian
+ * matrices are expanded to the general form. File without `%%MatrixMarket` banner
+ * is read as legacy pyspbla file with 0-based indices.
+ *
+ * @note Pass `SPBLA_HINT_TIME_CHECK` hint to measure operation time
+ *
+ * @param path UTF-8 encoded null-terminated path to the file
+ * @param matrix Pointer where to store created matrix handle
+ * @param hints Hints flags for processing.
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_ImportMtx(
+    const char* path,
+    spbla_Matrix* matrix,
+    spbla_Hints hints
+);
+
+/**
+ * Fills matrix with synthetic values (adjacency matrix of random graph).
+ * Previous content of the matrix is discarded.
+ *
+ * Generation takes O(nvals) time and runs in parallel. Result depends only on
+ * the matrix size, generator kind, its params, nvals and seed, so the same seed
+ * gives the same matrix on any machine and with any number of threads.
+ *
+ * @note `SPBLA_GENERATOR_ERDOS_RENYI` generates exactly `nvals` values.
+ *       Other generators sample `nvals` values, so the result has less values
+ *       if some values are sampled several times.
+ *
+ * @note Pass `SPBLA_HINT_TIME_CHECK` hint to measure operation time
+ *
+ * @param matrix Matrix handle to fill
+ * @param generator Kind of the generator
+ * @param nvals Number of values to generate
+ * @param seed Seed of the random generator
+ * @param params Generator params (pass null to use default params)
+ * @param hints Hints for the operation
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_Generate(
+    spbla_Matrix matrix,
+    spbla_Generator generator,
+    spbla_Index nvals,
+    uint64_t seed,
+    const spbla_GeneratorParams* params,
+    spbla_Hints hints
+);
+
 /**
  * Extracts sub-matrix of the input matrix and stores it into result matrix.
  *
@@ -425,6 +786,17 @@ SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_Nvals(
     spbla_Index* nvals
 );
 
+/**
+ * Evaluates pending value of the matrix, if library is initialized with `SPBLA_HINT_DEFERRED`.
+ *
+ * @param matrix Matrix handle to perform operation on
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_Wait(
+    spbla_Matrix matrix
+);
+
 /**
  * Query number of rows in the matrix.
  *
@@ -462,6 +834,109 @@ SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_Free(
     spbla_Matrix matrix
 );
 
+/**
+ * Creates new sparse vector with specified size.
+ *
+ * @param vector Pointer where to store created vector handle
+ * @param nrows Vector rows count
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Vector_New(
+    spbla_Vector* vector,
+    spbla_Index nrows
+);
+
+/**
+ * Build sparse vector from provided indices array.
+ *
+ * @note This function automatically reduces duplicates
+ * @note Pass `SPBLA_HINT_VALUES_SORTED` if values already in the ascending order.
+ * @note Pass `SPBLA_HINT_NO_DUPLICATES` if values has no duplicates
+ *
+ * @param vector Vector handle to perform operation on
+ * @param rows Array of values indices
+ * @param nvals Number of the indices passed
+ * @param hints Hits flags for processing.
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Vector_Build(
+    spbla_Vector vector,
+    const spbla_Index* rows,
+    spbla_Index nvals,
+    spbla_Hints hints
+);
+
+/**
+ * Reads vector data to the host visible CPU buffer as an array of values indices.
+ * Indices are stored in the ascending order.
+ *
+ * The array must be provided by the user and the size of this array must
+ * be greater or equal the values count of the vector.
+ *
+ * @param vector Vector handle to perform operation on
+ * @param[in,out] rows Buffer to store values indices
+ * @param[in,out] nvals Total number of the values
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Vector_ExtractValues(
+    spbla_Vector vector,
+    spbla_Index* rows,
+    spbla_Index* nvals
+);
+
+/**
+ * Creates new sparse vector, duplicates content and stores handle in the provided pointer.
+ *
+ * @param vector Vector handle to perform operation on
+ * @param duplicated[out] Pointer to the vector handle where to create and store created vector
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Vector_Duplicate(
+    spbla_Vector vector,
+    spbla_Vector* duplicated
+);
+
+/**
+ * Query number of non-zero values of the vector.
+ *
+ * @param vector Vector handle to perform operation on
+ * @param nvals[out] Pointer to the place where to store number of the non-zero elements of the vector
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Vector_Nvals(
+    spbla_Vector vector,
+    spbla_Index* nvals
+);
+
+/**
+ * Query number of rows in the vector.
+ *
+ * @param vector Vector handle to perform operation on
+ * @param nrows[out] Pointer to the place where to store number of vector rows
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Vector_Nrows(
+    spbla_Vector vector,
+    spbla_Index* nrows
+);
+
+/**
+ * Deletes sparse vector object.
+ *
+ * @param vector Vector handle to delete the vector
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Vector_Free(
+    spbla_Vector vector
+);
+
 /**
  * Reduce the source matrix to the column matrix result (column vector).
  * Formally: result = sum(cols of matrix).
@@ -484,6 +959,32 @@ SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_Reduce(
     spbla_Hints hints
 );
 
+/**
+ * Evaluates transitive closure of the square matrix (adjacency matrix of the directed graph).
+ * Formally: result = matrix + matrix^2 + matrix^3 + ..., where '+' and 'x' are boolean semiring operations.
+ *
+ * @note Closure is evaluated with semi-naive iteration: on each step only newly discovered
+ *       pairs (delta) are multiplied by the matrix, pairs already present in the result are masked out.
+ *       Iterations stop inside the library, when no new pairs are discovered.
+ *
+ * @note Matrices must be compatible
+ *          dim(matrix) = N x N
+ *          dim(result) = N x N
+ *
+ * @note Pass `SPBLA_HINT_TIME_CHECK` hint to measure operation time
+ *
+ * @param result[out] Matrix hnd where to store result (may be the same as matrix)
+ * @param matrix Source matrix
+ * @param hints Hints for the operation
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_TransitiveClosure(
+    spbla_Matrix result,
+    spbla_Matrix matrix,
+    spbla_Hints hints
+);
+
 /**
  * Performs result = left + right, where '+' is boolean semiring operation.
  *
@@ -508,6 +1009,56 @@ SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_EWiseAdd(
     spbla_Hints hints
 );
 
+/**
+ * Performs result = left * right, where '*' is boolean semiring operation
+ * (result contains only values present in both matrices).
+ *
+ * @note Matrices must be compatible
+ *          dim(result) = M x N
+ *          dim(left) = M x N
+ *          dim(right) = M x N
+ *
+ * @note Pass `SPBLA_HINT_TIME_CHECK` hint to measure operation time
+ *
+ * @param result[out] Destination matrix to store result
+ * @param left Source matrix to be multiplied
+ * @param right Source matrix to be multiplied
+ * @param hints Hints for the operation
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_EWiseMult(
+    spbla_Matrix result,
+    spbla_Matrix left,
+    spbla_Matrix right,
+    spbla_Hints hints
+);
+
+/**
+ * Performs result = left AND NOT right
+ * (result contains values of the left matrix, which are not present in the right matrix).
+ *
+ * @note Matrices must be compatible
+ *          dim(result) = M x N
+ *          dim(left) = M x N
+ *          dim(right) = M x N
+ *
+ * @note Pass `SPBLA_HINT_TIME_CHECK` hint to measure operation time
+ *
+ * @param result[out] Destination matrix to store result
+ * @param left Source matrix values are taken from
+ * @param right Source matrix of values to be excluded
+ * @param hints Hints for the operation
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_EWiseDiff(
+    spbla_Matrix result,
+    spbla_Matrix left,
+    spbla_Matrix right,
+    spbla_Hints hints
+);
+
 /**
  * Performs result (accum)= left x right evaluation, where source '+' and 'x' are boolean semiring operations.
  * If accum hint passed, the the result of the multiplication is added to the result matrix.
@@ -519,6 +1070,10 @@ SPBLA_EXPORT SPBLA_API spbla_Status spbla_Matrix_EWiseAdd(
  *
  * @note Pass `SPBLA_HINT_ACCUMULATE` hint to add result of the left x right operation.
  * @note Pass `SPBLA_HINT_TIME_CHECK` hint to measure operation time
+ * @note Pass `SPBLA_HINT_TRANSPOSE_LEFT` and (or) `SPBLA_HINT_TRANSPOSE_RIGHT` hint to use transposed
+ *       operand in the product, so dim(left) = T x M or dim(right) = N x T respectively.
+ *       Cpu backends evaluate left x right^T by sparse dot products of the rows and left^T x right
+ *       by accumulation of outer products, if it is cheaper than explicit transpose.
  *
  * @param result[out] Matrix handle where to store operation result
  * @param left Input left matrix
@@ -534,6 +1089,150 @@ SPBLA_EXPORT SPBLA_API spbla_Status spbla_MxM(
     spbla_Hints hints
 );
 
+/**
+ * Performs result<mask> (accum)= left x right evaluation, where source '+' and 'x' are boolean semiring operations.
+ * Only values of the product, which are present in the mask, are written to the result.
+ * If accum hint passed, the the masked result of the multiplication is added to the result matrix.
+ *
+ * @note Masked-out values are not evaluated at all, what is faster than full product with filtering.
+ *
+ * @note To perform this operation matrices must be compatible
+ *          dim(left) = M x T
+ *          dim(right) = T x N
+ *          dim(mask) = M x N
+ *          dim(result) = M x N
+ *
+ * @note Pass `SPBLA_HINT_MASK_COMPLEMENT` hint to keep only values, which are not present in the mask.
+ * @note Pass `SPBLA_HINT_ACCUMULATE` hint to add masked result of the left x right operation.
+ * @note Pass `SPBLA_HINT_TIME_CHECK` hint to measure operation time
+ *
+ * @param result[out] Matrix handle where to store operation result
+ * @param mask Mask matrix (structure only)
+ * @param left Input left matrix
+ * @param right Input right matrix
+ * @param hints Hints for the operation
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_MxM_Masked(
+    spbla_Matrix result,
+    spbla_Matrix mask,
+    spbla_Matrix left,
+    spbla_Matrix right,
+    spbla_Hints hints
+);
+
+/**
+ * Performs result = matrix x vector evaluation, where source '+' and 'x' are boolean semiring operations.
+ *
+ * @note To perform this operation matrix and vectors must be compatible
+ *          dim(matrix) = M x N
+ *          dim(vector) = N
+ *          dim(result) = M
+ *
+ * @note Cpu backends select push or pull traversal of the matrix by the density of the vector.
+ * @note Pass `SPBLA_HINT_TIME_CHECK` hint to measure operation time
+ *
+ * @param result[out] Vector handle where to store operation result
+ * @param matrix Input matrix
+ * @param vector Input vector
+ * @param hints Hints for the operation
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_MxV(
+    spbla_Vector result,
+    spbla_Matrix matrix,
+    spbla_Vector vector,
+    spbla_Hints hints
+);
+
+/**
+ * Performs result<mask> = matrix x vector evaluation, where source '+' and 'x' are boolean semiring operations.
+ * Only values of the product, which are present in the mask, are written to the result.
+ *
+ * @note To perform this operation matrix and vectors must be compatible
+ *          dim(matrix) = M x N
+ *          dim(vector) = N
+ *          dim(mask) = M
+ *          dim(result) = M
+ *
+ * @note Pass `SPBLA_HINT_MASK_COMPLEMENT` hint to keep only values, which are not present in the mask.
+ * @note Pass `SPBLA_HINT_TIME_CHECK` hint to measure operation time
+ *
+ * @param result[out] Vector handle where to store operation result
+ * @param mask Mask vector (structure only)
+ * @param matrix Input matrix
+ * @param vector Input vector
+ * @param hints Hints for the operation
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_MxV_Masked(
+    spbla_Vector result,
+    spbla_Vector mask,
+    spbla_Matrix matrix,
+    spbla_Vector vector,
+    spbla_Hints hints
+);
+
+/**
+ * Performs result = vector x matrix evaluation, where source '+' and 'x' are boolean semiring operations.
+ * This is the single step of the reachability traversal: result contains all vertices,
+ * which are reachable by one edge of the matrix from the vertices of the vector.
+ *
+ * @note To perform this operation matrix and vectors must be compatible
+ *          dim(vector) = M
+ *          dim(matrix) = M x N
+ *          dim(result) = N
+ *
+ * @note Cpu backends select push or pull traversal of the matrix by the density of the vector.
+ * @note Pass `SPBLA_HINT_TIME_CHECK` hint to measure operation time
+ *
+ * @param result[out] Vector handle where to store operation result
+ * @param vector Input vector
+ * @param matrix Input matrix
+ * @param hints Hints for the operation
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_VxM(
+    spbla_Vector result,
+    spbla_Vector vector,
+    spbla_Matrix matrix,
+    spbla_Hints hints
+);
+
+/**
+ * Performs result<mask> = vector x matrix evaluation, where source '+' and 'x' are boolean semiring operations.
+ * Only values of the product, which are present in the mask, are written to the result.
+ *
+ * @note To perform this operation matrix and vectors must be compatible
+ *          dim(vector) = M
+ *          dim(matrix) = M x N
+ *          dim(mask) = N
+ *          dim(result) = N
+ *
+ * @note Pass `SPBLA_HINT_MASK_COMPLEMENT` hint to keep only values, which are not present in the mask
+ *       (for instance, not yet visited vertices of the traversal).
+ * @note Pass `SPBLA_HINT_TIME_CHECK` hint to measure operation time
+ *
+ * @param result[out] Vector handle where to store operation result
+ * @param mask Mask vector (structure only)
+ * @param vector Input vector
+ * @param matrix Input matrix
+ * @param hints Hints for the operation
+ *
+ * @return Error code on this operation
+ */
+SPBLA_EXPORT SPBLA_API spbla_Status spbla_VxM_Masked(
+    spbla_Vector result,
+    spbla_Vector mask,
+    spbla_Vector vector,
+    spbla_Matrix matrix,
+    spbla_Hints hints
+);
+
 /**
  * Performs result = left `kron` right, where `kron` is a Kronecker product for boolean semiring.
  *
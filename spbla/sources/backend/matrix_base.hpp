@@ -26,7 +26,9 @@
 #define SPBLA_MATRIX_BASE_HPP
 
 #include <core/config.hpp>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace spbla {
 
@@ -39,7 +41,15 @@ namespace spbla {
 
         virtual void setElement(index i, index j) = 0;
         virtual void build(const index *rows, const index *cols, size_t nvals, bool isSorted, bool noDuplicates) = 0;
+        /** Add values sorted in row-col order without duplicates to the matrix (values may be already present) */
+        virtual void insert(const index *rows, const index *cols, size_t nvals) = 0;
+        /** Build matrix from csr arrays, taking ownership of them */
+        virtual void buildCsr(std::vector<index> &&rowOffsets, std::vector<index> &&colIndices, bool isSorted, bool noDuplicates) = 0;
         virtual void extract(index* rows, index* cols, size_t &nvals) = 0;
+        /** Get read-only view of csr arrays, valid until the matrix is modified */
+        virtual void extractCsr(const index* &rowOffsets, const index* &colIndices) = 0;
+        /** Release csr view, returned by extractCsr, if backend restored it aside of the matrix storage */
+        virtual void releaseCsr() { }
         virtual void
         extractSubMatrix(const MatrixBase &otherBase, index i, index j, index nrows, index ncols, bool checkTime) = 0;
 
@@ -48,12 +58,22 @@ namespace spbla {
         virtual void reduce(const MatrixBase &otherBase, bool checkTime) = 0;
 
         virtual void multiply(const MatrixBase &aBase, const MatrixBase &bBase, bool accumulate, bool checkTime) = 0;
+        /** Evaluate this (+)= op(a) x op(b), where op transposes operand if its flag is set */
+        virtual void multiplyTransposed(const MatrixBase &aBase, const MatrixBase &bBase, bool transposeA, bool transposeB, bool accumulate, bool checkTime) = 0;
+        virtual void multiplyMasked(const MatrixBase &maskBase, const MatrixBase &aBase, const MatrixBase &bBase, bool complement, bool accumulate, bool checkTime) = 0;
         virtual void kronecker(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) = 0;
         virtual void eWiseAdd(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) = 0;
+        virtual void eWiseMult(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) = 0;
+        virtual void eWiseDiff(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) = 0;
 
         virtual index getNrows() const = 0;
         virtual index getNcols() const = 0;
         virtual index getNvals() const = 0;
+        /** @return Estimated size of the matrix storage in bytes (csr storage size by default) */
+        virtual uint64_t getStorageBytes() const { return sizeof(index) * ((uint64_t) getNrows() + 1 + (uint64_t) getNvals()); }
+
+        /** Hint to keep transposed (csc) storage of the matrix, backends without such storage ignore it */
+        virtual void setKeepTransposed(bool) { }
 
         bool isZeroDim() const { return (size_t)getNrows() * (size_t)getNcols() == 0; }
     };
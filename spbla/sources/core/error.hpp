@@ -129,6 +129,7 @@ namespace spbla {
     using InvalidState = TException<spbla_Status::SPBLA_STATUS_INVALID_STATE>;
     using BackendError = TException<spbla_Status::SPBLA_STATUS_BACKEND_ERROR>;
     using NotImplemented = TException<spbla_Status::SPBLA_STATUS_NOT_IMPLEMENTED>;
+    using IndexOverflow = TException<spbla_Status::SPBLA_STATUS_INDEX_OVERFLOW>;
 
 }
 
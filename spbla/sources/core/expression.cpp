@@ -0,0 +1,366 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/expression.hpp>
+#include <core/matrix.hpp>
+#include <core/library.hpp>
+#include <core/stats.hpp>
+#include <io/tracer.hpp>
+#include <utils/timer.hpp>
+#include <utils/csr_utils.hpp>
+#include <utils/exclusive_scan.hpp>
+#include <utils/thread_pool.hpp>
+#include <algorithm>
+
+#define TIMER_ACTION(timer, action)              \
+    Timer timer;                                 \
+    timer.start();                               \
+    action;                                      \
+    timer.end()
+
+namespace spbla {
+
+    static void recordNode(spbla_Operation op, const Timer &timer, uint64_t nnzIn, uint64_t flops, const MatrixBase &result, TraceScope &trace) {
+        Stats::Record record;
+        record.timeNs = timer.getElapsedTimeNs();
+        record.nnzIn = nnzIn;
+        record.nnzOut = result.getNvals();
+        record.flops = flops;
+        record.bytesAllocated = result.getStorageBytes();
+        Stats::record(op, record);
+
+        trace.arg("nnz_in", record.nnzIn).arg("nnz_out", record.nnzOut).arg("flops", record.flops);
+    }
+
+    Expression::Expression(Kind kind, index nrows, index ncols)
+        : mKind(kind), mNrows(nrows), mNcols(ncols) {
+
+    }
+
+    Expression::Ptr Expression::leaf(const Matrix &matrix) {
+        std::shared_ptr<Expression> node(new Expression(Kind::Leaf, matrix.getNrows(), matrix.getNcols()));
+        node->mMatrix = &matrix;
+        return node;
+    }
+
+    Expression::Ptr Expression::transpose(Ptr arg) {
+        if (arg->mKind == Kind::Transpose)
+            return arg->mArgs.front();
+
+        std::shared_ptr<Expression> node(new Expression(Kind::Transpose, arg->mNcols, arg->mNrows));
+        node->mArgs.push_back(std::move(arg));
+        return node;
+    }
+
+    Expression::Ptr Expression::reduce(Ptr arg) {
+        // Reduce of the single column gives the same column
+        if (arg->mNcols == 1)
+            return arg;
+
+        // Product is reduced by reduce of the right argument, reduce(A x B) = A x reduce(B)
+        if (arg->mKind == Kind::Multiply)
+            return multiply(arg->mArgs[0], reduce(arg->mArgs[1]));
+
+        std::shared_ptr<Expression> node(new Expression(Kind::Reduce, arg->mNrows, 1));
+        node->mArgs.push_back(std::move(arg));
+        return node;
+    }
+
+    Expression::Ptr Expression::subMatrix(Ptr arg, index i, index j, index nrows, index ncols) {
+        if (i == 0 && j == 0 && nrows == arg->mNrows && ncols == arg->mNcols)
+            return arg;
+
+        switch (arg->mKind) {
+            case Kind::SubMatrix:
+                return subMatrix(arg->mArgs[0], arg->mI + i, arg->mJ + j, nrows, ncols);
+            case Kind::Transpose:
+                return transpose(subMatrix(arg->mArgs[0], j, i, ncols, nrows));
+            case Kind::Multiply: {
+                // Only selected rows of A and selected columns of B contribute, sub(A x B) = sub(A) x sub(B)
+                const auto& a = arg->mArgs[0];
+                const auto& b = arg->mArgs[1];
+                return multiply(subMatrix(a, i, 0, nrows, a->mNcols), subMatrix(b, 0, j, b->mNrows, ncols));
+            }
+            default:
+                break;
+        }
+
+        std::shared_ptr<Expression> node(new Expression(Kind::SubMatrix, nrows, ncols));
+        node->mI = i;
+        node->mJ = j;
+        node->mArgs.push_back(std::move(arg));
+        return node;
+    }
+
+    Expression::Ptr Expression::multiply(Ptr a, Ptr b) {
+        std::shared_ptr<Expression> node(new Expression(Kind::Multiply, a->mNrows, b->mNcols));
+        node->mArgs.push_back(std::move(a));
+        node->mArgs.push_back(std::move(b));
+        return node;
+    }
+
+    Expression::Ptr Expression::eWiseAdd(std::initializer_list<Ptr> args) {
+        std::vector<Ptr> flattened;
+
+        auto append = [&](const Ptr& arg) {
+            // Addition is idempotent, so the same value is added only once
+            auto same = [&](const Ptr& other) {
+                return other == arg || (arg->mKind == Kind::Leaf && other->isLeafOf(*arg->mMatrix));
+            };
+
+            if (std::none_of(flattened.begin(), flattened.end(), same))
+                flattened.push_back(arg);
+        };
+
+        for (const auto& arg: args) {
+            if (arg->mKind == Kind::EWiseAdd) {
+                for (const auto& nested: arg->mArgs)
+                    append(nested);
+            }
+            else {
+                append(arg);
+            }
+        }
+
+        if (flattened.size() == 1)
+            return flattened.front();
+
+        std::shared_ptr<Expression> node(new Expression(Kind::EWiseAdd, flattened.front()->mNrows, flattened.front()->mNcols));
+        node->mArgs = std::move(flattened);
+        return node;
+    }
+
+    bool Expression::references(const Matrix &matrix) const {
+        if (mKind == Kind::Leaf)
+            return mMatrix == &matrix;
+
+        return std::any_of(mArgs.begin(), mArgs.end(), [&](const Ptr& arg) { return arg->references(matrix); });
+    }
+
+    void Expression::collectLeaves(std::vector<const Matrix *> &leaves) const {
+        if (mKind == Kind::Leaf) {
+            if (std::find(leaves.begin(), leaves.end(), mMatrix) == leaves.end())
+                leaves.push_back(mMatrix);
+            return;
+        }
+
+        for (const auto& arg: mArgs)
+            arg->collectLeaves(leaves);
+    }
+
+    ExpressionEvaluator::ExpressionEvaluator(const Matrix &owner, BackendBase &provider)
+        : mOwner(owner), mProvider(provider) {
+
+    }
+
+    ExpressionEvaluator::~ExpressionEvaluator() {
+        for (auto m: mScratch)
+            mProvider.releaseMatrix(m);
+    }
+
+    void ExpressionEvaluator::evaluate(const Expression &expr, MatrixBase &target) {
+        compute(expr, target);
+    }
+
+    MatrixBase & ExpressionEvaluator::value(const Expression &expr) {
+        if (expr.getKind() == Expression::Kind::Leaf) {
+            const Matrix* matrix = expr.getMatrix();
+
+            // Owner is referenced by its current storage, other matrices may have own pending values
+            if (matrix != &mOwner)
+                matrix->commitCache();
+
+            return *matrix->mHnd;
+        }
+
+        // Node shared within expression is evaluated once
+        auto found = mValues.find(&expr);
+        if (found != mValues.end())
+            return *found->second;
+
+        auto& result = scratch(expr.getNrows(), expr.getNcols());
+        compute(expr, result);
+        mValues.emplace(&expr, &result);
+        return result;
+    }
+
+    MatrixBase & ExpressionEvaluator::scratch(index nrows, index ncols) {
+        mScratch.reserve(mScratch.size() + 1);
+        mScratch.push_back(mProvider.createMatrix(nrows, ncols));
+        return *mScratch.back();
+    }
+
+    void ExpressionEvaluator::compute(const Expression &expr, MatrixBase &target) {
+        const auto& args = expr.getArgs();
+
+        switch (expr.getKind()) {
+            case Expression::Kind::Leaf: {
+                auto& source = value(expr);
+                if (&source != &target)
+                    target.clone(source);
+                break;
+            }
+            case Expression::Kind::Transpose: {
+                auto& arg = value(*args[0]);
+                TraceScope trace("Expression::transpose");
+                uint64_t nnzIn = arg.getNvals();
+                TIMER_ACTION(timer, target.transpose(arg, false));
+                recordNode(SPBLA_OPERATION_TRANSPOSE, timer, nnzIn, 0, target, trace);
+                break;
+            }
+            case Expression::Kind::Reduce: {
+                auto& arg = value(*args[0]);
+                TraceScope trace("Expression::reduce");
+                uint64_t nnzIn = arg.getNvals();
+                TIMER_ACTION(timer, target.reduce(arg, false));
+                recordNode(SPBLA_OPERATION_REDUCE, timer, nnzIn, 0, target, trace);
+                break;
+            }
+            case Expression::Kind::SubMatrix: {
+                auto& arg = value(*args[0]);
+                TraceScope trace("Expression::extractSubMatrix");
+                uint64_t nnzIn = arg.getNvals();
+                TIMER_ACTION(timer, target.extractSubMatrix(arg, expr.getI(), expr.getJ(), expr.getNrows(), expr.getNcols(), false));
+                recordNode(SPBLA_OPERATION_EXTRACT_SUB_MATRIX, timer, nnzIn, 0, target, trace);
+                break;
+            }
+            case Expression::Kind::Multiply:
+                computeMultiply(expr, target, nullptr);
+                break;
+            case Expression::Kind::EWiseAdd: {
+                // Accumulated product is evaluated by backend multiply with accumulation
+                if (args.size() == 2 && args[1]->getKind() == Expression::Kind::Multiply) {
+                    computeMultiply(*args[1], target, args[0].get());
+                    break;
+                }
+
+                std::vector<MatrixBase*> values;
+                uint64_t nnzIn = 0;
+
+                for (const auto& arg: args) {
+                    values.push_back(&value(*arg));
+                    nnzIn += values.back()->getNvals();
+                }
+
+                TraceScope trace("Expression::eWiseAdd");
+                trace.arg("args", values.size());
+                TIMER_ACTION(timer, values.size() == 2? target.eWiseAdd(*values[0], *values[1], false): mergeRows(values, target));
+                recordNode(SPBLA_OPERATION_EWISE_ADD, timer, nnzIn, 0, target, trace);
+                break;
+            }
+        }
+    }
+
+    void ExpressionEvaluator::computeMultiply(const Expression &expr, MatrixBase &target, const Expression* accumulated) {
+        const auto& args = expr.getArgs();
+
+        // Transposed operands are passed to backend by flags, so they are never materialized
+        bool transposeA = args[0]->getKind() == Expression::Kind::Transpose;
+        bool transposeB = args[1]->getKind() == Expression::Kind::Transpose;
+
+        auto& a = value(transposeA? *args[0]->getArgs().front(): *args[0]);
+        auto& b = value(transposeB? *args[1]->getArgs().front(): *args[1]);
+
+        if (accumulated) {
+            // Target is updated in place if it is the accumulated matrix storage
+            if (accumulated->getKind() == Expression::Kind::Leaf) {
+                auto& source = value(*accumulated);
+                if (&source != &target)
+                    target.clone(source);
+            }
+            else {
+                compute(*accumulated, target);
+            }
+        }
+
+        TraceScope trace("Expression::multiply");
+        uint64_t nnzIn = a.getNvals() + b.getNvals() + (accumulated? target.getNvals(): 0);
+        index inner = transposeB? b.getNcols(): b.getNrows();
+        uint64_t flops = inner > 0? (uint64_t) a.getNvals() * b.getNvals() / inner: 0;
+        TIMER_ACTION(timer, target.multiplyTransposed(a, b, transposeA, transposeB, accumulated != nullptr, false));
+        recordNode(SPBLA_OPERATION_MXM, timer, nnzIn, flops, target, trace);
+    }
+
+    void ExpressionEvaluator::mergeRows(const std::vector<MatrixBase *> &args, MatrixBase &target) {
+        size_t nrows = target.getNrows();
+        size_t count = args.size();
+
+        std::vector<const index*> offsets(count);
+        std::vector<const index*> cols(count);
+
+        for (size_t k = 0; k < count; k++)
+            args[k]->extractCsr(offsets[k], cols[k]);
+
+        // Gather row values of all arguments, sort them and remove duplicates
+        auto merge = [&](size_t i, std::vector<index>& row, std::vector<index>& buffer) {
+            size_t nonEmpty = 0;
+            row.clear();
+
+            for (size_t k = 0; k < count; k++) {
+                index first = offsets[k][i];
+                index last = offsets[k][i + 1];
+                nonEmpty += first != last? 1: 0;
+                row.insert(row.end(), cols[k] + first, cols[k] + last);
+            }
+
+            if (nonEmpty > 1) {
+                CsrUtils::sortIndices(row.data(), row.data() + row.size(), buffer);
+                row.erase(std::unique(row.begin(), row.end()), row.end());
+            }
+        };
+
+        auto& pool = Library::getThreadPool();
+        std::vector<index> rowOffsets(nrows + 1, 0);
+
+        pool.parallelFor(0, nrows, MERGE_GRAIN_SIZE, [&](size_t first, size_t last) {
+            std::vector<index> row;
+            std::vector<index> buffer;
+
+            for (size_t i = first; i < last; i++) {
+                merge(i, row, buffer);
+                rowOffsets[i] = row.size();
+            }
+        });
+
+        exclusive_scan(rowOffsets.begin(), rowOffsets.end(), (index) 0);
+
+        std::vector<index> colIndices(rowOffsets.back());
+
+        pool.parallelFor(0, nrows, MERGE_GRAIN_SIZE, [&](size_t first, size_t last) {
+            std::vector<index> row;
+            std::vector<index> buffer;
+
+            for (size_t i = first; i < last; i++) {
+                merge(i, row, buffer);
+                std::copy(row.begin(), row.end(), colIndices.begin() + rowOffsets[i]);
+            }
+        });
+
+        for (auto arg: args)
+            arg->releaseCsr();
+
+        target.buildCsr(std::move(rowOffsets), std::move(colIndices), true, true);
+    }
+
+}
@@ -0,0 +1,131 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_EXPRESSION_HPP
+#define SPBLA_EXPRESSION_HPP
+
+#include <core/config.hpp>
+#include <backend/matrix_base.hpp>
+#include <backend/backend_base.hpp>
+#include <initializer_list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace spbla {
+
+    /**
+     * Node of the deferred operations graph.
+     * Leaves reference core matrices, inner nodes describe pending operations over its arguments.
+     * Nodes are immutable and may be shared by pending values of several matrices.
+     *
+     * Factory functions apply fusion rules while build nodes:
+     *  - reduce(A x B) = A x reduce(B)
+     *  - submatrix(A x B) = submatrix(A) x submatrix(B), submatrix is also moved through transpose
+     *  - transpose(transpose(A)) = A
+     *  - nested element-wise additions are flattened into single n-ary addition
+     * Pending transpose, used as multiplication argument, is inlined into the product,
+     * so transposed matrix is never materialized in the user visible matrix.
+     */
+    class Expression {
+    public:
+        enum class Kind {
+            Leaf,
+            Transpose,
+            Reduce,
+            SubMatrix,
+            Multiply,
+            EWiseAdd
+        };
+
+        using Ptr = std::shared_ptr<const Expression>;
+
+        static Ptr leaf(const class Matrix& matrix);
+        static Ptr transpose(Ptr arg);
+        static Ptr reduce(Ptr arg);
+        static Ptr subMatrix(Ptr arg, index i, index j, index nrows, index ncols);
+        static Ptr multiply(Ptr a, Ptr b);
+        static Ptr eWiseAdd(std::initializer_list<Ptr> args);
+
+        /** @return True if the matrix is referenced by some leaf of this expression */
+        bool references(const class Matrix& matrix) const;
+        /** Appends matrices of the expression leaves (without duplicates) */
+        void collectLeaves(std::vector<const class Matrix*>& leaves) const;
+        /** @return True if this is leaf, which references the matrix */
+        bool isLeafOf(const class Matrix& matrix) const { return mKind == Kind::Leaf && mMatrix == &matrix; }
+
+        Kind getKind() const { return mKind; }
+        index getNrows() const { return mNrows; }
+        index getNcols() const { return mNcols; }
+        index getI() const { return mI; }
+        index getJ() const { return mJ; }
+        const class Matrix* getMatrix() const { return mMatrix; }
+        const std::vector<Ptr>& getArgs() const { return mArgs; }
+
+    private:
+        Expression(Kind kind, index nrows, index ncols);
+
+        Kind mKind;
+        index mNrows;
+        index mNcols;
+        index mI = 0;
+        index mJ = 0;
+        const class Matrix* mMatrix = nullptr;
+        std::vector<Ptr> mArgs;
+    };
+
+    /**
+     * Evaluates expression of the pending matrix with backend operations.
+     * Intermediate values are stored in scratch matrices, released with the evaluator.
+     * Nodes, shared within single expression, are evaluated once.
+     */
+    class ExpressionEvaluator {
+    public:
+        ExpressionEvaluator(const class Matrix& owner, BackendBase& provider);
+        ExpressionEvaluator(const ExpressionEvaluator& other) = delete;
+        ExpressionEvaluator(ExpressionEvaluator&& other) noexcept = delete;
+        ~ExpressionEvaluator();
+
+        /** Evaluate expression and store result into target matrix */
+        void evaluate(const Expression& expr, MatrixBase& target);
+
+    private:
+        MatrixBase& value(const Expression& expr);
+        MatrixBase& scratch(index nrows, index ncols);
+        void compute(const Expression& expr, MatrixBase& target);
+        void computeMultiply(const Expression& expr, MatrixBase& target, const Expression* accumulated);
+        void mergeRows(const std::vector<MatrixBase*>& args, MatrixBase& target);
+
+        /** Min number of rows processed by single task of rows merge */
+        static const size_t MERGE_GRAIN_SIZE = 256;
+
+        const class Matrix& mOwner;
+        BackendBase& mProvider;
+        std::vector<MatrixBase*> mScratch;
+        std::unordered_map<const Expression*, MatrixBase*> mValues;
+    };
+
+}
+
+#endif //SPBLA_EXPRESSION_HPP
@@ -25,10 +25,15 @@
 #include <core/library.hpp>
 #include <core/error.hpp>
 #include <core/matrix.hpp>
+#include <core/vector.hpp>
 #include <backend/backend_base.hpp>
 #include <backend/matrix_base.hpp>
 #include <io/logger.hpp>
+#include <io/async_log_writer.hpp>
+#include <io/tracer.hpp>
+#include <utils/thread_pool.hpp>
 
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -42,6 +47,10 @@
 #include <sequential/sq_backend.hpp>
 #endif
 
+#ifdef SPBLA_WITH_PARALLEL
+#include <parallel/par_backend.hpp>
+#endif
+
 #ifdef SPBLA_WITH_OPENCL
 #include <opencl/opencl_backend.hpp>
 #endif
@@ -58,9 +67,14 @@
 namespace spbla {
 
     std::unordered_set<class Matrix*> Library::mAllocated;
+    std::unordered_set<class Vector*> Library::mAllocatedVectors;
     std::shared_ptr<class BackendBase> Library::mBackend = nullptr;
     std::shared_ptr<class Logger>  Library::mLogger = std::make_shared<DummyLogger>();
+    std::shared_ptr<class Tracer> Library::mTracer = nullptr;
+    std::shared_ptr<class ThreadPool> Library::mThreadPool = nullptr;
+    size_t Library::mNumThreads = 0;
     bool Library::mRelaxedRelease = false;
+    bool Library::mDeferred = false;
 
     void Library::initialize(hints initHints) {
         CHECK_RAISE_CRITICAL_ERROR(mBackend == nullptr, InvalidState, "Library already initialized");
@@ -68,7 +82,8 @@ namespace spbla {
         bool preferCpu = initHints & SPBLA_HINT_CPU_BACKEND;
         bool preferCuda = initHints & SPBLA_HINT_CUDA_BACKEND;
         bool preferOpenCL = initHints & SPBLA_HINT_OPENCL_BACKEND;
-        bool prefer = preferCpu || preferCuda || preferOpenCL;
+        bool preferCpuParallel = initHints & SPBLA_HINT_CPU_PARALLEL_BACKEND;
+        bool prefer = preferCpu || preferCuda || preferOpenCL || preferCpuParallel;
         bool initialized = false;
 
 #ifdef SPBLA_WITH_CUDA
@@ -97,6 +112,19 @@ namespace spbla {
         }
 #endif
 
+#ifdef SPBLA_WITH_PARALLEL
+        // Multithreaded cpu backend is used only on request, sequential one stays the default cpu backend
+        if (!initialized && preferCpuParallel) {
+            INIT_BACKEND(ParBackend)
+
+            // Failed somehow setup, go to try sequential fallback
+            if (!initialized) {
+                mBackend = nullptr;
+                mLogger->logWarning("Failed to initialize Cpu parallel backend");
+            }
+        }
+#endif
+
 #ifdef SPBLA_WITH_SEQUENTIAL
         if (!initialized) {
             INIT_BACKEND(SqBackend)
@@ -113,6 +141,7 @@ namespace spbla {
 
         // If initialized, post-init actions
         mRelaxedRelease = initHints & SPBLA_HINT_RELAXED_FINALIZE;
+        mDeferred = initHints & SPBLA_HINT_DEFERRED;
         logDeviceInfo();
     }
 
@@ -129,6 +158,13 @@ namespace spbla {
                 }
 
                 mAllocated.clear();
+
+                for (auto v: mAllocatedVectors) {
+                    stream << Logger::Level::Warning << "Implicitly release vector " << v->getDebugMarker() << LogStream::cmt;
+                    delete v;
+                }
+
+                mAllocatedVectors.clear();
             }
 
             // Some final message
@@ -137,9 +173,20 @@ namespace spbla {
             // Remember to finalize backend
             mBackend->finalize();
             mBackend = nullptr;
+            mDeferred = false;
+
+            // Stop worker threads (if were used)
+            mThreadPool = nullptr;
 
             // Release (possibly setup text logger) logger, reassign dummy
             mLogger = std::make_shared<DummyLogger>();
+
+            // Workers are stopped, so all events are recorded and trace can be written
+            if (mTracer) {
+                auto tracer = mTracer;
+                mTracer = nullptr;
+                tracer->write();
+            }
         }
     }
 
@@ -161,7 +208,8 @@ namespace spbla {
         // Create logger and setup filters && post-actions
         auto textLogger = std::make_shared<TextLogger>();
 
-        textLogger->addFilter([=](Logger::Level level, const std::string& message) -> bool {
+        // Filter by level, so messages are not built at all if ignored
+        textLogger->addLevelFilter([=](Logger::Level level) -> bool {
             bool all = hints == 0x0 || (hints & SPBLA_HINT_LOG_ALL);
             bool error = hints & SPBLA_HINT_LOG_ERROR;
             bool warning = hints & SPBLA_HINT_LOG_WARNING;
@@ -171,9 +219,7 @@ namespace spbla {
                     (warning && level == Logger::Level::Warning);
         });
 
-        textLogger->addOnLoggerAction([=](size_t id, Logger::Level level, const std::string& message) {
-            auto& file = *lofFile;
-
+        auto format = [](std::ostream& file, size_t id, Logger::Level level, const std::string& message) {
             const auto idSize = 10;
             const auto levelSize = 20;
 
@@ -193,8 +239,23 @@ namespace spbla {
                     file << "Level::Always";
             }
             file << std::setw(-1) << "] ";
-            file << message << std::endl;
-        });
+            file << message << "\n";
+        };
+
+        if (hints & SPBLA_HINT_LOG_ASYNC) {
+            // Writer is owned by the action, so it drains the queue when the logger is released
+            auto writer = std::make_shared<AsyncLogWriter>(lofFile, format);
+
+            textLogger->addOnLoggerAction([=](size_t id, Logger::Level level, const std::string& message) {
+                writer->push(id, level, message);
+            });
+        }
+        else {
+            textLogger->addOnLoggerAction([=](size_t id, Logger::Level level, const std::string& message) {
+                format(*lofFile, id, level, message);
+                lofFile->flush();
+            });
+        }
 
         // Assign new text logger
         mLogger = textLogger;
@@ -207,6 +268,43 @@ namespace spbla {
             logDeviceInfo();
     }
 
+    void Library::setupTracing(const char *traceFileName) {
+        CHECK_RAISE_ERROR(traceFileName != nullptr, InvalidArgument, "Null file name is not allowed");
+
+        auto tracer = std::make_shared<Tracer>(traceFileName);
+
+        // Events of the previous tracer are written to its file
+        if (mTracer)
+            mTracer->write();
+
+        mTracer = tracer;
+        mLogger->logInfo(std::string("Tracing to file ") + traceFileName);
+    }
+
+    void Library::setNumThreads(size_t numThreads) {
+        mNumThreads = numThreads;
+
+        // Pool will be re-created with new threads count on next request
+        mThreadPool = nullptr;
+    }
+
+    ThreadPool &Library::getThreadPool() {
+        if (!mThreadPool) {
+            size_t numThreads = mNumThreads;
+
+            // Try to get value from environment, if not set explicitly
+            if (numThreads == 0) {
+                const char* env = std::getenv("SPBLA_NUM_THREADS");
+                numThreads = env != nullptr? std::strtoul(env, nullptr, 10): 0;
+            }
+
+            // Zero is interpreted as hardware concurrency by the pool
+            mThreadPool = std::make_shared<ThreadPool>(numThreads);
+        }
+
+        return *mThreadPool;
+    }
+
     Matrix *Library::createMatrix(size_t nrows, size_t ncols) {
         CHECK_RAISE_ERROR(nrows > 0, InvalidArgument, "Cannot create matrix with zero dimension");
         CHECK_RAISE_ERROR(ncols > 0, InvalidArgument, "Cannot create matrix with zero dimension");
@@ -233,6 +331,31 @@ namespace spbla {
         delete matrix;
     }
 
+    Vector *Library::createVector(size_t nrows) {
+        CHECK_RAISE_ERROR(nrows > 0, InvalidArgument, "Cannot create vector with zero dimension");
+
+        auto v = new Vector(nrows, *mBackend);
+        mAllocatedVectors.emplace(v);
+
+        LogStream stream(*getLogger());
+        stream << Logger::Level::Info << "Create Vector " << v->getDebugMarker()
+               << " (" << nrows << ")" << LogStream::cmt;
+
+        return v;
+    }
+
+    void Library::releaseVector(Vector *vector) {
+        if (mRelaxedRelease && !mBackend) return;
+
+        CHECK_RAISE_ERROR(mAllocatedVectors.find(vector) != mAllocatedVectors.end(), InvalidArgument, "No such vector was allocated");
+
+        LogStream stream(*getLogger());
+        stream << Logger::Level::Info << "Release Vector " << vector->getDebugMarker() << LogStream::cmt;
+
+        mAllocatedVectors.erase(vector);
+        delete vector;
+    }
+
     void Library::handleError(const std::exception& error) {
         mLogger->log(Logger::Level::Error, error.what());
     }
@@ -282,8 +405,21 @@ namespace spbla {
         return mBackend != nullptr;
     }
 
+    bool Library::isDeferred() {
+        return mDeferred;
+    }
+
+    void Library::wait() {
+        for (auto m: mAllocated)
+            m->wait();
+    }
+
     class Logger * Library::getLogger() {
         return mLogger.get();
     }
 
+    class Tracer * Library::getTracer() {
+        return mTracer.get();
+    }
+
 }
\ No newline at end of file
@@ -38,19 +38,32 @@ namespace spbla {
         static void finalize();
         static void validate();
         static void setupLogging(const char* logFileName, spbla_Hints hints);
+        static void setupTracing(const char* traceFileName);
+        static void setNumThreads(size_t numThreads);
+        static class ThreadPool& getThreadPool();
         static class Matrix *createMatrix(size_t nrows, size_t ncols);
         static void releaseMatrix(class Matrix *matrix);
+        static class Vector *createVector(size_t nrows);
+        static void releaseVector(class Vector *vector);
         static void handleError(const std::exception& error);
         static void queryCapabilities(spbla_DeviceCaps& caps);
         static void logDeviceInfo();
         static bool isBackedInitialized();
+        static bool isDeferred();
+        static void wait();
         static class Logger* getLogger();
+        static class Tracer* getTracer();
 
     private:
         static std::unordered_set<class Matrix*> mAllocated;
+        static std::unordered_set<class Vector*> mAllocatedVectors;
         static std::shared_ptr<class BackendBase> mBackend;
         static std::shared_ptr<class Logger> mLogger;
+        static std::shared_ptr<class Tracer> mTracer;
+        static std::shared_ptr<class ThreadPool> mThreadPool;
+        static size_t mNumThreads;
         static bool mRelaxedRelease;
+        static bool mDeferred;
     };
 
 }
@@ -25,9 +25,18 @@
 #include <core/matrix.hpp>
 #include <core/error.hpp>
 #include <core/library.hpp>
+#include <core/stats.hpp>
 #include <io/logger.hpp>
+#include <io/matrix_file.hpp>
+#include <io/mtx_file.hpp>
+#include <io/tracer.hpp>
 #include <utils/timer.hpp>
+#include <utils/csr_utils.hpp>
+#include <utils/graph_generator.hpp>
+#include <algorithm>
 #include <cassert>
+#include <limits>
+#include <memory>
 
 #define TIMER_ACTION(timer, action)              \
     Timer timer;                                 \
@@ -37,6 +46,17 @@
 
 namespace spbla {
 
+    // Expected number of products for uniformly distributed values of b rows
+    static uint64_t estimateMultiplyFlops(const Matrix &a, const Matrix &b, index inner) {
+        return inner > 0? (uint64_t) a.getNvals() * b.getNvals() / inner: 0;
+    }
+
+    // Deleter of backend matrix handles
+    struct HandleRelease {
+        BackendBase* backend;
+        void operator()(MatrixBase* matrix) const { backend->releaseMatrix(matrix); }
+    };
+
     Matrix::Matrix(size_t nrows, size_t ncols, BackendBase &backend) {
         mHnd = backend.createMatrix(nrows, ncols);
         mProvider = &backend;
@@ -48,6 +68,20 @@ namespace spbla {
     }
 
     Matrix::~Matrix() {
+        // Pending values of other matrices may still reference this one
+        try {
+            this->forceDependents();
+        }
+        catch (const std::exception& e) {
+            Library::handleError(e);
+
+            // Failed values can not be evaluated without this matrix
+            while (!mDependents.empty())
+                (*mDependents.begin())->dropPending();
+        }
+
+        this->dropPending();
+
         if (mHnd) {
             mProvider->releaseMatrix(mHnd);
             mHnd = nullptr;
@@ -59,16 +93,34 @@ namespace spbla {
         CHECK_RAISE_ERROR(i < getNrows(), InvalidArgument, "Value out of matrix bounds");
         CHECK_RAISE_ERROR(j < getNcols(), InvalidArgument, "Value out of matrix bounds");
 
+        this->forceDependents();
+
         // This values will be committed later
         mCachedI.push_back(i);
         mCachedJ.push_back(j);
     }
 
+    void Matrix::insert(const index *rows, const index *cols, size_t nvals) {
+        CHECK_RAISE_ERROR(rows != nullptr || nvals == 0, InvalidArgument, "Null ptr rows array");
+        CHECK_RAISE_ERROR(cols != nullptr || nvals == 0, InvalidArgument, "Null ptr cols array");
+
+        for (size_t k = 0; k < nvals; k++) {
+            CHECK_RAISE_ERROR(rows[k] < getNrows(), InvalidArgument, "Value out of matrix bounds");
+            CHECK_RAISE_ERROR(cols[k] < getNcols(), InvalidArgument, "Value out of matrix bounds");
+        }
+
+        this->forceDependents();
+
+        // This values will be committed later (cache is sorted on commit)
+        mCachedI.insert(mCachedI.end(), rows, rows + nvals);
+        mCachedJ.insert(mCachedJ.end(), cols, cols + nvals);
+    }
+
     void Matrix::build(const index *rows, const index *cols, size_t nvals, bool isSorted, bool noDuplicates) {
         CHECK_RAISE_ERROR(rows != nullptr || nvals == 0, InvalidArgument, "Null ptr rows array");
         CHECK_RAISE_ERROR(cols != nullptr || nvals == 0, InvalidArgument, "Null ptr cols array");
 
-        this->releaseCache();
+        this->prepareWrite(false);
 
         LogStream stream(*Library::getLogger());
         stream << Logger::Level::Info
@@ -76,7 +128,34 @@ namespace spbla {
                << "isSorted=" << isSorted << ", "
                << "noDuplicates=" << noDuplicates << LogStream::cmt;
 
-        mHnd->build(rows, cols, nvals, isSorted, noDuplicates);
+        TraceScope trace("Matrix::build");
+        trace.arg("matrix", getDebugMarker());
+        TIMER_ACTION(timer, mHnd->build(rows, cols, nvals, isSorted, noDuplicates));
+        this->recordStats(SPBLA_OPERATION_BUILD, timer, nvals, 0, trace);
+    }
+
+    void Matrix::buildCsr(std::vector<index> &&rowOffsets, std::vector<index> &&colIndices, bool isSorted, bool noDuplicates) {
+        CHECK_RAISE_ERROR(rowOffsets.size() == getNrows() + 1, InvalidArgument, "Row offsets array must have nrows + 1 values");
+        CHECK_RAISE_ERROR(rowOffsets.front() == 0, InvalidArgument, "First row offset must be zero");
+        CHECK_RAISE_ERROR(rowOffsets.back() == colIndices.size(), InvalidArgument, "Last row offset must be equal to the number of values");
+
+        for (size_t i = 0; i < getNrows(); i++) {
+            CHECK_RAISE_ERROR(rowOffsets[i] <= rowOffsets[i + 1], InvalidArgument, "Row offsets must be in non-decreasing order");
+        }
+
+        this->prepareWrite(false);
+
+        LogStream stream(*Library::getLogger());
+        stream << Logger::Level::Info
+               << "Matrix:buildCsr:" << this->getDebugMarker() << " "
+               << "isSorted=" << isSorted << ", "
+               << "noDuplicates=" << noDuplicates << LogStream::cmt;
+
+        TraceScope trace("Matrix::buildCsr");
+        trace.arg("matrix", getDebugMarker());
+        uint64_t nnzIn = colIndices.size();
+        TIMER_ACTION(timer, mHnd->buildCsr(std::move(rowOffsets), std::move(colIndices), isSorted, noDuplicates));
+        this->recordStats(SPBLA_OPERATION_BUILD, timer, nnzIn, 0, trace);
     }
 
     void Matrix::extract(index *rows, index *cols, size_t &nvals) {
@@ -85,7 +164,163 @@ namespace spbla {
         CHECK_RAISE_ERROR(getNvals() <= nvals, InvalidArgument, "Passed arrays size must be more or equal to the nvals of the matrix");
 
         this->commitCache();
-        mHnd->extract(rows, cols, nvals);
+
+        TraceScope trace("Matrix::extract");
+        trace.arg("matrix", getDebugMarker());
+        Stats::Record record;
+        TIMER_ACTION(timer, mHnd->extract(rows, cols, nvals));
+        record.timeNs = timer.getElapsedTimeNs();
+        record.nnzIn = record.nnzOut = nvals;
+        Stats::record(SPBLA_OPERATION_EXTRACT, record);
+        trace.arg("nnz", nvals);
+    }
+
+    void Matrix::extractCsr(const index* &rowOffsets, const index* &colIndices) {
+        this->commitCache();
+        mHnd->extractCsr(rowOffsets, colIndices);
+    }
+
+    void Matrix::save(const std::string &path) {
+        const index* rowOffsets = nullptr;
+        const index* colIndices = nullptr;
+
+        this->extractCsr(rowOffsets, colIndices);
+
+        TraceScope trace("Matrix::save");
+        trace.arg("matrix", getDebugMarker());
+        Stats::Record record;
+        TIMER_ACTION(timer, MatrixFile::save(path, getNrows(), getNcols(), rowOffsets, colIndices, getNvals()));
+        mHnd->releaseCsr();
+        record.timeNs = timer.getElapsedTimeNs();
+        record.nnzIn = getNvals();
+        Stats::record(SPBLA_OPERATION_SAVE, record);
+        trace.arg("nnz", record.nnzIn);
+
+        LogStream stream(*Library::getLogger());
+        stream << Logger::Level::Info
+               << "Matrix::save: " << this->getDebugMarker() << " "
+               << "path=" << path << LogStream::cmt;
+    }
+
+    void Matrix::load(const MatrixFile &file, bool checkTime) {
+        CHECK_RAISE_ERROR(file.getNrows() == this->getNrows(), InvalidArgument, "Loaded matrix has incompatible size");
+        CHECK_RAISE_ERROR(file.getNcols() == this->getNcols(), InvalidArgument, "Loaded matrix has incompatible size");
+
+        this->prepareWrite(false);
+
+        // File content is already validated, so sections are copied into storage as is (counted as load only)
+        auto load = [&]() {
+            std::vector<index> rowOffsets(file.getRowOffsets(), file.getRowOffsets() + file.getNrows() + 1);
+            std::vector<index> colIndices(file.getColIndices(), file.getColIndices() + file.getNvals());
+            mHnd->buildCsr(std::move(rowOffsets), std::move(colIndices), true, true);
+        };
+
+        TraceScope trace("Matrix::load");
+        trace.arg("matrix", getDebugMarker());
+        uint64_t nnz = file.getNvals();
+        TIMER_ACTION(timer, load());
+        this->recordStats(SPBLA_OPERATION_LOAD, timer, nnz, 0, trace);
+
+        if (checkTime) {
+            LogStream stream(*Library::getLogger());
+            stream << Logger::Level::Info
+                   << "Time: " << timer.getElapsedTimeMs() << " ms "
+                   << "Matrix::load: "
+                   << this->getDebugMarker() << LogStream::cmt;
+        }
+    }
+
+    void Matrix::exportMtx(const std::string &path) {
+        const index* rowOffsets = nullptr;
+        const index* colIndices = nullptr;
+
+        this->extractCsr(rowOffsets, colIndices);
+
+        TraceScope trace("Matrix::exportMtx");
+        trace.arg("matrix", getDebugMarker());
+        Stats::Record record;
+        TIMER_ACTION(timer, MtxFile::save(Library::getThreadPool(), path, getNrows(), getNcols(), rowOffsets, colIndices, getNvals()));
+        mHnd->releaseCsr();
+        record.timeNs = timer.getElapsedTimeNs();
+        record.nnzIn = getNvals();
+        Stats::record(SPBLA_OPERATION_SAVE, record);
+        trace.arg("nnz", record.nnzIn);
+
+        LogStream stream(*Library::getLogger());
+        stream << Logger::Level::Info
+               << "Matrix::exportMtx: " << this->getDebugMarker() << " "
+               << "path=" << path << LogStream::cmt;
+    }
+
+    void Matrix::importMtx(const MtxFile &file, bool checkTime) {
+        CHECK_RAISE_ERROR(file.getNrows() == this->getNrows(), InvalidArgument, "Imported matrix has incompatible size");
+        CHECK_RAISE_ERROR(file.getNcols() == this->getNcols(), InvalidArgument, "Imported matrix has incompatible size");
+
+        this->prepareWrite(false);
+
+        // Entries go in file order, so backend sorts and dedups them while builds csr (counted as load only)
+        std::vector<index> rows;
+        std::vector<index> cols;
+        auto import = [&]() {
+            file.read(Library::getThreadPool(), rows, cols);
+            mHnd->build(rows.data(), cols.data(), rows.size(), false, false);
+        };
+
+        TraceScope trace("Matrix::importMtx");
+        trace.arg("matrix", getDebugMarker());
+        TIMER_ACTION(timer, import());
+        this->recordStats(SPBLA_OPERATION_LOAD, timer, rows.size(), 0, trace);
+
+        if (checkTime) {
+            LogStream stream(*Library::getLogger());
+            stream << Logger::Level::Info
+                   << "Time: " << timer.getElapsedTimeMs() << " ms "
+                   << "Matrix::importMtx: "
+                   << this->getDebugMarker() << LogStream::cmt;
+        }
+    }
+
+    void Matrix::generate(spbla_Generator generator, size_t nvals, uint64_t seed, const spbla_GeneratorParams &params, bool checkTime) {
+        this->prepareWrite(false);
+
+        std::vector<index> rows;
+        std::vector<index> cols;
+        auto generate = [&]() {
+            auto& pool = Library::getThreadPool();
+
+            switch (generator) {
+                case SPBLA_GENERATOR_ERDOS_RENYI:
+                    GraphGenerator::erdosRenyi(pool, getNrows(), getNcols(), nvals, seed, rows, cols);
+                    break;
+                case SPBLA_GENERATOR_RMAT:
+                    GraphGenerator::rmat(pool, getNrows(), getNcols(), nvals, seed, params.rmatA, params.rmatB, params.rmatC, rows, cols);
+                    break;
+                case SPBLA_GENERATOR_POWER_LAW:
+                    GraphGenerator::powerLaw(pool, getNrows(), getNcols(), nvals, seed, params.powerLawExponent, rows, cols);
+                    break;
+                default:
+                    RAISE_ERROR(InvalidArgument, "Unknown generator kind");
+            }
+
+            // Generators give sorted unique pairs
+            mHnd->build(rows.data(), cols.data(), rows.size(), true, true);
+        };
+
+        TraceScope trace("Matrix::generate");
+        trace.arg("matrix", getDebugMarker()).arg("generator", (uint64_t) generator);
+        TIMER_ACTION(timer, generate());
+        this->recordStats(SPBLA_OPERATION_BUILD, timer, rows.size(), 0, trace);
+
+        if (checkTime) {
+            LogStream stream(*Library::getLogger());
+            stream << Logger::Level::Info
+                   << "Time: " << timer.getElapsedTimeMs() << " ms "
+                   << "Matrix::generate: "
+                   << this->getDebugMarker() << " "
+                   << "generator=" << generator << ", "
+                   << "nvals=" << nvals << ", "
+                   << "seed=" << seed << LogStream::cmt;
+        }
     }
 
     void Matrix::extractSubMatrix(const MatrixBase &otherBase, index i, index j, index nrows, index ncols, bool checkTime) {
@@ -105,12 +340,23 @@ namespace spbla {
         CHECK_RAISE_ERROR(nrows == this->getNrows(), InvalidArgument, "Result matrix has incompatible size for extracted sub-matrix range");
         CHECK_RAISE_ERROR(ncols == this->getNcols(), InvalidArgument, "Result matrix has incompatible size for extracted sub-matrix range");
 
+        if (Library::isDeferred()) {
+            this->forceDependents();
+            auto arg = operandOf(*other, {Expression::Kind::Multiply, Expression::Kind::Transpose, Expression::Kind::SubMatrix});
+            this->setPending(Expression::subMatrix(std::move(arg), i, j, nrows, ncols));
+            return;
+        }
+
         other->commitCache();
-        this->releaseCache(); // Values of this matrix won't be used any more
+        this->prepareWrite(false); // Values of this matrix won't be used any more
 
-        if (checkTime) {
-            TIMER_ACTION(timer, mHnd->extractSubMatrix(*other->mHnd, i, j, nrows, ncols, false));
+        TraceScope trace("Matrix::extractSubMatrix");
+        trace.arg("result", getDebugMarker()).arg("matrix", other->getDebugMarker());
+        uint64_t nnzIn = other->getNvals();
+        TIMER_ACTION(timer, mHnd->extractSubMatrix(*other->mHnd, i, j, nrows, ncols, false));
+        this->recordStats(SPBLA_OPERATION_EXTRACT_SUB_MATRIX, timer, nnzIn, 0, trace);
 
+        if (checkTime) {
             LogStream stream(*Library::getLogger());
             stream << Logger::Level::Info
                    << "Time: " << timer.getElapsedTimeMs() << " ms "
@@ -118,11 +364,7 @@ namespace spbla {
                    << this->getDebugMarker() << " =submatrix( "
                    << i << "," << j << ", shape=(" << nrows << "," << ncols << ") "
                    << other->getDebugMarker() << LogStream::cmt;
-
-            return;
         }
-
-        mHnd->extractSubMatrix(*other->mHnd, i, j, nrows, ncols, false);
     }
 
     void Matrix::clone(const MatrixBase &otherBase) {
@@ -140,9 +382,13 @@ namespace spbla {
         CHECK_RAISE_ERROR(N == this->getNcols(), InvalidArgument, "Cloned matrix has incompatible size");
 
         other->commitCache();
-        this->releaseCache(); // Values of this matrix won't be used any more
+        this->prepareWrite(false); // Values of this matrix won't be used any more
 
-        mHnd->clone(*other->mHnd);
+        TraceScope trace("Matrix::clone");
+        trace.arg("result", getDebugMarker()).arg("matrix", other->getDebugMarker());
+        uint64_t nnzIn = other->getNvals();
+        TIMER_ACTION(timer, mHnd->clone(*other->mHnd));
+        this->recordStats(SPBLA_OPERATION_DUPLICATE, timer, nnzIn, 0, trace);
     }
 
     void Matrix::transpose(const MatrixBase &otherBase, bool checkTime) {
@@ -156,23 +402,29 @@ namespace spbla {
         CHECK_RAISE_ERROR(M == this->getNcols(), InvalidArgument, "Transposed matrix has incompatible size");
         CHECK_RAISE_ERROR(N == this->getNrows(), InvalidArgument, "Transposed matrix has incompatible size");
 
-        this->commitCache();
-        this->releaseCache(); // Values of this matrix won't be used any more
+        if (Library::isDeferred()) {
+            this->forceDependents();
+            this->setPending(Expression::transpose(operandOf(*other, {Expression::Kind::Transpose})));
+            return;
+        }
 
-        if (checkTime) {
-            TIMER_ACTION(timer, mHnd->transpose(*other->mHnd, false));
+        other->commitCache();
+        this->prepareWrite(false); // Values of this matrix won't be used any more
+
+        TraceScope trace("Matrix::transpose");
+        trace.arg("result", getDebugMarker()).arg("matrix", other->getDebugMarker());
+        uint64_t nnzIn = other->getNvals();
+        TIMER_ACTION(timer, mHnd->transpose(*other->mHnd, false));
+        this->recordStats(SPBLA_OPERATION_TRANSPOSE, timer, nnzIn, 0, trace);
 
+        if (checkTime) {
             LogStream stream(*Library::getLogger());
             stream << Logger::Level::Info
                    << "Time: " << timer.getElapsedTimeMs() << " ms "
                    << "Matrix::transpose: "
                    << this->getDebugMarker() << " =transposed "
                    << other->getDebugMarker() << LogStream::cmt;
-
-            return;
         }
-
-        mHnd->transpose(*other->mHnd, false);
     }
 
     void Matrix::reduce(const MatrixBase &otherBase, bool checkTime) {
@@ -185,29 +437,89 @@ namespace spbla {
         CHECK_RAISE_ERROR(M == this->getNrows(), InvalidArgument, "Matrix has incompatible size");
         CHECK_RAISE_ERROR(1 == this->getNcols(), InvalidArgument, "Matrix has incompatible size");
 
+        if (Library::isDeferred()) {
+            this->forceDependents();
+            this->setPending(Expression::reduce(operandOf(*other, {Expression::Kind::Multiply})));
+            return;
+        }
+
         other->commitCache();
-        this->releaseCache(); // Values of this matrix won't be used any more
+        this->prepareWrite(false); // Values of this matrix won't be used any more
 
-        if (checkTime) {
-            TIMER_ACTION(timer, mHnd->reduce(*other->mHnd, false));
+        TraceScope trace("Matrix::reduce");
+        trace.arg("result", getDebugMarker()).arg("matrix", other->getDebugMarker());
+        uint64_t nnzIn = other->getNvals();
+        TIMER_ACTION(timer, mHnd->reduce(*other->mHnd, false));
+        this->recordStats(SPBLA_OPERATION_REDUCE, timer, nnzIn, 0, trace);
 
+        if (checkTime) {
             LogStream stream(*Library::getLogger());
             stream << Logger::Level::Info
                    << "Time: " << timer.getElapsedTimeMs() << " ms "
                    << "Matrix::reduce: "
                    << this->getDebugMarker() << " =reduce "
                    << other->getDebugMarker() << LogStream::cmt;
+        }
+    }
+
+    void Matrix::multiply(const MatrixBase &aBase, const MatrixBase &bBase, bool accumulate, bool checkTime) {
+        this->multiplyTransposed(aBase, bBase, false, false, accumulate, checkTime);
+    }
+
+    void Matrix::multiplyTransposed(const MatrixBase &aBase, const MatrixBase &bBase, bool transposeA, bool transposeB, bool accumulate, bool checkTime) {
+        const auto* a = dynamic_cast<const Matrix*>(&aBase);
+        const auto* b = dynamic_cast<const Matrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Passed matrix does not belong to core matrix class");
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Passed matrix does not belong to core matrix class");
+
+        // Shapes of the operands as they are used in the product
+        auto M = transposeA? a->getNcols(): a->getNrows();
+        auto T = transposeA? a->getNrows(): a->getNcols();
+        auto N = transposeB? b->getNrows(): b->getNcols();
+        auto K = transposeB? b->getNcols(): b->getNrows();
 
+        CHECK_RAISE_ERROR(M == this->getNrows(), InvalidArgument, "Matrix has incompatible size for operation result");
+        CHECK_RAISE_ERROR(N == this->getNcols(), InvalidArgument, "Matrix has incompatible size for operation result");
+        CHECK_RAISE_ERROR(T == K, InvalidArgument, "Cannot multiply passed matrices");
+
+        if (Library::isDeferred()) {
+            this->forceDependents();
+            auto left = operandOf(*a, {Expression::Kind::Transpose});
+            auto right = operandOf(*b, {Expression::Kind::Transpose});
+            auto product = Expression::multiply(transposeA? Expression::transpose(left): left, transposeB? Expression::transpose(right): right);
+            this->setPending(accumulate? Expression::eWiseAdd({operandOf(*this, {Expression::Kind::EWiseAdd}), product}): product);
             return;
         }
 
-        mHnd->reduce(*other->mHnd, false);
+        a->commitCache();
+        b->commitCache();
+        this->prepareWrite(accumulate);
+
+        TraceScope trace("Matrix::multiply");
+        trace.arg("result", getDebugMarker()).arg("a", a->getDebugMarker()).arg("b", b->getDebugMarker());
+        uint64_t nnzIn = a->getNvals() + b->getNvals() + (accumulate? this->getNvals(): 0);
+        uint64_t flops = estimateMultiplyFlops(*a, *b, T);
+        TIMER_ACTION(timer, mHnd->multiplyTransposed(*a->mHnd, *b->mHnd, transposeA, transposeB, accumulate, false));
+        this->recordStats(SPBLA_OPERATION_MXM, timer, nnzIn, flops, trace);
+
+        if (checkTime) {
+            LogStream stream(*Library::getLogger());
+            stream << Logger::Level::Info
+                   << "Time: " << timer.getElapsedTimeMs() << " ms "
+                   << "Matrix::multiply: "
+                   << this->getDebugMarker() << (accumulate? " += ": " = ")
+                   << a->getDebugMarker() << (transposeA? "^T": "") << " x "
+                   << b->getDebugMarker() << (transposeB? "^T": "") << LogStream::cmt;
+        }
     }
 
-    void Matrix::multiply(const MatrixBase &aBase, const MatrixBase &bBase, bool accumulate, bool checkTime) {
+    void Matrix::multiplyMasked(const MatrixBase &maskBase, const MatrixBase &aBase, const MatrixBase &bBase, bool complement, bool accumulate, bool checkTime) {
+        const auto* mask = dynamic_cast<const Matrix*>(&maskBase);
         const auto* a = dynamic_cast<const Matrix*>(&aBase);
         const auto* b = dynamic_cast<const Matrix*>(&bBase);
 
+        CHECK_RAISE_ERROR(mask != nullptr, InvalidArgument, "Passed matrix does not belong to core matrix class");
         CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Passed matrix does not belong to core matrix class");
         CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Passed matrix does not belong to core matrix class");
 
@@ -218,30 +530,31 @@ namespace spbla {
         CHECK_RAISE_ERROR(M == this->getNrows(), InvalidArgument, "Matrix has incompatible size for operation result");
         CHECK_RAISE_ERROR(N == this->getNcols(), InvalidArgument, "Matrix has incompatible size for operation result");
         CHECK_RAISE_ERROR(T == b->getNrows(), InvalidArgument, "Cannot multiply passed matrices");
+        CHECK_RAISE_ERROR(M == mask->getNrows(), InvalidArgument, "Mask has incompatible size for operation result");
+        CHECK_RAISE_ERROR(N == mask->getNcols(), InvalidArgument, "Mask has incompatible size for operation result");
 
+        mask->commitCache();
         a->commitCache();
         b->commitCache();
+        this->prepareWrite(accumulate);
 
-        if (accumulate)
-            this->commitCache();
-        else
-            this->releaseCache();
+        TraceScope trace("Matrix::multiplyMasked");
+        trace.arg("result", getDebugMarker()).arg("mask", mask->getDebugMarker()).arg("a", a->getDebugMarker()).arg("b", b->getDebugMarker());
+        uint64_t nnzIn = mask->getNvals() + a->getNvals() + b->getNvals() + (accumulate? this->getNvals(): 0);
+        uint64_t flops = estimateMultiplyFlops(*a, *b, T);
+        TIMER_ACTION(timer, mHnd->multiplyMasked(*mask->mHnd, *a->mHnd, *b->mHnd, complement, accumulate, false));
+        this->recordStats(SPBLA_OPERATION_MXM_MASKED, timer, nnzIn, flops, trace);
 
         if (checkTime) {
-            TIMER_ACTION(timer, mHnd->multiply(*a->mHnd, *b->mHnd, accumulate, false));
-
             LogStream stream(*Library::getLogger());
             stream << Logger::Level::Info
                    << "Time: " << timer.getElapsedTimeMs() << " ms "
-                   << "Matrix::multiply: "
-                   << this->getDebugMarker() << (accumulate? " += ": " = ")
+                   << "Matrix::multiplyMasked: "
+                   << this->getDebugMarker() << (complement? "<!": "<")
+                   << mask->getDebugMarker() << ">" << (accumulate? " += ": " = ")
                    << a->getDebugMarker() << " x "
                    << b->getDebugMarker() << LogStream::cmt;
-
-            return;
         }
-
-        mHnd->multiply(*a->mHnd, *b->mHnd, accumulate, false);
     }
 
     void Matrix::kronecker(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) {
@@ -256,16 +569,33 @@ namespace spbla {
         index K = b->getNrows();
         index T = b->getNcols();
 
+        const index maxIndex = std::numeric_limits<index>::max();
+
+        if ((K > 0 && M > maxIndex / K) || (T > 0 && N > maxIndex / T))
+            RAISE_ERROR(IndexOverflow, "Size of the result matrix exceeds spbla_Index range");
+
         CHECK_RAISE_ERROR(M * K == this->getNrows(), InvalidArgument, "Matrix has incompatible size for operation result");
         CHECK_RAISE_ERROR(N * T == this->getNcols(), InvalidArgument, "Matrix has incompatible size for operation result");
 
         a->commitCache();
         b->commitCache();
-        this->releaseCache();
 
-        if (checkTime) {
-            TIMER_ACTION(timer, mHnd->kronecker(*a->mHnd, *b->mHnd, false));
+        index aNvals = a->getNvals();
+        index bNvals = b->getNvals();
+
+        if (bNvals > 0 && aNvals > maxIndex / bNvals)
+            RAISE_ERROR(IndexOverflow, "Number of values of the result exceeds spbla_Index range");
+
+        this->prepareWrite(false);
+
+        TraceScope trace("Matrix::kronecker");
+        trace.arg("result", getDebugMarker()).arg("a", a->getDebugMarker()).arg("b", b->getDebugMarker());
+        uint64_t nnzIn = a->getNvals() + b->getNvals();
+        uint64_t flops = (uint64_t) a->getNvals() * b->getNvals();
+        TIMER_ACTION(timer, mHnd->kronecker(*a->mHnd, *b->mHnd, false));
+        this->recordStats(SPBLA_OPERATION_KRONECKER, timer, nnzIn, flops, trace);
 
+        if (checkTime) {
             LogStream stream(*Library::getLogger());
             stream << Logger::Level::Info
                    << "Time: " << timer.getElapsedTimeMs() << " ms "
@@ -273,11 +603,7 @@ namespace spbla {
                    << this->getDebugMarker() << " = "
                    << a->getDebugMarker() << " (x) "
                    << b->getDebugMarker() << LogStream::cmt;
-
-            return;
         }
-
-        mHnd->kronecker(*a->mHnd, *b->mHnd, false);
     }
 
     void Matrix::eWiseAdd(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) {
@@ -296,13 +622,23 @@ namespace spbla {
         CHECK_RAISE_ERROR(M == this->getNrows(), InvalidArgument, "Matrix has incompatible size for operation result");
         CHECK_RAISE_ERROR(N == this->getNcols(), InvalidArgument, "Matrix has incompatible size for operation result");
 
+        if (Library::isDeferred()) {
+            this->forceDependents();
+            this->setPending(Expression::eWiseAdd({operandOf(*a, {Expression::Kind::EWiseAdd}), operandOf(*b, {Expression::Kind::EWiseAdd})}));
+            return;
+        }
+
         a->commitCache();
         b->commitCache();
-        this->releaseCache();
+        this->prepareWrite(false);
 
-        if (checkTime) {
-            TIMER_ACTION(timer, mHnd->eWiseAdd(*a->mHnd, *b->mHnd, false));
+        TraceScope trace("Matrix::eWiseAdd");
+        trace.arg("result", getDebugMarker()).arg("a", a->getDebugMarker()).arg("b", b->getDebugMarker());
+        uint64_t nnzIn = a->getNvals() + b->getNvals();
+        TIMER_ACTION(timer, mHnd->eWiseAdd(*a->mHnd, *b->mHnd, false));
+        this->recordStats(SPBLA_OPERATION_EWISE_ADD, timer, nnzIn, 0, trace);
 
+        if (checkTime) {
             LogStream stream(*Library::getLogger());
             stream << Logger::Level::Info
                    << "Time: " << timer.getElapsedTimeMs() << " ms "
@@ -310,11 +646,116 @@ namespace spbla {
                    << this->getDebugMarker() << " = "
                    << a->getDebugMarker() << " + "
                    << b->getDebugMarker() << LogStream::cmt;
+        }
+    }
 
-            return;
+    void Matrix::eWiseMult(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) {
+        const auto* a = dynamic_cast<const Matrix*>(&aBase);
+        const auto* b = dynamic_cast<const Matrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Passed matrix does not belong to core matrix class");
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Passed matrix does not belong to core matrix class");
+
+        index M = a->getNrows();
+        index N = a->getNcols();
+
+        CHECK_RAISE_ERROR(M == b->getNrows(), InvalidArgument, "Passed matrices have incompatible size");
+        CHECK_RAISE_ERROR(N == b->getNcols(), InvalidArgument, "Passed matrices have incompatible size");
+
+        CHECK_RAISE_ERROR(M == this->getNrows(), InvalidArgument, "Matrix has incompatible size for operation result");
+        CHECK_RAISE_ERROR(N == this->getNcols(), InvalidArgument, "Matrix has incompatible size for operation result");
+
+        a->commitCache();
+        b->commitCache();
+        this->prepareWrite(false);
+
+        TraceScope trace("Matrix::eWiseMult");
+        trace.arg("result", getDebugMarker()).arg("a", a->getDebugMarker()).arg("b", b->getDebugMarker());
+        uint64_t nnzIn = a->getNvals() + b->getNvals();
+        TIMER_ACTION(timer, mHnd->eWiseMult(*a->mHnd, *b->mHnd, false));
+        this->recordStats(SPBLA_OPERATION_EWISE_MULT, timer, nnzIn, 0, trace);
+
+        if (checkTime) {
+            LogStream stream(*Library::getLogger());
+            stream << Logger::Level::Info
+                   << "Time: " << timer.getElapsedTimeMs() << " ms "
+                   << "Matrix::eWiseMult: "
+                   << this->getDebugMarker() << " = "
+                   << a->getDebugMarker() << " * "
+                   << b->getDebugMarker() << LogStream::cmt;
+        }
+    }
+
+    void Matrix::eWiseDiff(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) {
+        const auto* a = dynamic_cast<const Matrix*>(&aBase);
+        const auto* b = dynamic_cast<const Matrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Passed matrix does not belong to core matrix class");
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Passed matrix does not belong to core matrix class");
+
+        index M = a->getNrows();
+        index N = a->getNcols();
+
+        CHECK_RAISE_ERROR(M == b->getNrows(), InvalidArgument, "Passed matrices have incompatible size");
+        CHECK_RAISE_ERROR(N == b->getNcols(), InvalidArgument, "Passed matrices have incompatible size");
+
+        CHECK_RAISE_ERROR(M == this->getNrows(), InvalidArgument, "Matrix has incompatible size for operation result");
+        CHECK_RAISE_ERROR(N == this->getNcols(), InvalidArgument, "Matrix has incompatible size for operation result");
+
+        a->commitCache();
+        b->commitCache();
+        this->prepareWrite(false);
+
+        TraceScope trace("Matrix::eWiseDiff");
+        trace.arg("result", getDebugMarker()).arg("a", a->getDebugMarker()).arg("b", b->getDebugMarker());
+        uint64_t nnzIn = a->getNvals() + b->getNvals();
+        TIMER_ACTION(timer, mHnd->eWiseDiff(*a->mHnd, *b->mHnd, false));
+        this->recordStats(SPBLA_OPERATION_EWISE_DIFF, timer, nnzIn, 0, trace);
+
+        if (checkTime) {
+            LogStream stream(*Library::getLogger());
+            stream << Logger::Level::Info
+                   << "Time: " << timer.getElapsedTimeMs() << " ms "
+                   << "Matrix::eWiseDiff: "
+                   << this->getDebugMarker() << " = "
+                   << a->getDebugMarker() << " - "
+                   << b->getDebugMarker() << LogStream::cmt;
         }
+    }
+
+    void Matrix::transitiveClosure(const MatrixBase &otherBase, bool checkTime) {
+        const auto* other = dynamic_cast<const Matrix*>(&otherBase);
+
+        CHECK_RAISE_ERROR(other != nullptr, InvalidArgument, "Passed matrix does not belong to core matrix class");
+
+        auto N = other->getNrows();
+
+        CHECK_RAISE_ERROR(N == other->getNcols(), InvalidArgument, "Transitive closure requires square matrix");
+        CHECK_RAISE_ERROR(N == this->getNrows(), InvalidArgument, "Matrix has incompatible size for operation result");
+        CHECK_RAISE_ERROR(N == this->getNcols(), InvalidArgument, "Matrix has incompatible size for operation result");
+
+        other->commitCache();
+        this->prepareWrite(this == other); // Values of this matrix won't be used any more, if it is not the source
 
-        mHnd->eWiseAdd(*a->mHnd, *b->mHnd, false);
+        size_t iterations = 0;
+
+        TraceScope trace("Matrix::transitiveClosure");
+        trace.arg("result", getDebugMarker()).arg("matrix", other->getDebugMarker());
+        uint64_t nnzIn = other->getNvals();
+        uint64_t flops = estimateMultiplyFlops(*other, *other, other->getNrows());
+        TIMER_ACTION(timer, iterations = evalTransitiveClosure(*other));
+        this->recordStats(SPBLA_OPERATION_TRANSITIVE_CLOSURE, timer, nnzIn, iterations * flops, trace);
+        trace.arg("iterations", iterations);
+
+        if (checkTime) {
+            LogStream stream(*Library::getLogger());
+            stream << Logger::Level::Info
+                   << "Time: " << timer.getElapsedTimeMs() << " ms "
+                   << "Matrix::transitiveClosure: "
+                   << this->getDebugMarker() << " =closure "
+                   << other->getDebugMarker() << " "
+                   << "iterations=" << iterations << LogStream::cmt;
+        }
     }
 
     index Matrix::getNrows() const {
@@ -330,6 +771,15 @@ namespace spbla {
         return mHnd->getNvals();
     }
 
+    void Matrix::setKeepTransposed(bool keep) {
+        mKeepTransposed = keep;
+        mHnd->setKeepTransposed(keep);
+    }
+
+    void Matrix::wait() const {
+        this->commitCache();
+    }
+
     void Matrix::setDebugMarker(const char *marker) {
         CHECK_RAISE_ERROR(marker, InvalidArgument, "Null pointer marker string");
 
@@ -347,6 +797,60 @@ namespace spbla {
         return mMarker.length() + 1;
     }
 
+    size_t Matrix::evalTransitiveClosure(const Matrix &other) {
+        auto N = getNrows();
+
+        // Semi-naive evaluation:
+        //  T = A, D = A
+        //  D = (D x A)<!T>, T = T + D, while D is not empty
+
+        // Temporary handles are returned to the backend even if evaluation fails
+        using Handle = std::unique_ptr<MatrixBase, HandleRelease>;
+        auto create = [&]() { return Handle(mProvider->createMatrix(N, N), HandleRelease{mProvider}); };
+
+        Handle delta = create();
+        Handle next = create();
+
+        // Backend without masked multiplication fails here, before any copy is made
+        next->multiplyMasked(*delta, *delta, *delta, true, false, false);
+
+        // Closure is evaluated aside, so source is intact and this matrix is untouched on failure
+        const MatrixBase& adjacency = *other.mHnd;
+        Handle result = create();
+        result->clone(adjacency);
+        delta->clone(adjacency);
+
+        size_t iterations = 0;
+
+        while (delta->getNvals() > 0) {
+            next->multiplyMasked(*result, *delta, adjacency, true, false, false);
+            result->eWiseAdd(*result, *next, false);
+            std::swap(delta, next);
+            iterations += 1;
+        }
+
+        result->setKeepTransposed(mKeepTransposed);
+
+        // Previous handle is released with the result one
+        MatrixBase* previous = mHnd;
+        mHnd = result.release();
+        result.reset(previous);
+
+        return iterations;
+    }
+
+    void Matrix::recordStats(spbla_Operation op, const Timer &timer, uint64_t nnzIn, uint64_t flops, TraceScope &trace) const {
+        Stats::Record record;
+        record.timeNs = timer.getElapsedTimeNs();
+        record.nnzIn = nnzIn;
+        record.nnzOut = this->getNvals();
+        record.flops = flops;
+        record.bytesAllocated = mHnd->getStorageBytes();
+        Stats::record(op, record);
+
+        trace.arg("nnz_in", record.nnzIn).arg("nnz_out", record.nnzOut).arg("flops", record.flops);
+    }
+
     void Matrix::releaseCache() const {
         mCachedI.clear();
         mCachedJ.clear();
@@ -355,30 +859,132 @@ namespace spbla {
     void Matrix::commitCache() const {
         assert(mCachedI.size() == mCachedJ.size());
 
+        // Pending value goes first, values cached after the operation are set on top of it
+        if (mExpression)
+            this->evaluatePending();
+
         size_t cachedNvals = mCachedI.size();
 
         // Nothing to do if no value was cached on CPU side
         if (cachedNvals == 0)
             return;
 
-        bool isSorted = false;
-        bool noDuplicates = false;
+        TraceScope trace("Matrix::commitCache");
+        trace.arg("matrix", getDebugMarker()).arg("nnz", cachedNvals);
 
-        if (mHnd->getNvals() > 0) {
-            // We will have to join old and new values
-            // Create tmp matrix and merge values
+        // Sort cached values once, so backend receives ready to merge data
+        size_t uniqueNvals = CsrUtils::sortPairs(mCachedI.data(), mCachedJ.data(), cachedNvals);
 
-            MatrixBase* tmp = mProvider->createMatrix(getNrows(), getNcols());
-            tmp->build(mCachedI.data(), mCachedJ.data(), cachedNvals, isSorted, noDuplicates);
-            mHnd->eWiseAdd(*mHnd, *tmp, false);
-            mProvider->releaseMatrix(tmp);
+        bool isSorted = true;
+        bool noDuplicates = true;
+
+        if (mHnd->getNvals() > 0) {
+            // We will have to join old and new values, only affected rows are updated
+            mHnd->insert(mCachedI.data(), mCachedJ.data(), uniqueNvals);
         }
         else {
             // Otherwise, new values are used to build matrix content
-            mHnd->build(mCachedI.data(), mCachedJ.data(), cachedNvals, isSorted, noDuplicates);
+            mHnd->build(mCachedI.data(), mCachedJ.data(), uniqueNvals, isSorted, noDuplicates);
         }
 
         // Clear arrays
         releaseCache();
     }
+
+    Expression::Ptr Matrix::operandOf(const Matrix &matrix, std::initializer_list<Expression::Kind> fusible) const {
+        const auto& expression = matrix.mExpression;
+
+        // Pending value is inlined only into fused operation and only if it does not read previous value of its matrix
+        bool canInline = expression && matrix.mCachedI.empty() && !expression->references(matrix) &&
+                         std::find(fusible.begin(), fusible.end(), expression->getKind()) != fusible.end();
+
+        if (canInline)
+            return expression;
+
+        // Storage of this matrix is read by the new pending value, so it must hold the current value
+        if (&matrix == this)
+            matrix.commitCache();
+
+        return Expression::leaf(matrix);
+    }
+
+    void Matrix::prepareWrite(bool keepValues) {
+        this->forceDependents();
+
+        if (keepValues) {
+            this->commitCache();
+        }
+        else {
+            this->dropPending();
+            this->releaseCache();
+        }
+    }
+
+    void Matrix::setPending(Expression::Ptr expression) {
+        this->dropPending();
+        this->releaseCache();
+
+        mExpression = std::move(expression);
+        mExpression->collectLeaves(mExpressionLeaves);
+
+        for (auto leaf: mExpressionLeaves) {
+            if (leaf != this)
+                leaf->mDependents.emplace(this);
+        }
+    }
+
+    void Matrix::dropPending() const {
+        for (auto leaf: mExpressionLeaves) {
+            if (leaf != this)
+                leaf->mDependents.erase(this);
+        }
+
+        mExpressionLeaves.clear();
+        mExpression = nullptr;
+    }
+
+    void Matrix::forceDependents() const {
+        // Dependents read the current value, so they are evaluated before it is changed.
+        // Evaluated matrix removes itself from the dependents.
+        while (!mDependents.empty()) {
+            auto dependent = *mDependents.begin();
+            dependent->evaluatePending();
+        }
+    }
+
+    void Matrix::evaluatePending() const {
+        auto expression = mExpression;
+        const auto& args = expression->getArgs();
+
+        TraceScope trace("Matrix::evaluate");
+        trace.arg("matrix", getDebugMarker());
+
+        // Result is written in place, if storage is not read by the evaluation or only accumulates the product
+        bool accumulated = expression->getKind() == Expression::Kind::EWiseAdd && args.size() == 2 &&
+                           args[0]->isLeafOf(*this) && args[1]->getKind() == Expression::Kind::Multiply;
+        bool inPlace = accumulated || !expression->references(*this);
+
+        ExpressionEvaluator evaluator(*this, *mProvider);
+
+        if (inPlace) {
+            evaluator.evaluate(*expression, *mHnd);
+        }
+        else {
+            MatrixBase* result = mProvider->createMatrix(getNrows(), getNcols());
+            result->setKeepTransposed(mKeepTransposed);
+
+            try {
+                evaluator.evaluate(*expression, *result);
+            }
+            catch (...) {
+                mProvider->releaseMatrix(result);
+                throw;
+            }
+
+            mProvider->releaseMatrix(mHnd);
+            mHnd = result;
+        }
+
+        this->dropPending();
+    }
 }
\ No newline at end of file
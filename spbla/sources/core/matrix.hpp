@@ -26,8 +26,11 @@
 #define SPBLA_MATRIX_HPP
 
 #include <core/config.hpp>
+#include <core/expression.hpp>
 #include <backend/matrix_base.hpp>
 #include <backend/backend_base.hpp>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace spbla {
@@ -43,7 +46,10 @@ namespace spbla {
 
         void setElement(index i, index j) override;
         void build(const index *rows, const index *cols, size_t nvals, bool isSorted, bool noDuplicates) override;
+        void insert(const index *rows, const index *cols, size_t nvals) override;
+        void buildCsr(std::vector<index> &&rowOffsets, std::vector<index> &&colIndices, bool isSorted, bool noDuplicates) override;
         void extract(index *rows, index *cols, size_t &nvals) override;
+        void extractCsr(const index* &rowOffsets, const index* &colIndices) override;
         void extractSubMatrix(const MatrixBase &otherBase, index i, index j, index nrows, index ncols,
                               bool checkTime) override;
 
@@ -52,32 +58,69 @@ namespace spbla {
         void reduce(const MatrixBase &otherBase, bool checkTime) override;
 
         void multiply(const MatrixBase &aBase, const MatrixBase &bBase, bool accumulate, bool checkTime) override;
+        void multiplyTransposed(const MatrixBase &aBase, const MatrixBase &bBase, bool transposeA, bool transposeB, bool accumulate, bool checkTime) override;
+        void multiplyMasked(const MatrixBase &maskBase, const MatrixBase &aBase, const MatrixBase &bBase, bool complement, bool accumulate, bool checkTime) override;
         void kronecker(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
         void eWiseAdd(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
+        void eWiseMult(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
+        void eWiseDiff(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
+
+        void transitiveClosure(const MatrixBase &otherBase, bool checkTime);
+
+        void save(const std::string& path);
+        void load(const class MatrixFile& file, bool checkTime);
+        void exportMtx(const std::string& path);
+        void importMtx(const class MtxFile& file, bool checkTime);
+        void generate(spbla_Generator generator, size_t nvals, uint64_t seed, const spbla_GeneratorParams& params, bool checkTime);
 
         index getNrows() const override;
         index getNcols() const override;
         index getNvals() const override;
 
+        void setKeepTransposed(bool keep) override;
+
+        /** Evaluate pending (deferred) operations of the matrix */
+        void wait() const;
+
         void setDebugMarker(const char* marker);
         const char* getDebugMarker() const;
         index getDebugMarkerSizeWithNullT() const;
 
     private:
+        friend class Vector;
+        friend class ExpressionEvaluator;
+
+        size_t evalTransitiveClosure(const Matrix &other);
+        void recordStats(spbla_Operation op, const class Timer& timer, uint64_t nnzIn, uint64_t flops, class TraceScope& trace) const;
 
         void releaseCache() const;
         void commitCache() const;
 
+        Expression::Ptr operandOf(const Matrix& matrix, std::initializer_list<Expression::Kind> fusible) const;
+        void prepareWrite(bool keepValues);
+        void setPending(Expression::Ptr expression);
+        void dropPending() const;
+        void forceDependents() const;
+        void evaluatePending() const;
+
         // Cached values by the set functions
         mutable std::vector<index> mCachedI;
         mutable std::vector<index> mCachedJ;
 
+        // Pending value in deferred mode, matrices with pending values referencing this one
+        mutable Expression::Ptr mExpression;
+        mutable std::vector<const Matrix*> mExpressionLeaves;
+        mutable std::unordered_set<const Matrix*> mDependents;
+
         // Marker for debugging
         std::string mMarker;
 
-        // Implementation handle references
-        MatrixBase* mHnd = nullptr;
+        // Implementation handle references (handle is replaced, when pending value is evaluated)
+        mutable MatrixBase* mHnd = nullptr;
         BackendBase* mProvider = nullptr;
+
+        // Applied to the replaced handles as well
+        bool mKeepTransposed = false;
     };
 
 }
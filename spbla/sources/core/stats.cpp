@@ -0,0 +1,85 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/stats.hpp>
+#include <algorithm>
+
+namespace spbla {
+
+    Stats::Counters Stats::mCounters[SPBLA_OPERATION_COUNT];
+
+    void Stats::record(spbla_Operation op, const Record &record) {
+        auto& counters = mCounters[op];
+        auto relaxed = std::memory_order_relaxed;
+
+        counters.calls.fetch_add(1, relaxed);
+        counters.timeTotalNs.fetch_add(record.timeNs, relaxed);
+        counters.nnzIn.fetch_add(record.nnzIn, relaxed);
+        counters.nnzOut.fetch_add(record.nnzOut, relaxed);
+        counters.flops.fetch_add(record.flops, relaxed);
+        counters.bytesAllocated.fetch_add(record.bytesAllocated, relaxed);
+
+        // Min and max are updated until stored value is no more better than the new one
+        uint64_t min = counters.timeMinNs.load(relaxed);
+        while (record.timeNs < min && !counters.timeMinNs.compare_exchange_weak(min, record.timeNs, relaxed));
+
+        uint64_t max = counters.timeMaxNs.load(relaxed);
+        while (record.timeNs > max && !counters.timeMaxNs.compare_exchange_weak(max, record.timeNs, relaxed));
+    }
+
+    void Stats::query(spbla_OperationStats *stats, size_t count) {
+        auto relaxed = std::memory_order_relaxed;
+        count = std::min<size_t>(count, SPBLA_OPERATION_COUNT);
+
+        for (size_t op = 0; op < count; op++) {
+            auto& counters = mCounters[op];
+            auto& out = stats[op];
+
+            out.calls = counters.calls.load(relaxed);
+            out.timeTotalNs = counters.timeTotalNs.load(relaxed);
+            out.timeMinNs = out.calls? counters.timeMinNs.load(relaxed): 0;
+            out.timeMaxNs = counters.timeMaxNs.load(relaxed);
+            out.nnzIn = counters.nnzIn.load(relaxed);
+            out.nnzOut = counters.nnzOut.load(relaxed);
+            out.flops = counters.flops.load(relaxed);
+            out.bytesAllocated = counters.bytesAllocated.load(relaxed);
+        }
+    }
+
+    void Stats::reset() {
+        auto relaxed = std::memory_order_relaxed;
+
+        for (auto& counters: mCounters) {
+            counters.calls.store(0, relaxed);
+            counters.timeTotalNs.store(0, relaxed);
+            counters.timeMinNs.store(UINT64_MAX, relaxed);
+            counters.timeMaxNs.store(0, relaxed);
+            counters.nnzIn.store(0, relaxed);
+            counters.nnzOut.store(0, relaxed);
+            counters.flops.store(0, relaxed);
+            counters.bytesAllocated.store(0, relaxed);
+        }
+    }
+
+}
@@ -0,0 +1,71 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_STATS_HPP
+#define SPBLA_STATS_HPP
+
+#include <core/config.hpp>
+#include <atomic>
+#include <cstdint>
+
+namespace spbla {
+
+    /**
+     * Per operation kind performance counters.
+     * Counters are lock-free atomics, so operations are recorded from any thread.
+     * Counters are global and live independently of the library initialization.
+     */
+    class Stats {
+    public:
+        /** Single operation call measurements */
+        struct Record {
+            uint64_t timeNs = 0;
+            uint64_t nnzIn = 0;
+            uint64_t nnzOut = 0;
+            uint64_t flops = 0;
+            uint64_t bytesAllocated = 0;
+        };
+
+        static void record(spbla_Operation op, const Record& record);
+        static void query(spbla_OperationStats* stats, size_t count);
+        static void reset();
+
+    private:
+        struct Counters {
+            std::atomic<uint64_t> calls{0};
+            std::atomic<uint64_t> timeTotalNs{0};
+            std::atomic<uint64_t> timeMinNs{UINT64_MAX};
+            std::atomic<uint64_t> timeMaxNs{0};
+            std::atomic<uint64_t> nnzIn{0};
+            std::atomic<uint64_t> nnzOut{0};
+            std::atomic<uint64_t> flops{0};
+            std::atomic<uint64_t> bytesAllocated{0};
+        };
+
+        static Counters mCounters[SPBLA_OPERATION_COUNT];
+    };
+
+}
+
+#endif //SPBLA_STATS_HPP
@@ -0,0 +1,201 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <core/vector.hpp>
+#include <core/matrix.hpp>
+#include <core/error.hpp>
+#include <core/library.hpp>
+#include <core/stats.hpp>
+#include <io/logger.hpp>
+#include <io/tracer.hpp>
+#include <utils/timer.hpp>
+#include <sstream>
+
+#define TIMER_ACTION(timer, action)              \
+    Timer timer;                                 \
+    timer.start();                               \
+    action;                                      \
+    timer.end()
+
+namespace spbla {
+
+    Vector::Vector(size_t nrows, BackendBase &backend) {
+        mHnd = backend.createVector(nrows);
+        mProvider = &backend;
+
+        // By default marker is the address of the vector
+        std::stringstream s;
+        s << this;
+        mMarker = s.str();
+    }
+
+    Vector::~Vector() {
+        if (mHnd) {
+            mProvider->releaseVector(mHnd);
+            mHnd = nullptr;
+            mProvider = nullptr;
+        }
+    }
+
+    void Vector::build(const index *rows, size_t nvals, bool isSorted, bool noDuplicates) {
+        CHECK_RAISE_ERROR(rows != nullptr || nvals == 0, InvalidArgument, "Null ptr rows array");
+
+        for (size_t k = 0; k < nvals; k++) {
+            CHECK_RAISE_ERROR(rows[k] < getNrows(), InvalidArgument, "Value out of vector bounds");
+        }
+
+        LogStream stream(*Library::getLogger());
+        stream << Logger::Level::Info
+               << "Vector:build:" << this->getDebugMarker() << " "
+               << "isSorted=" << isSorted << ", "
+               << "noDuplicates=" << noDuplicates << LogStream::cmt;
+
+        mHnd->build(rows, nvals, isSorted, noDuplicates);
+    }
+
+    void Vector::extract(index *rows, size_t &nvals) {
+        CHECK_RAISE_ERROR(rows != nullptr || getNvals() == 0, InvalidArgument, "Null ptr rows array");
+        CHECK_RAISE_ERROR(getNvals() <= nvals, InvalidArgument, "Passed array size must be more or equal to the nvals of the vector");
+
+        mHnd->extract(rows, nvals);
+    }
+
+    void Vector::clone(const VectorBase &otherBase) {
+        const auto* other = dynamic_cast<const Vector*>(&otherBase);
+
+        CHECK_RAISE_ERROR(other != nullptr, InvalidArgument, "Passed vector does not belong to core vector class");
+
+        if (this == other)
+            return;
+
+        CHECK_RAISE_ERROR(other->getNrows() == this->getNrows(), InvalidArgument, "Cloned vector has incompatible size");
+
+        mHnd->clone(*other->mHnd);
+    }
+
+    void Vector::multiplyMxV(const MatrixBase &mBase, const VectorBase &vBase, const VectorBase *maskBase, bool complement, bool checkTime) {
+        const auto* m = dynamic_cast<const Matrix*>(&mBase);
+        const auto* v = dynamic_cast<const Vector*>(&vBase);
+        const auto* mask = dynamic_cast<const Vector*>(maskBase);
+
+        CHECK_RAISE_ERROR(m != nullptr, InvalidArgument, "Passed matrix does not belong to core matrix class");
+        CHECK_RAISE_ERROR(v != nullptr, InvalidArgument, "Passed vector does not belong to core vector class");
+        CHECK_RAISE_ERROR(mask != nullptr || maskBase == nullptr, InvalidArgument, "Passed vector does not belong to core vector class");
+
+        CHECK_RAISE_ERROR(m->getNrows() == this->getNrows(), InvalidArgument, "Vector has incompatible size for operation result");
+        CHECK_RAISE_ERROR(m->getNcols() == v->getNrows(), InvalidArgument, "Cannot multiply passed matrix and vector");
+        CHECK_RAISE_ERROR(mask == nullptr || mask->getNrows() == this->getNrows(), InvalidArgument, "Mask has incompatible size for operation result");
+
+        m->commitCache();
+
+        TraceScope trace("Vector::multiplyMxV");
+        trace.arg("result", getDebugMarker()).arg("matrix", m->getDebugMarker()).arg("vector", v->getDebugMarker());
+
+        Stats::Record record;
+        record.nnzIn = m->getNvals() + v->getNvals();
+        record.flops = m->getNcols() > 0? (uint64_t) m->getNvals() * v->getNvals() / m->getNcols(): 0;
+
+        TIMER_ACTION(timer, mHnd->multiplyMxV(*m->mHnd, *v->mHnd, mask? mask->mHnd: nullptr, complement, false));
+
+        record.timeNs = timer.getElapsedTimeNs();
+        record.nnzOut = this->getNvals();
+        record.bytesAllocated = sizeof(index) * record.nnzOut;
+        Stats::record(SPBLA_OPERATION_MXV, record);
+        trace.arg("nnz_in", record.nnzIn).arg("nnz_out", record.nnzOut).arg("flops", record.flops);
+
+        if (checkTime) {
+            LogStream stream(*Library::getLogger());
+            stream << Logger::Level::Info
+                   << "Time: " << timer.getElapsedTimeMs() << " ms "
+                   << "Vector::multiplyMxV: "
+                   << this->getDebugMarker();
+
+            if (mask)
+                stream << (complement? "<!": "<") << mask->getDebugMarker() << ">";
+
+            stream << " = "
+                   << m->getDebugMarker() << " x "
+                   << v->getDebugMarker() << LogStream::cmt;
+        }
+    }
+
+    void Vector::multiplyVxM(const VectorBase &vBase, const MatrixBase &mBase, const VectorBase *maskBase, bool complement, bool checkTime) {
+        const auto* v = dynamic_cast<const Vector*>(&vBase);
+        const auto* m = dynamic_cast<const Matrix*>(&mBase);
+        const auto* mask = dynamic_cast<const Vector*>(maskBase);
+
+        CHECK_RAISE_ERROR(v != nullptr, InvalidArgument, "Passed vector does not belong to core vector class");
+        CHECK_RAISE_ERROR(m != nullptr, InvalidArgument, "Passed matrix does not belong to core matrix class");
+        CHECK_RAISE_ERROR(mask != nullptr || maskBase == nullptr, InvalidArgument, "Passed vector does not belong to core vector class");
+
+        CHECK_RAISE_ERROR(m->getNcols() == this->getNrows(), InvalidArgument, "Vector has incompatible size for operation result");
+        CHECK_RAISE_ERROR(m->getNrows() == v->getNrows(), InvalidArgument, "Cannot multiply passed vector and matrix");
+        CHECK_RAISE_ERROR(mask == nullptr || mask->getNrows() == this->getNrows(), InvalidArgument, "Mask has incompatible size for operation result");
+
+        m->commitCache();
+
+        TraceScope trace("Vector::multiplyVxM");
+        trace.arg("result", getDebugMarker()).arg("vector", v->getDebugMarker()).arg("matrix", m->getDebugMarker());
+
+        Stats::Record record;
+        record.nnzIn = v->getNvals() + m->getNvals();
+        record.flops = m->getNrows() > 0? (uint64_t) m->getNvals() * v->getNvals() / m->getNrows(): 0;
+
+        TIMER_ACTION(timer, mHnd->multiplyVxM(*v->mHnd, *m->mHnd, mask? mask->mHnd: nullptr, complement, false));
+
+        record.timeNs = timer.getElapsedTimeNs();
+        record.nnzOut = this->getNvals();
+        record.bytesAllocated = sizeof(index) * record.nnzOut;
+        Stats::record(SPBLA_OPERATION_VXM, record);
+        trace.arg("nnz_in", record.nnzIn).arg("nnz_out", record.nnzOut).arg("flops", record.flops);
+
+        if (checkTime) {
+            LogStream stream(*Library::getLogger());
+            stream << Logger::Level::Info
+                   << "Time: " << timer.getElapsedTimeMs() << " ms "
+                   << "Vector::multiplyVxM: "
+                   << this->getDebugMarker();
+
+            if (mask)
+                stream << (complement? "<!": "<") << mask->getDebugMarker() << ">";
+
+            stream << " = "
+                   << v->getDebugMarker() << " x "
+                   << m->getDebugMarker() << LogStream::cmt;
+        }
+    }
+
+    index Vector::getNrows() const {
+        return mHnd->getNrows();
+    }
+
+    index Vector::getNvals() const {
+        return mHnd->getNvals();
+    }
+
+    const char *Vector::getDebugMarker() const {
+        return mMarker.c_str();
+    }
+
+}
@@ -25,6 +25,7 @@
 #include <cuda/cuda_backend.hpp>
 #include <cuda/cuda_matrix.hpp>
 #include <core/library.hpp>
+#include <core/error.hpp>
 #include <io/logger.hpp>
 
 namespace spbla {
@@ -66,6 +67,14 @@ namespace spbla {
         delete matrixBase;
     }
 
+    VectorBase *CudaBackend::createVector(size_t nrows) {
+        RAISE_ERROR(NotImplemented, "Vectors are not supported by cuda backend");
+    }
+
+    void CudaBackend::releaseVector(VectorBase *vectorBase) {
+        delete vectorBase;
+    }
+
     void CudaBackend::queryCapabilities(spbla_DeviceCaps &caps) {
         CudaInstance::queryDeviceCapabilities(caps);
     }
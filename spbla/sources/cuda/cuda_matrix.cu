@@ -38,6 +38,18 @@ namespace spbla {
         RAISE_ERROR(NotImplemented, "This function is not supported for this matrix class");
     }
 
+    void CudaMatrix::multiplyMasked(const MatrixBase &mask, const MatrixBase &a, const MatrixBase &b, bool complement, bool accumulate, bool checkTime) {
+        RAISE_ERROR(NotImplemented, "This function is not supported for this matrix class");
+    }
+
+    void CudaMatrix::eWiseMult(const MatrixBase &a, const MatrixBase &b, bool checkTime) {
+        RAISE_ERROR(NotImplemented, "This function is not supported for this matrix class");
+    }
+
+    void CudaMatrix::eWiseDiff(const MatrixBase &a, const MatrixBase &b, bool checkTime) {
+        RAISE_ERROR(NotImplemented, "This function is not supported for this matrix class");
+    }
+
     void CudaMatrix::clone(const MatrixBase &otherBase) {
         auto other = dynamic_cast<const CudaMatrix*>(&otherBase);
 
@@ -45,7 +45,10 @@ namespace spbla {
 
         void setElement(index i, index j) override;
         void build(const index *rows, const index *cols, size_t nvals, bool isSorted, bool noDuplicates) override;
+        void insert(const index *rows, const index *cols, size_t nvals) override;
+        void buildCsr(std::vector<index> &&rowOffsets, std::vector<index> &&colIndices, bool isSorted, bool noDuplicates) override;
         void extract(index* rows, index* cols, size_t &nvals) override;
+        void extractCsr(const index* &rowOffsets, const index* &colIndices) override;
         void extractSubMatrix(const MatrixBase &otherBase, index i, index j, index nrows, index ncols, bool checkTime) override;
 
         void clone(const MatrixBase &other) override;
@@ -53,8 +56,12 @@ namespace spbla {
         void reduce(const MatrixBase &other, bool checkTime) override;
 
         void multiply(const MatrixBase &a, const MatrixBase &b, bool accumulate, bool checkTime) override;
+        void multiplyTransposed(const MatrixBase &a, const MatrixBase &b, bool transposeA, bool transposeB, bool accumulate, bool checkTime) override;
+        void multiplyMasked(const MatrixBase &mask, const MatrixBase &a, const MatrixBase &b, bool complement, bool accumulate, bool checkTime) override;
         void kronecker(const MatrixBase &a, const MatrixBase &b, bool checkTime) override;
         void eWiseAdd(const MatrixBase &a, const MatrixBase &b, bool checkTime) override;
+        void eWiseMult(const MatrixBase &a, const MatrixBase &b, bool checkTime) override;
+        void eWiseDiff(const MatrixBase &a, const MatrixBase &b, bool checkTime) override;
 
         index getNrows() const override;
         index getNcols() const override;
@@ -71,6 +78,10 @@ namespace spbla {
         // Uses nsparse csr matrix implementation as a backend
         mutable MatrixImplType mMatrixImpl;
 
+        // Host copy of the matrix storage, exposed by extractCsr
+        std::vector<index> mHostRowOffsets;
+        std::vector<index> mHostColIndices;
+
         size_t mNrows = 0;
         size_t mNcols = 0;
         CudaInstance& mInstance;
@@ -27,6 +27,12 @@
 
 namespace spbla {
 
+    void CudaMatrix::insert(const index *rows, const index *cols, size_t nvals) {
+        CudaMatrix tmp(getNrows(), getNcols(), mInstance);
+        tmp.build(rows, cols, nvals, true, true);
+        this->eWiseAdd(*this, tmp, false);
+    }
+
     void CudaMatrix::build(const index *rows, const index *cols, size_t nvals, bool isSorted, bool noDuplicates) {
         if (nvals == 0) {
             mMatrixImpl.zero_dim();  // no content, empty matrix
@@ -43,4 +49,16 @@ namespace spbla {
         this->transferToDevice(rowOffsets, colIndices);
     }
 
+    void CudaMatrix::buildCsr(std::vector<index> &&rowOffsets, std::vector<index> &&colIndices, bool isSorted, bool noDuplicates) {
+        CsrUtils::normalizeRows(getNrows(), getNcols(), rowOffsets, colIndices, isSorted, noDuplicates);
+
+        if (colIndices.empty()) {
+            mMatrixImpl.zero_dim();  // no content, empty matrix
+            return;
+        }
+
+        // Csr arrays are copied to the device as is
+        this->transferToDevice(rowOffsets, colIndices);
+    }
+
 }
\ No newline at end of file
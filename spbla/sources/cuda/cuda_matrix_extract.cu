@@ -44,4 +44,18 @@ namespace spbla {
         }
     }
 
+    void CudaMatrix::extractCsr(const index* &rowOffsets, const index* &colIndices) {
+        if (isMatrixEmpty() || isStorageEmpty()) {
+            mHostRowOffsets.clear();
+            mHostRowOffsets.resize(getNrows() + 1, 0);
+            mHostColIndices.clear();
+        }
+        else {
+            this->transferFromDevice(mHostRowOffsets, mHostColIndices);
+        }
+
+        rowOffsets = mHostRowOffsets.data();
+        colIndices = mHostColIndices.data();
+    }
+
 }
\ No newline at end of file
@@ -24,6 +24,7 @@
 
 #include <cuda/cuda_matrix.hpp>
 #include <nsparse/spgemm.h>
+#include <memory>
 
 namespace spbla {
 
@@ -63,4 +64,28 @@ namespace spbla {
         this->mMatrixImpl = std::move(result);
     }
 
+    void CudaMatrix::multiplyTransposed(const MatrixBase &aBase, const MatrixBase &bBase, bool transposeA, bool transposeB, bool accumulate, bool checkTime) {
+        auto a = dynamic_cast<const CudaMatrix*>(&aBase);
+        auto b = dynamic_cast<const CudaMatrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Passed matrix does not belong to csr matrix class");
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Passed matrix does not belong to csr matrix class");
+
+        // No transposed kernels on device: operands are transposed into temporary matrices
+        std::unique_ptr<CudaMatrix> at;
+        std::unique_ptr<CudaMatrix> bt;
+
+        if (transposeA) {
+            at = std::make_unique<CudaMatrix>(a->getNcols(), a->getNrows(), mInstance);
+            at->transpose(*a, checkTime);
+        }
+
+        if (transposeB) {
+            bt = std::make_unique<CudaMatrix>(b->getNcols(), b->getNrows(), mInstance);
+            bt->transpose(*b, checkTime);
+        }
+
+        this->multiply(at? *at: *a, bt? *bt: *b, accumulate, checkTime);
+    }
+
 }
\ No newline at end of file
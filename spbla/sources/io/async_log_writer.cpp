@@ -0,0 +1,120 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <io/async_log_writer.hpp>
+#include <cassert>
+
+namespace spbla {
+
+    AsyncLogWriter::AsyncLogWriter(std::shared_ptr<std::ostream> stream, Format format, size_t capacity)
+        : mStream(std::move(stream)), mFormat(std::move(format)), mEntries(capacity) {
+        assert(mStream);
+        assert(capacity > 0);
+
+        mThread = std::thread([this]() { run(); });
+    }
+
+    AsyncLogWriter::~AsyncLogWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+
+        mCondition.notify_one();
+        mThread.join();
+    }
+
+    void AsyncLogWriter::push(size_t id, Logger::Level level, const std::string &message) {
+        bool wasEmpty;
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            if (mSize == mEntries.size()) {
+                mDropped += 1;
+                return;
+            }
+
+            auto& entry = mEntries[(mHead + mSize) % mEntries.size()];
+            entry.message = message;
+            entry.level = level;
+            entry.id = id;
+
+            wasEmpty = mSize == 0;
+            mSize += 1;
+        }
+
+        // Writer sleeps only if queue is empty
+        if (wasEmpty)
+            mCondition.notify_one();
+    }
+
+    size_t AsyncLogWriter::getDroppedCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mDroppedTotal + mDropped;
+    }
+
+    void AsyncLogWriter::run() {
+        std::vector<Entry> batch;
+        batch.reserve(mEntries.size());
+
+        while (true) {
+            size_t dropped;
+            bool stop;
+
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this]() { return mSize > 0 || mStop; });
+
+                // Strings are moved out, so slots keep no memory after the batch is taken
+                for (size_t k = 0; k < mSize; k++)
+                    batch.push_back(std::move(mEntries[(mHead + k) % mEntries.size()]));
+
+                mHead = (mHead + mSize) % mEntries.size();
+                mSize = 0;
+
+                dropped = mDropped;
+                mDroppedTotal += mDropped;
+                mDropped = 0;
+                stop = mStop;
+            }
+
+            auto& stream = *mStream;
+
+            for (const auto& entry: batch)
+                mFormat(stream, entry.id, entry.level, entry.message);
+
+            if (dropped > 0)
+                mFormat(stream, batch.empty()? 0: batch.back().id, Logger::Level::Warning,
+                        "Log queue is full: dropped " + std::to_string(dropped) + " messages");
+
+            stream.flush();
+            batch.clear();
+
+            if (stop)
+                break;
+        }
+    }
+
+}
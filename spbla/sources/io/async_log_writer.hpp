@@ -0,0 +1,94 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_ASYNC_LOG_WRITER_HPP
+#define SPBLA_ASYNC_LOG_WRITER_HPP
+
+#include <io/logger.hpp>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace spbla {
+
+    /**
+     * Writes logged messages to the stream on the background thread.
+     *
+     * Messages are queued into fixed-size ring buffer, so logging never blocks on io
+     * and memory usage is bounded. If the buffer is full, new messages are dropped and
+     * the count of dropped messages is reported in the log. Writer drains all queued
+     * messages at once and flushes the stream once per such batch.
+     */
+    class AsyncLogWriter {
+    public:
+        /** Writes single message into the stream */
+        using Format = std::function<void(std::ostream& stream, size_t id, Logger::Level level, const std::string& message)>;
+
+        static const size_t DEFAULT_CAPACITY = 4096;
+
+        AsyncLogWriter(std::shared_ptr<std::ostream> stream, Format format, size_t capacity = DEFAULT_CAPACITY);
+        AsyncLogWriter(const AsyncLogWriter& other) = delete;
+        AsyncLogWriter(AsyncLogWriter&& other) noexcept = delete;
+
+        /** Writes remaining queued messages and stops writer thread */
+        ~AsyncLogWriter();
+
+        /** Queue message for writing (or drop it, if queue is full) */
+        void push(size_t id, Logger::Level level, const std::string& message);
+
+        /** @return Total number of dropped messages */
+        size_t getDroppedCount() const;
+
+    private:
+        struct Entry {
+            std::string message;
+            Logger::Level level;
+            size_t id;
+        };
+
+        void run();
+
+        std::shared_ptr<std::ostream> mStream;
+        Format mFormat;
+
+        mutable std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::vector<Entry> mEntries;
+        size_t mHead = 0;
+        size_t mSize = 0;
+        size_t mDropped = 0;
+        size_t mDroppedTotal = 0;
+        bool mStop = false;
+
+        std::thread mThread;
+    };
+
+}
+
+#endif //SPBLA_ASYNC_LOG_WRITER_HPP
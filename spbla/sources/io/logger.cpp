@@ -39,7 +39,7 @@ namespace spbla {
     }
 
     void TextLogger::log(Logger::Level level, const std::string &message) {
-        bool pass = true;
+        bool pass = isEnabled(level);
 
         // If pass all filters
         for (const auto& filter: mFilters) {
@@ -49,13 +49,6 @@ namespace spbla {
         if (pass || level == Level::Always) {
             auto id = mNextMessageId++;
 
-            Entry entry;
-            entry.message = message;
-            entry.level = level;
-            entry.id = id;
-
-            mEntries.emplace_back(std::move(entry));
-
             // Notify listeners
             for (const auto& action: mOnLogged) {
                 action(id, level, message);
@@ -64,19 +57,34 @@ namespace spbla {
     }
 
     size_t TextLogger::getMessagesCount() const {
-        return mEntries.size();
+        return mNextMessageId;
     }
 
     bool TextLogger::isDummy() const {
         return false;
     }
 
+    bool TextLogger::isEnabled(Logger::Level level) const {
+        bool pass = true;
+
+        for (const auto& filter: mLevelFilters) {
+            pass = pass && filter(level);
+        }
+
+        return pass || level == Level::Always;
+    }
+
     void TextLogger::addFilter(Filter filter) {
         mFilters.emplace_back(std::move(filter));
     }
 
+    void TextLogger::addLevelFilter(LevelFilter filter) {
+        mLevelFilters.emplace_back(std::move(filter));
+    }
+
     void TextLogger::removeAllFilters() {
         mFilters.clear();
+        mLevelFilters.clear();
     }
 
     void TextLogger::addOnLoggerAction(OnLogged onLogged) {
@@ -98,4 +106,9 @@ namespace spbla {
     bool DummyLogger::isDummy() const {
         return true;
     }
+
+    bool DummyLogger::isEnabled(Logger::Level) const {
+        // Nothing is logged, so messages are never built
+        return false;
+    }
 }
@@ -51,19 +51,24 @@ namespace spbla {
         virtual void logError(const std::string &message);
         virtual bool isDummy() const = 0;
         virtual size_t getMessagesCount() const = 0;
+
+        /** @return True if messages of this level can pass logger filters (checked before message is built) */
+        virtual bool isEnabled(Level level) const = 0;
     };
 
     /**
      * @brief Text logger
      *
-     * Collects logged messages into an array.
+     * Counts logged messages and passes them to post-logging actions
+     * (messages are not stored inside, actions commit them to the output log file).
      * Allows add filters to ignore some messages.
-     * Allows commit messages to the output log file.
      */
     class TextLogger final: public Logger {
     public:
         /** Allows filter logged messages (before they are actually saved inside) */
         using Filter = std::function<bool(Level level, const std::string& message)>;
+        /** Allows filter messages by level only (before they are built) */
+        using LevelFilter = std::function<bool(Level level)>;
         /** Allows perform post-logging action (if message was saved) */
         using OnLogged = std::function<void(size_t id, Level level, const std::string& message)>;
 
@@ -71,21 +76,17 @@ namespace spbla {
         void log(Level level, const std::string &message) override;
         size_t getMessagesCount() const override;
         bool isDummy() const override;
+        bool isEnabled(Level level) const override;
 
         void addFilter(Filter filter);
+        void addLevelFilter(LevelFilter filter);
         void removeAllFilters();
         void addOnLoggerAction(OnLogged onLogged);
         void removeAllOnLoggedActions();
 
     private:
-        struct Entry {
-            std::string message;
-            Level level;
-            size_t id;
-        };
-
-        std::vector<Entry> mEntries;
         std::vector<Filter> mFilters;
+        std::vector<LevelFilter> mLevelFilters;
         std::vector<OnLogged> mOnLogged;
         size_t mNextMessageId = 0;
     };
@@ -100,6 +101,7 @@ namespace spbla {
         void log(Level level, const std::string &message) override;
         size_t getMessagesCount() const override;
         bool isDummy() const override;
+        bool isEnabled(Level level) const override;
     };
 
     /**
@@ -111,14 +113,14 @@ namespace spbla {
         constexpr static const Commit cmt = Commit{};
 
         explicit LogStream(Logger& logger)
-            : mLogger(logger), mLevel(Logger::Level::Info) {
+            : mLogger(logger), mLevel(Logger::Level::Info), mEnabled(logger.isEnabled(Logger::Level::Info)) {
         };
 
         LogStream(LogStream&& other) noexcept = default;
         ~LogStream() = default;
 
         void commit() {
-            if (!mLogger.isDummy()) {
+            if (mEnabled) {
                 mLogger.log(mLevel, mStream.str());
                 mStream.str(std::string());
             }
@@ -127,13 +129,14 @@ namespace spbla {
         friend LogStream& operator<<(LogStream& stream, Logger::Level level) {
             if (!stream.mLogger.isDummy()) {
                 stream.mLevel = level;
+                stream.mEnabled = stream.mLogger.isEnabled(level);
             }
 
             return stream;
         }
 
         friend LogStream& operator<<(LogStream& stream, Commit commit) {
-            if (!stream.mLogger.isDummy()) {
+            if (stream.mEnabled) {
                 stream.commit();
             }
 
@@ -142,7 +145,8 @@ namespace spbla {
 
         template<typename T>
         friend LogStream& operator<<(LogStream& stream, T&& t) {
-            if (!stream.mLogger.isDummy()) {
+            // Filtered out messages are not formatted at all
+            if (stream.mEnabled) {
                 stream.mStream << std::forward<T>(t);
             }
 
@@ -152,6 +156,7 @@ namespace spbla {
     private:
         Logger& mLogger;
         Logger::Level mLevel;
+        bool mEnabled;
         std::stringstream mStream;
     };
 
@@ -0,0 +1,88 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <io/mapped_file.hpp>
+#include <core/error.hpp>
+#include <fstream>
+
+#if defined(SPBLA_PLATFORM_LINUX) || defined(SPBLA_PLATFORM_MACOS)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define SPBLA_MAPPED_FILE_MMAP
+#endif
+
+namespace spbla {
+
+    MappedFile::MappedFile(const std::string &path) {
+#ifdef SPBLA_MAPPED_FILE_MMAP
+        int fd = open(path.c_str(), O_RDONLY);
+        CHECK_RAISE_ERROR(fd >= 0, InvalidArgument, "Failed to open file for reading");
+
+        struct stat st{};
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* data = mmap(nullptr, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (data != MAP_FAILED) {
+                mData = (const uint8_t*) data;
+                mSize = (size_t) st.st_size;
+                mMapped = true;
+                madvise(data, mSize, MADV_SEQUENTIAL);
+            }
+        }
+
+        close(fd);
+#endif
+
+        if (!mMapped) {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            CHECK_RAISE_ERROR(file.is_open(), InvalidArgument, "Failed to open file for reading");
+
+            mBuffer.resize((size_t) file.tellg());
+            file.seekg(0);
+            file.read((char*) mBuffer.data(), (std::streamsize) mBuffer.size());
+
+            mData = mBuffer.data();
+            mSize = mBuffer.size();
+        }
+    }
+
+    MappedFile::~MappedFile() {
+#ifdef SPBLA_MAPPED_FILE_MMAP
+        if (mMapped) {
+            munmap((void*) mData, mSize);
+        }
+#endif
+    }
+
+    const uint8_t *MappedFile::getData() const {
+        return mData;
+    }
+
+    size_t MappedFile::getSize() const {
+        return mSize;
+    }
+
+}
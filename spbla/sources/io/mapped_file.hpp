@@ -0,0 +1,60 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_MAPPED_FILE_HPP
+#define SPBLA_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace spbla {
+
+    /**
+     * Read-only file content.
+     * File is memory mapped where supported, otherwise its content is read into memory.
+     */
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path);
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile(MappedFile&& other) noexcept = delete;
+        ~MappedFile();
+
+        const uint8_t* getData() const;
+        size_t getSize() const;
+
+    private:
+        const uint8_t* mData = nullptr;
+        size_t mSize = 0;
+        bool mMapped = false;
+
+        // Used if file cannot be mapped
+        std::vector<uint8_t> mBuffer;
+    };
+
+}
+
+#endif //SPBLA_MAPPED_FILE_HPP
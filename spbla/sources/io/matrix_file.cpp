@@ -0,0 +1,170 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <io/matrix_file.hpp>
+#include <core/error.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace spbla {
+
+    static const char MATRIX_FILE_MAGIC[8] = {'S', 'P', 'B', 'L', 'A', 'M', 'T', 'X'};
+    static const uint32_t MATRIX_FILE_BYTE_ORDER = 0x01020304u;
+
+    // FNV-1a over header words and index values
+    static const uint64_t CHECKSUM_BASIS = 0xcbf29ce484222325ull;
+    static const uint64_t CHECKSUM_PRIME = 0x100000001b3ull;
+
+    void MatrixFile::save(const std::string &path, index nrows, index ncols,
+                          const index *rowOffsets, const index *colIndices, size_t nvals) {
+        Header header{};
+        std::memcpy(header.magic, MATRIX_FILE_MAGIC, sizeof(header.magic));
+        header.version = VERSION;
+        header.indexSize = sizeof(index);
+        header.byteOrder = MATRIX_FILE_BYTE_ORDER;
+        header.nrows = nrows;
+        header.ncols = ncols;
+        header.nvals = nvals;
+        header.rowOffsetsOffset = alignOffset(sizeof(Header));
+        header.colIndicesOffset = alignOffset(header.rowOffsetsOffset + sizeof(index) * (nrows + 1));
+        header.checksum = checksum(colIndices, nvals, checksum(rowOffsets, nrows + 1, checksum(header, CHECKSUM_BASIS)));
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        CHECK_RAISE_ERROR(file.is_open(), InvalidArgument, "Failed to open file for writing");
+
+        static const char padding[ALIGNMENT] = {};
+
+        file.write((const char*) &header, sizeof(Header));
+        file.write(padding, header.rowOffsetsOffset - sizeof(Header));
+        file.write((const char*) rowOffsets, sizeof(index) * (nrows + 1));
+        file.write(padding, header.colIndicesOffset - header.rowOffsetsOffset - sizeof(index) * (nrows + 1));
+        file.write((const char*) colIndices, sizeof(index) * nvals);
+        file.flush();
+
+        CHECK_RAISE_ERROR(file.good(), Error, "Failed to write file");
+    }
+
+    MatrixFile::MatrixFile(const std::string &path) : mFile(path) {
+        mData = mFile.getData();
+        mSize = mFile.getSize();
+        validate();
+    }
+
+    index MatrixFile::getNrows() const {
+        return (index) mHeader.nrows;
+    }
+
+    index MatrixFile::getNcols() const {
+        return (index) mHeader.ncols;
+    }
+
+    index MatrixFile::getNvals() const {
+        return (index) mHeader.nvals;
+    }
+
+    const index *MatrixFile::getRowOffsets() const {
+        return (const index*) (mData + mHeader.rowOffsetsOffset);
+    }
+
+    const index *MatrixFile::getColIndices() const {
+        return (const index*) (mData + mHeader.colIndicesOffset);
+    }
+
+    uint64_t MatrixFile::checksum(const index *values, size_t count, uint64_t hash) {
+        for (size_t k = 0; k < count; k++) {
+            hash = (hash ^ (uint64_t) values[k]) * CHECKSUM_PRIME;
+        }
+
+        return hash;
+    }
+
+    uint64_t MatrixFile::checksum(const Header &header, uint64_t hash) {
+        // Checksum field itself is hashed as zero
+        Header copy = header;
+        copy.checksum = 0;
+
+        uint32_t words[sizeof(Header) / sizeof(uint32_t)];
+        std::memcpy(words, &copy, sizeof(Header));
+
+        for (auto word: words) {
+            hash = (hash ^ (uint64_t) word) * CHECKSUM_PRIME;
+        }
+
+        return hash;
+    }
+
+    uint64_t MatrixFile::alignOffset(uint64_t offset) {
+        return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    void MatrixFile::validate() {
+        CHECK_RAISE_ERROR(mSize >= sizeof(Header), InvalidArgument, "File is too small to be a matrix file");
+
+        auto& header = mHeader;
+        std::memcpy(&header, mData, sizeof(Header));
+
+        CHECK_RAISE_ERROR(std::memcmp(header.magic, MATRIX_FILE_MAGIC, sizeof(header.magic)) == 0, InvalidArgument, "File is not a matrix file");
+        CHECK_RAISE_ERROR(header.version == VERSION, InvalidArgument, "Unsupported matrix file version");
+        CHECK_RAISE_ERROR(header.indexSize == sizeof(index), InvalidArgument, "Unsupported matrix file index size");
+        CHECK_RAISE_ERROR(header.byteOrder == MATRIX_FILE_BYTE_ORDER, InvalidArgument, "Unsupported matrix file byte order");
+        CHECK_RAISE_ERROR(header.nrows > 0 && header.ncols > 0, InvalidArgument, "Matrix file has zero dimension");
+        CHECK_RAISE_ERROR(header.nrows <= std::numeric_limits<index>::max(), InvalidArgument, "Matrix file size exceeds index range");
+        CHECK_RAISE_ERROR(header.ncols <= std::numeric_limits<index>::max(), InvalidArgument, "Matrix file size exceeds index range");
+        CHECK_RAISE_ERROR(header.nvals <= std::numeric_limits<index>::max(), InvalidArgument, "Matrix file size exceeds index range");
+
+        // Section bounds are checked by division, so header values can not overflow them
+        CHECK_RAISE_ERROR(header.rowOffsetsOffset % ALIGNMENT == 0 && header.colIndicesOffset % ALIGNMENT == 0, InvalidArgument, "Matrix file sections are not aligned");
+        CHECK_RAISE_ERROR(header.rowOffsetsOffset >= sizeof(Header) && header.rowOffsetsOffset <= mSize, InvalidArgument, "Matrix file is truncated");
+        CHECK_RAISE_ERROR(header.nrows < (mSize - header.rowOffsetsOffset) / sizeof(index), InvalidArgument, "Matrix file is truncated");
+
+        uint64_t rowOffsetsEnd = header.rowOffsetsOffset + sizeof(index) * (header.nrows + 1);
+
+        CHECK_RAISE_ERROR(header.colIndicesOffset >= rowOffsetsEnd, InvalidArgument, "Matrix file sections overlap");
+        CHECK_RAISE_ERROR(header.colIndicesOffset <= mSize, InvalidArgument, "Matrix file is truncated");
+        CHECK_RAISE_ERROR(header.nvals <= (mSize - header.colIndicesOffset) / sizeof(index), InvalidArgument, "Matrix file is truncated");
+
+        // Column bounds and row offsets order are checked within checksum pass, so loaded values can be used as is
+        const index* rowOffsets = getRowOffsets();
+        const index* colIndices = getColIndices();
+        uint64_t hash = checksum(rowOffsets, header.nrows + 1, checksum(header, CHECKSUM_BASIS));
+        index maxColIndex = 0;
+        bool ordered = rowOffsets[0] == 0 && rowOffsets[header.nrows] == header.nvals;
+
+        for (size_t i = 0; i < header.nrows; i++) {
+            ordered = ordered && rowOffsets[i] <= rowOffsets[i + 1];
+        }
+
+        for (size_t k = 0; k < header.nvals; k++) {
+            hash = (hash ^ (uint64_t) colIndices[k]) * CHECKSUM_PRIME;
+            maxColIndex = std::max(maxColIndex, colIndices[k]);
+        }
+
+        CHECK_RAISE_ERROR(hash == header.checksum, InvalidArgument, "Matrix file checksum mismatch");
+        CHECK_RAISE_ERROR(ordered, InvalidArgument, "Matrix file has invalid row offsets");
+        CHECK_RAISE_ERROR(header.nvals == 0 || maxColIndex < header.ncols, InvalidArgument, "Matrix file has index out of matrix bounds");
+    }
+
+}
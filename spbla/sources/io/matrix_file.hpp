@@ -0,0 +1,107 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_MATRIX_FILE_HPP
+#define SPBLA_MATRIX_FILE_HPP
+
+#include <core/config.hpp>
+#include <io/mapped_file.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace spbla {
+
+    /**
+     * Binary file with boolean matrix in csr format.
+     *
+     * File layout: header, row offsets section, column indices section.
+     * Each section starts at 64-byte aligned offset. Values are stored in little-endian order.
+     * Header keeps format version, matrix size and checksum of the header and both sections.
+     *
+     * Opened file is memory mapped (where supported), so sections are accessed in place.
+     */
+    class MatrixFile {
+    public:
+        static const uint32_t VERSION = 2;
+        static const size_t ALIGNMENT = 64;
+
+        /**
+         * Write matrix to the file.
+         *
+         * @param path Path to the file (overwritten if exists)
+         * @param nrows Matrix rows count
+         * @param ncols Matrix columns count
+         * @param rowOffsets Row offsets array of nrows + 1 size
+         * @param colIndices Column indices array of nvals size
+         * @param nvals Number of values
+         */
+        static void save(const std::string& path, index nrows, index ncols,
+                         const index* rowOffsets, const index* colIndices, size_t nvals);
+
+        /**
+         * Open file and validate its header, sections bounds and checksum.
+         *
+         * @param path Path to the file
+         */
+        explicit MatrixFile(const std::string& path);
+        MatrixFile(const MatrixFile& other) = delete;
+        MatrixFile(MatrixFile&& other) noexcept = delete;
+        ~MatrixFile() = default;
+
+        index getNrows() const;
+        index getNcols() const;
+        index getNvals() const;
+        const index* getRowOffsets() const;
+        const index* getColIndices() const;
+
+    private:
+        struct Header {
+            char magic[8];
+            uint32_t version;
+            uint32_t indexSize;
+            uint32_t byteOrder;
+            uint32_t reserved;
+            uint64_t nrows;
+            uint64_t ncols;
+            uint64_t nvals;
+            uint64_t rowOffsetsOffset;
+            uint64_t colIndicesOffset;
+            uint64_t checksum;
+        };
+
+        static uint64_t checksum(const index* values, size_t count, uint64_t hash);
+        static uint64_t checksum(const Header& header, uint64_t hash);
+        static uint64_t alignOffset(uint64_t offset);
+        void validate();
+
+        MappedFile mFile;
+        Header mHeader{};
+        const uint8_t* mData = nullptr;
+        size_t mSize = 0;
+    };
+
+}
+
+#endif //SPBLA_MATRIX_FILE_HPP
@@ -0,0 +1,304 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <io/mtx_file.hpp>
+#include <core/error.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace spbla {
+
+    static const char MTX_BANNER[] = "%%MatrixMarket";
+
+    // Max length of the formatted "i j\n" line
+    static const size_t MTX_MAX_LINE_SIZE = 2 * std::numeric_limits<index>::digits10 + 4;
+
+    static bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    static const char* skipBlanks(const char* p, const char* end) {
+        while (p < end && isBlank(*p))
+            p++;
+        return p;
+    }
+
+    static const char* skipLine(const char* p, const char* end) {
+        auto newLine = (const char*) std::memchr(p, '\n', end - p);
+        return newLine? newLine + 1: end;
+    }
+
+    static bool parseValue(const char* &p, const char* end, uint64_t &value) {
+        // Values above this bound never fit index (1-based values may exceed it by one), so stop before overflow
+        const uint64_t limit = std::numeric_limits<uint64_t>::max();
+        const uint64_t bound = sizeof(index) < sizeof(uint64_t)? (uint64_t) std::numeric_limits<index>::max() + 1: limit;
+        const char* first = p;
+
+        value = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            auto digit = (uint64_t) (*p - '0');
+            if (value > (limit - digit) / 10)
+                return false;
+
+            value = value * 10 + digit;
+            p++;
+
+            if (value > bound)
+                return false;
+        }
+
+        return p != first && (p == end || isBlank(*p) || *p == '\n');
+    }
+
+    static char* formatValue(char* out, uint64_t value) {
+        char digits[std::numeric_limits<uint64_t>::digits10 + 1];
+        size_t count = 0;
+
+        do {
+            digits[count++] = (char) ('0' + value % 10);
+            value /= 10;
+        } while (value);
+
+        while (count > 0)
+            *(out++) = digits[--count];
+
+        return out;
+    }
+
+    void MtxFile::save(ThreadPool &pool, const std::string &path, index nrows, index ncols,
+                       const index *rowOffsets, const index *colIndices, size_t nvals) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        CHECK_RAISE_ERROR(file.is_open(), InvalidArgument, "Failed to open file for writing");
+
+        file << MTX_BANNER << " matrix coordinate pattern general\n"
+             << nrows << " " << ncols << " " << nvals << "\n";
+
+        // Split rows into blocks with approximately equal nnz count
+        size_t blocks = std::max<size_t>(1, nvals / WRITE_BLOCK_SIZE);
+        std::vector<index> blockRows(blocks + 1, nrows);
+        blockRows[0] = 0;
+
+        for (size_t b = 1; b < blocks; b++) {
+            auto bound = (index) (nvals * b / blocks);
+            blockRows[b] = (index) (std::upper_bound(rowOffsets, rowOffsets + nrows + 1, bound) - rowOffsets - 1);
+        }
+
+        // Blocks are formatted by batches, so only a batch of text is kept in memory at a time
+        size_t batch = pool.getNumThreads() * ThreadPool::CHUNKS_PER_THREAD;
+        std::vector<std::string> texts(std::min(batch, blocks));
+
+        for (size_t first = 0; first < blocks; first += batch) {
+            size_t count = std::min(batch, blocks - first);
+
+            pool.parallelForEach(count, [&](size_t t) {
+                index rowBegin = blockRows[first + t];
+                index rowEnd = blockRows[first + t + 1];
+                auto& text = texts[t];
+
+                text.resize((rowOffsets[rowEnd] - rowOffsets[rowBegin]) * MTX_MAX_LINE_SIZE);
+                char* out = &text[0];
+
+                for (index i = rowBegin; i < rowEnd; i++) {
+                    for (index k = rowOffsets[i]; k < rowOffsets[i + 1]; k++) {
+                        out = formatValue(out, (uint64_t) i + 1);
+                        *(out++) = ' ';
+                        out = formatValue(out, (uint64_t) colIndices[k] + 1);
+                        *(out++) = '\n';
+                    }
+                }
+
+                text.resize(out - text.data());
+            });
+
+            for (size_t t = 0; t < count; t++)
+                file.write(texts[t].data(), (std::streamsize) texts[t].size());
+        }
+
+        file.flush();
+        CHECK_RAISE_ERROR(file.good(), Error, "Failed to write file");
+    }
+
+    MtxFile::MtxFile(const std::string &path) : mFile(path) {
+        mBegin = (const char*) mFile.getData();
+        mEnd = mBegin + mFile.getSize();
+        parseHeader();
+    }
+
+    void MtxFile::read(ThreadPool &pool, std::vector<index> &rows, std::vector<index> &cols) const {
+        size_t size = mEnd - mBegin;
+        size_t count = std::max<size_t>(1, std::min<size_t>(pool.getNumThreads() * ThreadPool::CHUNKS_PER_THREAD, size / READ_CHUNK_SIZE));
+        std::vector<Chunk> chunks(count);
+
+        // Chunk bounds are moved to the beginning of the next line
+        const char* begin = mBegin;
+        for (size_t c = 0; c < count; c++) {
+            const char* end = mBegin + size * (c + 1) / count;
+            end = std::max(begin, end);
+
+            if (end > mBegin && end < mEnd && end[-1] != '\n')
+                end = skipLine(end, mEnd);
+
+            chunks[c].begin = begin;
+            chunks[c].end = end;
+            begin = end;
+        }
+
+        pool.parallelForEach(count, [&](size_t c) {
+            parseChunk(chunks[c]);
+        });
+
+        size_t entries = 0;
+        std::vector<size_t> offsets(count + 1, 0);
+
+        for (size_t c = 0; c < count; c++) {
+            entries += chunks[c].entries;
+            offsets[c + 1] = offsets[c] + chunks[c].rows.size();
+        }
+
+        CHECK_RAISE_ERROR(entries == mNentries, InvalidArgument, "Number of entries in mtx file does not match its header");
+
+        rows.resize(offsets[count]);
+        cols.resize(offsets[count]);
+
+        pool.parallelForEach(count, [&](size_t c) {
+            std::copy(chunks[c].rows.begin(), chunks[c].rows.end(), rows.begin() + offsets[c]);
+            std::copy(chunks[c].cols.begin(), chunks[c].cols.end(), cols.begin() + offsets[c]);
+        });
+    }
+
+    index MtxFile::getNrows() const {
+        return mNrows;
+    }
+
+    index MtxFile::getNcols() const {
+        return mNcols;
+    }
+
+    size_t MtxFile::getNentries() const {
+        return mNentries;
+    }
+
+    void MtxFile::parseHeader() {
+        const char* p = mBegin;
+        size_t bannerSize = sizeof(MTX_BANNER) - 1;
+
+        if ((size_t) (mEnd - p) >= bannerSize && std::memcmp(p, MTX_BANNER, bannerSize) == 0) {
+            const char* lineEnd = skipLine(p, mEnd);
+            std::string line(p + bannerSize, lineEnd);
+            std::transform(line.begin(), line.end(), line.begin(), [](char c) { return (char) std::tolower(c); });
+
+            std::string object, format, field, symmetry;
+            std::stringstream(line) >> object >> format >> field >> symmetry;
+
+            CHECK_RAISE_ERROR(object == "matrix", InvalidArgument, "Unsupported mtx object type");
+            CHECK_RAISE_ERROR(format == "coordinate", InvalidArgument, "Only coordinate mtx format is supported");
+
+            if (symmetry == "symmetric" || symmetry == "skew-symmetric" || symmetry == "hermitian")
+                mSymmetry = Symmetry::Symmetric;
+            else
+                CHECK_RAISE_ERROR(symmetry == "general", InvalidArgument, "Unsupported mtx symmetry type");
+
+            mOneBased = true;
+            p = lineEnd;
+        }
+
+        // Skip comments and empty lines before size line
+        while (true) {
+            p = skipBlanks(p, mEnd);
+            CHECK_RAISE_ERROR(p < mEnd, InvalidArgument, "Mtx file has no size line");
+
+            if (*p != '%' && *p != '#' && *p != '\n')
+                break;
+
+            p = skipLine(p, mEnd);
+        }
+
+        uint64_t nrows, ncols, nentries = 0;
+        bool parsed = parseValue(p, mEnd, nrows);
+        parsed = parsed && parseValue(p = skipBlanks(p, mEnd), mEnd, ncols);
+
+        // Number of entries is not limited by index type
+        if (parsed) {
+            p = skipBlanks(p, mEnd);
+            const char* first = p;
+
+            while (p < mEnd && *p >= '0' && *p <= '9')
+                nentries = nentries * 10 + (uint64_t) (*(p++) - '0');
+
+            parsed = p != first;
+        }
+
+        CHECK_RAISE_ERROR(parsed, InvalidArgument, "Invalid size line in mtx file");
+        CHECK_RAISE_ERROR(nrows <= std::numeric_limits<index>::max(), InvalidArgument, "Too large matrix size");
+        CHECK_RAISE_ERROR(ncols <= std::numeric_limits<index>::max(), InvalidArgument, "Too large matrix size");
+
+        mNrows = (index) nrows;
+        mNcols = (index) ncols;
+        mNentries = (size_t) nentries;
+        mBegin = skipLine(p, mEnd);
+    }
+
+    void MtxFile::parseChunk(Chunk &chunk) const {
+        const char* p = chunk.begin;
+        const char* end = chunk.end;
+        uint64_t base = mOneBased? 1: 0;
+
+        while (p < end) {
+            p = skipBlanks(p, end);
+
+            if (p == end)
+                break;
+
+            if (*p == '\n' || *p == '%' || *p == '#') {
+                p = skipLine(p, end);
+                continue;
+            }
+
+            uint64_t i, j;
+            bool parsed = parseValue(p, end, i);
+            parsed = parsed && parseValue(p = skipBlanks(p, end), end, j);
+
+            CHECK_RAISE_ERROR(parsed, InvalidArgument, "Invalid entry in mtx file");
+            CHECK_RAISE_ERROR(i >= base && i - base < mNrows, InvalidArgument, "Index out of matrix bounds");
+            CHECK_RAISE_ERROR(j >= base && j - base < mNcols, InvalidArgument, "Index out of matrix bounds");
+
+            chunk.rows.push_back((index) (i - base));
+            chunk.cols.push_back((index) (j - base));
+            chunk.entries += 1;
+
+            if (mSymmetry == Symmetry::Symmetric && i != j) {
+                chunk.rows.push_back((index) (j - base));
+                chunk.cols.push_back((index) (i - base));
+            }
+
+            // Values of the entry are ignored
+            p = skipLine(p, end);
+        }
+    }
+
+}
@@ -0,0 +1,120 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_MTX_FILE_HPP
+#define SPBLA_MTX_FILE_HPP
+
+#include <core/config.hpp>
+#include <io/mapped_file.hpp>
+#include <utils/thread_pool.hpp>
+#include <string>
+#include <vector>
+
+namespace spbla {
+
+    /**
+     * Text file with boolean matrix in Matrix Market coordinate format.
+     *
+     * File with `%%MatrixMarket` banner uses 1-based indices. Values of entries (if any) are ignored,
+     * symmetric, skew-symmetric and hermitian matrices are expanded to the general form.
+     * File without banner is treated as legacy pyspbla file with 0-based indices.
+     * Lines starting with `%` or `#` are comments.
+     *
+     * Entries are parsed by chunks of the file in parallel.
+     */
+    class MtxFile {
+    public:
+        /** Min size of the file chunk parsed by single task */
+        static const size_t READ_CHUNK_SIZE = 1u << 16u;
+        /** Approximate number of values formatted by single task on save */
+        static const size_t WRITE_BLOCK_SIZE = 1u << 16u;
+
+        /**
+         * Write matrix to the file as general pattern matrix with 1-based indices.
+         *
+         * @param pool Pool used to format values
+         * @param path Path to the file (overwritten if exists)
+         * @param nrows Matrix rows count
+         * @param ncols Matrix columns count
+         * @param rowOffsets Row offsets array of nrows + 1 size
+         * @param colIndices Column indices array of nvals size
+         * @param nvals Number of values
+         */
+        static void save(ThreadPool& pool, const std::string& path, index nrows, index ncols,
+                         const index* rowOffsets, const index* colIndices, size_t nvals);
+
+        /**
+         * Open file and parse its banner and size line.
+         *
+         * @param path Path to the file
+         */
+        explicit MtxFile(const std::string& path);
+        MtxFile(const MtxFile& other) = delete;
+        MtxFile(MtxFile&& other) noexcept = delete;
+        ~MtxFile() = default;
+
+        /**
+         * Parse entries of the file into 0-based coo arrays.
+         * Arrays are neither sorted nor free of duplicates.
+         *
+         * @param pool Pool used to parse file chunks
+         * @param[out] rows Row indices of entries
+         * @param[out] cols Column indices of entries
+         */
+        void read(ThreadPool& pool, std::vector<index>& rows, std::vector<index>& cols) const;
+
+        index getNrows() const;
+        index getNcols() const;
+        size_t getNentries() const;
+
+    private:
+        enum class Symmetry {
+            General,
+            Symmetric
+        };
+
+        struct Chunk {
+            const char* begin;
+            const char* end;
+            size_t entries = 0;
+            std::vector<index> rows;
+            std::vector<index> cols;
+        };
+
+        void parseHeader();
+        void parseChunk(Chunk& chunk) const;
+
+        MappedFile mFile;
+        const char* mBegin = nullptr;
+        const char* mEnd = nullptr;
+        index mNrows = 0;
+        index mNcols = 0;
+        size_t mNentries = 0;
+        bool mOneBased = false;
+        Symmetry mSymmetry = Symmetry::General;
+    };
+
+}
+
+#endif //SPBLA_MTX_FILE_HPP
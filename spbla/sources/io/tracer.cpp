@@ -0,0 +1,176 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <io/tracer.hpp>
+#include <core/error.hpp>
+#include <core/library.hpp>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace spbla {
+
+    // Ids let threads to detect, that cached buffer belongs to the previous tracer
+    static std::atomic<uint64_t> tracerIds{1};
+
+    static void writeEscaped(std::ostream &stream, const char* value) {
+        for (; *value; value++) {
+            char c = *value;
+
+            if (c == '"' || c == '\\')
+                stream << '\\' << c;
+            else if ((unsigned char) c < 0x20)
+                stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int) c << std::dec << std::setfill(' ');
+            else
+                stream << c;
+        }
+    }
+
+    Tracer::Tracer(std::string path) : mPath(std::move(path)) {
+        mStart = std::chrono::steady_clock::now();
+        mId = tracerIds.fetch_add(1);
+
+        // Check early, that trace can be written
+        std::ofstream file(mPath, std::ios::out | std::ios::trunc);
+        CHECK_RAISE_ERROR(file.is_open(), InvalidArgument, "Failed to create tracing file");
+    }
+
+    uint64_t Tracer::now() const {
+        using namespace std::chrono;
+        return (uint64_t) duration_cast<nanoseconds>(steady_clock::now() - mStart).count();
+    }
+
+    void Tracer::record(const char *name, uint64_t begin, uint64_t end, std::string &&args) {
+        getThreadBuffer().events.push_back({name, begin, end - begin, std::move(args)});
+    }
+
+    void Tracer::write() const {
+        std::ofstream file(mPath, std::ios::out | std::ios::trunc);
+        CHECK_RAISE_ERROR(file.is_open(), InvalidArgument, "Failed to open tracing file");
+
+        // Time in microseconds with nanoseconds precision
+        auto writeTime = [&](uint64_t ns) {
+            file << ns / 1000 << "." << std::setw(3) << std::setfill('0') << ns % 1000 << std::setfill(' ');
+        };
+
+        const char* separator = "\n";
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        for (const auto& buffer: mBuffers) {
+            file << separator
+                 << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid << ","
+                 << "\"args\":{\"name\":\"spbla thread " << buffer->tid << "\"}}";
+            separator = ",\n";
+
+            for (const auto& event: buffer->events) {
+                file << separator << "{\"name\":\"";
+                writeEscaped(file, event.name);
+                file << "\",\"cat\":\"spbla\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid << ",\"ts\":";
+                writeTime(event.begin);
+                file << ",\"dur\":";
+                writeTime(event.duration);
+                file << ",\"args\":{" << event.args << "}}";
+            }
+        }
+
+        file << "\n]}\n";
+        file.flush();
+
+        CHECK_RAISE_ERROR(file.good(), Error, "Failed to write tracing file");
+    }
+
+    Tracer::Buffer &Tracer::getThreadBuffer() {
+        struct Cache {
+            uint64_t tracerId = 0;
+            Buffer* buffer = nullptr;
+        };
+
+        thread_local Cache cache;
+
+        if (cache.tracerId != mId) {
+            std::lock_guard<std::mutex> guard(mMutex);
+
+            mBuffers.emplace_back(new Buffer());
+            mBuffers.back()->tid = mBuffers.size() - 1;
+
+            cache.tracerId = mId;
+            cache.buffer = mBuffers.back().get();
+        }
+
+        return *cache.buffer;
+    }
+
+    TraceScope::TraceScope(const char *name) : mTracer(Library::getTracer()), mName(name) {
+        if (mTracer)
+            mBegin = mTracer->now();
+    }
+
+    TraceScope::~TraceScope() {
+        if (mTracer)
+            finish();
+    }
+
+    void TraceScope::next(const char *name) {
+        if (!mTracer)
+            return;
+
+        finish();
+
+        mName = name;
+        mArgs.clear();
+        mBegin = mTracer->now();
+    }
+
+    TraceScope &TraceScope::arg(const char *key, uint64_t value) {
+        if (mTracer) {
+            mArgs += mArgs.empty()? "\"": ",\"";
+            mArgs += key;
+            mArgs += "\":";
+            mArgs += std::to_string(value);
+        }
+
+        return *this;
+    }
+
+    TraceScope &TraceScope::arg(const char *key, const char *value) {
+        if (mTracer) {
+            std::stringstream escaped;
+            writeEscaped(escaped, value);
+
+            mArgs += mArgs.empty()? "\"": ",\"";
+            mArgs += key;
+            mArgs += "\":\"";
+            mArgs += escaped.str();
+            mArgs += "\"";
+        }
+
+        return *this;
+    }
+
+    void TraceScope::finish() {
+        mTracer->record(mName, mBegin, mTracer->now(), std::move(mArgs));
+    }
+
+}
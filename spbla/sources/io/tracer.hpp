@@ -0,0 +1,123 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_TRACER_HPP
+#define SPBLA_TRACER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace spbla {
+
+    /**
+     * Collects timeline of library operations and kernels phases.
+     *
+     * Each thread appends events to its own buffer, so recording takes no locks
+     * (buffer is registered once per thread). Events are written as Chrome trace json
+     * (viewed in chrome://tracing or Perfetto) by `write`, when no events are recorded.
+     */
+    class Tracer {
+    public:
+        explicit Tracer(std::string path);
+        Tracer(const Tracer& other) = delete;
+        Tracer(Tracer&& other) noexcept = delete;
+        ~Tracer() = default;
+
+        /** @return Time in nanoseconds since tracer creation */
+        uint64_t now() const;
+
+        /**
+         * Record complete event of calling thread.
+         *
+         * @param name Static name of the event
+         * @param begin Begin time of the event
+         * @param end End time of the event
+         * @param args Event arguments as json object fields
+         */
+        void record(const char* name, uint64_t begin, uint64_t end, std::string&& args);
+
+        /** Write recorded events of all threads to the file */
+        void write() const;
+
+    private:
+        struct Event {
+            const char* name;
+            uint64_t begin;
+            uint64_t duration;
+            std::string args;
+        };
+
+        struct Buffer {
+            size_t tid;
+            std::vector<Event> events;
+        };
+
+        Buffer& getThreadBuffer();
+
+        std::string mPath;
+        std::chrono::steady_clock::time_point mStart;
+        uint64_t mId;
+
+        // Guards registration of new thread buffers only
+        std::mutex mMutex;
+        std::vector<std::unique_ptr<Buffer>> mBuffers;
+    };
+
+    /**
+     * Scoped event of the active library tracer.
+     * Does nothing (except tracer check), if tracing is not set up.
+     *
+     * Scope can be split into consecutive phases with `next`.
+     */
+    class TraceScope {
+    public:
+        explicit TraceScope(const char* name);
+        TraceScope(const TraceScope& other) = delete;
+        TraceScope(TraceScope&& other) noexcept = delete;
+        ~TraceScope();
+
+        /** Finish current event and begin next one */
+        void next(const char* name);
+
+        TraceScope& arg(const char* key, uint64_t value);
+        TraceScope& arg(const char* key, const char* value);
+
+        bool isEnabled() const { return mTracer != nullptr; }
+
+    private:
+        void finish();
+
+        Tracer* mTracer;
+        const char* mName;
+        uint64_t mBegin = 0;
+        std::string mArgs;
+    };
+
+}
+
+#endif //SPBLA_TRACER_HPP
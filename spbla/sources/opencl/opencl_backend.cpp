@@ -59,6 +59,14 @@ namespace spbla {
         delete matrixBase;
     }
 
+    VectorBase* OpenCLBackend::createVector(size_t nrows) {
+        RAISE_ERROR(NotImplemented, "Vectors are not supported by opencl backend");
+    }
+
+    void OpenCLBackend::releaseVector(VectorBase *vectorBase) {
+        delete vectorBase;
+    }
+
     std::pair<int, int> OpenCLBackend::getVersion() {
         int major = -1;
         int minor = -1;
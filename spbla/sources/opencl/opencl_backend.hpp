@@ -45,6 +45,8 @@ namespace spbla {
 
         MatrixBase *createMatrix(size_t nrows, size_t ncols) override;
         void releaseMatrix(MatrixBase *matrixBase) override;
+        VectorBase *createVector(size_t nrows) override;
+        void releaseVector(VectorBase *vectorBase) override;
 
         void queryCapabilities(spbla_DeviceCaps &caps) override;
         void queryAvailableDevices();
@@ -43,6 +43,18 @@ namespace spbla {
         RAISE_ERROR(NotImplemented, "This function is not supported for this matrix class");
     }
 
+    void OpenCLMatrix::multiplyMasked(const MatrixBase &maskBase, const MatrixBase &aBase, const MatrixBase &bBase, bool complement, bool accumulate, bool checkTime) {
+        RAISE_ERROR(NotImplemented, "This function is not supported for this matrix class");
+    }
+
+    void OpenCLMatrix::eWiseMult(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) {
+        RAISE_ERROR(NotImplemented, "This function is not supported for this matrix class");
+    }
+
+    void OpenCLMatrix::eWiseDiff(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) {
+        RAISE_ERROR(NotImplemented, "This function is not supported for this matrix class");
+    }
+
     // shallow copy
     void OpenCLMatrix::clone(const MatrixBase &otherBase) {
         auto other = dynamic_cast<const OpenCLMatrix*>(&otherBase);
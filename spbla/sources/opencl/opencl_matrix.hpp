@@ -41,7 +41,10 @@ namespace spbla {
 
         void setElement(index i, index j) override;
         void build(const index *rows, const index *cols, size_t nvals, bool isSorted, bool noDuplicates) override;
+        void insert(const index *rows, const index *cols, size_t nvals) override;
+        void buildCsr(std::vector<index> &&rowOffsets, std::vector<index> &&colIndices, bool isSorted, bool noDuplicates) override;
         void extract(index *rows, index *cols, size_t &nvals) override;
+        void extractCsr(const index* &rowOffsets, const index* &colIndices) override;
         void extractSubMatrix(const MatrixBase &otherBase, index i, index j, index nrows, index ncols, bool checkTime) override;
 
         void clone(const MatrixBase &otherBase) override;
@@ -49,8 +52,12 @@ namespace spbla {
         void reduce(const MatrixBase &otherBase, bool checkTime) override;
 
         void multiply(const MatrixBase &aBase, const MatrixBase &bBase, bool accumulate, bool checkTime) override;
+        void multiplyTransposed(const MatrixBase &aBase, const MatrixBase &bBase, bool transposeA, bool transposeB, bool accumulate, bool checkTime) override;
+        void multiplyMasked(const MatrixBase &maskBase, const MatrixBase &aBase, const MatrixBase &bBase, bool complement, bool accumulate, bool checkTime) override;
         void kronecker(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
         void eWiseAdd(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
+        void eWiseMult(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
+        void eWiseDiff(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
 
         index getNrows() const override;
         index getNcols() const override;
@@ -63,6 +70,10 @@ namespace spbla {
 
         MatrixImplType mMatrixImpl;
 
+        // Host copy of the matrix storage, exposed by extractCsr
+        std::vector<index> mHostRowOffsets;
+        std::vector<index> mHostColIndices;
+
         OpenCLMatrix(clbool::Controls *controls, MatrixImplType clbool_matrix);
         friend spbla::OpenCLBackend;
         clbool::Controls *clboolState = nullptr;
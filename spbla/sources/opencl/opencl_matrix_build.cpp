@@ -24,6 +24,7 @@
 
 #include <opencl/opencl_matrix.hpp>
 #include <core/error.hpp>
+#include <utils/csr_utils.hpp>
 
 #include <core/matrix_coo.hpp>
 #include <common/matrices_conversions.hpp>
@@ -36,4 +37,22 @@ namespace spbla {
 
         updateFromImpl();
     }
+
+    void OpenCLMatrix::insert(const index *rows, const index *cols, size_t nvals) {
+        OpenCLMatrix tmp(clboolState, mNrows, mNcols);
+        tmp.build(rows, cols, nvals, true, true);
+        this->eWiseAdd(*this, tmp, false);
+    }
+
+    void OpenCLMatrix::buildCsr(std::vector<index> &&rowOffsets, std::vector<index> &&colIndices, bool isSorted, bool noDuplicates) {
+        CsrUtils::normalizeRows(mNrows, mNcols, rowOffsets, colIndices, isSorted, noDuplicates);
+
+        // Dcsr storage is built from coo, values are already sorted and have no duplicates
+        size_t nvals = colIndices.size();
+        std::vector<index> rows(nvals);
+        std::vector<index> cols(nvals);
+
+        CsrUtils::extractData(mNrows, mNcols, rows.data(), cols.data(), nvals, rowOffsets, colIndices);
+        this->build(rows.data(), cols.data(), nvals, true, true);
+    }
 }
\ No newline at end of file
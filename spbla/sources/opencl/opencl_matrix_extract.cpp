@@ -24,6 +24,7 @@
 
 #include <opencl/opencl_matrix.hpp>
 #include <core/error.hpp>
+#include <utils/csr_utils.hpp>
 #include <matrix_coo.hpp>
 #include <matrices_conversions.hpp>
 
@@ -43,4 +44,16 @@ namespace spbla {
         evRow.wait(); evCol.wait();
     }
 
+    void OpenCLMatrix::extractCsr(const index* &rowOffsets, const index* &colIndices) {
+        size_t nvals = mNvals;
+        std::vector<index> rows(nvals);
+        std::vector<index> cols(nvals);
+
+        this->extract(rows.data(), cols.data(), nvals);
+        CsrUtils::buildFromData(mNrows, mNcols, rows.data(), cols.data(), nvals, mHostRowOffsets, mHostColIndices, true, true);
+
+        rowOffsets = mHostRowOffsets.data();
+        colIndices = mHostColIndices.data();
+    }
+
 }
\ No newline at end of file
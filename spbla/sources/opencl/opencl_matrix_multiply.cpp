@@ -26,6 +26,7 @@
 #include <core/error.hpp>
 #include <dcsr/dcsr.hpp>
 #include <cassert>
+#include <memory>
 
 namespace spbla {
 
@@ -54,4 +55,30 @@ namespace spbla {
 
     }
 
+    void OpenCLMatrix::multiplyTransposed(const MatrixBase &aBase, const MatrixBase &bBase, bool transposeA, bool transposeB, bool accumulate, bool checkTime) {
+
+        auto a = dynamic_cast<const OpenCLMatrix*>(&aBase);
+        auto b = dynamic_cast<const OpenCLMatrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Passed matrix does not belong to OpenCLMatrix class")
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Passed matrix does not belong to OpenCLMatrix class")
+
+        // No transposed kernels in clbool: operands are transposed into temporary matrices
+        std::unique_ptr<OpenCLMatrix> at;
+        std::unique_ptr<OpenCLMatrix> bt;
+
+        if (transposeA) {
+            at = std::make_unique<OpenCLMatrix>(clboolState, a->getNcols(), a->getNrows());
+            at->transpose(*a, checkTime);
+        }
+
+        if (transposeB) {
+            bt = std::make_unique<OpenCLMatrix>(clboolState, b->getNcols(), b->getNrows());
+            bt->transpose(*b, checkTime);
+        }
+
+        this->multiply(at? *at: *a, bt? *bt: *b, accumulate, checkTime);
+
+    }
+
 }
\ No newline at end of file
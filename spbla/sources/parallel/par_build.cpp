@@ -0,0 +1,176 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <parallel/par_build.hpp>
+#include <parallel/par_utils.hpp>
+#include <utils/csr_utils.hpp>
+#include <core/error.hpp>
+#include <algorithm>
+
+namespace spbla {
+
+    static void par_compact_rows(ThreadPool& pool, CsrData& data, bool isSorted, bool noDuplicates) {
+        data.nvals = data.colIndices.size();
+
+        if (isSorted && noDuplicates)
+            return;
+
+        // Split rows by nnz, so long rows do not stall single task
+        size_t parts = std::max<size_t>(1, std::min<size_t>(pool.getNumThreads() * ThreadPool::CHUNKS_PER_THREAD, data.nvals / PAR_VALUES_GRAIN));
+        auto bounds = par_split_by_work(data.rowOffsets, parts);
+
+        std::vector<index> rowSizes;
+
+        if (!noDuplicates)
+            rowSizes.resize(data.nrows + 1, 0);
+
+        pool.parallelForEach(parts, [&](size_t p) {
+            std::vector<index> buffer;
+
+            for (index i = bounds[p]; i < bounds[p + 1]; i++) {
+                index* first = data.colIndices.data() + data.rowOffsets[i];
+                index* last = data.colIndices.data() + data.rowOffsets[i + 1];
+
+                if (!isSorted)
+                    CsrUtils::sortIndices(first, last, buffer);
+
+                if (!noDuplicates)
+                    rowSizes[i] = (index) (std::unique(first, last) - first);
+            }
+        });
+
+        if (noDuplicates)
+            return;
+
+        par_exclusive_scan(pool, rowSizes);
+
+        if (rowSizes.back() != data.nvals) {
+            // Rows are moved towards the beginning, so they are compacted serially to avoid overlaps
+            for (index i = 0; i < data.nrows; i++) {
+                auto first = data.colIndices.begin() + data.rowOffsets[i];
+                std::move(first, first + (rowSizes[i + 1] - rowSizes[i]), data.colIndices.begin() + rowSizes[i]);
+            }
+        }
+
+        data.rowOffsets = std::move(rowSizes);
+        data.colIndices.resize(data.rowOffsets.back());
+        data.nvals = data.colIndices.size();
+    }
+
+    void par_build(ThreadPool& pool, const index* rows, const index* cols, size_t nvals,
+                   bool isSorted, bool noDuplicates, CsrData& out) {
+        auto nrows = out.nrows;
+        auto ncols = out.ncols;
+
+        out.rowOffsets.clear();
+        out.rowOffsets.resize(nrows + 1, 0);
+        out.colIndices.resize(nvals);
+        out.nvals = 0;
+        out.nrowsNotEmpty = 0;
+
+        if (nvals == 0)
+            return;
+
+        // Each part keeps its own rows histogram, so parts count is limited to keep histograms within input size
+        size_t parts = std::max<size_t>(1, std::min<size_t>(pool.getNumThreads(), nvals / PAR_VALUES_GRAIN));
+        parts = std::max<size_t>(1, std::min<size_t>(parts, nvals / nrows));
+
+        std::vector<std::vector<index>> counts(parts);
+
+        pool.parallelForEach(parts, [&](size_t p) {
+            auto& partCounts = counts[p];
+            partCounts.resize(nrows, 0);
+
+            for (size_t k = nvals * p / parts; k < nvals * (p + 1) / parts; k++) {
+                CHECK_RAISE_ERROR(rows[k] < nrows, InvalidArgument, "Index out of matrix bounds");
+                CHECK_RAISE_ERROR(cols[k] < ncols, InvalidArgument, "Index out of matrix bounds");
+
+                partCounts[rows[k]]++;
+            }
+        });
+
+        pool.parallelFor(0, nrows, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) {
+                for (size_t p = 0; p < parts; p++)
+                    out.rowOffsets[i] += counts[p][i];
+            }
+        });
+
+        // Dedup never empties a row, so rows counted here stay not empty after compaction
+        out.nrowsNotEmpty = (index) par_exclusive_scan(pool, out.rowOffsets);
+
+        // Part p writes its values of the row i after values of parts [0, p), so input order within rows is kept
+        pool.parallelFor(0, nrows, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) {
+                index offset = out.rowOffsets[i];
+
+                for (size_t p = 0; p < parts; p++) {
+                    index count = counts[p][i];
+                    counts[p][i] = offset;
+                    offset += count;
+                }
+            }
+        });
+
+        pool.parallelForEach(parts, [&](size_t p) {
+            auto& writeOffsets = counts[p];
+
+            for (size_t k = nvals * p / parts; k < nvals * (p + 1) / parts; k++) {
+                out.colIndices[writeOffsets[rows[k]]++] = cols[k];
+            }
+        });
+
+        counts.clear();
+        par_compact_rows(pool, out, isSorted, noDuplicates);
+    }
+
+    void par_normalize_rows(ThreadPool& pool, CsrData& data, bool isSorted, bool noDuplicates) {
+        data.nvals = data.colIndices.size();
+
+        // Provided rows are not counted by any kernel, so they are counted here by parts
+        size_t parts = std::max<size_t>(1, std::min<size_t>(pool.getNumThreads(), data.nrows / PAR_ROWS_GRAIN));
+        std::vector<index> notEmpty(parts, 0);
+
+        pool.parallelForEach(parts, [&](size_t p) {
+            for (size_t i = data.nrows * p / parts; i < data.nrows * (p + 1) / parts; i++)
+                notEmpty[p] += data.rowOffsets[i] != data.rowOffsets[i + 1];
+        });
+
+        data.nrowsNotEmpty = 0;
+        for (auto n: notEmpty)
+            data.nrowsNotEmpty += n;
+
+        if (isSorted && noDuplicates)
+            return;
+
+        pool.parallelFor(0, data.nvals, PAR_VALUES_GRAIN, [&](size_t first, size_t last) {
+            for (size_t k = first; k < last; k++) {
+                CHECK_RAISE_ERROR(data.colIndices[k] < data.ncols, InvalidArgument, "Index out of matrix bounds");
+            }
+        });
+
+        par_compact_rows(pool, data, isSorted, noDuplicates);
+    }
+
+}
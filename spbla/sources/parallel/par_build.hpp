@@ -0,0 +1,61 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_PAR_BUILD_HPP
+#define SPBLA_PAR_BUILD_HPP
+
+#include <sequential/sq_csr_data.hpp>
+#include <utils/thread_pool.hpp>
+
+namespace spbla {
+
+    /**
+     * Build csr matrix from pairs.
+     * Each thread counts and scatters its own range of pairs, then rows are sorted and deduplicated in parallel.
+     *
+     * @param pool Pool to run computations
+     * @param rows Pairs row indices
+     * @param cols Pairs column indices
+     * @param nvals Number of pairs
+     * @param isSorted True if pairs are sorted in row-col order
+     * @param noDuplicates True if pairs have no duplicates
+     * @param[in,out] out Result (nrows and ncols must be set)
+     */
+    void par_build(ThreadPool& pool, const index* rows, const index* cols, size_t nvals,
+                   bool isSorted, bool noDuplicates, CsrData& out);
+
+    /**
+     * Sort column indices within rows and remove duplicates in place.
+     * Does nothing if values are already sorted and have no duplicates.
+     *
+     * @param pool Pool to run computations
+     * @param[in,out] data Matrix with row offsets and column indices set
+     * @param isSorted True if column indices are sorted within rows
+     * @param noDuplicates True if rows have no duplicated column indices
+     */
+    void par_normalize_rows(ThreadPool& pool, CsrData& data, bool isSorted, bool noDuplicates);
+
+}
+
+#endif //SPBLA_PAR_BUILD_HPP
@@ -0,0 +1,46 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_PAR_EWISEDIFF_HPP
+#define SPBLA_PAR_EWISEDIFF_HPP
+
+#include <sequential/sq_csr_data.hpp>
+#include <utils/thread_pool.hpp>
+
+namespace spbla {
+
+    /**
+     * Element-wise difference of the matrices `a` and `b` (values of `a`, which are not present in `b`).
+     * Rows are processed in parallel.
+     *
+     * @param pool Pool to run computations
+     * @param a Input matrix
+     * @param b Input matrix
+     * @param[out] out Where to store the result
+     */
+    void par_ewisediff(ThreadPool& pool, const CsrData& a, const CsrData& b, CsrData& out);
+
+}
+
+#endif //SPBLA_PAR_EWISEDIFF_HPP
@@ -0,0 +1,77 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <parallel/par_ewisemult.hpp>
+#include <parallel/par_utils.hpp>
+#include <sequential/sq_merge_rows.hpp>
+#include <utils/exclusive_scan.hpp>
+#include <algorithm>
+
+namespace spbla {
+
+    void par_ewisemult(ThreadPool& pool, const CsrData& a, const CsrData& b, CsrData& out) {
+        out.rowOffsets.clear();
+        out.rowOffsets.resize(a.nrows + 1, 0);
+
+        // Count exact nnz of the result matrix to allocate memory
+        pool.parallelFor(0, a.nrows, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+            for (index i = first; i < last; i++) {
+                const index* ar = a.colIndices.data() + a.rowOffsets[i];
+                const index* br = b.colIndices.data() + b.rowOffsets[i];
+                const index* arend = a.colIndices.data() + a.rowOffsets[i + 1];
+                const index* brend = b.colIndices.data() + b.rowOffsets[i + 1];
+
+                index nvalsInRow = 0;
+                sq_merge_intersect(ar, arend, br, brend, [&](const index*, size_t count) {
+                    nvalsInRow += count;
+                });
+
+                out.rowOffsets[i] = nvalsInRow;
+            }
+        });
+
+        // Eval row offsets
+        exclusive_scan_offsets(out.rowOffsets.begin(), out.rowOffsets.end(), out.nrowsNotEmpty);
+
+        // Allocate memory for values
+        out.nvals = out.rowOffsets.back();
+        out.colIndices.resize(out.nvals);
+
+        // Fill sorted column indices
+        pool.parallelFor(0, a.nrows, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+            for (index i = first; i < last; i++) {
+                const index* ar = a.colIndices.data() + a.rowOffsets[i];
+                const index* br = b.colIndices.data() + b.rowOffsets[i];
+                const index* arend = a.colIndices.data() + a.rowOffsets[i + 1];
+                const index* brend = b.colIndices.data() + b.rowOffsets[i + 1];
+
+                index* dst = out.colIndices.data() + out.rowOffsets[i];
+                sq_merge_intersect(ar, arend, br, brend, [&](const index* values, size_t count) {
+                    dst = std::copy(values, values + count, dst);
+                });
+            }
+        });
+    }
+
+}
@@ -0,0 +1,70 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <parallel/par_kronecker.hpp>
+#include <parallel/par_utils.hpp>
+#include <utils/exclusive_scan.hpp>
+
+namespace spbla {
+
+    void par_kronecker(ThreadPool& pool, const CsrData& a, const CsrData& b, CsrData& out) {
+        size_t nrows = (size_t) a.nrows * b.nrows;
+
+        out.rowOffsets.clear();
+        out.rowOffsets.resize(nrows + 1, 0);
+
+        // Row (ai, bi) of the result has nnz(ai) * nnz(bi) values
+        pool.parallelFor(0, nrows, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+            for (size_t rowId = first; rowId < last; rowId++) {
+                index ai = rowId / b.nrows;
+                index bi = rowId % b.nrows;
+
+                out.rowOffsets[rowId] = (a.rowOffsets[ai + 1] - a.rowOffsets[ai]) * (b.rowOffsets[bi + 1] - b.rowOffsets[bi]);
+            }
+        });
+
+        exclusive_scan_offsets(out.rowOffsets.begin(), out.rowOffsets.end(), out.nrowsNotEmpty);
+
+        out.nvals = out.rowOffsets.back();
+        out.colIndices.resize(out.nvals);
+
+        pool.parallelFor(0, nrows, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+            for (size_t rowId = first; rowId < last; rowId++) {
+                index ai = rowId / b.nrows;
+                index bi = rowId % b.nrows;
+                size_t id = out.rowOffsets[rowId];
+
+                for (index k = a.rowOffsets[ai]; k < a.rowOffsets[ai + 1]; k++) {
+                    index colIdBase = a.colIndices[k] * b.ncols;
+
+                    for (index l = b.rowOffsets[bi]; l < b.rowOffsets[bi + 1]; l++) {
+                        out.colIndices[id] = colIdBase + b.colIndices[l];
+                        id += 1;
+                    }
+                }
+            }
+        });
+    }
+
+}
@@ -0,0 +1,664 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <parallel/par_matrix.hpp>
+#include <parallel/par_build.hpp>
+#include <parallel/par_transpose.hpp>
+#include <parallel/par_submatrix.hpp>
+#include <parallel/par_kronecker.hpp>
+#include <parallel/par_ewiseadd.hpp>
+#include <parallel/par_ewisemult.hpp>
+#include <parallel/par_ewisediff.hpp>
+#include <parallel/par_spgemm.hpp>
+#include <parallel/par_reduce.hpp>
+#include <parallel/par_utils.hpp>
+#include <sequential/sq_spgemm_transposed.hpp>
+#include <sequential/sq_tiles.hpp>
+#include <utils/csr_utils.hpp>
+#include <core/library.hpp>
+#include <core/error.hpp>
+#include <io/tracer.hpp>
+#include <cassert>
+
+namespace spbla {
+
+    ParMatrix::ParMatrix(size_t nrows, size_t ncols) : mStorage(nrows, ncols) {
+        assert(nrows > 0);
+        assert(ncols > 0);
+    }
+
+    void ParMatrix::setElement(index i, index j) {
+        RAISE_ERROR(NotImplemented, "This function is not supported for this matrix class");
+    }
+
+    void ParMatrix::build(const index *rows, const index *cols, size_t nvals, bool isSorted, bool noDuplicates) {
+        // Few values never fill enough rows for csr storage, so they are built as dcsr
+        if (nvals * HYPERSPARSE_FACTOR < getNrows()) {
+            mStorage.build(rows, cols, nvals, isSorted, noDuplicates);
+            invalidateTransposed();
+            return;
+        }
+
+        CsrData out;
+        out.nrows = getNrows();
+        out.ncols = getNcols();
+
+        // Pairs are counted and scattered by parts, then rows are sorted and deduplicated in parallel
+        par_build(Library::getThreadPool(), rows, cols, nvals, isSorted, noDuplicates, out);
+        this->assign(std::move(out));
+    }
+
+    void ParMatrix::insert(const index *rows, const index *cols, size_t nvals) {
+        mStorage.insert(rows, cols, nvals);
+        invalidateTransposed();
+    }
+
+    void ParMatrix::buildCsr(std::vector<index> &&rowOffsets, std::vector<index> &&colIndices, bool isSorted, bool noDuplicates) {
+        // Adopt provided arrays as matrix storage, no copy is made
+        CsrData data;
+        data.nrows = getNrows();
+        data.ncols = getNcols();
+        data.rowOffsets = std::move(rowOffsets);
+        data.colIndices = std::move(colIndices);
+
+        par_normalize_rows(Library::getThreadPool(), data, isSorted, noDuplicates);
+
+        this->assign(std::move(data));
+    }
+
+    void ParMatrix::extract(index *rows, index *cols, size_t &nvals) {
+        if (mStorage.isHypersparse() || mStorage.isTiled()) {
+            mStorage.extract(rows, cols, nvals);
+            return;
+        }
+
+        assert(nvals >= getNvals());
+        nvals = getNvals();
+
+        CsrData buffer;
+        const CsrData& data = getData(buffer);
+
+        if (nvals > 0) {
+            assert(rows);
+            assert(cols);
+
+            Library::getThreadPool().parallelFor(0, getNrows(), PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+                for (index i = first; i < last; i++) {
+                    for (index k = data.rowOffsets[i]; k < data.rowOffsets[i + 1]; k++) {
+                        rows[k] = i;
+                        cols[k] = data.colIndices[k];
+                    }
+                }
+            });
+        }
+    }
+
+    void ParMatrix::extractCsr(const index* &rowOffsets, const index* &colIndices) {
+        mStorage.extractCsr(rowOffsets, colIndices);
+    }
+
+    void ParMatrix::releaseCsr() {
+        mStorage.releaseCsr();
+    }
+
+    void ParMatrix::extractSubMatrix(const MatrixBase &otherBase, index i, index j, index nrows, index ncols,
+                                     bool checkTime) {
+        auto other = dynamic_cast<const ParMatrix*>(&otherBase);
+
+        CHECK_RAISE_ERROR(other != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+        CHECK_RAISE_ERROR(other != this, InvalidArgument, "Matrices must differ");
+
+        assert(this->getNrows() == nrows);
+        assert(this->getNcols() == ncols);
+
+        // Hypersparse operands are processed by sequential dcsr kernels over their stored rows only
+        if (other->isHypersparse()) {
+            mStorage.extractSubMatrix(other->mStorage, i, j, nrows, ncols, checkTime);
+            invalidateTransposed();
+            return;
+        }
+
+        CsrData out;
+        out.nrows = this->getNrows();
+        out.ncols = this->getNcols();
+
+        // Narrow columns range is extracted from the rows of transposed data, only the result is transposed back
+        if (other->getTransposedCost() == 0 && (size_t) ncols * other->getNrows() < (size_t) nrows * other->getNcols()) {
+            CsrData buffer;
+            CsrData sub;
+            sub.nrows = ncols;
+            sub.ncols = nrows;
+            par_submatrix(Library::getThreadPool(), other->getTransposed(buffer), sub, j, i, ncols, nrows);
+            par_transpose(Library::getThreadPool(), sub, out);
+
+            this->assign(std::move(out));
+
+            if (this->mKeepTransposed && !this->isHypersparse()) {
+                this->mTransposed = std::move(sub);
+                this->mTransposedValid = true;
+            }
+
+            return;
+        }
+
+        CsrData bufferOther;
+        par_submatrix(Library::getThreadPool(), other->getData(bufferOther), out, i, j, nrows, ncols);
+
+        this->assign(std::move(out));
+    }
+
+    void ParMatrix::clone(const MatrixBase &otherBase) {
+        auto other = dynamic_cast<const ParMatrix*>(&otherBase);
+
+        CHECK_RAISE_ERROR(other != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+        CHECK_RAISE_ERROR(other != this, InvalidArgument, "Matrices must differ");
+
+        assert(other->getNrows() == this->getNrows());
+        assert(other->getNcols() == this->getNcols());
+
+        this->mStorage.clone(other->mStorage);
+        this->invalidateTransposed();
+
+        // Transposed data is copied only into the matrix, which keeps it
+        if (this->mKeepTransposed && other->mTransposedValid) {
+            this->mTransposed = other->mTransposed;
+            this->mTransposedValid = true;
+        }
+    }
+
+    void ParMatrix::transpose(const MatrixBase &otherBase, bool checkTime) {
+        auto other = dynamic_cast<const ParMatrix*>(&otherBase);
+
+        CHECK_RAISE_ERROR(other != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+
+        assert(other->getNcols() == this->getNrows());
+        assert(other->getNrows() == this->getNcols());
+
+        if (other->isHypersparse()) {
+            mStorage.transpose(other->mStorage, checkTime);
+            invalidateTransposed();
+            return;
+        }
+
+        CsrData out;
+        out.nrows = this->getNrows();
+        out.ncols = this->getNcols();
+
+        CsrData bufferOther;
+        const CsrData& data = other->getData(bufferOther);
+
+        // Transposed data of the source is copied, if it is available without sort
+        CsrData buffer;
+
+        if (other->getTransposedCost() == 0)
+            out = other->getTransposed(buffer);
+        else
+            par_transpose(Library::getThreadPool(), data, out);
+
+        // Source values are transposed data of the result
+        CsrData source = this->mKeepTransposed? data: CsrData();
+
+        this->assign(std::move(out));
+
+        if (this->mKeepTransposed && !this->isHypersparse()) {
+            this->mTransposed = std::move(source);
+            this->mTransposedValid = true;
+        }
+    }
+
+    void ParMatrix::reduce(const MatrixBase &otherBase, bool checkTime) {
+        auto other = dynamic_cast<const ParMatrix*>(&otherBase);
+
+        CHECK_RAISE_ERROR(other != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+
+        assert(other->getNrows() == this->getNrows());
+        assert(1 == this->getNcols());
+
+        if (other->isHypersparse()) {
+            mStorage.reduce(other->mStorage, checkTime);
+            invalidateTransposed();
+            return;
+        }
+
+        CsrData out;
+        out.nrows = this->getNrows();
+        out.ncols = this->getNcols();
+
+        CsrData bufferOther;
+        par_reduce(Library::getThreadPool(), other->getData(bufferOther), out);
+
+        this->assign(std::move(out));
+    }
+
+    void ParMatrix::multiply(const MatrixBase &aBase, const MatrixBase &bBase, bool accumulate, bool checkTime) {
+        auto a = dynamic_cast<const ParMatrix*>(&aBase);
+        auto b = dynamic_cast<const ParMatrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+
+        assert(a->getNcols() == b->getNrows());
+        assert(a->getNrows() == this->getNrows());
+        assert(b->getNcols() == this->getNcols());
+
+        if (a->isHypersparse() || b->isHypersparse()) {
+            mStorage.multiply(a->mStorage, b->mStorage, accumulate, checkTime);
+            invalidateTransposed();
+            return;
+        }
+
+        auto& pool = Library::getThreadPool();
+
+        // Dense operands are multiplied as bit matrices by the Four Russians method
+        if (sq_spgemm_prefer_dense(a->getNrows(), a->getNcols(), b->getNcols(), a->getNvals(), b->getNvals())) {
+            BitMatrix x, y, z;
+            sq_bits_init(a->getNrows(), a->getNcols(), x);
+            sq_bits_init(b->getNrows(), b->getNcols(), y);
+            sq_bits_init(this->getNrows(), this->getNcols(), z);
+
+            a->mStorage.fillBits(x);
+            b->mStorage.fillBits(y);
+
+            if (accumulate)
+                this->mStorage.fillBits(z);
+
+            par_spgemm_m4r(pool, x, y, z);
+
+            // Product of dense operands is dense as well, so it is stored as tiles (if it is not, storage is converted)
+            TileData out;
+            out.nrows = this->getNrows();
+            out.ncols = this->getNcols();
+            sq_tiles_from_bits(z, out);
+            this->assign(std::move(out));
+            return;
+        }
+
+        // Dense tiles are multiplied as bitmasks by the sequential tile kernel
+        if (a->isTiled() && b->isTiled()) {
+            mStorage.multiply(a->mStorage, b->mStorage, accumulate, checkTime);
+            invalidateTransposed();
+            return;
+        }
+
+        CsrData out;
+        out.nrows = this->getNrows();
+        out.ncols = this->getNcols();
+
+        CsrData bufferA;
+        CsrData bufferB;
+        const CsrData& dataA = a->getData(bufferA);
+        const CsrData& dataB = b->getData(bufferB);
+
+        if (accumulate) {
+            // Fused out = this + a x b, no temporary product is allocated
+            CsrData bufferThis;
+            par_spgemm_accumulate(pool, dataA, dataB, this->getData(bufferThis), out);
+        }
+        else {
+            par_spgemm(pool, dataA, dataB, out);
+        }
+
+        this->assign(std::move(out));
+    }
+
+    void ParMatrix::multiplyTransposed(const MatrixBase &aBase, const MatrixBase &bBase, bool transposeA, bool transposeB, bool accumulate, bool checkTime) {
+        if (!transposeA && !transposeB) {
+            multiply(aBase, bBase, accumulate, checkTime);
+            return;
+        }
+
+        auto a = dynamic_cast<const ParMatrix*>(&aBase);
+        auto b = dynamic_cast<const ParMatrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+
+        assert((transposeA? a->getNrows(): a->getNcols()) == (transposeB? b->getNcols(): b->getNrows()));
+        assert((transposeA? a->getNcols(): a->getNrows()) == this->getNrows());
+        assert((transposeB? b->getNrows(): b->getNcols()) == this->getNcols());
+
+        if (a->isHypersparse() || b->isHypersparse()) {
+            mStorage.multiplyTransposed(a->mStorage, b->mStorage, transposeA, transposeB, accumulate, checkTime);
+            invalidateTransposed();
+            return;
+        }
+
+        auto& pool = Library::getThreadPool();
+
+        CsrData out;
+        out.nrows = this->getNrows();
+        out.ncols = this->getNcols();
+
+        CsrData bufferA;
+        CsrData bufferB;
+        const CsrData& dataA = a->getData(bufferA);
+        const CsrData& dataB = b->getData(bufferB);
+
+        // Kernels add values of the matrix to the product, if accumulate is requested
+        CsrData bufferThis;
+        const CsrData* c = accumulate? &this->getData(bufferThis): nullptr;
+
+        // Operands of the Gustavson kernel, if no specialized kernel is selected
+        CsrData transposed;
+        const CsrData* left = nullptr;
+        const CsrData* right = nullptr;
+
+        if (transposeA && transposeB) {
+            // aT x bT = (b x a)T, only the result is transposed, so values of the matrix are added afterwards
+            CsrData product;
+            product.nrows = b->getNrows();
+            product.ncols = a->getNcols();
+            par_spgemm(pool, dataB, dataA, product);
+
+            if (c) {
+                CsrData productT;
+                productT.nrows = this->getNrows();
+                productT.ncols = this->getNcols();
+                par_transpose(pool, product, productT);
+                par_ewiseadd(pool, *c, productT, out);
+            }
+            else {
+                par_transpose(pool, product, out);
+            }
+        }
+        else if (transposeB) {
+            if (sq_spgemm_prefer_dot(dataA, dataB, b->getTransposedCost())) {
+                if (c)
+                    par_spgemm_dot_accumulate(pool, dataA, dataB, *c, out);
+                else
+                    par_spgemm_dot(pool, dataA, dataB, out);
+            }
+            else {
+                left = &dataA;
+                right = &b->getTransposed(transposed);
+            }
+        }
+        else {
+            if (sq_spgemm_prefer_outer(dataA, dataB, a->getTransposedCost())) {
+                if (c)
+                    par_spgemm_outer_accumulate(pool, dataA, dataB, *c, out);
+                else
+                    par_spgemm_outer(pool, dataA, dataB, out);
+            }
+            else {
+                left = &a->getTransposed(transposed);
+                right = &dataB;
+            }
+        }
+
+        if (left != nullptr) {
+            if (c) {
+                par_spgemm_accumulate(pool, *left, *right, *c, out);
+            }
+            else {
+                par_spgemm(pool, *left, *right, out);
+            }
+        }
+
+        this->assign(std::move(out));
+    }
+
+    void ParMatrix::multiplyMasked(const MatrixBase &maskBase, const MatrixBase &aBase, const MatrixBase &bBase, bool complement, bool accumulate, bool checkTime) {
+        auto mask = dynamic_cast<const ParMatrix*>(&maskBase);
+        auto a = dynamic_cast<const ParMatrix*>(&aBase);
+        auto b = dynamic_cast<const ParMatrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(mask != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+
+        assert(a->getNcols() == b->getNrows());
+        assert(a->getNrows() == this->getNrows());
+        assert(b->getNcols() == this->getNcols());
+        assert(mask->getNrows() == this->getNrows());
+        assert(mask->getNcols() == this->getNcols());
+
+        if (mask->isHypersparse() || a->isHypersparse() || b->isHypersparse()) {
+            mStorage.multiplyMasked(mask->mStorage, a->mStorage, b->mStorage, complement, accumulate, checkTime);
+            invalidateTransposed();
+            return;
+        }
+
+        auto& pool = Library::getThreadPool();
+
+        CsrData out;
+        out.nrows = this->getNrows();
+        out.ncols = this->getNcols();
+
+        CsrData bufferMask;
+        CsrData bufferA;
+        CsrData bufferB;
+
+        if (accumulate) {
+            CsrData bufferThis;
+            par_spgemm_masked_accumulate(pool, a->getData(bufferA), b->getData(bufferB), this->getData(bufferThis), mask->getData(bufferMask), complement, out);
+        }
+        else {
+            par_spgemm_masked(pool, a->getData(bufferA), b->getData(bufferB), mask->getData(bufferMask), complement, out);
+        }
+
+        this->assign(std::move(out));
+    }
+
+    void ParMatrix::kronecker(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) {
+        auto a = dynamic_cast<const ParMatrix*>(&aBase);
+        auto b = dynamic_cast<const ParMatrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+
+        assert(a->getNrows() * b->getNrows() == this->getNrows());
+        assert(a->getNcols() * b->getNcols() == this->getNcols());
+
+        if (a->isHypersparse() || b->isHypersparse()) {
+            mStorage.kronecker(a->mStorage, b->mStorage, checkTime);
+            invalidateTransposed();
+            return;
+        }
+
+        CsrData out;
+        out.nrows = this->getNrows();
+        out.ncols = this->getNcols();
+
+        CsrData bufferA;
+        CsrData bufferB;
+        par_kronecker(Library::getThreadPool(), a->getData(bufferA), b->getData(bufferB), out);
+
+        this->assign(std::move(out));
+    }
+
+    void ParMatrix::eWiseAdd(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) {
+        auto a = dynamic_cast<const ParMatrix*>(&aBase);
+        auto b = dynamic_cast<const ParMatrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+
+        assert(a->getNrows() == this->getNrows());
+        assert(a->getNcols() == this->getNcols());
+        assert(a->getNrows() == b->getNrows());
+        assert(a->getNcols() == b->getNcols());
+
+        // Tiled operands are combined word by word by the sequential tile kernels
+        if (a->isHypersparse() || b->isHypersparse() || a->isTiled() || b->isTiled()) {
+            mStorage.eWiseAdd(a->mStorage, b->mStorage, checkTime);
+            invalidateTransposed();
+            return;
+        }
+
+        CsrData out;
+        out.nrows = this->getNrows();
+        out.ncols = this->getNcols();
+
+        CsrData bufferA;
+        CsrData bufferB;
+        par_ewiseadd(Library::getThreadPool(), a->getData(bufferA), b->getData(bufferB), out);
+
+        this->assign(std::move(out));
+    }
+
+    void ParMatrix::eWiseMult(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) {
+        auto a = dynamic_cast<const ParMatrix*>(&aBase);
+        auto b = dynamic_cast<const ParMatrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+
+        assert(a->getNrows() == this->getNrows());
+        assert(a->getNcols() == this->getNcols());
+        assert(a->getNrows() == b->getNrows());
+        assert(a->getNcols() == b->getNcols());
+
+        // Tiled operands are combined word by word by the sequential tile kernels
+        if (a->isHypersparse() || b->isHypersparse() || a->isTiled() || b->isTiled()) {
+            mStorage.eWiseMult(a->mStorage, b->mStorage, checkTime);
+            invalidateTransposed();
+            return;
+        }
+
+        CsrData out;
+        out.nrows = this->getNrows();
+        out.ncols = this->getNcols();
+
+        CsrData bufferA;
+        CsrData bufferB;
+        par_ewisemult(Library::getThreadPool(), a->getData(bufferA), b->getData(bufferB), out);
+
+        this->assign(std::move(out));
+    }
+
+    void ParMatrix::eWiseDiff(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) {
+        auto a = dynamic_cast<const ParMatrix*>(&aBase);
+        auto b = dynamic_cast<const ParMatrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Provided matrix does not belongs to parallel matrix class");
+
+        assert(a->getNrows() == this->getNrows());
+        assert(a->getNcols() == this->getNcols());
+        assert(a->getNrows() == b->getNrows());
+        assert(a->getNcols() == b->getNcols());
+
+        // Tiled operands are combined word by word by the sequential tile kernels
+        if (a->isHypersparse() || b->isHypersparse() || a->isTiled() || b->isTiled()) {
+            mStorage.eWiseDiff(a->mStorage, b->mStorage, checkTime);
+            invalidateTransposed();
+            return;
+        }
+
+        CsrData out;
+        out.nrows = this->getNrows();
+        out.ncols = this->getNcols();
+
+        CsrData bufferA;
+        CsrData bufferB;
+        par_ewisediff(Library::getThreadPool(), a->getData(bufferA), b->getData(bufferB), out);
+
+        this->assign(std::move(out));
+    }
+
+    index ParMatrix::getNrows() const {
+        return mStorage.getNrows();
+    }
+
+    index ParMatrix::getNcols() const {
+        return mStorage.getNcols();
+    }
+
+    index ParMatrix::getNvals() const {
+        return mStorage.getNvals();
+    }
+
+    uint64_t ParMatrix::getStorageBytes() const {
+        return mStorage.getStorageBytes();
+    }
+
+    void ParMatrix::setKeepTransposed(bool keep) {
+        mKeepTransposed = keep;
+
+        if (!keep)
+            invalidateTransposed();
+    }
+
+    bool ParMatrix::isHypersparse() const {
+        return mStorage.isHypersparse();
+    }
+
+    bool ParMatrix::isTiled() const {
+        return mStorage.isTiled();
+    }
+
+    RowsView ParMatrix::getRows(CsrData &buffer) const {
+        return mStorage.getRows(buffer);
+    }
+
+    const CsrData &ParMatrix::getData(CsrData &buffer) const {
+        return mStorage.getData(buffer);
+    }
+
+    const CsrData &ParMatrix::getTransposed(CsrData &buffer) const {
+        if (mTransposedValid)
+            return mTransposed;
+
+        // Transposed data is stored by the matrix only on request, otherwise it lives for one operation
+        CsrData& out = mKeepTransposed? mTransposed: buffer;
+
+        TraceScope trace("par_matrix:transposed");
+        trace.arg("kept", (uint64_t) mKeepTransposed);
+
+        out = CsrData();
+        out.nrows = getNcols();
+        out.ncols = getNrows();
+
+        CsrData data;
+        par_transpose(Library::getThreadPool(), getData(data), out);
+        mTransposedValid = mKeepTransposed;
+
+        return out;
+    }
+
+    bool ParMatrix::hasTransposed() const {
+        return mTransposedValid;
+    }
+
+    size_t ParMatrix::getTransposedCost() const {
+        // Kept transposed data is built once and reused until the matrix is modified
+        return hasTransposed() || mKeepTransposed? 0: getNvals();
+    }
+
+    void ParMatrix::assign(CsrData &&data) {
+        mStorage.assign(std::move(data));
+        invalidateTransposed();
+    }
+
+    void ParMatrix::assign(TileData &&data) {
+        mStorage.assign(std::move(data));
+        invalidateTransposed();
+    }
+
+    void ParMatrix::invalidateTransposed() {
+        mTransposedValid = false;
+        mTransposed = CsrData();
+    }
+}
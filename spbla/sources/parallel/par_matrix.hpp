@@ -0,0 +1,101 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_PAR_MATRIX_HPP
+#define SPBLA_PAR_MATRIX_HPP
+
+#include <backend/matrix_base.hpp>
+#include <sequential/sq_matrix.hpp>
+
+namespace spbla {
+
+    /**
+     * Csr matrix for Cpu side operations in multithreaded backend.
+     * Values are kept in the sequential backend matrix, so its storage selection is shared:
+     * csr operands are processed by parallel kernels, hypersparse and tiled operands by sequential dcsr and tile kernels.
+     */
+    class ParMatrix final: public MatrixBase {
+    public:
+        ParMatrix(size_t nrows, size_t ncols);
+        ~ParMatrix() override = default;
+
+        void setElement(index i, index j) override;
+        void build(const index *rows, const index *cols, size_t nvals, bool isSorted, bool noDuplicates) override;
+        void insert(const index *rows, const index *cols, size_t nvals) override;
+        void buildCsr(std::vector<index> &&rowOffsets, std::vector<index> &&colIndices, bool isSorted, bool noDuplicates) override;
+        void extract(index *rows, index *cols, size_t &nvals) override;
+        void extractCsr(const index* &rowOffsets, const index* &colIndices) override;
+        void releaseCsr() override;
+        void extractSubMatrix(const MatrixBase &otherBase, index i, index j, index nrows, index ncols,
+                              bool checkTime) override;
+
+        void clone(const MatrixBase &otherBase) override;
+        void transpose(const MatrixBase &otherBase, bool checkTime) override;
+        void reduce(const MatrixBase &otherBase, bool checkTime) override;
+
+        void multiply(const MatrixBase &aBase, const MatrixBase &bBase, bool accumulate, bool checkTime) override;
+        void multiplyTransposed(const MatrixBase &aBase, const MatrixBase &bBase, bool transposeA, bool transposeB, bool accumulate, bool checkTime) override;
+        void multiplyMasked(const MatrixBase &maskBase, const MatrixBase &aBase, const MatrixBase &bBase, bool complement, bool accumulate, bool checkTime) override;
+        void kronecker(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
+        void eWiseAdd(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
+        void eWiseMult(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
+        void eWiseDiff(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
+
+        index getNrows() const override;
+        index getNcols() const override;
+        index getNvals() const override;
+        uint64_t getStorageBytes() const override;
+
+        void setKeepTransposed(bool keep) override;
+
+        /** @return True if matrix is stored as dcsr */
+        bool isHypersparse() const;
+        /** @return True if matrix is stored as tiles */
+        bool isTiled() const;
+        /** @return Rows of the matrix storage (csr or dcsr, tiles are converted into buffer) */
+        RowsView getRows(CsrData& buffer) const;
+        /** @return Csr data of the matrix (hypersparse and tiled storage is kept, its csr arrays are restored into buffer) */
+        const CsrData& getData(CsrData& buffer) const;
+        /** @return Csr data of the transposed matrix (kept until write with keep transposed hint, otherwise built into buffer) */
+        const CsrData& getTransposed(CsrData& buffer) const;
+        /** @return True if transposed data is built and valid */
+        bool hasTransposed() const;
+        /** @return Additional cost of the transposed data access (zero if it is built or kept by the matrix) */
+        size_t getTransposedCost() const;
+
+    private:
+
+        void assign(CsrData&& data);
+        void assign(TileData&& data);
+        void invalidateTransposed();
+
+        SqMatrix mStorage;
+        mutable CsrData mTransposed;
+        mutable bool mTransposedValid = false;
+        bool mKeepTransposed = false;
+    };
+
+}
+
+#endif //SPBLA_PAR_MATRIX_HPP
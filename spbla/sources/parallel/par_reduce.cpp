@@ -0,0 +1,48 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <parallel/par_reduce.hpp>
+#include <parallel/par_utils.hpp>
+#include <utils/exclusive_scan.hpp>
+
+namespace spbla {
+
+    void par_reduce(ThreadPool& pool, const CsrData& a, CsrData& out) {
+        out.rowOffsets.clear();
+        out.rowOffsets.resize(a.nrows + 1, 0);
+
+        pool.parallelFor(0, a.nrows, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+            for (index i = first; i < last; i++) {
+                out.rowOffsets[i] = a.rowOffsets[i + 1] > a.rowOffsets[i]? 1: 0;
+            }
+        });
+
+        exclusive_scan_offsets(out.rowOffsets.begin(), out.rowOffsets.end(), out.nrowsNotEmpty);
+
+        out.nvals = out.rowOffsets.back();
+        out.colIndices.clear();
+        out.colIndices.resize(out.nvals, 0);
+    }
+
+}
@@ -0,0 +1,354 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <parallel/par_spgemm.hpp>
+#include <parallel/par_utils.hpp>
+#include <sequential/sq_spgemm_accumulator.hpp>
+#include <sequential/sq_spgemm_transposed.hpp>
+#include <io/tracer.hpp>
+#include <utils/csr_utils.hpp>
+#include <utils/exclusive_scan.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace spbla {
+
+    static void splitByFlops(ThreadPool& pool, const CsrData& a, const CsrData& b, const CsrData* c, std::vector<size_t>& flops, std::vector<index>& bounds) {
+        // Estimate flops per row as sum of `b` rows lengths, referenced by row of `a`
+        flops.clear();
+        flops.resize(a.nrows + 1, 0);
+
+        pool.parallelFor(0, a.nrows, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+            for (index i = first; i < last; i++) {
+                flops[i] = SpgemmAccumulator::upperBound(a, b, c, i);
+            }
+        });
+
+        exclusive_scan(flops.begin(), flops.end(), (size_t) 0);
+
+        // Split rows into parts with approximately equal flops count (rows skew is common for graphs)
+        size_t parts = std::max<size_t>(1, std::min<size_t>(pool.getNumThreads() * ThreadPool::CHUNKS_PER_THREAD, flops.back() / PAR_VALUES_GRAIN));
+        bounds = par_split_by_work(flops, parts);
+    }
+
+    static void spgemm(ThreadPool& pool, const CsrData& a, const CsrData& b, const CsrData* c, CsrData& out) {
+        TraceScope trace("par_spgemm:estimate");
+        trace.arg("nrows", a.nrows);
+
+        std::vector<size_t> flops;
+        std::vector<index> bounds;
+        splitByFlops(pool, a, b, c, flops, bounds);
+
+        size_t numThreads = pool.getNumThreads();
+        size_t parts = bounds.size() - 1;
+
+        // Each worker has its own accumulator, reused across rows and passes
+        std::vector<SpgemmAccumulator> accumulators(numThreads);
+
+        auto process = [&](size_t p, bool fill) {
+            auto& accumulator = accumulators[ThreadPool::getWorkerId()];
+
+            // Parts events show balance of the work between threads
+            TraceScope partTrace(fill? "par_spgemm:numeric:part": "par_spgemm:symbolic:part");
+            partTrace.arg("rows", bounds[p + 1] - bounds[p]).arg("flops", flops[bounds[p + 1]] - flops[bounds[p]]);
+
+            for (index i = bounds[p]; i < bounds[p + 1]; i++) {
+                size_t upperBound = flops[i + 1] - flops[i];
+                auto kind = SpgemmAccumulator::select(a.rowOffsets[i + 1] - a.rowOffsets[i], upperBound, b.ncols);
+
+                if (fill)
+                    accumulator.fill(kind, a, b, c, i, upperBound, out.colIndices.data() + out.rowOffsets[i]);
+                else
+                    out.rowOffsets[i] = accumulator.count(kind, a, b, c, i, upperBound);
+            }
+        };
+
+        // Evaluate nnz per row
+        trace.next("par_spgemm:symbolic");
+        trace.arg("parts", parts);
+        out.rowOffsets.clear();
+        out.rowOffsets.resize(a.nrows + 1, 0);
+
+        pool.parallelForEach(parts, [&](size_t p) { process(p, false); });
+
+        // Row offsets
+        exclusive_scan_offsets(out.rowOffsets.begin(), out.rowOffsets.end(), out.nrowsNotEmpty);
+
+        out.nvals = out.rowOffsets.back();
+        out.colIndices.resize(out.nvals);
+
+        // Fill sorted column indices per row
+        trace.next("par_spgemm:numeric");
+        trace.arg("nnz", out.nvals);
+        pool.parallelForEach(parts, [&](size_t p) { process(p, true); });
+    }
+
+    void par_spgemm(ThreadPool& pool, const CsrData& a, const CsrData& b, CsrData& out) {
+        spgemm(pool, a, b, nullptr, out);
+    }
+
+    void par_spgemm_accumulate(ThreadPool& pool, const CsrData& a, const CsrData& b, const CsrData& c, CsrData& out) {
+        spgemm(pool, a, b, &c, out);
+    }
+
+
+    static void spgemmMasked(ThreadPool& pool, const CsrData& a, const CsrData& b, const CsrData* c, const CsrData& mask, bool complement, CsrData& out) {
+        TraceScope trace("par_spgemm_masked:estimate");
+        trace.arg("nrows", a.nrows);
+
+        std::vector<size_t> flops;
+        std::vector<index> bounds;
+        splitByFlops(pool, a, b, c, flops, bounds);
+
+        size_t numThreads = pool.getNumThreads();
+        size_t parts = bounds.size() - 1;
+
+        std::vector<MaskedSpgemmAccumulator> accumulators(numThreads);
+
+        // Evaluate nnz per row
+        trace.next("par_spgemm_masked:symbolic");
+        trace.arg("parts", parts);
+        out.rowOffsets.clear();
+        out.rowOffsets.resize(a.nrows + 1, 0);
+
+        pool.parallelForEach(parts, [&](size_t p) {
+            auto& accumulator = accumulators[ThreadPool::getWorkerId()];
+
+            for (index i = bounds[p]; i < bounds[p + 1]; i++)
+                out.rowOffsets[i] = accumulator.count(a, b, c, mask, complement, i);
+        });
+
+        // Row offsets
+        exclusive_scan_offsets(out.rowOffsets.begin(), out.rowOffsets.end(), out.nrowsNotEmpty);
+
+        out.nvals = out.rowOffsets.back();
+        out.colIndices.resize(out.nvals);
+
+        // Fill sorted column indices per row
+        trace.next("par_spgemm_masked:numeric");
+        trace.arg("nnz", out.nvals);
+        pool.parallelForEach(parts, [&](size_t p) {
+            auto& accumulator = accumulators[ThreadPool::getWorkerId()];
+
+            for (index i = bounds[p]; i < bounds[p + 1]; i++) {
+                if (out.rowOffsets[i] != out.rowOffsets[i + 1])
+                    accumulator.fill(a, b, c, mask, complement, i, out.colIndices.data() + out.rowOffsets[i]);
+            }
+        });
+    }
+
+    void par_spgemm_masked(ThreadPool& pool, const CsrData& a, const CsrData& b, const CsrData& mask, bool complement, CsrData& out) {
+        spgemmMasked(pool, a, b, nullptr, mask, complement, out);
+    }
+
+    void par_spgemm_masked_accumulate(ThreadPool& pool, const CsrData& a, const CsrData& b, const CsrData& c, const CsrData& mask, bool complement, CsrData& out) {
+        spgemmMasked(pool, a, b, &c, mask, complement, out);
+    }
+
+    static void spgemmDot(ThreadPool& pool, const CsrData& a, const CsrData& b, const CsrData* c, CsrData& out) {
+        TraceScope trace("par_spgemm_dot:symbolic");
+        trace.arg("nrows", a.nrows);
+
+        std::vector<index> bRows;
+        sq_spgemm_dot_rows(b, bRows);
+
+        out.rowOffsets.clear();
+        out.rowOffsets.resize(a.nrows + 1, 0);
+
+        pool.parallelFor(0, a.nrows, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+            for (index i = first; i < last; i++)
+                out.rowOffsets[i] = sq_spgemm_dot_row(a, b, c, bRows, i, nullptr);
+        });
+
+        exclusive_scan_offsets(out.rowOffsets.begin(), out.rowOffsets.end(), out.nrowsNotEmpty);
+
+        out.nvals = out.rowOffsets.back();
+        out.colIndices.resize(out.nvals);
+
+        trace.next("par_spgemm_dot:numeric");
+        trace.arg("nnz", out.nvals);
+
+        pool.parallelFor(0, a.nrows, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+            for (index i = first; i < last; i++)
+                sq_spgemm_dot_row(a, b, c, bRows, i, out.colIndices.data() + out.rowOffsets[i]);
+        });
+    }
+
+    void par_spgemm_dot(ThreadPool& pool, const CsrData& a, const CsrData& b, CsrData& out) {
+        spgemmDot(pool, a, b, nullptr, out);
+    }
+
+    void par_spgemm_dot_accumulate(ThreadPool& pool, const CsrData& a, const CsrData& b, const CsrData& c, CsrData& out) {
+        spgemmDot(pool, a, b, &c, out);
+    }
+
+    static void spgemmOuter(ThreadPool& pool, const CsrData& a, const CsrData& b, const CsrData* c, CsrData& out) {
+        TraceScope trace("par_spgemm_outer:histogram");
+        trace.arg("nrows", a.ncols);
+
+        size_t nrows = a.ncols;
+
+        // Split rows of `a` and `b` into parts with approximately equal number of products
+        std::vector<size_t> work(a.nrows + 1, 0);
+
+        pool.parallelFor(0, a.nrows, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+            for (size_t k = first; k < last; k++)
+                work[k] = (size_t) (a.rowOffsets[k + 1] - a.rowOffsets[k]) * (size_t) (b.rowOffsets[k + 1] - b.rowOffsets[k]);
+        });
+
+        exclusive_scan(work.begin(), work.end(), (size_t) 0);
+
+        size_t parts = std::max<size_t>(1, std::min<size_t>(pool.getNumThreads(), work.back() / PAR_VALUES_GRAIN));
+        std::vector<index> bounds = par_split_by_work(work, parts);
+
+        // Per part number of products of the result rows
+        std::vector<std::vector<size_t>> offsets(parts);
+
+        pool.parallelForEach(parts, [&](size_t p) {
+            offsets[p].resize(nrows, 0);
+
+            for (index k = bounds[p]; k < bounds[p + 1]; k++) {
+                size_t length = b.rowOffsets[k + 1] - b.rowOffsets[k];
+
+                for (index ak = a.rowOffsets[k]; ak < a.rowOffsets[k + 1]; ak++)
+                    offsets[p][a.colIndices[ak]] += length;
+            }
+        });
+
+        // Row starts with the seed row, part p writes its products after parts [0, p)
+        trace.next("par_spgemm_outer:scan");
+        std::vector<size_t> rowOffsets(nrows + 1, 0);
+
+        pool.parallelFor(0, nrows, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) {
+                size_t offset = c? c->rowOffsets[i + 1] - c->rowOffsets[i]: 0;
+
+                for (size_t p = 0; p < parts; p++) {
+                    size_t count = offsets[p][i];
+                    offsets[p][i] = offset;
+                    offset += count;
+                }
+
+                rowOffsets[i] = offset;
+            }
+        });
+
+        exclusive_scan(rowOffsets.begin(), rowOffsets.end(), (size_t) 0);
+
+        trace.next("par_spgemm_outer:scatter");
+        trace.arg("products", rowOffsets.back());
+        std::vector<index> products(rowOffsets.back());
+
+        if (c) {
+            pool.parallelFor(0, nrows, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; i++)
+                    std::copy(c->colIndices.begin() + c->rowOffsets[i], c->colIndices.begin() + c->rowOffsets[i + 1], products.begin() + rowOffsets[i]);
+            });
+        }
+
+        pool.parallelForEach(parts, [&](size_t p) {
+            auto& writeOffsets = offsets[p];
+
+            for (index k = bounds[p]; k < bounds[p + 1]; k++) {
+                const index* bFirst = b.colIndices.data() + b.rowOffsets[k];
+                const index* bLast = b.colIndices.data() + b.rowOffsets[k + 1];
+
+                for (index ak = a.rowOffsets[k]; ak < a.rowOffsets[k + 1]; ak++) {
+                    index i = a.colIndices[ak];
+                    std::copy(bFirst, bLast, products.begin() + rowOffsets[i] + writeOffsets[i]);
+                    writeOffsets[i] += bLast - bFirst;
+                }
+            }
+        });
+
+        // Accumulate products of each row, result rows are split by the number of products
+        trace.next("par_spgemm_outer:accumulate");
+        size_t rowParts = std::max<size_t>(1, std::min<size_t>(pool.getNumThreads() * ThreadPool::CHUNKS_PER_THREAD, rowOffsets.back() / PAR_VALUES_GRAIN));
+        std::vector<index> rowBounds = par_split_by_work(rowOffsets, rowParts);
+        std::vector<size_t> written(rowParts, 0);
+
+        out.rowOffsets.clear();
+        out.rowOffsets.resize(nrows + 1, 0);
+
+        pool.parallelForEach(rowParts, [&](size_t p) {
+            std::vector<index> buffer;
+
+            for (index i = rowBounds[p]; i < rowBounds[p + 1]; i++) {
+                index* first = products.data() + rowOffsets[i];
+                index* last = products.data() + rowOffsets[i + 1];
+
+                CsrUtils::sortIndices(first, last, buffer);
+                out.rowOffsets[i] = (index) (std::unique(first, last) - first);
+                written[p] += out.rowOffsets[i];
+            }
+        });
+
+        size_t nvals = 0;
+        for (auto count: written)
+            nvals += count;
+
+        CHECK_RAISE_ERROR(nvals <= std::numeric_limits<index>::max(), IndexOverflow, "Number of values of the result exceeds spbla_Index range");
+
+        exclusive_scan_offsets(out.rowOffsets.begin(), out.rowOffsets.end(), out.nrowsNotEmpty);
+
+        out.nvals = out.rowOffsets.back();
+        out.colIndices.resize(out.nvals);
+
+        pool.parallelForEach(rowParts, [&](size_t p) {
+            for (index i = rowBounds[p]; i < rowBounds[p + 1]; i++) {
+                auto first = products.begin() + rowOffsets[i];
+                std::copy(first, first + (out.rowOffsets[i + 1] - out.rowOffsets[i]), out.colIndices.begin() + out.rowOffsets[i]);
+            }
+        });
+    }
+
+    void par_spgemm_outer(ThreadPool& pool, const CsrData& a, const CsrData& b, CsrData& out) {
+        spgemmOuter(pool, a, b, nullptr, out);
+    }
+
+    void par_spgemm_outer_accumulate(ThreadPool& pool, const CsrData& a, const CsrData& b, const CsrData& c, CsrData& out) {
+        spgemmOuter(pool, a, b, &c, out);
+    }
+
+    void par_spgemm_m4r(ThreadPool& pool, const BitMatrix& a, const BitMatrix& b, BitMatrix& out) {
+        TraceScope trace("par_spgemm_m4r");
+        trace.arg("nrows", a.nrows);
+
+        size_t tableWords = DENSE_TABLE_SIZE * b.stride;
+        std::vector<uint64_t> tables(DENSE_GROUPS_IN_WORD * tableWords);
+
+        for (size_t w = 0; w < a.stride; w++) {
+            pool.parallelForEach(DENSE_GROUPS_IN_WORD, [&](size_t g) {
+                size_t first = w * 64 + g * DENSE_GROUP_BITS;
+                if (first < b.nrows)
+                    sq_m4r_table(b, (index) first, tables.data() + g * tableWords);
+            });
+
+            pool.parallelFor(0, a.nrows, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+                sq_m4r_rows(a, tables.data(), w, (index) first, (index) last, out);
+            });
+        }
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_PAR_SPGEMM_HPP
+#define SPBLA_PAR_SPGEMM_HPP
+
+#include <sequential/sq_csr_data.hpp>
+#include <sequential/sq_spgemm_dense.hpp>
+#include <utils/thread_pool.hpp>
+
+namespace spbla {
+
+    /**
+     * Matrix-matrix multiplication of `a` and `b` (rows are processed in parallel).
+     *
+     * @param pool Pool to run computations
+     * @param a Input matrix
+     * @param b Input matrix
+     * @param[out] out Where to store result
+     */
+    void par_spgemm(ThreadPool& pool, const CsrData& a, const CsrData& b, CsrData& out);
+
+    /**
+     * Fused matrix-matrix multiplication and addition out = c + a x b (rows are processed in parallel).
+     *
+     * @param pool Pool to run computations
+     * @param a Input matrix
+     * @param b Input matrix
+     * @param c Input matrix to add
+     * @param[out] out Where to store result (must differ from inputs)
+     */
+    void par_spgemm_accumulate(ThreadPool& pool, const CsrData& a, const CsrData& b, const CsrData& c, CsrData& out);
+
+    /**
+     * Masked matrix-matrix multiplication out<mask> = a x b (rows are processed in parallel).
+     *
+     * @param pool Pool to run computations
+     * @param a Input matrix
+     * @param b Input matrix
+     * @param mask Mask matrix (same shape as result)
+     * @param complement True to use structural complement of the mask
+     * @param[out] out Where to store result
+     */
+    void par_spgemm_masked(ThreadPool& pool, const CsrData& a, const CsrData& b, const CsrData& mask, bool complement, CsrData& out);
+
+    /**
+     * Fused masked matrix-matrix multiplication and addition out = c + (a x b)<mask> (rows are processed in parallel).
+     *
+     * @param pool Pool to run computations
+     * @param a Input matrix
+     * @param b Input matrix
+     * @param c Input matrix to add
+     * @param mask Mask matrix (same shape as result)
+     * @param complement True to use structural complement of the mask
+     * @param[out] out Where to store result (must differ from inputs)
+     */
+    void par_spgemm_masked_accumulate(ThreadPool& pool, const CsrData& a, const CsrData& b, const CsrData& c, const CsrData& mask, bool complement, CsrData& out);
+
+    /**
+     * Matrix-matrix multiplication out = a x bT by sparse dot products of the rows (rows are processed in parallel).
+     *
+     * @param pool Pool to run computations
+     * @param a Input matrix
+     * @param b Input matrix (product uses transposed `b`)
+     * @param[out] out Where to store result
+     */
+    void par_spgemm_dot(ThreadPool& pool, const CsrData& a, const CsrData& b, CsrData& out);
+
+    /**
+     * Fused matrix-matrix multiplication and addition out = c + a x bT by sparse dot products (rows are processed in parallel).
+     *
+     * @param pool Pool to run computations
+     * @param a Input matrix
+     * @param b Input matrix (product uses transposed `b`)
+     * @param c Input matrix to add
+     * @param[out] out Where to store result (must differ from inputs)
+     */
+    void par_spgemm_dot_accumulate(ThreadPool& pool, const CsrData& a, const CsrData& b, const CsrData& c, CsrData& out);
+
+    /**
+     * Matrix-matrix multiplication out = aT x b by accumulation of the outer products
+     * (products are scattered by parts of the rows of `a` and `b`, then result rows are accumulated in parallel).
+     *
+     * @param pool Pool to run computations
+     * @param a Input matrix (product uses transposed `a`)
+     * @param b Input matrix
+     * @param[out] out Where to store result
+     */
+    void par_spgemm_outer(ThreadPool& pool, const CsrData& a, const CsrData& b, CsrData& out);
+
+    /**
+     * Fused matrix-matrix multiplication and addition out = c + aT x b by accumulation of the outer products (in parallel).
+     *
+     * @param pool Pool to run computations
+     * @param a Input matrix (product uses transposed `a`)
+     * @param b Input matrix
+     * @param c Input matrix to add
+     * @param[out] out Where to store result (must differ from inputs)
+     */
+    void par_spgemm_outer_accumulate(ThreadPool& pool, const CsrData& a, const CsrData& b, const CsrData& c, CsrData& out);
+
+    /**
+     * Matrix-matrix multiplication out += a x b of dense bit matrices by the Method of Four Russians
+     * (lookup tables of each word of `a` rows are built in parallel, then rows are processed in parallel).
+     *
+     * @param pool Pool to run computations
+     * @param a Input matrix
+     * @param b Input matrix
+     * @param[out] out Where to accumulate result (allocated by caller, may contain values to add)
+     */
+    void par_spgemm_m4r(ThreadPool& pool, const BitMatrix& a, const BitMatrix& b, BitMatrix& out);
+
+}
+
+#endif //SPBLA_PAR_SPGEMM_HPP
@@ -0,0 +1,178 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <parallel/par_spmv.hpp>
+#include <parallel/par_utils.hpp>
+#include <sequential/sq_spmv.hpp>
+#include <utils/bits.hpp>
+#include <algorithm>
+#include <atomic>
+
+namespace spbla {
+
+    namespace {
+
+        /** Concatenate per-part results (parts are ordered) */
+        void concat(const std::vector<std::vector<index>>& parts, VecData& out) {
+            size_t total = 0;
+            for (auto& part: parts)
+                total += part.size();
+
+            out.indices.reserve(total);
+            for (auto& part: parts)
+                out.indices.insert(out.indices.end(), part.begin(), part.end());
+
+            out.nvals = out.indices.size();
+        }
+
+    }
+
+    void par_spmv_pull(ThreadPool& pool, const CsrData& a, const VecData& v, const VecData* mask, bool complement, VecData& out) {
+        out.indices.clear();
+        out.nvals = 0;
+
+        if (v.nvals == 0 || a.nvals == 0 || (mask && !complement && mask->nvals == 0))
+            return;
+
+        DenseBitset frontier(v.nrows);
+        frontier.set(v);
+
+        DenseBitset masked(mask && complement? a.nrows: 0);
+
+        if (mask && complement)
+            masked.set(*mask);
+
+        auto hasHit = [&](index i) {
+            for (index k = a.rowOffsets[i]; k < a.rowOffsets[i + 1]; k++) {
+                if (frontier.test(a.colIndices[k]))
+                    return true;
+            }
+            return false;
+        };
+
+        // Candidates are either mask rows or all rows of the matrix
+        bool byMask = mask && !complement;
+        size_t candidates = byMask? mask->nvals: a.nrows;
+        size_t partsCount = std::min(pool.getNumThreads() * ThreadPool::CHUNKS_PER_THREAD,
+                                     (candidates + PAR_ROWS_GRAIN - 1) / PAR_ROWS_GRAIN);
+
+        std::vector<std::vector<index>> parts(partsCount);
+
+        pool.parallelForEach(partsCount, [&](size_t p) {
+            size_t first = candidates * p / partsCount;
+            size_t last = candidates * (p + 1) / partsCount;
+            auto& result = parts[p];
+
+            for (size_t k = first; k < last; k++) {
+                index i = byMask? mask->indices[k]: (index) k;
+
+                if (mask && complement && masked.test(i))
+                    continue;
+                if (hasHit(i))
+                    result.push_back(i);
+            }
+        });
+
+        concat(parts, out);
+    }
+
+    void par_spmv_push(ThreadPool& pool, const CsrData& a, const VecData& v, const VecData* mask, bool complement, VecData& out) {
+        out.indices.clear();
+        out.nvals = 0;
+
+        if (v.nvals == 0 || a.nvals == 0 || (mask && !complement && mask->nvals == 0))
+            return;
+
+        const size_t BITS_IN_WORD = 64;
+
+        DenseBitset masked(mask? a.ncols: 0);
+
+        if (mask)
+            masked.set(*mask);
+
+        std::vector<std::atomic<uint64_t>> result((a.ncols + BITS_IN_WORD - 1) / BITS_IN_WORD);
+
+        for (auto& word: result)
+            word.store(0, std::memory_order_relaxed);
+
+        // Frontier is split by the number of scattered values
+        std::vector<size_t> work(v.nvals + 1, 0);
+        for (size_t k = 0; k < v.nvals; k++) {
+            index i = v.indices[k];
+            work[k + 1] = work[k] + a.rowOffsets[i + 1] - a.rowOffsets[i];
+        }
+
+        size_t partsCount = std::min(pool.getNumThreads() * ThreadPool::CHUNKS_PER_THREAD,
+                                     (work.back() + PAR_VALUES_GRAIN - 1) / PAR_VALUES_GRAIN);
+        auto bounds = par_split_by_work(work, std::max(partsCount, (size_t) 1));
+
+        std::vector<std::vector<index>> parts(bounds.size() - 1);
+
+        pool.parallelForEach(parts.size(), [&](size_t p) {
+            auto& found = parts[p];
+
+            for (index k = bounds[p]; k < bounds[p + 1]; k++) {
+                index i = v.indices[k];
+
+                for (index t = a.rowOffsets[i]; t < a.rowOffsets[i + 1]; t++) {
+                    index j = a.colIndices[t];
+
+                    if (mask && masked.test(j) == complement)
+                        continue;
+
+                    uint64_t bit = 1ull << (j % BITS_IN_WORD);
+                    auto& word = result[j / BITS_IN_WORD];
+
+                    if ((word.load(std::memory_order_relaxed) & bit) == 0 &&
+                        (word.fetch_or(bit, std::memory_order_relaxed) & bit) == 0)
+                        found.push_back(j);
+                }
+            }
+        });
+
+        size_t total = 0;
+        for (auto& part: parts)
+            total += part.size();
+
+        // Short result is sorted, long one is collected from the bitset in order
+        if (total * BITS_IN_WORD < a.ncols) {
+            concat(parts, out);
+            std::sort(out.indices.begin(), out.indices.end());
+        }
+        else {
+            out.indices.reserve(total);
+
+            for (size_t w = 0; w < result.size(); w++) {
+                uint64_t word = result[w].load(std::memory_order_relaxed);
+                while (word) {
+                    out.indices.push_back((index) (w * BITS_IN_WORD + lowestBit(word)));
+                    word &= word - 1;
+                }
+            }
+
+            out.nvals = out.indices.size();
+        }
+    }
+
+}
@@ -0,0 +1,74 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <parallel/par_submatrix.hpp>
+#include <parallel/par_utils.hpp>
+#include <utils/exclusive_scan.hpp>
+#include <algorithm>
+
+namespace spbla {
+
+    void par_submatrix(ThreadPool& pool, const CsrData& a, CsrData& sub, index i, index j, index nrows, index ncols) {
+        sub.rowOffsets.clear();
+        sub.rowOffsets.resize(nrows + 1, 0);
+
+        // Columns of the row are sorted, so the range [j, j + ncols) is found with binary search
+        auto findRange = [&](index ai, const index*& first, const index*& last) {
+            const index* begin = a.colIndices.data() + a.rowOffsets[ai];
+            const index* end = a.colIndices.data() + a.rowOffsets[ai + 1];
+
+            first = std::lower_bound(begin, end, j);
+            last = std::lower_bound(first, end, j + ncols);
+        };
+
+        pool.parallelFor(0, nrows, PAR_ROWS_GRAIN, [&](size_t firstRow, size_t lastRow) {
+            for (index ri = firstRow; ri < lastRow; ri++) {
+                const index* first;
+                const index* last;
+                findRange(i + ri, first, last);
+
+                sub.rowOffsets[ri] = (index)(last - first);
+            }
+        });
+
+        exclusive_scan_offsets(sub.rowOffsets.begin(), sub.rowOffsets.end(), sub.nrowsNotEmpty);
+
+        sub.nvals = sub.rowOffsets.back();
+        sub.colIndices.resize(sub.nvals);
+
+        pool.parallelFor(0, nrows, PAR_ROWS_GRAIN, [&](size_t firstRow, size_t lastRow) {
+            for (index ri = firstRow; ri < lastRow; ri++) {
+                const index* first;
+                const index* last;
+                findRange(i + ri, first, last);
+
+                index* dst = sub.colIndices.data() + sub.rowOffsets[ri];
+
+                while (first != last)
+                    *(dst++) = *(first++) - j;
+            }
+        });
+    }
+
+}
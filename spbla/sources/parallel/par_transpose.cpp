@@ -0,0 +1,98 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <parallel/par_transpose.hpp>
+#include <parallel/par_utils.hpp>
+#include <io/tracer.hpp>
+#include <utils/exclusive_scan.hpp>
+#include <algorithm>
+
+namespace spbla {
+
+    void par_transpose(ThreadPool& pool, const CsrData& a, CsrData& at) {
+        TraceScope trace("par_transpose:histogram");
+        trace.arg("nnz", a.nvals);
+
+        // Split rows into parts with approximately equal nnz count
+        size_t parts = std::max<size_t>(1, std::min<size_t>(pool.getNumThreads(), a.nvals / PAR_VALUES_GRAIN));
+        std::vector<index> partRows(parts + 1, a.nrows);
+        partRows[0] = 0;
+
+        for (size_t p = 1; p < parts; p++) {
+            auto bound = (index) (a.nvals * p / parts);
+            partRows[p] = (index) (std::upper_bound(a.rowOffsets.begin(), a.rowOffsets.end(), bound) - a.rowOffsets.begin() - 1);
+        }
+
+        // Per part histogram of columns
+        std::vector<std::vector<index>> offsets(parts);
+
+        pool.parallelForEach(parts, [&](size_t p) {
+            offsets[p].resize(a.ncols, 0);
+
+            for (size_t k = a.rowOffsets[partRows[p]]; k < a.rowOffsets[partRows[p + 1]]; k++) {
+                offsets[p][a.colIndices[k]]++;
+            }
+        });
+
+        trace.next("par_transpose:scan");
+        at.rowOffsets.clear();
+        at.rowOffsets.resize(a.ncols + 1, 0);
+        at.colIndices.resize(a.nvals);
+        at.nvals = a.nvals;
+
+        pool.parallelFor(0, a.ncols, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+            for (size_t j = first; j < last; j++) {
+                for (size_t p = 0; p < parts; p++)
+                    at.rowOffsets[j] += offsets[p][j];
+            }
+        });
+
+        exclusive_scan_offsets(at.rowOffsets.begin(), at.rowOffsets.end(), at.nrowsNotEmpty);
+
+        // Part p writes its values of the column j after values of parts [0, p), so rows stay sorted
+        trace.next("par_transpose:scatter");
+        pool.parallelFor(0, a.ncols, PAR_ROWS_GRAIN, [&](size_t first, size_t last) {
+            for (size_t j = first; j < last; j++) {
+                index offset = at.rowOffsets[j];
+
+                for (size_t p = 0; p < parts; p++) {
+                    index count = offsets[p][j];
+                    offsets[p][j] = offset;
+                    offset += count;
+                }
+            }
+        });
+
+        pool.parallelForEach(parts, [&](size_t p) {
+            auto& writeOffsets = offsets[p];
+
+            for (index i = partRows[p]; i < partRows[p + 1]; i++) {
+                for (size_t k = a.rowOffsets[i]; k < a.rowOffsets[i + 1]; k++) {
+                    at.colIndices[writeOffsets[a.colIndices[k]]++] = i;
+                }
+            }
+        });
+    }
+
+}
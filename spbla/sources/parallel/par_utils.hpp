@@ -0,0 +1,128 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_PAR_UTILS_HPP
+#define SPBLA_PAR_UTILS_HPP
+
+#include <core/config.hpp>
+#include <utils/thread_pool.hpp>
+#include <utils/exclusive_scan.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace spbla {
+
+    /** Min number of matrix rows processed by single parallel task */
+    static const size_t PAR_ROWS_GRAIN = 256;
+
+    /** Min number of values processed by single parallel task */
+    static const size_t PAR_VALUES_GRAIN = 4096;
+
+    /**
+     * Split rows into `parts` consecutive ranges with approximately equal total work.
+     *
+     * @param prefix Exclusive prefix sum of per-row work (size is rows count + 1)
+     * @param parts Number of ranges to split into
+     *
+     * @return Ranges bounds, where range p is [bounds[p], bounds[p + 1])
+     */
+    template<typename T>
+    inline std::vector<index> par_split_by_work(const std::vector<T>& prefix, size_t parts) {
+        auto nrows = (index) (prefix.size() - 1);
+        auto total = prefix.back();
+
+        std::vector<index> bounds(parts + 1, nrows);
+        bounds[0] = 0;
+
+        for (size_t p = 1; p < parts; p++) {
+            auto target = (T) (total / parts * p + total % parts * p / parts);
+            bounds[p] = (index) (std::upper_bound(prefix.begin(), prefix.end(), target) - prefix.begin() - 1);
+        }
+
+        return bounds;
+    }
+
+    /**
+     * Exclusive prefix sum of the values in place.
+     * Values are split into blocks: blocks sums are evaluated in parallel,
+     * scanned serially, and then each block is scanned in parallel from its base.
+     *
+     * @param pool Pool to run computations
+     * @param values Values to scan
+     *
+     * @return Number of not zero values (number of not empty rows, if values are row sizes)
+     */
+    template<typename T>
+    inline size_t par_exclusive_scan(ThreadPool& pool, std::vector<T>& values) {
+        size_t count = values.size();
+        size_t blocks = std::max<size_t>(1, std::min<size_t>(pool.getNumThreads(), count / PAR_VALUES_GRAIN));
+
+        if (blocks <= 1) {
+            size_t notZero = 0;
+            T sum = 0;
+
+            for (auto& value: values) {
+                T next = sum + value;
+                notZero += value != 0;
+                value = sum;
+                sum = next;
+            }
+
+            return notZero;
+        }
+
+        size_t step = (count + blocks - 1) / blocks;
+        std::vector<T> sums(blocks, 0);
+        std::vector<size_t> notZero(blocks, 0);
+
+        pool.parallelForEach(blocks, [&](size_t b) {
+            size_t last = std::min(count, (b + 1) * step);
+            T sum = 0;
+
+            for (size_t k = b * step; k < last; k++) {
+                sum += values[k];
+                notZero[b] += values[k] != 0;
+            }
+
+            sums[b] = sum;
+        });
+
+        exclusive_scan(sums.begin(), sums.end(), (T) 0);
+
+        pool.parallelForEach(blocks, [&](size_t b) {
+            size_t last = std::min(count, (b + 1) * step);
+            exclusive_scan(values.begin() + b * step, values.begin() + last, sums[b]);
+        });
+
+        size_t total = 0;
+        for (auto n: notZero)
+            total += n;
+
+        return total;
+    }
+
+}
+
+#endif //SPBLA_PAR_UTILS_HPP
@@ -0,0 +1,60 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_PAR_VECTOR_HPP
+#define SPBLA_PAR_VECTOR_HPP
+
+#include <backend/vector_base.hpp>
+#include <sequential/sq_vec_data.hpp>
+
+namespace spbla {
+
+    /**
+     * Sparse vector for Cpu side operations in multithreaded backend.
+     */
+    class ParVector final: public VectorBase {
+    public:
+        explicit ParVector(size_t nrows);
+        ~ParVector() override = default;
+
+        void build(const index *rows, size_t nvals, bool isSorted, bool noDuplicates) override;
+        void extract(index *rows, size_t &nvals) override;
+        void clone(const VectorBase &otherBase) override;
+
+        void multiplyMxV(const MatrixBase &mBase, const VectorBase &vBase, const VectorBase *maskBase, bool complement, bool checkTime) override;
+        void multiplyVxM(const VectorBase &vBase, const MatrixBase &mBase, const VectorBase *maskBase, bool complement, bool checkTime) override;
+
+        index getNrows() const override;
+        index getNvals() const override;
+
+        /** @return Sorted indices of the vector values */
+        const VecData& getData() const;
+
+    private:
+        VecData mData;
+    };
+
+}
+
+#endif //SPBLA_PAR_VECTOR_HPP
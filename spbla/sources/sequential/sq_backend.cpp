@@ -24,6 +24,7 @@
 
 #include <sequential/sq_backend.hpp>
 #include <sequential/sq_matrix.hpp>
+#include <sequential/sq_vector.hpp>
 #include <core/library.hpp>
 #include <io/logger.hpp>
 #include <cassert>
@@ -37,12 +38,19 @@ namespace spbla {
 
     void SqBackend::finalize() {
         assert(mMatCount == 0);
+        assert(mVecCount == 0);
 
         if (mMatCount > 0) {
             LogStream stream(*Library::getLogger());
             stream << Logger::Level::Error
                    << "Lost some (" << mMatCount << ") matrix objects" << LogStream::cmt;
         }
+
+        if (mVecCount > 0) {
+            LogStream stream(*Library::getLogger());
+            stream << Logger::Level::Error
+                   << "Lost some (" << mVecCount << ") vector objects" << LogStream::cmt;
+        }
     }
 
     bool SqBackend::isInitialized() const {
@@ -59,6 +67,16 @@ namespace spbla {
         delete matrixBase;
     }
 
+    VectorBase *SqBackend::createVector(size_t nrows) {
+        mVecCount++;
+        return new SqVector(nrows);
+    }
+
+    void SqBackend::releaseVector(VectorBase *vectorBase) {
+        mVecCount--;
+        delete vectorBase;
+    }
+
     void SqBackend::queryCapabilities(spbla_DeviceCaps &caps) {
         caps.cudaSupported = false;
     }
@@ -42,11 +42,14 @@ namespace spbla {
 
         MatrixBase *createMatrix(size_t nrows, size_t ncols) override;
         void releaseMatrix(MatrixBase *matrixBase) override;
+        VectorBase *createVector(size_t nrows) override;
+        void releaseVector(VectorBase *vectorBase) override;
 
         void queryCapabilities(spbla_DeviceCaps& caps) override;
 
     private:
         size_t mMatCount = 0;
+        size_t mVecCount = 0;
     };
 
 }
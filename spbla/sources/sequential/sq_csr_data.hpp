@@ -37,6 +37,8 @@ namespace spbla {
         index nrows = 0;
         index ncols = 0;
         index nvals = 0;
+        /** Number of not empty rows, reported by the kernel which filled the data */
+        index nrowsNotEmpty = 0;
     };
 
 }
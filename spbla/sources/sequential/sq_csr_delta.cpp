@@ -0,0 +1,172 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <sequential/sq_csr_delta.hpp>
+#include <algorithm>
+#include <cassert>
+
+namespace spbla {
+
+    void CsrDelta::insert(const CsrData &data, const index *rows, const index *cols, size_t nvals) {
+        assert(data.rowOffsets.size() == data.nrows + 1);
+
+        std::vector<std::pair<index, index>> values;
+        values.reserve(nvals);
+
+        // Skip values, already present in the matrix
+        for (size_t k = 0; k < nvals; k++) {
+            const index* first = data.colIndices.data() + data.rowOffsets[rows[k]];
+            const index* last = data.colIndices.data() + data.rowOffsets[rows[k] + 1];
+
+            if (!std::binary_search(first, last, cols[k]))
+                values.emplace_back(rows[k], cols[k]);
+        }
+
+        if (values.empty())
+            return;
+
+        if (mValues.empty()) {
+            mValues = std::move(values);
+            return;
+        }
+
+        // Both lists are sorted, merge and drop values inserted twice
+        std::vector<std::pair<index, index>> merged(mValues.size() + values.size());
+        auto end = std::set_union(mValues.begin(), mValues.end(), values.begin(), values.end(), merged.begin());
+        merged.resize(end - merged.begin());
+
+        mValues = std::move(merged);
+    }
+
+    void CsrDelta::compact(CsrData &data) {
+        assert(data.rowOffsets.size() == data.nrows + 1);
+
+        size_t k = mValues.size();
+
+        if (k == 0)
+            return;
+
+        data.colIndices.resize(data.nvals + k);
+        index* colIndices = data.colIndices.data();
+
+        // Rows are merged in place from the last one: every row after the first affected one
+        // is shifted by the number of values inserted before it, rows before it are not touched
+        for (index i = data.nrows; i > 0 && k > 0; i--) {
+            index row = i - 1;
+            size_t kb = k;
+
+            while (kb > 0 && mValues[kb - 1].first == row)
+                kb--;
+
+            index begin = data.rowOffsets[row];
+            index end = data.rowOffsets[row + 1];
+
+            // Row is shifted by the number of values inserted in the previous rows
+            data.rowOffsets[row + 1] = end + (index) k;
+
+            // Row gets its first values
+            data.nrowsNotEmpty += begin == end && kb < k;
+
+            size_t out = end + k;
+            size_t a = end;
+            size_t b = k;
+
+            while (b > kb) {
+                index j = mValues[b - 1].second;
+
+                if (a > begin && colIndices[a - 1] > j) {
+                    colIndices[--out] = colIndices[--a];
+                }
+                else {
+                    colIndices[--out] = j;
+                    b--;
+                }
+            }
+
+            if (kb > 0)
+                std::copy_backward(colIndices + begin, colIndices + a, colIndices + out);
+
+            k = kb;
+        }
+
+        data.nvals += mValues.size();
+        mValues.clear();
+    }
+
+    void CsrDelta::merge(const CsrData &data, CsrData &out) const {
+        assert(data.rowOffsets.size() == data.nrows + 1);
+
+        out.nrows = data.nrows;
+        out.ncols = data.ncols;
+        out.nvals = data.nvals + mValues.size();
+        out.nrowsNotEmpty = 0;
+        out.rowOffsets.clear();
+        out.rowOffsets.resize(data.nrows + 1, 0);
+        out.colIndices.clear();
+        out.colIndices.reserve(out.nvals);
+
+        const index* colIndices = data.colIndices.data();
+        size_t k = 0;
+
+        // Single forward pass: rows without buffered values are copied as is
+        for (index i = 0; i < data.nrows; i++) {
+            auto a = colIndices + data.rowOffsets[i];
+            auto aEnd = colIndices + data.rowOffsets[i + 1];
+
+            while (k < mValues.size() && mValues[k].first == i) {
+                index j = mValues[k].second;
+
+                while (a != aEnd && *a < j)
+                    out.colIndices.push_back(*(a++));
+
+                out.colIndices.push_back(j);
+                k++;
+            }
+
+            out.colIndices.insert(out.colIndices.end(), a, aEnd);
+            out.rowOffsets[i + 1] = (index) out.colIndices.size();
+            out.nrowsNotEmpty += out.rowOffsets[i] != out.rowOffsets[i + 1];
+        }
+
+        assert(k == mValues.size());
+        assert(out.colIndices.size() == out.nvals);
+    }
+
+    bool CsrDelta::needsCompaction(const CsrData &data) const {
+        return mValues.size() * COMPACT_FACTOR >= data.nvals;
+    }
+
+    void CsrDelta::clear() {
+        mValues.clear();
+    }
+
+    bool CsrDelta::empty() const {
+        return mValues.empty();
+    }
+
+    size_t CsrDelta::size() const {
+        return mValues.size();
+    }
+
+}
@@ -0,0 +1,83 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_SQ_CSR_DELTA_HPP
+#define SPBLA_SQ_CSR_DELTA_HPP
+
+#include <sequential/sq_csr_data.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace spbla {
+
+    /**
+     * Buffer of values, inserted into csr matrix, but not merged into its storage yet.
+     * Buffered values are sorted in row-col order and none of them is present in the matrix.
+     */
+    class CsrDelta {
+    public:
+        /** Buffer is compacted, when it has more than matrix nvals / COMPACT_FACTOR values */
+        static const size_t COMPACT_FACTOR = 64;
+
+        /**
+         * Add values to the buffer.
+         *
+         * @param data Matrix storage (row offsets must be allocated)
+         * @param rows Sorted in row-col order rows indices without duplicates
+         * @param cols Sorted in row-col order column indices without duplicates
+         * @param nvals Number of values
+         */
+        void insert(const CsrData& data, const index* rows, const index* cols, size_t nvals);
+
+        /**
+         * Merge buffered values into affected rows of the matrix storage and clear buffer.
+         *
+         * @param data Matrix storage (row offsets must be allocated)
+         */
+        void compact(CsrData& data);
+
+        /**
+         * Merge buffered values with the matrix storage into separate data, buffer and storage are not changed.
+         *
+         * @param data Matrix storage (row offsets must be allocated)
+         * @param out Csr data of the matrix with buffered values
+         */
+        void merge(const CsrData& data, CsrData& out) const;
+
+        /** @return True if buffer is too large to defer its merge */
+        bool needsCompaction(const CsrData& data) const;
+
+        void clear();
+        bool empty() const;
+        size_t size() const;
+
+    private:
+        // (i, j) values
+        std::vector<std::pair<index, index>> mValues;
+    };
+
+}
+
+#endif //SPBLA_SQ_CSR_DELTA_HPP
@@ -0,0 +1,431 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <sequential/sq_dcsr.hpp>
+#include <sequential/sq_merge_rows.hpp>
+#include <io/tracer.hpp>
+#include <utils/csr_utils.hpp>
+#include <utils/exclusive_scan.hpp>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace spbla {
+
+    static void beginRows(DcsrData& out) {
+        out.rowIndices.clear();
+        out.rowOffsets.assign(1, 0);
+        out.colIndices.clear();
+    }
+
+    // Values, appended after the previous row, form row i (nothing is stored for empty row)
+    static void closeRow(DcsrData& out, index i) {
+        if (out.colIndices.size() != out.rowOffsets.back()) {
+            out.rowIndices.push_back(i);
+            out.rowOffsets.push_back(out.colIndices.size());
+        }
+    }
+
+    static void endRows(DcsrData& out) {
+        CHECK_RAISE_ERROR(out.colIndices.size() <= std::numeric_limits<index>::max(), IndexOverflow, "Number of values of the result exceeds spbla_Index range");
+        out.nvals = out.colIndices.size();
+    }
+
+    static void fromSortedPairs(const index* rows, const index* cols, size_t nvals, DcsrData& out) {
+        beginRows(out);
+        out.colIndices.reserve(nvals);
+
+        for (size_t k = 0; k < nvals; k++) {
+            if (k > 0 && rows[k] != rows[k - 1])
+                closeRow(out, rows[k - 1]);
+
+            out.colIndices.push_back(cols[k]);
+        }
+
+        if (nvals > 0)
+            closeRow(out, rows[nvals - 1]);
+
+        endRows(out);
+    }
+
+    // Walk over union of stored rows of `a` and `b` in ascending order
+    template<typename Op>
+    static void unionRows(const RowsView& a, const RowsView& b, DcsrData& out, Op&& op) {
+        const index none = std::numeric_limits<index>::max();
+        size_t ka = 0;
+        size_t kb = 0;
+
+        beginRows(out);
+
+        while (ka < a.count() || kb < b.count()) {
+            index ia = ka < a.count()? a.id(ka): none;
+            index ib = kb < b.count()? b.id(kb): none;
+            index i = std::min(ia, ib);
+
+            const index* af = ia == i? a.begin(ka): nullptr;
+            const index* al = ia == i? a.end(ka): nullptr;
+            const index* bf = ib == i? b.begin(kb): nullptr;
+            const index* bl = ib == i? b.end(kb): nullptr;
+
+            op(af, al, bf, bl);
+            closeRow(out, i);
+
+            ka += ia == i;
+            kb += ib == i;
+        }
+
+        endRows(out);
+    }
+
+    size_t sq_csr_count_rows(const CsrData& a) {
+        size_t count = 0;
+
+        for (index i = 0; i < a.nrows; i++)
+            count += a.rowOffsets[i] != a.rowOffsets[i + 1];
+
+        return count;
+    }
+
+    void sq_dcsr_from_csr(const CsrData& a, DcsrData& out) {
+        out.rowIndices.clear();
+        out.rowOffsets.assign(1, 0);
+        out.rowIndices.reserve(sq_csr_count_rows(a));
+        out.rowOffsets.reserve(out.rowIndices.capacity() + 1);
+
+        for (index i = 0; i < a.nrows; i++) {
+            if (a.rowOffsets[i] != a.rowOffsets[i + 1]) {
+                out.rowIndices.push_back(i);
+                out.rowOffsets.push_back(a.rowOffsets[i + 1]);
+            }
+        }
+
+        out.colIndices = a.colIndices;
+        out.nvals = a.nvals;
+    }
+
+    void sq_dcsr_to_csr(const DcsrData& a, CsrData& out) {
+        out.rowOffsets.clear();
+        out.rowOffsets.resize(a.nrows + 1, 0);
+
+        for (size_t k = 0; k < a.rowIndices.size(); k++)
+            out.rowOffsets[a.rowIndices[k]] = a.rowOffsets[k + 1] - a.rowOffsets[k];
+
+        exclusive_scan_offsets(out.rowOffsets.begin(), out.rowOffsets.end(), out.nrowsNotEmpty);
+
+        out.colIndices = a.colIndices;
+        out.nvals = a.nvals;
+    }
+
+    void sq_dcsr_build(const index* rows, const index* cols, size_t nvals, bool isSorted, bool noDuplicates, DcsrData& out) {
+        if (isSorted && noDuplicates) {
+            fromSortedPairs(rows, cols, nvals, out);
+            return;
+        }
+
+        std::vector<index> sortedRows(rows, rows + nvals);
+        std::vector<index> sortedCols(cols, cols + nvals);
+
+        nvals = CsrUtils::sortPairs(sortedRows.data(), sortedCols.data(), nvals);
+        fromSortedPairs(sortedRows.data(), sortedCols.data(), nvals, out);
+    }
+
+    void sq_dcsr_insert(const DcsrData& a, const index* rows, const index* cols, size_t nvals, DcsrData& out) {
+        // Inserted values are viewed as dcsr storage with the same rows as well
+        DcsrData values;
+        values.nrows = a.nrows;
+        values.ncols = a.ncols;
+        fromSortedPairs(rows, cols, nvals, values);
+
+        sq_dcsr_ewiseadd(RowsView(a), RowsView(values), out);
+    }
+
+    void sq_dcsr_extract(const DcsrData& a, index* rows, index* cols) {
+        for (size_t k = 0; k < a.rowIndices.size(); k++) {
+            for (index v = a.rowOffsets[k]; v < a.rowOffsets[k + 1]; v++) {
+                *(rows++) = a.rowIndices[k];
+                *(cols++) = a.colIndices[v];
+            }
+        }
+    }
+
+    void sq_dcsr_submatrix(const RowsView& a, index i, index j, index nrows, index ncols, DcsrData& out) {
+        beginRows(out);
+
+        for (size_t k = a.lowerBound(i); k < a.count() && a.id(k) < i + nrows; k++) {
+            auto first = std::lower_bound(a.begin(k), a.end(k), j);
+            auto last = std::lower_bound(first, a.end(k), j + ncols);
+
+            for (; first != last; first++)
+                out.colIndices.push_back(*first - j);
+
+            closeRow(out, a.id(k) - i);
+        }
+
+        endRows(out);
+    }
+
+    void sq_dcsr_transpose(const RowsView& a, DcsrData& out) {
+        TraceScope trace("sq_dcsr_transpose");
+        trace.arg("nnz", a.nvals);
+
+        std::vector<index> rows;
+        std::vector<index> cols;
+        rows.reserve(a.nvals);
+        cols.reserve(a.nvals);
+
+        for (size_t k = 0; k < a.count(); k++) {
+            for (auto v = a.begin(k); v != a.end(k); v++) {
+                rows.push_back(*v);
+                cols.push_back(a.id(k));
+            }
+        }
+
+        size_t nvals = CsrUtils::sortPairs(rows.data(), cols.data(), rows.size());
+        fromSortedPairs(rows.data(), cols.data(), nvals, out);
+    }
+
+    void sq_dcsr_reduce(const RowsView& a, DcsrData& out) {
+        beginRows(out);
+
+        for (size_t k = 0; k < a.count(); k++) {
+            if (a.begin(k) != a.end(k)) {
+                out.colIndices.push_back(0);
+                closeRow(out, a.id(k));
+            }
+        }
+
+        endRows(out);
+    }
+
+    void sq_dcsr_ewiseadd(const RowsView& a, const RowsView& b, DcsrData& out) {
+        unionRows(a, b, out, [&](const index* af, const index* al, const index* bf, const index* bl) {
+            std::set_union(af, al, bf, bl, std::back_inserter(out.colIndices));
+        });
+    }
+
+    void sq_dcsr_ewisemult(const RowsView& a, const RowsView& b, DcsrData& out) {
+        auto emit = [&](const index* first, size_t count) {
+            out.colIndices.insert(out.colIndices.end(), first, first + count);
+        };
+
+        beginRows(out);
+
+        // Rows with fewer stored rows are walked, rows of the other one are looked up
+        bool swap = b.count() < a.count();
+        const RowsView& walk = swap? b: a;
+        const RowsView& look = swap? a: b;
+
+        for (size_t k = 0; k < walk.count(); k++) {
+            size_t found = look.find(walk.id(k));
+
+            if (found != look.count()) {
+                sq_merge_intersect(walk.begin(k), walk.end(k), look.begin(found), look.end(found), emit);
+                closeRow(out, walk.id(k));
+            }
+        }
+
+        endRows(out);
+    }
+
+    void sq_dcsr_ewisediff(const RowsView& a, const RowsView& b, DcsrData& out) {
+        auto emit = [&](const index* first, size_t count) {
+            out.colIndices.insert(out.colIndices.end(), first, first + count);
+        };
+
+        beginRows(out);
+
+        for (size_t k = 0; k < a.count(); k++) {
+            size_t found = b.find(a.id(k));
+
+            if (found != b.count())
+                sq_merge_difference(a.begin(k), a.end(k), b.begin(found), b.end(found), emit);
+            else
+                emit(a.begin(k), a.end(k) - a.begin(k));
+
+            closeRow(out, a.id(k));
+        }
+
+        endRows(out);
+    }
+
+    void sq_dcsr_kronecker(const RowsView& a, const RowsView& b, DcsrData& out) {
+        beginRows(out);
+
+        for (size_t ka = 0; ka < a.count(); ka++) {
+            if (a.begin(ka) == a.end(ka))
+                continue;
+
+            for (size_t kb = 0; kb < b.count(); kb++) {
+                for (auto ca = a.begin(ka); ca != a.end(ka); ca++) {
+                    for (auto cb = b.begin(kb); cb != b.end(kb); cb++)
+                        out.colIndices.push_back(*ca * b.ncols + *cb);
+                }
+
+                closeRow(out, a.id(ka) * b.nrows + b.id(kb));
+            }
+        }
+
+        endRows(out);
+    }
+
+    // Product row i = sum of rows of `b`, referenced by row k of `a` (sorted, no duplicates)
+    static void productRow(const RowsView& a, const RowsView& b, size_t k, std::vector<index>& row, std::vector<index>& buffer) {
+        size_t merged = 0;
+        row.clear();
+
+        for (auto c = a.begin(k); c != a.end(k); c++) {
+            size_t found = b.find(*c);
+
+            if (found != b.count() && b.begin(found) != b.end(found)) {
+                row.insert(row.end(), b.begin(found), b.end(found));
+                merged += 1;
+            }
+        }
+
+        // Single row of `b` is already sorted
+        if (merged > 1) {
+            CsrUtils::sortIndices(row.data(), row.data() + row.size(), buffer);
+            row.erase(std::unique(row.begin(), row.end()), row.end());
+        }
+    }
+
+    void sq_dcsr_spgemm(const RowsView& a, const RowsView& b, DcsrData& out) {
+        TraceScope trace("sq_dcsr_spgemm");
+        trace.arg("rows", a.count());
+
+        std::vector<index> row;
+        std::vector<index> buffer;
+
+        beginRows(out);
+
+        for (size_t k = 0; k < a.count(); k++) {
+            productRow(a, b, k, row, buffer);
+            out.colIndices.insert(out.colIndices.end(), row.begin(), row.end());
+            closeRow(out, a.id(k));
+        }
+
+        endRows(out);
+    }
+
+    void sq_dcsr_spgemm_masked(const RowsView& a, const RowsView& b, const RowsView& mask, bool complement, DcsrData& out) {
+        TraceScope trace("sq_dcsr_spgemm_masked");
+        trace.arg("rows", a.count());
+
+        auto emit = [&](const index* first, size_t count) {
+            out.colIndices.insert(out.colIndices.end(), first, first + count);
+        };
+
+        std::vector<index> row;
+        std::vector<index> buffer;
+
+        beginRows(out);
+
+        for (size_t k = 0; k < a.count(); k++) {
+            size_t found = mask.find(a.id(k));
+            bool hasMask = found != mask.count() && mask.begin(found) != mask.end(found);
+
+            // Masked-out rows are not evaluated at all
+            if (!complement && !hasMask)
+                continue;
+
+            productRow(a, b, k, row, buffer);
+
+            if (!hasMask)
+                emit(row.data(), row.size());
+            else if (complement)
+                sq_merge_difference(row.data(), row.data() + row.size(), mask.begin(found), mask.end(found), emit);
+            else
+                sq_merge_intersect(row.data(), row.data() + row.size(), mask.begin(found), mask.end(found), emit);
+
+            closeRow(out, a.id(k));
+        }
+
+        endRows(out);
+    }
+
+    void sq_dcsr_spmv_pull(const RowsView& a, const VecData& v, const VecData* mask, bool complement, VecData& out) {
+        out.indices.clear();
+        out.nvals = 0;
+
+        auto vFirst = v.indices.data();
+        auto vLast = v.indices.data() + v.indices.size();
+
+        auto hasHit = [&](size_t k) {
+            for (auto c = a.begin(k); c != a.end(k); c++) {
+                if (std::binary_search(vFirst, vLast, *c))
+                    return true;
+            }
+            return false;
+        };
+
+        if (mask && !complement) {
+            // Only mask rows are candidates
+            for (auto i: mask->indices) {
+                size_t k = a.find(i);
+                if (k != a.count() && hasHit(k))
+                    out.indices.push_back(i);
+            }
+        }
+        else {
+            for (size_t k = 0; k < a.count(); k++) {
+                if (mask && std::binary_search(mask->indices.begin(), mask->indices.end(), a.id(k)))
+                    continue;
+                if (hasHit(k))
+                    out.indices.push_back(a.id(k));
+            }
+        }
+
+        out.nvals = out.indices.size();
+    }
+
+    void sq_dcsr_spmv_push(const RowsView& a, const VecData& v, const VecData* mask, bool complement, VecData& out) {
+        std::vector<index> values;
+        std::vector<index> buffer;
+
+        for (auto i: v.indices) {
+            size_t k = a.find(i);
+            if (k != a.count())
+                values.insert(values.end(), a.begin(k), a.end(k));
+        }
+
+        CsrUtils::sortIndices(values.data(), values.data() + values.size(), buffer);
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+
+        out.indices.clear();
+
+        auto emit = [&](const index* first, size_t count) {
+            out.indices.insert(out.indices.end(), first, first + count);
+        };
+
+        if (!mask)
+            emit(values.data(), values.size());
+        else if (complement)
+            sq_merge_difference(values.data(), values.data() + values.size(), mask->indices.data(), mask->indices.data() + mask->indices.size(), emit);
+        else
+            sq_merge_intersect(values.data(), values.data() + values.size(), mask->indices.data(), mask->indices.data() + mask->indices.size(), emit);
+
+        out.nvals = out.indices.size();
+    }
+
+}
@@ -0,0 +1,118 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_SQ_DCSR_HPP
+#define SPBLA_SQ_DCSR_HPP
+
+#include <sequential/sq_dcsr_data.hpp>
+#include <sequential/sq_vec_data.hpp>
+
+namespace spbla {
+
+    /*
+     * Kernels over hypersparse matrices.
+     * Inputs are csr or dcsr storages (accessed through rows view), result is always dcsr.
+     * Work and memory depend only on the number of stored rows and values, so dcsr inputs
+     * never allocate arrays of the matrix rows count size. Result dimensions must be set by caller.
+     */
+
+    /** @return Number of not empty rows of the csr matrix */
+    size_t sq_csr_count_rows(const CsrData& a);
+
+    /** Convert csr storage to dcsr one (empty rows are dropped) */
+    void sq_dcsr_from_csr(const CsrData& a, DcsrData& out);
+
+    /** Convert dcsr storage to csr one (empty rows are restored) */
+    void sq_dcsr_to_csr(const DcsrData& a, CsrData& out);
+
+    /**
+     * Build dcsr storage from pairs.
+     *
+     * @param rows Pairs row indices
+     * @param cols Pairs column indices
+     * @param nvals Number of pairs
+     * @param isSorted True if pairs are sorted in row-col order
+     * @param noDuplicates True if pairs have no duplicates
+     * @param[out] out Where to store result
+     */
+    void sq_dcsr_build(const index* rows, const index* cols, size_t nvals, bool isSorted, bool noDuplicates, DcsrData& out);
+
+    /**
+     * Add values to the dcsr matrix: out = a + values.
+     *
+     * @param a Input matrix
+     * @param rows Sorted in row-col order rows indices without duplicates
+     * @param cols Sorted in row-col order column indices without duplicates
+     * @param nvals Number of values
+     * @param[out] out Where to store result (must differ from input)
+     */
+    void sq_dcsr_insert(const DcsrData& a, const index* rows, const index* cols, size_t nvals, DcsrData& out);
+
+    /** Extract pairs of the matrix values in row-col order */
+    void sq_dcsr_extract(const DcsrData& a, index* rows, index* cols);
+
+    /** Extract sub-matrix of the size nrows x ncols starting from (i, j) */
+    void sq_dcsr_submatrix(const RowsView& a, index i, index j, index nrows, index ncols, DcsrData& out);
+
+    /** Transpose out = aT (pairs are sorted, no array of columns count size is allocated) */
+    void sq_dcsr_transpose(const RowsView& a, DcsrData& out);
+
+    /** Reduce rows of the matrix to column vector */
+    void sq_dcsr_reduce(const RowsView& a, DcsrData& out);
+
+    /** Element-wise addition out = a + b */
+    void sq_dcsr_ewiseadd(const RowsView& a, const RowsView& b, DcsrData& out);
+
+    /** Element-wise multiplication out = a * b */
+    void sq_dcsr_ewisemult(const RowsView& a, const RowsView& b, DcsrData& out);
+
+    /** Element-wise difference out = a - b */
+    void sq_dcsr_ewisediff(const RowsView& a, const RowsView& b, DcsrData& out);
+
+    /** Kronecker product out = a (x) b */
+    void sq_dcsr_kronecker(const RowsView& a, const RowsView& b, DcsrData& out);
+
+    /** Matrix-matrix multiplication out = a x b (rows of `b` are looked up by column indices of `a`) */
+    void sq_dcsr_spgemm(const RowsView& a, const RowsView& b, DcsrData& out);
+
+    /**
+     * Masked matrix-matrix multiplication out<mask> = a x b.
+     *
+     * @param a Input matrix
+     * @param b Input matrix
+     * @param mask Mask matrix (same shape as result)
+     * @param complement True to use structural complement of the mask
+     * @param[out] out Where to store result
+     */
+    void sq_dcsr_spgemm_masked(const RowsView& a, const RowsView& b, const RowsView& mask, bool complement, DcsrData& out);
+
+    /** Matrix-vector multiplication out<mask> = a x v over stored rows of `a` */
+    void sq_dcsr_spmv_pull(const RowsView& a, const VecData& v, const VecData* mask, bool complement, VecData& out);
+
+    /** Vector-matrix multiplication out<mask> = vT x a by lookup of the rows of `a` */
+    void sq_dcsr_spmv_push(const RowsView& a, const VecData& v, const VecData* mask, bool complement, VecData& out);
+
+}
+
+#endif //SPBLA_SQ_DCSR_HPP
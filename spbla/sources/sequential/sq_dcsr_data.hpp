@@ -0,0 +1,103 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_SQ_DCSR_DATA_HPP
+#define SPBLA_SQ_DCSR_DATA_HPP
+
+#include <sequential/sq_csr_data.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace spbla {
+
+    /** Matrix is stored as dcsr, if less than nrows / HYPERSPARSE_FACTOR of its rows are not empty */
+    static const size_t HYPERSPARSE_FACTOR = 16;
+
+    /**
+     * Doubly compressed sparse row storage: only not empty rows are stored.
+     * Row rowIndices[k] has column indices colIndices[rowOffsets[k], rowOffsets[k + 1]).
+     * Memory does not depend on the number of matrix rows.
+     */
+    class DcsrData {
+    public:
+        std::vector<index> rowIndices;
+        std::vector<index> rowOffsets;
+        std::vector<index> colIndices;
+        index nrows = 0;
+        index ncols = 0;
+        index nvals = 0;
+    };
+
+    /**
+     * Uniform read-only access to the rows of csr or dcsr storage.
+     * Csr storage has all rows stored (empty ones as well), dcsr only not empty ones.
+     */
+    class RowsView {
+    public:
+        explicit RowsView(const CsrData& a)
+            : nrows(a.nrows), ncols(a.ncols), nvals(a.nvals),
+              mOffsets(a.rowOffsets.data()), mCols(a.colIndices.data()), mIds(nullptr), mCount(a.nrows) {}
+
+        explicit RowsView(const DcsrData& a)
+            : nrows(a.nrows), ncols(a.ncols), nvals(a.nvals),
+              mOffsets(a.rowOffsets.data()), mCols(a.colIndices.data()), mIds(a.rowIndices.data()), mCount(a.rowIndices.size()) {}
+
+        /** @return Number of stored rows */
+        size_t count() const { return mCount; }
+        /** @return Matrix row index of the k-th stored row */
+        index id(size_t k) const { return mIds? mIds[k]: (index) k; }
+        const index* begin(size_t k) const { return mCols + mOffsets[k]; }
+        const index* end(size_t k) const { return mCols + mOffsets[k + 1]; }
+
+        /** @return Position of the first stored row with index not less than i */
+        size_t lowerBound(index i) const {
+            if (!mIds)
+                return std::min<size_t>(i, mCount);
+
+            return std::lower_bound(mIds, mIds + mCount, i) - mIds;
+        }
+
+        /** @return Position of the matrix row i in stored rows or count(), if row is not stored */
+        size_t find(index i) const {
+            if (!mIds)
+                return i;
+
+            auto found = std::lower_bound(mIds, mIds + mCount, i);
+            return found != mIds + mCount && *found == i? (size_t) (found - mIds): mCount;
+        }
+
+        index nrows;
+        index ncols;
+        index nvals;
+
+    private:
+        const index* mOffsets;
+        const index* mCols;
+        const index* mIds;
+        size_t mCount;
+    };
+
+}
+
+#endif //SPBLA_SQ_DCSR_DATA_HPP
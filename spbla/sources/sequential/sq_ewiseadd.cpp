@@ -30,8 +30,6 @@ namespace spbla {
     void sq_ewiseadd(const CsrData& a, const CsrData& b, CsrData& out) {
         out.rowOffsets.resize(a.nrows + 1, 0);
 
-        size_t nvals = 0;
-
         // Count nnz of the result matrix to allocate memory
         for (index i = 0; i < a.nrows; i++) {
             index ak = a.rowOffsets[i];
@@ -65,12 +63,11 @@ namespace spbla {
             nvalsInRow += (size_t)(arend - ar);
             nvalsInRow += (size_t)(brend - br);
 
-            nvals += nvalsInRow;
             out.rowOffsets[i] = nvalsInRow;
         }
 
         // Eval row offsets
-        exclusive_scan(out.rowOffsets.begin(), out.rowOffsets.end(), 0);
+        index nvals = exclusive_scan_offsets(out.rowOffsets.begin(), out.rowOffsets.end(), out.nrowsNotEmpty);
 
         // Allocate memory for values
         out.nvals = nvals;
@@ -28,11 +28,11 @@
 namespace spbla {
 
     void sq_kronecker(const CsrData& a, const CsrData& b, CsrData& out) {
-        size_t nvals = a.nvals * b.nvals;
+        size_t nvals = (size_t) a.nvals * b.nvals;
 
         out.nvals = nvals;
         out.rowOffsets.clear();
-        out.rowOffsets.resize(a.nrows * b.nrows + 1, 0);
+        out.rowOffsets.resize((size_t) a.nrows * b.nrows + 1, 0);
         out.colIndices.resize(nvals);
 
         size_t id = 0;
@@ -55,7 +55,7 @@ namespace spbla {
             }
         }
 
-        exclusive_scan(out.rowOffsets.begin(), out.rowOffsets.end(), 0);
+        exclusive_scan_offsets(out.rowOffsets.begin(), out.rowOffsets.end(), out.nrowsNotEmpty);
     }
 
 }
\ No newline at end of file
@@ -27,10 +27,18 @@
 #include <sequential/sq_submatrix.hpp>
 #include <sequential/sq_kronecker.hpp>
 #include <sequential/sq_ewiseadd.hpp>
+#include <sequential/sq_ewisemult.hpp>
+#include <sequential/sq_ewisediff.hpp>
 #include <sequential/sq_spgemm.hpp>
+#include <sequential/sq_spgemm_transposed.hpp>
+#include <sequential/sq_spgemm_masked.hpp>
+#include <sequential/sq_spgemm_dense.hpp>
 #include <sequential/sq_reduce.hpp>
+#include <sequential/sq_dcsr.hpp>
+#include <sequential/sq_tiles.hpp>
 #include <utils/csr_utils.hpp>
 #include <core/error.hpp>
+#include <io/tracer.hpp>
 #include <cassert>
 
 namespace spbla {
@@ -41,6 +49,11 @@ namespace spbla {
 
         mData.nrows = nrows;
         mData.ncols = ncols;
+
+        // Empty matrix is hypersparse, so no row offsets are allocated
+        mHyper.nrows = nrows;
+        mHyper.ncols = ncols;
+        mHyper.rowOffsets.assign(1, 0);
     }
 
     void SqMatrix::setElement(index i, index j) {
@@ -51,24 +64,109 @@ namespace spbla {
         auto nrows = mData.nrows;
         auto ncols = mData.ncols;
 
-        mData.rowOffsets.clear();
-        mData.colIndices.clear();
+        // Few values never fill enough rows for csr storage
+        if (nvals * HYPERSPARSE_FACTOR < nrows) {
+            DcsrData out;
+            out.nrows = nrows;
+            out.ncols = ncols;
+            sq_dcsr_build(rows, cols, nvals, isSorted, noDuplicates, out);
+            this->assign(std::move(out));
+            return;
+        }
+
+        CsrData out;
+        out.nrows = nrows;
+        out.ncols = ncols;
 
-        // Call utility to build csr row offsets and column indices and store in mData vectors
-        CsrUtils::buildFromData(nrows, ncols, rows, cols, nvals, mData.rowOffsets, mData.colIndices, isSorted, noDuplicates);
+        // Call utility to build csr row offsets and column indices
+        out.nrowsNotEmpty = CsrUtils::buildFromData(nrows, ncols, rows, cols, nvals, out.rowOffsets, out.colIndices, isSorted, noDuplicates);
 
-        mData.nvals = mData.colIndices.size();
+        out.nvals = out.colIndices.size();
+        this->assign(std::move(out));
+    }
+
+    void SqMatrix::insert(const index *rows, const index *cols, size_t nvals) {
+        if (mHypersparse) {
+            DcsrData out;
+            out.nrows = getNrows();
+            out.ncols = getNcols();
+            sq_dcsr_insert(mHyper, rows, cols, nvals, out);
+            this->assign(std::move(out));
+            return;
+        }
+
+        // Values are merged into csr arrays, so tiles are converted on write
+        if (mTiled) {
+            sq_tiles_to_csr(mTiles, mData);
+            mTiles = TileData();
+            mTiled = false;
+        }
+
+        allocateStorage();
+
+        // New values are buffered and merged into affected rows at once, when buffer grows large enough,
+        // until then reads merge the buffer into separate data (see getData)
+        mDelta.insert(mData, rows, cols, nvals);
+
+        if (mDelta.needsCompaction(mData))
+            mDelta.compact(mData);
+
+        invalidateTransposed();
+    }
+
+    void SqMatrix::buildCsr(std::vector<index> &&rowOffsets, std::vector<index> &&colIndices, bool isSorted, bool noDuplicates) {
+        auto nrowsNotEmpty = CsrUtils::normalizeRows(mData.nrows, mData.ncols, rowOffsets, colIndices, isSorted, noDuplicates);
+
+        CsrData out;
+        out.nrows = getNrows();
+        out.ncols = getNcols();
+        out.nrowsNotEmpty = nrowsNotEmpty;
+
+        // Adopt provided arrays as matrix storage, no copy is made
+        out.rowOffsets = std::move(rowOffsets);
+        out.colIndices = std::move(colIndices);
+
+        out.nvals = out.colIndices.size();
+        this->assign(std::move(out));
     }
 
     void SqMatrix::extract(index *rows, index *cols, size_t &nvals) {
         assert(nvals >= getNvals());
         nvals = getNvals();
 
+        if (mHypersparse) {
+            sq_dcsr_extract(mHyper, rows, cols);
+            return;
+        }
+
+        // Tiles are kept, values are extracted in row order through temporary csr
+        if (mTiled) {
+            CsrData data;
+            sq_tiles_to_csr(mTiles, data);
+            CsrUtils::extractData(getNrows(), getNcols(), rows, cols, nvals, data.rowOffsets, data.colIndices);
+            return;
+        }
+
+        CsrData buffer;
+        const CsrData& data = getData(buffer);
+
         if (nvals > 0) {
-            CsrUtils::extractData(getNrows(), getNcols(), rows, cols, nvals, mData.rowOffsets, mData.colIndices);
+            CsrUtils::extractData(getNrows(), getNcols(), rows, cols, nvals, data.rowOffsets, data.colIndices);
         }
     }
 
+    void SqMatrix::extractCsr(const index* &rowOffsets, const index* &colIndices) {
+        // Hypersparse storage is kept, csr arrays are restored aside and valid until the matrix is modified or view is released
+        const CsrData& data = getData(mCsrView);
+
+        rowOffsets = data.rowOffsets.data();
+        colIndices = data.colIndices.data();
+    }
+
+    void SqMatrix::releaseCsr() {
+        mCsrView = CsrData();
+    }
+
     void SqMatrix::extractSubMatrix(const MatrixBase &otherBase, index i, index j, index nrows, index ncols,
                                     bool checkTime) {
         auto other = dynamic_cast<const SqMatrix*>(&otherBase);
@@ -79,9 +177,41 @@ namespace spbla {
         assert(this->getNrows() == nrows);
         assert(this->getNcols() == ncols);
 
-        this->allocateStorage();
-        other->allocateStorage();
-        sq_submatrix(other->mData, this->mData, i, j, nrows, ncols);
+        if (other->isHypersparse()) {
+            DcsrData out;
+            out.nrows = nrows;
+            out.ncols = ncols;
+            CsrData bufferOther;
+            sq_dcsr_submatrix(other->getRows(bufferOther), i, j, nrows, ncols, out);
+            this->assign(std::move(out));
+            return;
+        }
+
+        CsrData out;
+        out.nrows = nrows;
+        out.ncols = ncols;
+
+        // Narrow columns range is extracted from the rows of transposed data, only the result is transposed back
+        if (other->getTransposedCost() == 0 && (size_t) ncols * other->getNrows() < (size_t) nrows * other->getNcols()) {
+            CsrData buffer;
+            CsrData sub;
+            sub.nrows = ncols;
+            sub.ncols = nrows;
+            sq_submatrix(other->getTransposed(buffer), sub, j, i, ncols, nrows);
+            sq_transpose(sub, out);
+            this->assign(std::move(out));
+
+            if (this->mKeepTransposed && !this->mHypersparse) {
+                this->mTransposed = std::move(sub);
+                this->mTransposedValid = true;
+            }
+
+            return;
+        }
+
+        CsrData bufferOther;
+        sq_submatrix(other->getData(bufferOther), out, i, j, nrows, ncols);
+        this->assign(std::move(out));
     }
 
     void SqMatrix::clone(const MatrixBase &otherBase) {
@@ -93,7 +223,29 @@ namespace spbla {
         assert(other->getNrows() == this->getNrows());
         assert(other->getNcols() == this->getNcols());
 
-        this->mData = other->mData;
+        this->mHypersparse = other->mHypersparse;
+        this->mHyper = other->mHyper;
+        this->mTiled = other->mTiled;
+        this->mTiles = other->mTiles;
+
+        if (!other->mHypersparse && !other->mTiled) {
+            other->allocateStorage();
+            this->mData = other->mData;
+        }
+        else {
+            this->mData = CsrData();
+            this->mData.nrows = other->getNrows();
+            this->mData.ncols = other->getNcols();
+        }
+
+        this->mDelta = other->mDelta;
+        this->invalidateTransposed();
+
+        // Transposed data is copied only into the matrix, which keeps it
+        if (this->mKeepTransposed && other->mTransposedValid) {
+            this->mTransposed = other->mTransposed;
+            this->mTransposedValid = true;
+        }
     }
 
     void SqMatrix::transpose(const MatrixBase &otherBase, bool checkTime) {
@@ -104,15 +256,40 @@ namespace spbla {
         assert(other->getNcols() == this->getNrows());
         assert(other->getNrows() == this->getNcols());
 
+        if (other->isHypersparse()) {
+            DcsrData out;
+            out.nrows = this->getNrows();
+            out.ncols = this->getNcols();
+            CsrData bufferOther;
+            sq_dcsr_transpose(other->getRows(bufferOther), out);
+            this->assign(std::move(out));
+            return;
+        }
+
         CsrData out;
         out.nrows = this->getNrows();
         out.ncols = this->getNcols();
 
-        this->allocateStorage();
-        other->allocateStorage();
-        sq_transpose(other->mData, out);
+        CsrData bufferOther;
+        const CsrData& data = other->getData(bufferOther);
+
+        // Transposed data of the source is copied, if it is available without sort
+        CsrData buffer;
 
-        this->mData = std::move(out);
+        if (other->getTransposedCost() == 0)
+            out = other->getTransposed(buffer);
+        else
+            sq_transpose(data, out);
+
+        // Source values are transposed data of the result
+        CsrData source = this->mKeepTransposed? data: CsrData();
+
+        this->assign(std::move(out));
+
+        if (this->mKeepTransposed && !this->mHypersparse) {
+            this->mTransposed = std::move(source);
+            this->mTransposedValid = true;
+        }
     }
 
     void SqMatrix::reduce(const MatrixBase &otherBase, bool checkTime) {
@@ -123,15 +300,24 @@ namespace spbla {
         assert(other->getNrows() == this->getNrows());
         assert(1 == this->getNcols());
 
+        if (other->isHypersparse()) {
+            DcsrData out;
+            out.nrows = this->getNrows();
+            out.ncols = this->getNcols();
+            CsrData bufferOther;
+            sq_dcsr_reduce(other->getRows(bufferOther), out);
+            this->assign(std::move(out));
+            return;
+        }
+
         CsrData out;
         out.nrows = this->getNrows();
         out.ncols = this->getNcols();
 
-        this->allocateStorage();
-        other->allocateStorage();
-        sq_reduce(other->mData, out);
+        CsrData bufferOther;
+        sq_reduce(other->getData(bufferOther), out);
 
-        this->mData = std::move(out);
+        this->assign(std::move(out));
     }
 
     void SqMatrix::multiply(const MatrixBase &aBase, const MatrixBase &bBase, bool accumulate, bool checkTime) {
@@ -145,26 +331,232 @@ namespace spbla {
         assert(a->getNrows() == this->getNrows());
         assert(b->getNcols() == this->getNcols());
 
+        if (a->isHypersparse() || b->isHypersparse()) {
+            DcsrData out;
+            out.nrows = this->getNrows();
+            out.ncols = this->getNcols();
+            CsrData bufferA;
+            CsrData bufferB;
+            sq_dcsr_spgemm(a->getRows(bufferA), b->getRows(bufferB), out);
+            this->assignAccumulated(std::move(out), accumulate);
+            return;
+        }
+
+        // Dense operands are multiplied as bit matrices by the Four Russians method
+        if (sq_spgemm_prefer_dense(a->getNrows(), a->getNcols(), b->getNcols(), a->getNvals(), b->getNvals())) {
+            BitMatrix x, y, z;
+            sq_bits_init(a->getNrows(), a->getNcols(), x);
+            sq_bits_init(b->getNrows(), b->getNcols(), y);
+            sq_bits_init(this->getNrows(), this->getNcols(), z);
+
+            a->fillBits(x);
+            b->fillBits(y);
+
+            if (accumulate)
+                this->fillBits(z);
+
+            sq_spgemm_m4r(x, y, z);
+
+            // Product of dense operands is dense as well, so it is stored as tiles (if it is not, storage is converted)
+            TileData out;
+            out.nrows = this->getNrows();
+            out.ncols = this->getNcols();
+            sq_tiles_from_bits(z, out);
+            this->assign(std::move(out));
+            return;
+        }
+
+        // Dense tiles are multiplied as bitmasks
+        if (a->isTiled() && b->isTiled()) {
+            TileData out;
+            out.nrows = this->getNrows();
+            out.ncols = this->getNcols();
+            sq_tiles_spgemm(a->mTiles, b->mTiles, out);
+            this->assignAccumulated(std::move(out), accumulate);
+            return;
+        }
+
         CsrData out;
         out.nrows = this->getNrows();
         out.ncols = this->getNcols();
 
-        a->allocateStorage();
-        b->allocateStorage();
-        sq_spgemm(a->mData, b->mData, out);
+        CsrData bufferA;
+        CsrData bufferB;
+        const CsrData& dataA = a->getData(bufferA);
+        const CsrData& dataB = b->getData(bufferB);
 
         if (accumulate) {
-            CsrData out2;
-            out2.nrows = this->getNrows();
-            out2.ncols = this->getNcols();
+            // Fused out = this + a x b, no temporary product is allocated
+            CsrData bufferThis;
+            sq_spgemm_accumulate(dataA, dataB, this->getData(bufferThis), out);
+        }
+        else {
+            sq_spgemm(dataA, dataB, out);
+        }
 
-            this->allocateStorage();
-            sq_ewiseadd(this->mData, out, out2);
+        this->assign(std::move(out));
+    }
 
-            std::swap(out2, out);
+    void SqMatrix::multiplyTransposed(const MatrixBase &aBase, const MatrixBase &bBase, bool transposeA, bool transposeB, bool accumulate, bool checkTime) {
+        if (!transposeA && !transposeB) {
+            multiply(aBase, bBase, accumulate, checkTime);
+            return;
         }
 
-        this->mData = std::move(out);
+        auto a = dynamic_cast<const SqMatrix*>(&aBase);
+        auto b = dynamic_cast<const SqMatrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Provided matrix does not belongs to sequential matrix class");
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Provided matrix does not belongs to sequential matrix class");
+
+        assert((transposeA? a->getNrows(): a->getNcols()) == (transposeB? b->getNcols(): b->getNrows()));
+        assert((transposeA? a->getNcols(): a->getNrows()) == this->getNrows());
+        assert((transposeB? b->getNrows(): b->getNcols()) == this->getNcols());
+
+        if (a->isHypersparse() || b->isHypersparse()) {
+            // Transposed operands are hypersparse as well, so they are built explicitly
+            CsrData bufferA;
+            CsrData bufferB;
+            DcsrData at;
+            DcsrData bt;
+
+            if (transposeA) {
+                at.nrows = a->getNcols();
+                at.ncols = a->getNrows();
+                sq_dcsr_transpose(a->getRows(bufferA), at);
+            }
+
+            if (transposeB) {
+                bt.nrows = b->getNcols();
+                bt.ncols = b->getNrows();
+                sq_dcsr_transpose(b->getRows(bufferB), bt);
+            }
+
+            DcsrData out;
+            out.nrows = this->getNrows();
+            out.ncols = this->getNcols();
+            sq_dcsr_spgemm(transposeA? RowsView(at): a->getRows(bufferA), transposeB? RowsView(bt): b->getRows(bufferB), out);
+            this->assignAccumulated(std::move(out), accumulate);
+            return;
+        }
+
+        CsrData out;
+        out.nrows = this->getNrows();
+        out.ncols = this->getNcols();
+
+        CsrData bufferA;
+        CsrData bufferB;
+        const CsrData& dataA = a->getData(bufferA);
+        const CsrData& dataB = b->getData(bufferB);
+
+        // Kernels add values of the matrix to the product, if accumulate is requested
+        CsrData bufferThis;
+        const CsrData* c = accumulate? &this->getData(bufferThis): nullptr;
+
+        // Operands of the Gustavson kernel, if no specialized kernel is selected
+        CsrData transposed;
+        const CsrData* left = nullptr;
+        const CsrData* right = nullptr;
+
+        if (transposeA && transposeB) {
+            // aT x bT = (b x a)T, only the result is transposed, so values of the matrix are added afterwards
+            CsrData product;
+            product.nrows = b->getNrows();
+            product.ncols = a->getNcols();
+            sq_spgemm(dataB, dataA, product);
+
+            if (c) {
+                CsrData productT;
+                productT.nrows = this->getNrows();
+                productT.ncols = this->getNcols();
+                sq_transpose(product, productT);
+                sq_ewiseadd(*c, productT, out);
+            }
+            else {
+                sq_transpose(product, out);
+            }
+        }
+        else if (transposeB) {
+            if (sq_spgemm_prefer_dot(dataA, dataB, b->getTransposedCost())) {
+                if (c)
+                    sq_spgemm_dot_accumulate(dataA, dataB, *c, out);
+                else
+                    sq_spgemm_dot(dataA, dataB, out);
+            }
+            else {
+                left = &dataA;
+                right = &b->getTransposed(transposed);
+            }
+        }
+        else {
+            if (sq_spgemm_prefer_outer(dataA, dataB, a->getTransposedCost())) {
+                if (c)
+                    sq_spgemm_outer_accumulate(dataA, dataB, *c, out);
+                else
+                    sq_spgemm_outer(dataA, dataB, out);
+            }
+            else {
+                left = &a->getTransposed(transposed);
+                right = &dataB;
+            }
+        }
+
+        if (left != nullptr) {
+            if (c) {
+                sq_spgemm_accumulate(*left, *right, *c, out);
+            }
+            else {
+                sq_spgemm(*left, *right, out);
+            }
+        }
+
+        this->assign(std::move(out));
+    }
+
+    void SqMatrix::multiplyMasked(const MatrixBase &maskBase, const MatrixBase &aBase, const MatrixBase &bBase, bool complement, bool accumulate, bool checkTime) {
+        auto mask = dynamic_cast<const SqMatrix*>(&maskBase);
+        auto a = dynamic_cast<const SqMatrix*>(&aBase);
+        auto b = dynamic_cast<const SqMatrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(mask != nullptr, InvalidArgument, "Provided matrix does not belongs to sequential matrix class");
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Provided matrix does not belongs to sequential matrix class");
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Provided matrix does not belongs to sequential matrix class");
+
+        assert(a->getNcols() == b->getNrows());
+        assert(a->getNrows() == this->getNrows());
+        assert(b->getNcols() == this->getNcols());
+        assert(mask->getNrows() == this->getNrows());
+        assert(mask->getNcols() == this->getNcols());
+
+        if (mask->isHypersparse() || a->isHypersparse() || b->isHypersparse()) {
+            DcsrData out;
+            out.nrows = this->getNrows();
+            out.ncols = this->getNcols();
+            CsrData bufferMask;
+            CsrData bufferA;
+            CsrData bufferB;
+            sq_dcsr_spgemm_masked(a->getRows(bufferA), b->getRows(bufferB), mask->getRows(bufferMask), complement, out);
+            this->assignAccumulated(std::move(out), accumulate);
+            return;
+        }
+
+        CsrData out;
+        out.nrows = this->getNrows();
+        out.ncols = this->getNcols();
+
+        CsrData bufferMask;
+        CsrData bufferA;
+        CsrData bufferB;
+
+        if (accumulate) {
+            CsrData bufferThis;
+            sq_spgemm_masked_accumulate(a->getData(bufferA), b->getData(bufferB), this->getData(bufferThis), mask->getData(bufferMask), complement, out);
+        }
+        else {
+            sq_spgemm_masked(a->getData(bufferA), b->getData(bufferB), mask->getData(bufferMask), complement, out);
+        }
+
+        this->assign(std::move(out));
     }
 
     void SqMatrix::kronecker(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) {
@@ -177,15 +569,26 @@ namespace spbla {
         assert(a->getNrows() * b->getNrows() == this->getNrows());
         assert(a->getNcols() * b->getNcols() == this->getNcols());
 
+        if (a->isHypersparse() || b->isHypersparse()) {
+            DcsrData out;
+            out.nrows = this->getNrows();
+            out.ncols = this->getNcols();
+            CsrData bufferA;
+            CsrData bufferB;
+            sq_dcsr_kronecker(a->getRows(bufferA), b->getRows(bufferB), out);
+            this->assign(std::move(out));
+            return;
+        }
+
         CsrData out;
         out.nrows = this->getNrows();
         out.ncols = this->getNcols();
 
-        a->allocateStorage();
-        b->allocateStorage();
-        sq_kronecker(a->mData, b->mData, out);
+        CsrData bufferA;
+        CsrData bufferB;
+        sq_kronecker(a->getData(bufferA), b->getData(bufferB), out);
 
-        this->mData = std::move(out);
+        this->assign(std::move(out));
     }
 
     void SqMatrix::eWiseAdd(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) {
@@ -200,15 +603,127 @@ namespace spbla {
         assert(a->getNrows() == b->getNrows());
         assert(a->getNcols() == b->getNcols());
 
+        if (a->isHypersparse() || b->isHypersparse()) {
+            DcsrData out;
+            out.nrows = this->getNrows();
+            out.ncols = this->getNcols();
+            CsrData bufferA;
+            CsrData bufferB;
+            sq_dcsr_ewiseadd(a->getRows(bufferA), b->getRows(bufferB), out);
+            this->assign(std::move(out));
+            return;
+        }
+
+        if (a->isTiled() || b->isTiled()) {
+            TileData bufferA;
+            TileData bufferB;
+            TileData out;
+            out.nrows = this->getNrows();
+            out.ncols = this->getNcols();
+            sq_tiles_ewiseadd(a->getTiles(bufferA), b->getTiles(bufferB), out);
+            this->assign(std::move(out));
+            return;
+        }
+
         CsrData out;
         out.nrows = this->getNrows();
         out.ncols = this->getNcols();
 
-        a->allocateStorage();
-        b->allocateStorage();
-        sq_ewiseadd(a->mData, b->mData, out);
+        CsrData bufferA;
+        CsrData bufferB;
+        sq_ewiseadd(a->getData(bufferA), b->getData(bufferB), out);
 
-        this->mData = std::move(out);
+        this->assign(std::move(out));
+    }
+
+    void SqMatrix::eWiseMult(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) {
+        auto a = dynamic_cast<const SqMatrix*>(&aBase);
+        auto b = dynamic_cast<const SqMatrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Provided matrix does not belongs to sequential matrix class");
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Provided matrix does not belongs to sequential matrix class");
+
+        assert(a->getNrows() == this->getNrows());
+        assert(a->getNcols() == this->getNcols());
+        assert(a->getNrows() == b->getNrows());
+        assert(a->getNcols() == b->getNcols());
+
+        if (a->isHypersparse() || b->isHypersparse()) {
+            DcsrData out;
+            out.nrows = this->getNrows();
+            out.ncols = this->getNcols();
+            CsrData bufferA;
+            CsrData bufferB;
+            sq_dcsr_ewisemult(a->getRows(bufferA), b->getRows(bufferB), out);
+            this->assign(std::move(out));
+            return;
+        }
+
+        if (a->isTiled() || b->isTiled()) {
+            TileData bufferA;
+            TileData bufferB;
+            TileData out;
+            out.nrows = this->getNrows();
+            out.ncols = this->getNcols();
+            sq_tiles_ewisemult(a->getTiles(bufferA), b->getTiles(bufferB), out);
+            this->assign(std::move(out));
+            return;
+        }
+
+        CsrData out;
+        out.nrows = this->getNrows();
+        out.ncols = this->getNcols();
+
+        CsrData bufferA;
+        CsrData bufferB;
+        sq_ewisemult(a->getData(bufferA), b->getData(bufferB), out);
+
+        this->assign(std::move(out));
+    }
+
+    void SqMatrix::eWiseDiff(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) {
+        auto a = dynamic_cast<const SqMatrix*>(&aBase);
+        auto b = dynamic_cast<const SqMatrix*>(&bBase);
+
+        CHECK_RAISE_ERROR(a != nullptr, InvalidArgument, "Provided matrix does not belongs to sequential matrix class");
+        CHECK_RAISE_ERROR(b != nullptr, InvalidArgument, "Provided matrix does not belongs to sequential matrix class");
+
+        assert(a->getNrows() == this->getNrows());
+        assert(a->getNcols() == this->getNcols());
+        assert(a->getNrows() == b->getNrows());
+        assert(a->getNcols() == b->getNcols());
+
+        if (a->isHypersparse() || b->isHypersparse()) {
+            DcsrData out;
+            out.nrows = this->getNrows();
+            out.ncols = this->getNcols();
+            CsrData bufferA;
+            CsrData bufferB;
+            sq_dcsr_ewisediff(a->getRows(bufferA), b->getRows(bufferB), out);
+            this->assign(std::move(out));
+            return;
+        }
+
+        if (a->isTiled() || b->isTiled()) {
+            TileData bufferA;
+            TileData bufferB;
+            TileData out;
+            out.nrows = this->getNrows();
+            out.ncols = this->getNcols();
+            sq_tiles_ewisediff(a->getTiles(bufferA), b->getTiles(bufferB), out);
+            this->assign(std::move(out));
+            return;
+        }
+
+        CsrData out;
+        out.nrows = this->getNrows();
+        out.ncols = this->getNcols();
+
+        CsrData bufferA;
+        CsrData bufferB;
+        sq_ewisediff(a->getData(bufferA), b->getData(bufferB), out);
+
+        this->assign(std::move(out));
     }
 
     index SqMatrix::getNrows() const {
@@ -220,10 +735,246 @@ namespace spbla {
     }
 
     index SqMatrix::getNvals() const {
-        return mData.nvals;
+        return mHypersparse? mHyper.nvals: (mTiled? mTiles.nvals: mData.nvals + mDelta.size());
+    }
+
+    uint64_t SqMatrix::getStorageBytes() const {
+        // Hypersparse storage keeps indices and offsets only of not empty rows
+        if (mHypersparse)
+            return sizeof(index) * (2 * (uint64_t) mHyper.rowIndices.size() + 1 + (uint64_t) mHyper.nvals);
+
+        return MatrixBase::getStorageBytes();
+    }
+
+    void SqMatrix::setKeepTransposed(bool keep) {
+        mKeepTransposed = keep;
+
+        if (!keep)
+            invalidateTransposed();
+    }
+
+    const CsrData &SqMatrix::getData(CsrData &buffer) const {
+        if (mHypersparse || mTiled) {
+            buffer = CsrData();
+            buffer.nrows = getNrows();
+            buffer.ncols = getNcols();
+
+            if (mHypersparse)
+                sq_dcsr_to_csr(mHyper, buffer);
+            else
+                sq_tiles_to_csr(mTiles, buffer);
+
+            return buffer;
+        }
+
+        allocateStorage();
+
+        // Buffered values are not merged into the storage on read, it is done on write once buffer is large
+        if (!mDelta.empty()) {
+            mDelta.merge(mData, buffer);
+            return buffer;
+        }
+
+        return mData;
+    }
+
+    const CsrData &SqMatrix::getTransposed(CsrData &buffer) const {
+        if (mTransposedValid)
+            return mTransposed;
+
+        // Transposed data is stored by the matrix only on request, otherwise it lives for one operation
+        CsrData& out = mKeepTransposed? mTransposed: buffer;
+
+        TraceScope trace("sq_matrix:transposed");
+        trace.arg("kept", (uint64_t) mKeepTransposed);
+
+        out = CsrData();
+        out.nrows = getNcols();
+        out.ncols = getNrows();
+
+        CsrData data;
+        sq_transpose(getData(data), out);
+        mTransposedValid = mKeepTransposed;
+
+        return out;
+    }
+
+    bool SqMatrix::isHypersparse() const {
+        return mHypersparse;
+    }
+
+    bool SqMatrix::isTiled() const {
+        return mTiled;
+    }
+
+    const TileData &SqMatrix::getTiles(TileData &buffer) const {
+        if (mTiled)
+            return mTiles;
+
+        CsrData data;
+        buffer.nrows = getNrows();
+        buffer.ncols = getNcols();
+        sq_tiles_from_csr(getData(data), buffer);
+        return buffer;
+    }
+
+    void SqMatrix::fillBits(BitMatrix &out) const {
+        if (mTiled) {
+            sq_bits_or_tiles(mTiles, out);
+            return;
+        }
+
+        CsrData data;
+        sq_bits_or_csr(getData(data), out);
+    }
+
+    RowsView SqMatrix::getRows(CsrData &buffer) const {
+        if (mHypersparse)
+            return RowsView(mHyper);
+
+        return RowsView(getData(buffer));
+    }
+
+    bool SqMatrix::hasTransposed() const {
+        return mTransposedValid;
+    }
+
+    size_t SqMatrix::getTransposedCost() const {
+        // Kept transposed data is built once and reused until the matrix is modified
+        return hasTransposed() || mKeepTransposed? 0: getNvals();
+    }
+
+    void SqMatrix::resetDerived() {
+        mDelta.clear();
+        mCsrView = CsrData();
+        invalidateTransposed();
+    }
+
+    void SqMatrix::invalidateTransposed() {
+        mTransposedValid = false;
+        mTransposed = CsrData();
+    }
+
+    void SqMatrix::assign(CsrData &&data) {
+        mData = std::move(data);
+        mHypersparse = false;
+        mHyper = DcsrData();
+        mTiled = false;
+        mTiles = TileData();
+        resetDerived();
+        selectStorage();
+    }
+
+    void SqMatrix::assign(DcsrData &&data) {
+        mHyper = std::move(data);
+        mHypersparse = true;
+        mTiled = false;
+        mTiles = TileData();
+        mData = CsrData();
+        mData.nrows = mHyper.nrows;
+        mData.ncols = mHyper.ncols;
+        resetDerived();
+        selectStorage();
+    }
+
+    void SqMatrix::assign(TileData &&data) {
+        mTiles = std::move(data);
+        mTiled = true;
+        mHypersparse = false;
+        mHyper = DcsrData();
+        mData = CsrData();
+        mData.nrows = mTiles.nrows;
+        mData.ncols = mTiles.ncols;
+        resetDerived();
+        selectStorage();
+    }
+
+    void SqMatrix::assignAccumulated(DcsrData &&data, bool accumulate) {
+        if (accumulate) {
+            DcsrData out;
+            out.nrows = getNrows();
+            out.ncols = getNcols();
+            CsrData buffer;
+            sq_dcsr_ewiseadd(getRows(buffer), RowsView(data), out);
+            data = std::move(out);
+        }
+
+        assign(std::move(data));
+    }
+
+    void SqMatrix::assignAccumulated(TileData &&data, bool accumulate) {
+        if (accumulate) {
+            TileData buffer;
+            TileData out;
+            out.nrows = getNrows();
+            out.ncols = getNcols();
+            sq_tiles_ewiseadd(getTiles(buffer), data, out);
+            data = std::move(out);
+        }
+
+        assign(std::move(data));
+    }
+
+    void SqMatrix::selectStorage() {
+        auto nrows = getNrows();
+        auto ncols = getNcols();
+
+        // Current storage is kept while it fits the values, otherwise csr is converted to the better one
+        if (mHypersparse && mHyper.rowIndices.size() * HYPERSPARSE_FACTOR < nrows)
+            return;
+
+        if (mTiled && sq_tiles_prefer(mTiles))
+            return;
+
+        if (mHypersparse) {
+            sq_dcsr_to_csr(mHyper, mData);
+            mHyper = DcsrData();
+            mHypersparse = false;
+        }
+
+        if (mTiled) {
+            sq_tiles_to_csr(mTiles, mData);
+            mTiles = TileData();
+            mTiled = false;
+        }
+
+        allocateStorage();
+        assert(mDelta.empty());
+
+        // Row count is reported by the kernel which filled the data, so rows are not scanned here
+        assert(mData.nrowsNotEmpty == sq_csr_count_rows(mData));
+
+        if (mData.nrowsNotEmpty * HYPERSPARSE_FACTOR < nrows) {
+            DcsrData data;
+            data.nrows = nrows;
+            data.ncols = ncols;
+            sq_dcsr_from_csr(mData, data);
+
+            mHyper = std::move(data);
+            mData = CsrData();
+            mData.nrows = nrows;
+            mData.ncols = ncols;
+            mHypersparse = true;
+        }
+        else if (sq_csr_prefer_tiles(mData)) {
+            TileData data;
+            data.nrows = nrows;
+            data.ncols = ncols;
+            sq_tiles_from_csr(mData, data);
+
+            mTiles = std::move(data);
+            mData = CsrData();
+            mData.nrows = nrows;
+            mData.ncols = ncols;
+            mTiled = true;
+        }
     }
 
     void SqMatrix::allocateStorage() const {
+        // Hypersparse and tiled storage is never converted here, its csr arrays are restored into buffer (see getData)
+        assert(!mHypersparse);
+        assert(!mTiled);
+
         if (mData.rowOffsets.size() != getNrows() + 1) {
             mData.rowOffsets.clear();
             mData.rowOffsets.resize(getNrows() + 1, 0);
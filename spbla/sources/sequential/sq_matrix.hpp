@@ -27,11 +27,18 @@
 
 #include <backend/matrix_base.hpp>
 #include <sequential/sq_csr_data.hpp>
+#include <sequential/sq_csr_delta.hpp>
+#include <sequential/sq_dcsr_data.hpp>
+#include <sequential/sq_tiles_data.hpp>
+#include <sequential/sq_spgemm_dense.hpp>
 
 namespace spbla {
 
     /**
      * Csr matrix for Cpu side operations in sequential backend.
+     * Matrix with few not empty rows is stored as dcsr (see HYPERSPARSE_FACTOR),
+     * matrix with the most of values in dense blocks is stored as bitmask tiles (see TileData),
+     * storage is selected after each write.
      */
     class SqMatrix final: public MatrixBase {
     public:
@@ -40,7 +47,11 @@ namespace spbla {
 
         void setElement(index i, index j) override;
         void build(const index *rows, const index *cols, size_t nvals, bool isSorted, bool noDuplicates) override;
+        void insert(const index *rows, const index *cols, size_t nvals) override;
+        void buildCsr(std::vector<index> &&rowOffsets, std::vector<index> &&colIndices, bool isSorted, bool noDuplicates) override;
         void extract(index *rows, index *cols, size_t &nvals) override;
+        void extractCsr(const index* &rowOffsets, const index* &colIndices) override;
+        void releaseCsr() override;
         void extractSubMatrix(const MatrixBase &otherBase, index i, index j, index nrows, index ncols,
                               bool checkTime) override;
 
@@ -49,18 +60,64 @@ namespace spbla {
         void reduce(const MatrixBase &otherBase, bool checkTime) override;
 
         void multiply(const MatrixBase &aBase, const MatrixBase &bBase, bool accumulate, bool checkTime) override;
+        void multiplyTransposed(const MatrixBase &aBase, const MatrixBase &bBase, bool transposeA, bool transposeB, bool accumulate, bool checkTime) override;
+        void multiplyMasked(const MatrixBase &maskBase, const MatrixBase &aBase, const MatrixBase &bBase, bool complement, bool accumulate, bool checkTime) override;
         void kronecker(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
         void eWiseAdd(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
+        void eWiseMult(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
+        void eWiseDiff(const MatrixBase &aBase, const MatrixBase &bBase, bool checkTime) override;
 
         index getNrows() const override;
         index getNcols() const override;
         index getNvals() const override;
+        uint64_t getStorageBytes() const override;
+
+        void setKeepTransposed(bool keep) override;
+
+        /** Replace values of the matrix by csr data, storage is selected for the new values */
+        void assign(CsrData&& data);
+        /** Replace values of the matrix by tiles, storage is selected for the new values */
+        void assign(TileData&& data);
+        /** Set bits of the matrix values in the bit matrix */
+        void fillBits(BitMatrix& out) const;
+
+        /** @return True if matrix is stored as dcsr */
+        bool isHypersparse() const;
+        /** @return True if matrix is stored as tiles */
+        bool isTiled() const;
+        /** @return Tiles of the matrix (csr storage is converted into buffer) */
+        const TileData& getTiles(TileData& buffer) const;
+        /** @return Rows of the matrix storage (csr or dcsr, tiles are converted into buffer) */
+        RowsView getRows(CsrData& buffer) const;
+        /** @return Csr data of the matrix (hypersparse and tiled storage is kept, its csr arrays are restored into buffer, as well as storage with buffered inserted values) */
+        const CsrData& getData(CsrData& buffer) const;
+        /** @return Csr data of the transposed matrix (kept until write with keep transposed hint, otherwise built into buffer) */
+        const CsrData& getTransposed(CsrData& buffer) const;
+        /** @return True if transposed data is built and valid */
+        bool hasTransposed() const;
+        /** @return Additional cost of the transposed data access (zero if it is built or kept by the matrix) */
+        size_t getTransposedCost() const;
 
     private:
 
+        void assign(DcsrData&& data);
+        void assignAccumulated(DcsrData&& data, bool accumulate);
+        void assignAccumulated(TileData&& data, bool accumulate);
+        void selectStorage();
         void allocateStorage() const;
+        void invalidateTransposed();
+        void resetDerived();
 
         mutable CsrData mData;
+        DcsrData mHyper;
+        bool mHypersparse = true;
+        TileData mTiles;
+        bool mTiled = false;
+        mutable CsrData mTransposed;
+        mutable bool mTransposedValid = false;
+        bool mKeepTransposed = false;
+        CsrDelta mDelta;
+        CsrData mCsrView;
     };
 
 }
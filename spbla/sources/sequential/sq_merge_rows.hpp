@@ -0,0 +1,154 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_SQ_MERGE_ROWS_HPP
+#define SPBLA_SQ_MERGE_ROWS_HPP
+
+#include <core/config.hpp>
+#include <algorithm>
+#include <cstddef>
+
+namespace spbla {
+
+    /** Ratio of rows lengths, after which linear merge is replaced by galloping search in the longer row */
+    static const size_t GALLOP_RATIO = 16;
+
+    /**
+     * Exponential search of the first value not less than target.
+     *
+     * @return Position in [first, last) or last, if all values are less than target
+     */
+    inline const index* sq_gallop(const index* first, const index* last, index target) {
+        size_t step = 1;
+
+        while (first + step < last && first[step] < target) {
+            first += step;
+            step <<= 1;
+        }
+
+        return std::lower_bound(first, std::min(first + step + 1, last), target);
+    }
+
+    /**
+     * Intersection of two sorted rows `a` and `b`.
+     * Emits found values as emit(first, count) ranges.
+     */
+    template<typename Emit>
+    inline void sq_merge_intersect(const index* ar, const index* arend, const index* br, const index* brend, Emit&& emit) {
+        auto asize = (size_t) (arend - ar);
+        auto bsize = (size_t) (brend - br);
+
+        if (asize == 0 || bsize == 0)
+            return;
+
+        // Walk the short row, gallop in the long one
+        if (asize * GALLOP_RATIO <= bsize || bsize * GALLOP_RATIO <= asize) {
+            if (asize > bsize) {
+                std::swap(ar, br);
+                std::swap(arend, brend);
+            }
+
+            for (; ar != arend; ar++) {
+                br = sq_gallop(br, brend, *ar);
+
+                if (br == brend)
+                    return;
+                if (*br == *ar)
+                    emit(ar, 1);
+            }
+
+            return;
+        }
+
+        while (ar != arend && br != brend) {
+            if (*ar == *br) {
+                emit(ar, 1);
+                ar++;
+                br++;
+            }
+            else if (*ar < *br) {
+                ar++;
+            }
+            else {
+                br++;
+            }
+        }
+    }
+
+    /**
+     * Difference of two sorted rows `a` and `b` (values of `a` not present in `b`).
+     * Emits found values as emit(first, count) ranges.
+     */
+    template<typename Emit>
+    inline void sq_merge_difference(const index* ar, const index* arend, const index* br, const index* brend, Emit&& emit) {
+        auto asize = (size_t) (arend - ar);
+        auto bsize = (size_t) (brend - br);
+
+        if (asize == 0)
+            return;
+
+        if (bsize * GALLOP_RATIO <= asize) {
+            // Long runs of `a` between values of `b` are emitted at once
+            for (; br != brend && ar != arend; br++) {
+                auto found = sq_gallop(ar, arend, *br);
+                emit(ar, (size_t) (found - ar));
+                ar = found;
+
+                if (ar != arend && *ar == *br)
+                    ar++;
+            }
+        }
+        else if (asize * GALLOP_RATIO <= bsize) {
+            // Check each value of `a` in the long row `b`
+            for (; ar != arend; ar++) {
+                br = sq_gallop(br, brend, *ar);
+
+                if (br == brend)
+                    break;
+                if (*br != *ar)
+                    emit(ar, 1);
+            }
+        }
+        else {
+            while (ar != arend && br != brend) {
+                if (*ar == *br) {
+                    ar++;
+                    br++;
+                }
+                else if (*ar < *br) {
+                    emit(ar, 1);
+                    ar++;
+                }
+                else {
+                    br++;
+                }
+            }
+        }
+
+        emit(ar, (size_t) (arend - ar));
+    }
+
+}
+
+#endif //SPBLA_SQ_MERGE_ROWS_HPP
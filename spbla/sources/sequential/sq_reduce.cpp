@@ -38,7 +38,7 @@ namespace spbla {
             }
         }
 
-        exclusive_scan(out.rowOffsets.begin(), out.rowOffsets.end(), 0);
+        exclusive_scan_offsets(out.rowOffsets.begin(), out.rowOffsets.end(), out.nrowsNotEmpty);
 
         out.nvals = out.rowOffsets.back();
         out.colIndices.clear();
@@ -23,74 +23,74 @@
 /**********************************************************************************/
 
 #include <sequential/sq_spgemm.hpp>
+#include <sequential/sq_spgemm_accumulator.hpp>
+#include <io/tracer.hpp>
 #include <utils/exclusive_scan.hpp>
-#include <algorithm>
-#include <limits>
 
 namespace spbla {
 
-    void sq_spgemm(const CsrData& a, const CsrData& b, CsrData& out) {
-        index max = std::numeric_limits<index>::max();
+    static void spgemm(const CsrData& a, const CsrData& b, const CsrData* c, CsrData& out) {
+        using Kind = SpgemmAccumulator::Kind;
+
+        TraceScope trace("sq_spgemm:binning");
+        trace.arg("nrows", a.nrows);
 
-        // Evaluate total nnz and nnz per row
-        size_t nvals = 0;
-        out.rowOffsets.resize(a.nrows + 1);
-        std::vector<index> mask(b.ncols, max);
+        // Bin rows by upper bound of nnz, so each bin is processed by the best accumulator
+        std::vector<size_t> upperBounds(a.nrows);
+        std::vector<Kind> kinds(a.nrows);
+        std::vector<index> binsOffsets(SpgemmAccumulator::KINDS_COUNT + 1, 0);
 
         for (index i = 0; i < a.nrows; i++) {
-            size_t nvalsInRow = 0;
+            upperBounds[i] = SpgemmAccumulator::upperBound(a, b, c, i);
+            kinds[i] = SpgemmAccumulator::select(a.rowOffsets[i + 1] - a.rowOffsets[i], upperBounds[i], b.ncols);
+            binsOffsets[(size_t) kinds[i]] += 1;
+        }
+
+        exclusive_scan(binsOffsets.begin(), binsOffsets.end(), (index) 0);
 
-            for (index ak = a.rowOffsets[i]; ak < a.rowOffsets[i + 1]; ak++) {
-                index k = a.colIndices[ak];
+        std::vector<index> binnedRows(a.nrows);
+        std::vector<index> binsFill(binsOffsets.begin(), binsOffsets.end() - 1);
+
+        for (index i = 0; i < a.nrows; i++) {
+            binnedRows[binsFill[(size_t) kinds[i]]++] = i;
+        }
 
-                for (index bk = b.rowOffsets[k]; bk < b.rowOffsets[k + 1]; bk++) {
-                    index j = b.colIndices[bk];
+        // Empty rows bin is skipped
+        index firstRow = binsOffsets[(size_t) Kind::Copy];
+        SpgemmAccumulator accumulator;
 
-                    // Do not compute col nnz twice
-                    if (mask[j] != i) {
-                        mask[j] = i;
-                        nvalsInRow += 1;
-                    }
-                }
-            }
+        // Evaluate nnz per row
+        trace.next("sq_spgemm:symbolic");
+        out.rowOffsets.clear();
+        out.rowOffsets.resize(a.nrows + 1, 0);
 
-            nvals += nvalsInRow;
-            out.rowOffsets[i] = nvalsInRow;
+        for (index r = firstRow; r < a.nrows; r++) {
+            index i = binnedRows[r];
+            out.rowOffsets[i] = accumulator.count(kinds[i], a, b, c, i, upperBounds[i]);
         }
 
         // Row offsets
-        exclusive_scan(out.rowOffsets.begin(), out.rowOffsets.end(), 0);
+        exclusive_scan_offsets(out.rowOffsets.begin(), out.rowOffsets.end(), out.nrowsNotEmpty);
 
-        out.nvals = nvals;
-        out.colIndices.resize(nvals);
+        out.nvals = out.rowOffsets.back();
+        out.colIndices.resize(out.nvals);
 
-        // Fill column indices per row and sort
-        mask.clear();
-        mask.resize(b.ncols, max);
+        // Fill sorted column indices per row
+        trace.next("sq_spgemm:numeric");
+        trace.arg("nnz", out.nvals);
 
-        for (index i = 0; i < a.nrows; i++) {
-            size_t id = 0;
-            size_t first = out.rowOffsets[i];
-            size_t last = out.rowOffsets[i + 1];
-
-            for (index ak = a.rowOffsets[i]; ak < a.rowOffsets[i + 1]; ak++) {
-                index k = a.colIndices[ak];
-
-                for (index bk = b.rowOffsets[k]; bk < b.rowOffsets[k + 1]; bk++) {
-                    index j = b.colIndices[bk];
-
-                    // Do not compute col nnz twice
-                    if (mask[j] != i) {
-                        mask[j] = i;
-                        out.colIndices[first + id] = j;
-                        id += 1;
-                    }
-                }
-            }
-
-            // Sort indices within row
-            std::sort(out.colIndices.begin() + first, out.colIndices.begin() + last);
+        for (index r = firstRow; r < a.nrows; r++) {
+            index i = binnedRows[r];
+            accumulator.fill(kinds[i], a, b, c, i, upperBounds[i], out.colIndices.data() + out.rowOffsets[i]);
         }
     }
 
-}
\ No newline at end of file
+    void sq_spgemm(const CsrData& a, const CsrData& b, CsrData& out) {
+        spgemm(a, b, nullptr, out);
+    }
+
+    void sq_spgemm_accumulate(const CsrData& a, const CsrData& b, const CsrData& c, CsrData& out) {
+        spgemm(a, b, &c, out);
+    }
+
+}
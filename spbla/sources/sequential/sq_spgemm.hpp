@@ -38,6 +38,17 @@ namespace spbla {
      */
     void sq_spgemm(const CsrData& a, const CsrData& b, CsrData& out);
 
+    /**
+     * Fused matrix-matrix multiplication and addition out = c + a x b.
+     * Accumulator of each row is seeded with the row of `c`, so result is written once.
+     *
+     * @param a Input matrix
+     * @param b Input matrix
+     * @param c Input matrix to add
+     * @param[out] out Where to store result (must differ from inputs)
+     */
+    void sq_spgemm_accumulate(const CsrData& a, const CsrData& b, const CsrData& c, CsrData& out);
+
 }
 
 #endif //SPBLA_SQ_SPGEMM_HPP
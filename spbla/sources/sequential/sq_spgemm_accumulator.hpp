@@ -0,0 +1,507 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_SQ_SPGEMM_ACCUMULATOR_HPP
+#define SPBLA_SQ_SPGEMM_ACCUMULATOR_HPP
+
+#include <sequential/sq_csr_data.hpp>
+#include <utils/bits.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace spbla {
+
+    /**
+     * Row accumulator for Gustavson spgemm, which selects strategy per row
+     * by the upper bound of the row nnz (number of flops for the row):
+     *
+     * - Copy: row of `a` has at most single value, result row is the row of `b`
+     *         (merged with the seed row, if present)
+     * - Hash: short rows, small open-addressing hash set, keys sorted on emit
+     * - Mask: medium rows, stamped mask of size `b.ncols`, keys sorted on emit
+     * - Dense: dense rows, bitmap of size `b.ncols`, keys are emitted already sorted
+     *
+     * Optional seed matrix `c` initializes the accumulator with the row of `c`,
+     * so c + a x b is evaluated in a single pass without temporary product.
+     *
+     * Single accumulator must be used by single thread at a time.
+     */
+    class SpgemmAccumulator {
+    public:
+        enum class Kind {
+            Empty = 0,
+            Copy = 1,
+            Hash = 2,
+            Mask = 3,
+            Dense = 4
+        };
+
+        static const size_t KINDS_COUNT = 5;
+
+        /** Max upper bound of row nnz to use hash accumulator */
+        static const size_t HASH_MAX_ROW = 1024;
+
+        /** Row is dense if its nnz upper bound * factor is at least the number of columns */
+        static const size_t DENSE_FACTOR = 16;
+
+        /**
+         * Select accumulator kind for the row.
+         *
+         * @param rowLength Number of values in the row of `a`
+         * @param upperBound Upper bound of result row nnz (flops and seed row length)
+         * @param ncols Number of columns in result
+         */
+        static Kind select(size_t rowLength, size_t upperBound, size_t ncols) {
+            if (upperBound == 0)
+                return Kind::Empty;
+            if (rowLength <= 1)
+                return Kind::Copy;
+            if (upperBound * DENSE_FACTOR >= ncols)
+                return Kind::Dense;
+            if (upperBound <= HASH_MAX_ROW)
+                return Kind::Hash;
+            return Kind::Mask;
+        }
+
+        /** @return Row upper bound of nnz in result of (c +) a x b */
+        static size_t upperBound(const CsrData& a, const CsrData& b, const CsrData* c, index i) {
+            size_t flops = c? c->rowOffsets[i + 1] - c->rowOffsets[i]: 0;
+
+            for (index ak = a.rowOffsets[i]; ak < a.rowOffsets[i + 1]; ak++) {
+                index k = a.colIndices[ak];
+                flops += b.rowOffsets[k + 1] - b.rowOffsets[k];
+            }
+
+            return flops;
+        }
+
+        /**
+         * Evaluate number of values in the row `i` of the (c +) a x b.
+         *
+         * @param c Optional seed matrix (nullptr if no seed)
+         * @param upperBound Row upper bound of nnz
+         */
+        index count(Kind kind, const CsrData& a, const CsrData& b, const CsrData* c, index i, size_t upperBound) {
+            switch (kind) {
+                case Kind::Empty:
+                    return 0;
+                case Kind::Copy: {
+                    return merge<false>(a, b, c, i, nullptr);
+                }
+                case Kind::Hash: {
+                    hashReset(upperBound);
+                    visit(a, b, c, i, [this](index j) { hashInsert(j); });
+                    auto nvals = (index) mSlots.size();
+                    hashClear();
+                    return nvals;
+                }
+                case Kind::Mask: {
+                    index nvals = 0;
+                    maskReset(b.ncols);
+                    visit(a, b, c, i, [this, &nvals](index j) {
+                        if (mMask[j] != mStamp) {
+                            mMask[j] = mStamp;
+                            nvals += 1;
+                        }
+                    });
+                    return nvals;
+                }
+                case Kind::Dense: {
+                    index nvals = 0;
+                    denseReset(b.ncols);
+                    visit(a, b, c, i, [this, &nvals](index j) {
+                        nvals += denseInsert(j)? 1: 0;
+                    });
+                    std::fill(mWords.begin() + mMinWord, mWords.begin() + mMaxWord + 1, 0);
+                    return nvals;
+                }
+                default:
+                    return 0;
+            }
+        }
+
+        /**
+         * Write sorted column indices of the row `i` of the (c +) a x b.
+         *
+         * @param c Optional seed matrix (nullptr if no seed)
+         * @param upperBound Row upper bound of nnz
+         * @param[out] out Where to write indices (must have `count` values)
+         */
+        void fill(Kind kind, const CsrData& a, const CsrData& b, const CsrData* c, index i, size_t upperBound, index* out) {
+            switch (kind) {
+                case Kind::Empty:
+                    return;
+                case Kind::Copy: {
+                    merge<true>(a, b, c, i, out);
+                    return;
+                }
+                case Kind::Hash: {
+                    hashReset(upperBound);
+                    visit(a, b, c, i, [this](index j) { hashInsert(j); });
+                    for (size_t s = 0; s < mSlots.size(); s++)
+                        out[s] = mTable[mSlots[s]];
+                    std::sort(out, out + mSlots.size());
+                    hashClear();
+                    return;
+                }
+                case Kind::Mask: {
+                    index* id = out;
+                    maskReset(b.ncols);
+                    visit(a, b, c, i, [this, &id](index j) {
+                        if (mMask[j] != mStamp) {
+                            mMask[j] = mStamp;
+                            *(id++) = j;
+                        }
+                    });
+                    std::sort(out, id);
+                    return;
+                }
+                case Kind::Dense: {
+                    denseReset(b.ncols);
+                    visit(a, b, c, i, [this](index j) { denseInsert(j); });
+                    for (size_t w = mMinWord; w <= mMaxWord; w++) {
+                        uint64_t word = mWords[w];
+                        while (word) {
+                            *(out++) = (index) (w * BITS_IN_WORD + lowestBit(word));
+                            word &= word - 1;
+                        }
+                        mWords[w] = 0;
+                    }
+                    return;
+                }
+                default:
+                    return;
+            }
+        }
+
+    private:
+        static const size_t BITS_IN_WORD = 64;
+        static const size_t HASH_MIN_CAPACITY = 16;
+        static const index HASH_SCALE = 107;
+        static constexpr index EMPTY = std::numeric_limits<index>::max();
+
+        template<typename Op>
+        static void visit(const CsrData& a, const CsrData& b, const CsrData* c, index i, Op&& op) {
+            if (c) {
+                for (index ck = c->rowOffsets[i]; ck < c->rowOffsets[i + 1]; ck++) {
+                    op(c->colIndices[ck]);
+                }
+            }
+
+            for (index ak = a.rowOffsets[i]; ak < a.rowOffsets[i + 1]; ak++) {
+                index k = a.colIndices[ak];
+
+                for (index bk = b.rowOffsets[k]; bk < b.rowOffsets[k + 1]; bk++) {
+                    op(b.colIndices[bk]);
+                }
+            }
+        }
+
+        /** Merge of sorted row of `b` (if row of `a` has single value) and row of `c` */
+        template<bool Fill>
+        static index merge(const CsrData& a, const CsrData& b, const CsrData* c, index i, index* out) {
+            const index* first1 = nullptr;
+            const index* last1 = nullptr;
+            const index* first2 = nullptr;
+            const index* last2 = nullptr;
+
+            if (a.rowOffsets[i] != a.rowOffsets[i + 1]) {
+                index k = a.colIndices[a.rowOffsets[i]];
+                first1 = b.colIndices.data() + b.rowOffsets[k];
+                last1 = b.colIndices.data() + b.rowOffsets[k + 1];
+            }
+
+            if (c) {
+                first2 = c->colIndices.data() + c->rowOffsets[i];
+                last2 = c->colIndices.data() + c->rowOffsets[i + 1];
+            }
+
+            index nvals = 0;
+
+            while (first1 != last1 && first2 != last2) {
+                index j1 = *first1;
+                index j2 = *first2;
+
+                first1 += j1 <= j2? 1: 0;
+                first2 += j2 <= j1? 1: 0;
+
+                if (Fill) out[nvals] = std::min(j1, j2);
+                nvals += 1;
+            }
+
+            index rest1 = (index) (last1 - first1);
+            index rest2 = (index) (last2 - first2);
+
+            if (Fill) {
+                std::copy(first1, last1, out + nvals);
+                std::copy(first2, last2, out + nvals + rest1);
+            }
+
+            return nvals + rest1 + rest2;
+        }
+
+        void hashReset(size_t upperBound) {
+            size_t capacity = HASH_MIN_CAPACITY;
+            while (capacity < 2 * upperBound)
+                capacity *= 2;
+
+            if (mTable.size() < capacity)
+                mTable.resize(capacity, EMPTY);
+
+            // Use only prefix of the table, so short rows touch less memory
+            mHashMask = capacity - 1;
+        }
+
+        void hashInsert(index j) {
+            size_t slot = (j * HASH_SCALE) & mHashMask;
+
+            while (true) {
+                index key = mTable[slot];
+
+                if (key == j)
+                    return;
+
+                if (key == EMPTY) {
+                    mTable[slot] = j;
+                    mSlots.push_back(slot);
+                    return;
+                }
+
+                slot = (slot + 1) & mHashMask;
+            }
+        }
+
+        void hashClear() {
+            for (auto slot: mSlots)
+                mTable[slot] = EMPTY;
+            mSlots.clear();
+        }
+
+        void maskReset(index ncols) {
+            if (mMask.size() != ncols) {
+                mMask.clear();
+                mMask.resize(ncols, EMPTY);
+                mStamp = 0;
+            }
+
+            // Each row has unique stamp, so mask is refilled only on stamps overflow
+            mStamp += 1;
+            if (mStamp == EMPTY) {
+                std::fill(mMask.begin(), mMask.end(), EMPTY);
+                mStamp = 0;
+            }
+        }
+
+        void denseReset(index ncols) {
+            size_t words = (ncols + BITS_IN_WORD - 1) / BITS_IN_WORD;
+            if (mWords.size() != words) {
+                mWords.clear();
+                mWords.resize(words, 0);
+            }
+
+            mMinWord = words;
+            mMaxWord = 0;
+        }
+
+        bool denseInsert(index j) {
+            size_t w = j / BITS_IN_WORD;
+            uint64_t bit = 1ull << (j % BITS_IN_WORD);
+            uint64_t word = mWords[w];
+
+            mMinWord = std::min(mMinWord, w);
+            mMaxWord = std::max(mMaxWord, w);
+            mWords[w] = word | bit;
+
+            return (word & bit) == 0;
+        }
+
+        std::vector<index> mTable;
+        std::vector<size_t> mSlots;
+        size_t mHashMask = 0;
+
+        std::vector<index> mMask;
+        index mStamp = 0;
+
+        std::vector<uint64_t> mWords;
+        size_t mMinWord = 0;
+        size_t mMaxWord = 0;
+    };
+
+    /**
+     * Row accumulator for masked Gustavson spgemm (result<mask> = a x b).
+     *
+     * Mask row is marked in the stamped states array before accumulation, so masked-out
+     * columns are skipped during accumulation. Without complement the result row is
+     * emitted in the order of the mask row, so no sort is required; accumulation of the
+     * row stops as soon as all mask row values are hit.
+     *
+     * Optional seed matrix `c` initializes the accumulator with the row of `c` (not masked),
+     * so c + (a x b)<mask> is evaluated in a single pass without temporary product.
+     *
+     * Single accumulator must be used by single thread at a time.
+     */
+    class MaskedSpgemmAccumulator {
+    public:
+        /** @return Number of values in the row `i` of the (c +) (a x b)<mask> */
+        index count(const CsrData& a, const CsrData& b, const CsrData* c, const CsrData& mask, bool complement, index i) {
+            return process<false>(a, b, c, mask, complement, i, nullptr);
+        }
+
+        /** Write sorted column indices of the row `i` of the (c +) (a x b)<mask> into `out` */
+        void fill(const CsrData& a, const CsrData& b, const CsrData* c, const CsrData& mask, bool complement, index i, index* out) {
+            process<true>(a, b, c, mask, complement, i, out);
+        }
+
+    private:
+        static constexpr index EMPTY = std::numeric_limits<index>::max();
+
+        template<bool Fill>
+        index process(const CsrData& a, const CsrData& b, const CsrData* c, const CsrData& mask, bool complement, index i, index* out) {
+            index maskFirst = mask.rowOffsets[i];
+            index maskLast = mask.rowOffsets[i + 1];
+            index maskLength = maskLast - maskFirst;
+
+            const index* seed = c? c->colIndices.data(): nullptr;
+            index seedFirst = c? c->rowOffsets[i]: 0;
+            index seedLast = c? c->rowOffsets[i + 1]: 0;
+            index seedLength = seedLast - seedFirst;
+
+            // Nothing is accumulated, result row is the seed row
+            if (a.rowOffsets[i] == a.rowOffsets[i + 1] || (!complement && maskLength == 0)) {
+                if (Fill)
+                    std::copy(seed + seedFirst, seed + seedLast, out);
+
+                return seedLength;
+            }
+
+            index nvals = 0;
+
+            if (complement) {
+                // Masked-out columns are marked as already visited
+                index visited = nextStamps(b.ncols, 1);
+
+                for (index mk = maskFirst; mk < maskLast; mk++)
+                    mStates[mask.colIndices[mk]] = visited;
+
+                // Seed row is not masked, its values go first and are visited as well
+                for (index sk = seedFirst; sk < seedLast; sk++) {
+                    mStates[seed[sk]] = visited;
+                    if (Fill) out[nvals] = seed[sk];
+                    nvals += 1;
+                }
+
+                for (index ak = a.rowOffsets[i]; ak < a.rowOffsets[i + 1]; ak++) {
+                    index k = a.colIndices[ak];
+
+                    for (index bk = b.rowOffsets[k]; bk < b.rowOffsets[k + 1]; bk++) {
+                        index j = b.colIndices[bk];
+
+                        if (mStates[j] != visited) {
+                            mStates[j] = visited;
+                            if (Fill) out[nvals] = j;
+                            nvals += 1;
+                        }
+                    }
+                }
+
+                if (Fill) {
+                    std::sort(out + seedLength, out + nvals);
+                    std::inplace_merge(out, out + seedLength, out + nvals);
+                }
+
+                return nvals;
+            }
+
+            // Only columns of the mask row are allowed, the ones of the seed row are already in result
+            index allowed = nextStamps(b.ncols, 3);
+            index hit = allowed + 1;
+            index seeded = allowed + 2;
+            index remaining = maskLength;
+
+            for (index mk = maskFirst; mk < maskLast; mk++)
+                mStates[mask.colIndices[mk]] = allowed;
+
+            for (index sk = seedFirst; sk < seedLast; sk++) {
+                if (mStates[seed[sk]] == allowed) {
+                    mStates[seed[sk]] = seeded;
+                    remaining -= 1;
+                }
+            }
+
+            for (index ak = a.rowOffsets[i]; ak < a.rowOffsets[i + 1] && nvals < remaining; ak++) {
+                index k = a.colIndices[ak];
+
+                for (index bk = b.rowOffsets[k]; bk < b.rowOffsets[k + 1]; bk++) {
+                    index j = b.colIndices[bk];
+
+                    if (mStates[j] == allowed) {
+                        mStates[j] = hit;
+                        nvals += 1;
+                    }
+                }
+            }
+
+            if (Fill) {
+                // Hit columns are not in the seed row, so both sorted sequences are merged without duplicates
+                index id = 0;
+                index sk = seedFirst;
+
+                for (index mk = maskFirst; mk < maskLast; mk++) {
+                    index j = mask.colIndices[mk];
+
+                    if (mStates[j] == hit) {
+                        while (sk < seedLast && seed[sk] < j)
+                            out[id++] = seed[sk++];
+
+                        out[id++] = j;
+                    }
+                }
+
+                std::copy(seed + sk, seed + seedLast, out + id);
+            }
+
+            return seedLength + nvals;
+        }
+
+        index nextStamps(index ncols, index count) {
+            if (mStates.size() != ncols || mStamp >= EMPTY - count) {
+                mStates.clear();
+                mStates.resize(ncols, EMPTY);
+                mStamp = 0;
+            }
+
+            index stamp = mStamp;
+            mStamp += count;
+            return stamp;
+        }
+
+        std::vector<index> mStates;
+        index mStamp = 0;
+    };
+
+}
+
+#endif //SPBLA_SQ_SPGEMM_ACCUMULATOR_HPP
@@ -0,0 +1,181 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <sequential/sq_spgemm_dense.hpp>
+#include <core/error.hpp>
+#include <utils/bits.hpp>
+#include <io/tracer.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace spbla {
+
+    bool sq_spgemm_prefer_dense(index m, index k, index n, size_t aNvals, size_t bNvals) {
+        if (aNvals == 0 || bNvals == 0)
+            return false;
+
+        // Values of `a` select rows of `b` of average length
+        double products = (double) aNvals * (double) bNvals / (double) k;
+
+        if (products < (double) DENSE_MIN_PRODUCTS)
+            return false;
+
+        double stride = (double) ((n + 63) / 64);
+        double groups = (double) ((k + DENSE_GROUP_BITS - 1) / DENSE_GROUP_BITS);
+        double convert = ((double) m * k + (double) k * n + (double) m * n) / 64.0;
+        double dense = groups * (double) (DENSE_TABLE_SIZE + m) * stride + convert;
+
+        return dense < products * DENSE_PRODUCT_COST;
+    }
+
+    void sq_bits_init(index nrows, index ncols, BitMatrix& out) {
+        out.nrows = nrows;
+        out.ncols = ncols;
+        out.stride = (ncols + 63) / 64;
+        out.words.clear();
+        out.words.resize((size_t) nrows * out.stride, 0);
+    }
+
+    void sq_bits_or_csr(const CsrData& a, BitMatrix& out) {
+        for (index i = 0; i < a.nrows; i++) {
+            uint64_t* row = out.row(i);
+
+            for (auto k = a.rowOffsets[i]; k < a.rowOffsets[i + 1]; k++) {
+                index j = a.colIndices[k];
+                row[j / 64] |= 1ull << (j % 64);
+            }
+        }
+    }
+
+    void sq_bits_or_tiles(const TileData& a, BitMatrix& out) {
+        // Tile column matches the word of the bit matrix row
+        for (index tileRow = 0; tileRow < a.tileRows(); tileRow++) {
+            index base = tileRow * TILE_SIZE;
+            index rows = std::min<index>(TILE_SIZE, a.nrows - base);
+
+            for (size_t t = a.tileRowOffsets[tileRow]; t < a.tileRowOffsets[tileRow + 1]; t++) {
+                index w = a.tileCols[t];
+
+                if (a.isDense(t)) {
+                    for (index r = 0; r < rows; r++)
+                        out.row(base + r)[w] |= a.words[a.wordOffsets[t] + r];
+                }
+                else {
+                    for (size_t k = a.entryOffsets[t]; k < a.entryOffsets[t + 1]; k++) {
+                        auto entry = a.entries[k];
+                        out.row(base + entry / TILE_SIZE)[w] |= 1ull << (entry % TILE_SIZE);
+                    }
+                }
+            }
+        }
+    }
+
+    void sq_bits_to_csr(const BitMatrix& a, CsrData& out) {
+        out.rowOffsets.clear();
+        out.rowOffsets.reserve(a.nrows + 1);
+        out.rowOffsets.push_back(0);
+        out.colIndices.clear();
+        out.nrowsNotEmpty = 0;
+
+        for (index i = 0; i < a.nrows; i++) {
+            const uint64_t* row = a.row(i);
+
+            for (size_t w = 0; w < a.stride; w++) {
+                uint64_t word = row[w];
+                while (word) {
+                    out.colIndices.push_back((index) (w * 64 + lowestBit(word)));
+                    word &= word - 1;
+                }
+            }
+
+            out.nrowsNotEmpty += out.colIndices.size() != out.rowOffsets.back();
+            out.rowOffsets.push_back(out.colIndices.size());
+        }
+
+        CHECK_RAISE_ERROR(out.colIndices.size() <= std::numeric_limits<index>::max(), IndexOverflow, "Number of values of the result exceeds spbla_Index range");
+        out.nvals = out.colIndices.size();
+    }
+
+    void sq_m4r_table(const BitMatrix& b, index first, uint64_t* table) {
+        size_t stride = b.stride;
+
+        std::fill(table, table + stride, 0);
+
+        // Each combination adds single row to the combination without its lowest bit
+        for (size_t mask = 1; mask < DENSE_TABLE_SIZE; mask++) {
+            const uint64_t* prev = table + (mask & (mask - 1)) * stride;
+            uint64_t* current = table + mask * stride;
+            index i = first + lowestBit(mask);
+
+            if (i < b.nrows) {
+                const uint64_t* row = b.row(i);
+                for (size_t s = 0; s < stride; s++)
+                    current[s] = prev[s] | row[s];
+            }
+            else {
+                std::copy(prev, prev + stride, current);
+            }
+        }
+    }
+
+    void sq_m4r_rows(const BitMatrix& a, const uint64_t* tables, size_t w, index first, index last, BitMatrix& out) {
+        size_t stride = out.stride;
+        size_t tableWords = DENSE_TABLE_SIZE * stride;
+
+        for (index i = first; i < last; i++) {
+            uint64_t word = a.row(i)[w];
+            uint64_t* row = out.row(i);
+
+            for (size_t g = 0; word; g++, word >>= DENSE_GROUP_BITS) {
+                size_t mask = word & (DENSE_TABLE_SIZE - 1);
+
+                if (mask) {
+                    const uint64_t* combined = tables + g * tableWords + mask * stride;
+                    for (size_t s = 0; s < stride; s++)
+                        row[s] |= combined[s];
+                }
+            }
+        }
+    }
+
+    void sq_spgemm_m4r(const BitMatrix& a, const BitMatrix& b, BitMatrix& out) {
+        TraceScope trace("sq_spgemm_m4r");
+        trace.arg("nrows", a.nrows);
+
+        size_t tableWords = DENSE_TABLE_SIZE * b.stride;
+        std::vector<uint64_t> tables(DENSE_GROUPS_IN_WORD * tableWords);
+
+        // Tables of the groups of the single word of `a` rows are built, then applied to all rows
+        for (size_t w = 0; w < a.stride; w++) {
+            for (size_t g = 0; g < DENSE_GROUPS_IN_WORD; g++) {
+                size_t first = w * 64 + g * DENSE_GROUP_BITS;
+                if (first < b.nrows)
+                    sq_m4r_table(b, (index) first, tables.data() + g * tableWords);
+            }
+
+            sq_m4r_rows(a, tables.data(), w, 0, a.nrows, out);
+        }
+    }
+
+}
@@ -0,0 +1,113 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_SQ_SPGEMM_DENSE_HPP
+#define SPBLA_SQ_SPGEMM_DENSE_HPP
+
+#include <sequential/sq_csr_data.hpp>
+#include <sequential/sq_tiles_data.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace spbla {
+
+    /** Rows of the right operand are combined by groups of DENSE_GROUP_BITS for lookup tables */
+    static const size_t DENSE_GROUP_BITS = 8;
+
+    /** Number of rows in each lookup table (all combinations of the group rows) */
+    static const size_t DENSE_TABLE_SIZE = 1u << DENSE_GROUP_BITS;
+
+    /** Number of groups, covered by single 64-bit word of the left operand row */
+    static const size_t DENSE_GROUPS_IN_WORD = 64 / DENSE_GROUP_BITS;
+
+    /** Single product of Gustavson kernel costs about DENSE_PRODUCT_COST operations over 64-bit words */
+    static const size_t DENSE_PRODUCT_COST = 8;
+
+    /** Products below this count are cheaper in Gustavson kernel than dense conversion */
+    static const size_t DENSE_MIN_PRODUCTS = 1u << 15;
+
+    /**
+     * Dense boolean matrix: row i is stride 64-bit words, bit j % 64 of the word j / 64 is value (i, j).
+     */
+    class BitMatrix {
+    public:
+        std::vector<uint64_t> words;
+        size_t stride = 0;
+        index nrows = 0;
+        index ncols = 0;
+
+        uint64_t* row(index i) { return words.data() + i * stride; }
+        const uint64_t* row(index i) const { return words.data() + i * stride; }
+    };
+
+    /**
+     * Select Four Russians kernel for the product of m x k and k x n matrices by estimated cost.
+     * Dense cost is building of lookup tables for each group of rows of `b`, lookup for each row of `a`
+     * and group, and conversion of the operands and the result. Gustavson cost is the expected number of products.
+     *
+     * @return True if dense kernel is preferred
+     */
+    bool sq_spgemm_prefer_dense(index m, index k, index n, size_t aNvals, size_t bNvals);
+
+    /** Allocate empty bit matrix of the given shape */
+    void sq_bits_init(index nrows, index ncols, BitMatrix& out);
+
+    /** Set bits of the csr matrix values (out must have the same shape) */
+    void sq_bits_or_csr(const CsrData& a, BitMatrix& out);
+
+    /** Set bits of the tiled matrix values (out must have the same shape) */
+    void sq_bits_or_tiles(const TileData& a, BitMatrix& out);
+
+    /** Convert bit matrix to csr */
+    void sq_bits_to_csr(const BitMatrix& a, CsrData& out);
+
+    /**
+     * Build lookup table of the group of rows [first, first + DENSE_GROUP_BITS) of `b`:
+     * row `mask` of the table is OR of the group rows, selected by bits of the mask.
+     *
+     * @param b Right operand
+     * @param first Index of the first row of the group
+     * @param[out] table Where to store DENSE_TABLE_SIZE x b.stride words
+     */
+    void sq_m4r_table(const BitMatrix& b, index first, uint64_t* table);
+
+    /**
+     * Accumulate into rows [first, last) of `out` products of the word w of `a` rows
+     * by the rows of `b` (DENSE_GROUPS_IN_WORD tables of the word are built already).
+     */
+    void sq_m4r_rows(const BitMatrix& a, const uint64_t* tables, size_t w, index first, index last, BitMatrix& out);
+
+    /**
+     * Matrix-matrix multiplication out += a x b by the Method of Four Russians:
+     * each byte of the `a` row selects precomputed OR of 8 rows of `b`.
+     *
+     * @param a Input matrix
+     * @param b Input matrix
+     * @param[out] out Where to accumulate result (allocated by caller, may contain values to add)
+     */
+    void sq_spgemm_m4r(const BitMatrix& a, const BitMatrix& b, BitMatrix& out);
+
+}
+
+#endif //SPBLA_SQ_SPGEMM_DENSE_HPP
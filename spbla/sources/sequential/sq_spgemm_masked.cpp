@@ -0,0 +1,68 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <sequential/sq_spgemm_masked.hpp>
+#include <sequential/sq_spgemm_accumulator.hpp>
+#include <io/tracer.hpp>
+#include <utils/exclusive_scan.hpp>
+
+namespace spbla {
+
+    static void spgemmMasked(const CsrData& a, const CsrData& b, const CsrData* c, const CsrData& mask, bool complement, CsrData& out) {
+        MaskedSpgemmAccumulator accumulator;
+
+        // Evaluate nnz per row
+        TraceScope trace("sq_spgemm_masked:symbolic");
+        out.rowOffsets.clear();
+        out.rowOffsets.resize(a.nrows + 1, 0);
+
+        for (index i = 0; i < a.nrows; i++) {
+            out.rowOffsets[i] = accumulator.count(a, b, c, mask, complement, i);
+        }
+
+        // Row offsets
+        exclusive_scan_offsets(out.rowOffsets.begin(), out.rowOffsets.end(), out.nrowsNotEmpty);
+
+        out.nvals = out.rowOffsets.back();
+        out.colIndices.resize(out.nvals);
+
+        // Fill sorted column indices per row
+        trace.next("sq_spgemm_masked:numeric");
+        trace.arg("nnz", out.nvals);
+
+        for (index i = 0; i < a.nrows; i++) {
+            if (out.rowOffsets[i] != out.rowOffsets[i + 1])
+                accumulator.fill(a, b, c, mask, complement, i, out.colIndices.data() + out.rowOffsets[i]);
+        }
+    }
+
+    void sq_spgemm_masked(const CsrData& a, const CsrData& b, const CsrData& mask, bool complement, CsrData& out) {
+        spgemmMasked(a, b, nullptr, mask, complement, out);
+    }
+
+    void sq_spgemm_masked_accumulate(const CsrData& a, const CsrData& b, const CsrData& c, const CsrData& mask, bool complement, CsrData& out) {
+        spgemmMasked(a, b, &c, mask, complement, out);
+    }
+
+}
@@ -0,0 +1,59 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_SQ_SPGEMM_MASKED_HPP
+#define SPBLA_SQ_SPGEMM_MASKED_HPP
+
+#include <sequential/sq_csr_data.hpp>
+
+namespace spbla {
+
+    /**
+     * Masked matrix-matrix multiplication out<mask> = a x b.
+     * Masked-out columns are skipped during accumulation.
+     *
+     * @param a Input matrix
+     * @param b Input matrix
+     * @param mask Mask matrix (same shape as result)
+     * @param complement True to use structural complement of the mask
+     * @param[out] out Where to store result
+     */
+    void sq_spgemm_masked(const CsrData& a, const CsrData& b, const CsrData& mask, bool complement, CsrData& out);
+
+    /**
+     * Fused masked matrix-matrix multiplication and addition out = c + (a x b)<mask>.
+     * Accumulator of each row is seeded with the row of `c` (not masked), so result is written once.
+     *
+     * @param a Input matrix
+     * @param b Input matrix
+     * @param c Input matrix to add
+     * @param mask Mask matrix (same shape as result)
+     * @param complement True to use structural complement of the mask
+     * @param[out] out Where to store result (must differ from inputs)
+     */
+    void sq_spgemm_masked_accumulate(const CsrData& a, const CsrData& b, const CsrData& c, const CsrData& mask, bool complement, CsrData& out);
+
+}
+
+#endif //SPBLA_SQ_SPGEMM_MASKED_HPP
@@ -0,0 +1,291 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <sequential/sq_spgemm_transposed.hpp>
+#include <io/tracer.hpp>
+#include <utils/csr_utils.hpp>
+#include <utils/exclusive_scan.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace spbla {
+
+    // Number of products of the a x bT, which is equal to sum of products of the columns lengths
+    static size_t countProducts(const CsrData& a, const CsrData& b) {
+        std::vector<size_t> lengths(a.ncols, 0);
+
+        for (index k = 0; k < a.nvals; k++)
+            lengths[a.colIndices[k]] += 1;
+
+        size_t products = 0;
+        for (index k = 0; k < b.nvals; k++)
+            products += lengths[b.colIndices[k]];
+
+        return products;
+    }
+
+    // Sorted ranges intersection test, stops on the first common value
+    static bool intersects(const index* first1, const index* last1, const index* first2, const index* last2) {
+        size_t length1 = last1 - first1;
+        size_t length2 = last2 - first2;
+
+        if (length1 > length2) {
+            std::swap(first1, first2);
+            std::swap(last1, last2);
+            std::swap(length1, length2);
+        }
+
+        // Much shorter range is searched in the longer one
+        if (length1 * SEARCH_FACTOR < length2) {
+            for (; first1 != last1 && first2 != last2; first1++) {
+                first2 = std::lower_bound(first2, last2, *first1);
+                if (first2 != last2 && *first2 == *first1)
+                    return true;
+            }
+
+            return false;
+        }
+
+        while (first1 != last1 && first2 != last2) {
+            if (*first1 < *first2)
+                first1++;
+            else if (*first2 < *first1)
+                first2++;
+            else
+                return true;
+        }
+
+        return false;
+    }
+
+    bool sq_spgemm_prefer_dot(const CsrData& a, const CsrData& b, size_t gustavsonExtraCost) {
+        if (a.nvals == 0 || b.nvals == 0)
+            return true;
+
+        std::vector<index> aRows;
+        std::vector<index> bRows;
+        sq_spgemm_dot_rows(a, aRows);
+        sq_spgemm_dot_rows(b, bRows);
+
+        // Rows of average lengths have la * lb / ncols common columns, merge stops on the first of them
+        double la = (double) a.nvals / (double) aRows.size();
+        double lb = (double) b.nvals / (double) bRows.size();
+        double pairCost = (la + lb) / (1.0 + la * lb / (double) std::max<index>(1, a.ncols));
+        double dotCost = (double) aRows.size() * (double) bRows.size() * pairCost;
+        double gustavsonCost = (double) countProducts(a, b) + (double) gustavsonExtraCost;
+
+        return dotCost < DOT_COST_FACTOR * gustavsonCost;
+    }
+
+    bool sq_spgemm_prefer_outer(const CsrData& a, const CsrData& b, size_t gustavsonExtraCost) {
+        size_t products = 0;
+
+        for (index k = 0; k < a.nrows; k++)
+            products += (size_t) (a.rowOffsets[k + 1] - a.rowOffsets[k]) * (size_t) (b.rowOffsets[k + 1] - b.rowOffsets[k]);
+
+        return (double) products * OUTER_COST_FACTOR <= (double) products + (double) gustavsonExtraCost;
+    }
+
+    void sq_spgemm_dot_rows(const CsrData& a, std::vector<index>& rows) {
+        rows.clear();
+
+        for (index i = 0; i < a.nrows; i++) {
+            if (a.rowOffsets[i] != a.rowOffsets[i + 1])
+                rows.push_back(i);
+        }
+    }
+
+    index sq_spgemm_dot_row(const CsrData& a, const CsrData& b, const CsrData* c, const std::vector<index>& bRows, index i, index* out) {
+        const index* aFirst = a.colIndices.data() + a.rowOffsets[i];
+        const index* aLast = a.colIndices.data() + a.rowOffsets[i + 1];
+
+        const index* cFirst = c? c->colIndices.data() + c->rowOffsets[i]: nullptr;
+        const index* cLast = c? c->colIndices.data() + c->rowOffsets[i + 1]: nullptr;
+
+        if (aFirst == aLast) {
+            if (out)
+                std::copy(cFirst, cLast, out);
+
+            return (index) (cLast - cFirst);
+        }
+
+        index count = 0;
+
+        for (index j: bRows) {
+            // Seed row values are merged in order, columns of the seed row are not evaluated
+            while (cFirst != cLast && *cFirst < j) {
+                if (out)
+                    out[count] = *cFirst;
+                count += 1;
+                cFirst++;
+            }
+
+            if (cFirst != cLast && *cFirst == j)
+                continue;
+
+            const index* bFirst = b.colIndices.data() + b.rowOffsets[j];
+            const index* bLast = b.colIndices.data() + b.rowOffsets[j + 1];
+
+            // Rows with disjoint columns ranges have no common values
+            if (*bFirst > *(aLast - 1) || *(bLast - 1) < *aFirst)
+                continue;
+
+            if (intersects(aFirst, aLast, bFirst, bLast)) {
+                if (out)
+                    out[count] = j;
+                count += 1;
+            }
+        }
+
+        if (out)
+            std::copy(cFirst, cLast, out + count);
+
+        return count + (index) (cLast - cFirst);
+    }
+
+    static void spgemmDot(const CsrData& a, const CsrData& b, const CsrData* c, CsrData& out) {
+        TraceScope trace("sq_spgemm_dot:symbolic");
+        trace.arg("nrows", a.nrows);
+
+        std::vector<index> bRows;
+        sq_spgemm_dot_rows(b, bRows);
+
+        out.rowOffsets.clear();
+        out.rowOffsets.resize(a.nrows + 1, 0);
+
+        for (index i = 0; i < a.nrows; i++)
+            out.rowOffsets[i] = sq_spgemm_dot_row(a, b, c, bRows, i, nullptr);
+
+        exclusive_scan_offsets(out.rowOffsets.begin(), out.rowOffsets.end(), out.nrowsNotEmpty);
+
+        out.nvals = out.rowOffsets.back();
+        out.colIndices.resize(out.nvals);
+
+        trace.next("sq_spgemm_dot:numeric");
+        trace.arg("nnz", out.nvals);
+
+        for (index i = 0; i < a.nrows; i++)
+            sq_spgemm_dot_row(a, b, c, bRows, i, out.colIndices.data() + out.rowOffsets[i]);
+    }
+
+    void sq_spgemm_dot(const CsrData& a, const CsrData& b, CsrData& out) {
+        spgemmDot(a, b, nullptr, out);
+    }
+
+    void sq_spgemm_dot_accumulate(const CsrData& a, const CsrData& b, const CsrData& c, CsrData& out) {
+        spgemmDot(a, b, &c, out);
+    }
+
+    static void spgemmOuter(const CsrData& a, const CsrData& b, const CsrData* c, CsrData& out) {
+        TraceScope trace("sq_spgemm_outer:scatter");
+        trace.arg("nrows", a.ncols);
+
+        size_t nrows = a.ncols;
+
+        // Upper bound of the result row: row k of `b` is scattered into rows, referenced by row k of `a`
+        // (and seed row goes first)
+        std::vector<size_t> offsets(nrows + 1, 0);
+
+        if (c) {
+            for (size_t i = 0; i < nrows; i++)
+                offsets[i] = c->rowOffsets[i + 1] - c->rowOffsets[i];
+        }
+
+        for (index k = 0; k < a.nrows; k++) {
+            size_t length = b.rowOffsets[k + 1] - b.rowOffsets[k];
+
+            for (index ak = a.rowOffsets[k]; ak < a.rowOffsets[k + 1]; ak++)
+                offsets[a.colIndices[ak]] += length;
+        }
+
+        exclusive_scan(offsets.begin(), offsets.end(), (size_t) 0);
+
+        std::vector<index> products(offsets.back());
+        std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+
+        if (c) {
+            for (size_t i = 0; i < nrows; i++) {
+                std::copy(c->colIndices.begin() + c->rowOffsets[i], c->colIndices.begin() + c->rowOffsets[i + 1], products.begin() + fill[i]);
+                fill[i] += c->rowOffsets[i + 1] - c->rowOffsets[i];
+            }
+        }
+
+        for (index k = 0; k < a.nrows; k++) {
+            const index* bFirst = b.colIndices.data() + b.rowOffsets[k];
+            const index* bLast = b.colIndices.data() + b.rowOffsets[k + 1];
+
+            for (index ak = a.rowOffsets[k]; ak < a.rowOffsets[k + 1]; ak++) {
+                index i = a.colIndices[ak];
+                std::copy(bFirst, bLast, products.begin() + fill[i]);
+                fill[i] += bLast - bFirst;
+            }
+        }
+
+        // Accumulate products of each row, result rows are compacted in place
+        trace.next("sq_spgemm_outer:accumulate");
+        trace.arg("products", products.size());
+
+        out.rowOffsets.clear();
+        out.rowOffsets.resize(nrows + 1, 0);
+
+        std::vector<index> buffer;
+        size_t written = 0;
+        out.nrowsNotEmpty = 0;
+
+        for (size_t i = 0; i < nrows; i++) {
+            index* first = products.data() + offsets[i];
+            index* last = products.data() + offsets[i + 1];
+
+            CsrUtils::sortIndices(first, last, buffer);
+            last = std::unique(first, last);
+
+            out.rowOffsets[i] = written;
+
+            // Row is moved to the front, it overlaps its destination, when previous rows lost no values
+            index* compacted = products.data() + written;
+            if (compacted != first)
+                std::move(first, last, compacted);
+
+            written += last - first;
+            out.nrowsNotEmpty += first != last;
+        }
+
+        CHECK_RAISE_ERROR(written <= std::numeric_limits<index>::max(), IndexOverflow, "Number of values of the result exceeds spbla_Index range");
+
+        out.rowOffsets[nrows] = written;
+        products.resize(written);
+
+        out.nvals = written;
+        out.colIndices = std::move(products);
+    }
+
+    void sq_spgemm_outer(const CsrData& a, const CsrData& b, CsrData& out) {
+        spgemmOuter(a, b, nullptr, out);
+    }
+
+    void sq_spgemm_outer_accumulate(const CsrData& a, const CsrData& b, const CsrData& c, CsrData& out) {
+        spgemmOuter(a, b, &c, out);
+    }
+
+}
@@ -0,0 +1,136 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_SQ_SPGEMM_TRANSPOSED_HPP
+#define SPBLA_SQ_SPGEMM_TRANSPOSED_HPP
+
+#include <sequential/sq_csr_data.hpp>
+#include <vector>
+
+namespace spbla {
+
+    /** Shorter row is searched in the longer one, if it is SEARCH_FACTOR times shorter */
+    static const size_t SEARCH_FACTOR = 8;
+
+    /** Dot kernel is preferred, while its merge cost is less than DOT_COST_FACTOR times of the Gustavson cost */
+    static const size_t DOT_COST_FACTOR = 2;
+
+    /** Outer kernel stores and sorts all products, what costs about OUTER_COST_FACTOR times of the Gustavson */
+    static const size_t OUTER_COST_FACTOR = 2;
+
+    /**
+     * Select kernel of the product a x bT by estimated cost.
+     *
+     * Dot kernel intersects sorted rows of `a` and `b`, what stops on the first common column
+     * (cost is proportional to the number of rows pairs and expected merge length).
+     * Gustavson kernel multiplies `a` by transposed `b` (cost is proportional to the number of products).
+     *
+     * @param a Input matrix
+     * @param b Input matrix (product uses transposed `b`)
+     * @param gustavsonExtraCost Additional cost to prepare Gustavson kernel (e.g. transpose of `b`)
+     *
+     * @return True if dot kernel is preferred
+     */
+    bool sq_spgemm_prefer_dot(const CsrData& a, const CsrData& b, size_t gustavsonExtraCost);
+
+    /**
+     * Select kernel of the product aT x b by estimated cost.
+     *
+     * Outer kernel scatters row of `b` into result rows, referenced by the same row of `a`,
+     * so all products are stored before duplicates are removed.
+     * Gustavson kernel multiplies transposed `a` by `b` (cost is proportional to the number of products).
+     *
+     * @param a Input matrix (product uses transposed `a`)
+     * @param b Input matrix
+     * @param gustavsonExtraCost Additional cost to prepare Gustavson kernel (e.g. transpose of `a`)
+     *
+     * @return True if outer kernel is preferred
+     */
+    bool sq_spgemm_prefer_outer(const CsrData& a, const CsrData& b, size_t gustavsonExtraCost);
+
+    /**
+     * Collect indices of not empty rows of the matrix.
+     *
+     * @param a Input matrix
+     * @param[out] rows Where to store indices in ascending order
+     */
+    void sq_spgemm_dot_rows(const CsrData& a, std::vector<index>& rows);
+
+    /**
+     * Evaluate single row of the product a x bT by sparse dot products.
+     *
+     * @param a Input matrix
+     * @param b Input matrix (product uses transposed `b`)
+     * @param c Optional seed matrix, which row is added to the row of the product (nullptr if no seed)
+     * @param bRows Indices of not empty rows of `b`
+     * @param i Index of the row to evaluate
+     * @param[out] out Where to store sorted column indices of the row (nullptr to count only)
+     *
+     * @return Number of values in the row
+     */
+    index sq_spgemm_dot_row(const CsrData& a, const CsrData& b, const CsrData* c, const std::vector<index>& bRows, index i, index* out);
+
+    /**
+     * Matrix-matrix multiplication out = a x bT by sparse dot products of the rows of `a` and `b`.
+     *
+     * @param a Input matrix
+     * @param b Input matrix (product uses transposed `b`)
+     * @param[out] out Where to store result
+     */
+    void sq_spgemm_dot(const CsrData& a, const CsrData& b, CsrData& out);
+
+    /**
+     * Fused matrix-matrix multiplication and addition out = c + a x bT by sparse dot products.
+     * Row of `c` is merged into the row of the product, pairs of its columns are not evaluated.
+     *
+     * @param a Input matrix
+     * @param b Input matrix (product uses transposed `b`)
+     * @param c Input matrix to add
+     * @param[out] out Where to store result (must differ from inputs)
+     */
+    void sq_spgemm_dot_accumulate(const CsrData& a, const CsrData& b, const CsrData& c, CsrData& out);
+
+    /**
+     * Matrix-matrix multiplication out = aT x b by accumulation of the outer products of the rows of `a` and `b`.
+     *
+     * @param a Input matrix (product uses transposed `a`)
+     * @param b Input matrix
+     * @param[out] out Where to store result
+     */
+    void sq_spgemm_outer(const CsrData& a, const CsrData& b, CsrData& out);
+
+    /**
+     * Fused matrix-matrix multiplication and addition out = c + aT x b by accumulation of the outer products.
+     * Row of `c` is stored with the products of the row, so duplicates are removed at once.
+     *
+     * @param a Input matrix (product uses transposed `a`)
+     * @param b Input matrix
+     * @param c Input matrix to add
+     * @param[out] out Where to store result (must differ from inputs)
+     */
+    void sq_spgemm_outer_accumulate(const CsrData& a, const CsrData& b, const CsrData& c, CsrData& out);
+
+}
+
+#endif //SPBLA_SQ_SPGEMM_TRANSPOSED_HPP
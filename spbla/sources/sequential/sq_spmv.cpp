@@ -0,0 +1,131 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <sequential/sq_spmv.hpp>
+#include <algorithm>
+
+namespace spbla {
+
+    bool sq_spmv_prefer_pull(size_t matrixNvals, const VecData& v, index resultNrows, const VecData* mask, bool complement,
+                             size_t pushExtraCost, size_t pullExtraCost) {
+        if (v.nvals == 0 || matrixNvals == 0)
+            return false;
+
+        size_t candidates = resultNrows;
+
+        if (mask)
+            candidates = complement? resultNrows - mask->nvals: mask->nvals;
+
+        // Push touches all values in rows of frontier
+        double pushCost = (double) v.nvals * ((double) matrixNvals / (double) v.nrows) + (double) pushExtraCost;
+
+        // Pull touches values of the candidate row until the first hit in the dense frontier
+        double rowLength = (double) matrixNvals / (double) resultNrows;
+        double checksPerRow = std::min(rowLength, (double) v.nrows / (double) v.nvals);
+        double pullCost = (double) candidates * checksPerRow + (double) pullExtraCost;
+
+        return pullCost < pushCost;
+    }
+
+    void sq_spmv_pull(const CsrData& a, const VecData& v, const VecData* mask, bool complement, VecData& out) {
+        out.indices.clear();
+        out.nvals = 0;
+
+        if (v.nvals == 0 || a.nvals == 0 || (mask && !complement && mask->nvals == 0))
+            return;
+
+        DenseBitset frontier(v.nrows);
+        frontier.set(v);
+
+        auto hasHit = [&](index i) {
+            for (index k = a.rowOffsets[i]; k < a.rowOffsets[i + 1]; k++) {
+                if (frontier.test(a.colIndices[k]))
+                    return true;
+            }
+            return false;
+        };
+
+        if (mask && !complement) {
+            // Only mask rows are candidates
+            for (auto i: mask->indices) {
+                if (hasHit(i))
+                    out.indices.push_back(i);
+            }
+        }
+        else {
+            DenseBitset masked(mask? a.nrows: 0);
+
+            if (mask)
+                masked.set(*mask);
+
+            for (index i = 0; i < a.nrows; i++) {
+                if (mask && masked.test(i))
+                    continue;
+                if (hasHit(i))
+                    out.indices.push_back(i);
+            }
+        }
+
+        out.nvals = out.indices.size();
+    }
+
+    void sq_spmv_push(const CsrData& a, const VecData& v, const VecData* mask, bool complement, VecData& out) {
+        out.indices.clear();
+        out.nvals = 0;
+
+        if (v.nvals == 0 || a.nvals == 0 || (mask && !complement && mask->nvals == 0))
+            return;
+
+        DenseBitset result(a.ncols);
+        DenseBitset masked(mask? a.ncols: 0);
+
+        if (mask)
+            masked.set(*mask);
+
+        for (auto i: v.indices) {
+            for (index k = a.rowOffsets[i]; k < a.rowOffsets[i + 1]; k++) {
+                index j = a.colIndices[k];
+
+                // Value allowed, if it is in the mask (or not in the mask for complement)
+                if (mask && masked.test(j) == complement)
+                    continue;
+
+                if (result.testAndSet(j))
+                    out.indices.push_back(j);
+            }
+        }
+
+        // Short result is sorted, long one is collected from the bitset in order
+        if (out.indices.size() * 64 < a.ncols) {
+            std::sort(out.indices.begin(), out.indices.end());
+        }
+        else {
+            out.indices.clear();
+            result.collect(out.indices);
+        }
+
+        out.nvals = out.indices.size();
+    }
+
+}
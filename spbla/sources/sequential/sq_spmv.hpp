@@ -0,0 +1,125 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_SQ_SPMV_HPP
+#define SPBLA_SQ_SPMV_HPP
+
+#include <sequential/sq_csr_data.hpp>
+#include <sequential/sq_vec_data.hpp>
+#include <utils/bits.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace spbla {
+
+    /**
+     * Dense bitset over vector indices for O(1) membership checks.
+     */
+    class DenseBitset {
+    public:
+        explicit DenseBitset(index size) : mWords((size + BITS_IN_WORD - 1) / BITS_IN_WORD, 0) {}
+
+        void set(index i) {
+            mWords[i / BITS_IN_WORD] |= 1ull << (i % BITS_IN_WORD);
+        }
+
+        void set(const VecData& v) {
+            for (auto i: v.indices)
+                set(i);
+        }
+
+        bool test(index i) const {
+            return (mWords[i / BITS_IN_WORD] >> (i % BITS_IN_WORD)) & 0x1u;
+        }
+
+        /** @return True if bit was not set before */
+        bool testAndSet(index i) {
+            uint64_t bit = 1ull << (i % BITS_IN_WORD);
+            uint64_t& word = mWords[i / BITS_IN_WORD];
+            bool isNew = (word & bit) == 0;
+            word |= bit;
+            return isNew;
+        }
+
+        /** Append indices of set bits in ascending order */
+        void collect(std::vector<index>& out) const {
+            for (size_t w = 0; w < mWords.size(); w++) {
+                uint64_t word = mWords[w];
+                while (word) {
+                    out.push_back((index) (w * BITS_IN_WORD + lowestBit(word)));
+                    word &= word - 1;
+                }
+            }
+        }
+
+    private:
+        static const size_t BITS_IN_WORD = 64;
+        std::vector<uint64_t> mWords;
+    };
+
+    /**
+     * Select direction of the matrix-vector product by estimated cost.
+     *
+     * Push scatters rows of the matrix, referenced by vector values (cost is proportional to the frontier).
+     * Pull checks each (not masked out) result row for the value in the dense vector bitmap,
+     * what stops on the first hit (cost is proportional to the number of candidate rows).
+     *
+     * @param matrixNvals Number of values in the matrix
+     * @param v Input vector
+     * @param resultNrows Number of rows of the result
+     * @param mask Optional mask (nullptr if no mask)
+     * @param complement True to use structural complement of the mask
+     * @param pushExtraCost Additional cost to prepare push (e.g. transpose of the matrix)
+     * @param pullExtraCost Additional cost to prepare pull (e.g. transpose of the matrix)
+     *
+     * @return True if pull is preferred
+     */
+    bool sq_spmv_prefer_pull(size_t matrixNvals, const VecData& v, index resultNrows, const VecData* mask, bool complement,
+                             size_t pushExtraCost, size_t pullExtraCost);
+
+    /**
+     * Pull product out[i] = OR_j a[i,j] AND v[j] (for each result row look up row of `a`).
+     *
+     * @param a Input matrix (rows of `a` are result rows)
+     * @param v Input vector
+     * @param mask Optional mask (nullptr if no mask)
+     * @param complement True to use structural complement of the mask
+     * @param[out] out Where to store result
+     */
+    void sq_spmv_pull(const CsrData& a, const VecData& v, const VecData* mask, bool complement, VecData& out);
+
+    /**
+     * Push product out[j] = OR_i v[i] AND a[i,j] (scatter rows of `a` referenced by `v`).
+     *
+     * @param a Input matrix (columns of `a` are result rows)
+     * @param v Input vector
+     * @param mask Optional mask (nullptr if no mask)
+     * @param complement True to use structural complement of the mask
+     * @param[out] out Where to store result
+     */
+    void sq_spmv_push(const CsrData& a, const VecData& v, const VecData* mask, bool complement, VecData& out);
+
+}
+
+#endif //SPBLA_SQ_SPMV_HPP
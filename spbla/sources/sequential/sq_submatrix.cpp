@@ -64,7 +64,7 @@ namespace spbla {
             }
         }
 
-        exclusive_scan(sub.rowOffsets.begin(), sub.rowOffsets.end(), 0);
+        exclusive_scan_offsets(sub.rowOffsets.begin(), sub.rowOffsets.end(), sub.nrowsNotEmpty);
     }
 
 }
\ No newline at end of file
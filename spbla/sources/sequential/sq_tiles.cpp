@@ -0,0 +1,373 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <sequential/sq_tiles.hpp>
+#include <core/error.hpp>
+#include <utils/bits.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace spbla {
+
+    static void beginTiles(TileData& out) {
+        out.tileRowOffsets.assign(1, 0);
+        out.tileCols.clear();
+        out.entryOffsets.assign(1, 0);
+        out.wordOffsets.assign(1, 0);
+        out.entries.clear();
+        out.words.clear();
+        out.nvals = 0;
+    }
+
+    static void closeTileRow(TileData& out) {
+        out.tileRowOffsets.push_back(out.tileCols.size());
+    }
+
+    static void addValues(TileData& out, size_t count) {
+        CHECK_RAISE_ERROR(count <= std::numeric_limits<index>::max() - out.nvals, IndexOverflow, "Number of values of the result exceeds spbla_Index range");
+        out.nvals += count;
+    }
+
+    static size_t countBits(const uint64_t* bits) {
+        size_t count = 0;
+
+        for (index r = 0; r < TILE_SIZE; r++)
+            count += popCount(bits[r]);
+
+        return count;
+    }
+
+    // Append tile with given bitmask, storage of the tile is selected by its values count (empty tile is dropped)
+    static void emitTile(TileData& out, index tileCol, const uint64_t* bits) {
+        size_t count = countBits(bits);
+
+        if (count == 0)
+            return;
+
+        if (count >= TILE_DENSE_VALUES) {
+            out.words.insert(out.words.end(), bits, bits + TILE_SIZE);
+        }
+        else {
+            for (index r = 0; r < TILE_SIZE; r++) {
+                uint64_t word = bits[r];
+                while (word) {
+                    out.entries.push_back((uint16_t) (r * TILE_SIZE + lowestBit(word)));
+                    word &= word - 1;
+                }
+            }
+        }
+
+        out.tileCols.push_back(tileCol);
+        out.entryOffsets.push_back(out.entries.size());
+        out.wordOffsets.push_back(out.words.size());
+        addValues(out, count);
+    }
+
+    // Append tile t of `a` as is
+    static void copyTile(TileData& out, const TileData& a, size_t t) {
+        if (a.isDense(t)) {
+            auto first = a.words.begin() + a.wordOffsets[t];
+            out.words.insert(out.words.end(), first, first + TILE_SIZE);
+            addValues(out, countBits(a.words.data() + a.wordOffsets[t]));
+        }
+        else {
+            auto first = a.entries.begin() + a.entryOffsets[t];
+            auto last = a.entries.begin() + a.entryOffsets[t + 1];
+            out.entries.insert(out.entries.end(), first, last);
+            addValues(out, last - first);
+        }
+
+        out.tileCols.push_back(a.tileCols[t]);
+        out.entryOffsets.push_back(out.entries.size());
+        out.wordOffsets.push_back(out.words.size());
+    }
+
+    // Bitmask of tile t: dense tile is referenced in place, sparse one is expanded into buffer
+    static const uint64_t* loadTile(const TileData& a, size_t t, uint64_t* buffer) {
+        if (a.isDense(t))
+            return a.words.data() + a.wordOffsets[t];
+
+        std::fill(buffer, buffer + TILE_SIZE, 0);
+
+        for (size_t k = a.entryOffsets[t]; k < a.entryOffsets[t + 1]; k++) {
+            auto entry = a.entries[k];
+            buffer[entry / TILE_SIZE] |= 1ull << (entry % TILE_SIZE);
+        }
+
+        return buffer;
+    }
+
+    bool sq_csr_prefer_tiles(const CsrData& a) {
+        if ((size_t) a.nvals * TILES_DENSITY_FACTOR < (size_t) a.nrows * a.ncols)
+            return false;
+
+        std::vector<index> counts((a.ncols + TILE_SIZE - 1) / TILE_SIZE, 0);
+        std::vector<index> touched;
+        size_t denseValues = 0;
+
+        for (size_t first = 0; first < a.nrows; first += TILE_SIZE) {
+            size_t last = std::min<size_t>(a.nrows, first + TILE_SIZE);
+
+            for (auto k = a.rowOffsets[first]; k < a.rowOffsets[last]; k++) {
+                index t = a.colIndices[k] / TILE_SIZE;
+                if (counts[t]++ == 0)
+                    touched.push_back(t);
+            }
+
+            for (auto t: touched) {
+                if (counts[t] >= TILE_DENSE_VALUES)
+                    denseValues += counts[t];
+                counts[t] = 0;
+            }
+
+            touched.clear();
+        }
+
+        return denseValues * 2 >= a.nvals;
+    }
+
+    bool sq_tiles_prefer(const TileData& a) {
+        return a.nvals > 0 && (a.nvals - a.entries.size()) * 2 >= a.nvals;
+    }
+
+    void sq_tiles_from_csr(const CsrData& a, TileData& out) {
+        const index none = std::numeric_limits<index>::max();
+
+        // Bitmasks of the touched tiles of the current tile row
+        std::vector<index> slots((a.ncols + TILE_SIZE - 1) / TILE_SIZE, none);
+        std::vector<index> touched;
+        std::vector<uint64_t> bits;
+
+        beginTiles(out);
+
+        for (size_t first = 0; first < a.nrows; first += TILE_SIZE) {
+            size_t last = std::min<size_t>(a.nrows, first + TILE_SIZE);
+
+            for (size_t i = first; i < last; i++) {
+                for (auto k = a.rowOffsets[i]; k < a.rowOffsets[i + 1]; k++) {
+                    index j = a.colIndices[k];
+                    index t = j / TILE_SIZE;
+
+                    if (slots[t] == none) {
+                        slots[t] = touched.size();
+                        touched.push_back(t);
+                        bits.resize(bits.size() + TILE_SIZE, 0);
+                    }
+
+                    bits[slots[t] * TILE_SIZE + (i - first)] |= 1ull << (j % TILE_SIZE);
+                }
+            }
+
+            std::sort(touched.begin(), touched.end());
+
+            for (auto t: touched) {
+                emitTile(out, t, bits.data() + slots[t] * TILE_SIZE);
+                slots[t] = none;
+            }
+
+            touched.clear();
+            bits.clear();
+            closeTileRow(out);
+        }
+    }
+
+    void sq_tiles_from_bits(const BitMatrix& a, TileData& out) {
+        uint64_t bits[TILE_SIZE];
+
+        beginTiles(out);
+
+        for (index tileRow = 0; tileRow < out.tileRows(); tileRow++) {
+            index base = tileRow * TILE_SIZE;
+            index rows = std::min<index>(TILE_SIZE, a.nrows - base);
+
+            std::fill(bits + rows, bits + TILE_SIZE, 0);
+
+            for (size_t w = 0; w < a.stride; w++) {
+                for (index r = 0; r < rows; r++)
+                    bits[r] = a.row(base + r)[w];
+
+                emitTile(out, (index) w, bits);
+            }
+
+            closeTileRow(out);
+        }
+    }
+
+    void sq_tiles_to_csr(const TileData& a, CsrData& out) {
+        std::vector<size_t> cursors;
+
+        out.rowOffsets.clear();
+        out.rowOffsets.reserve(a.nrows + 1);
+        out.rowOffsets.push_back(0);
+        out.colIndices.clear();
+        out.colIndices.reserve(a.nvals);
+        out.nrowsNotEmpty = 0;
+
+        for (index tileRow = 0; tileRow < a.tileRows(); tileRow++) {
+            size_t firstTile = a.tileRowOffsets[tileRow];
+            size_t lastTile = a.tileRowOffsets[tileRow + 1];
+            index rows = std::min<index>(TILE_SIZE, a.nrows - tileRow * TILE_SIZE);
+
+            // Sparse tiles are walked in row order, so each one keeps its position
+            cursors.assign(a.entryOffsets.begin() + firstTile, a.entryOffsets.begin() + lastTile);
+
+            for (index r = 0; r < rows; r++) {
+                for (size_t t = firstTile; t < lastTile; t++) {
+                    index base = a.tileCols[t] * TILE_SIZE;
+
+                    if (a.isDense(t)) {
+                        uint64_t word = a.words[a.wordOffsets[t] + r];
+                        while (word) {
+                            out.colIndices.push_back(base + lowestBit(word));
+                            word &= word - 1;
+                        }
+                    }
+                    else {
+                        auto& k = cursors[t - firstTile];
+                        for (; k < a.entryOffsets[t + 1] && a.entries[k] / TILE_SIZE == r; k++)
+                            out.colIndices.push_back(base + a.entries[k] % TILE_SIZE);
+                    }
+                }
+
+                out.nrowsNotEmpty += out.colIndices.size() != out.rowOffsets.back();
+                out.rowOffsets.push_back(out.colIndices.size());
+            }
+        }
+
+        out.nvals = a.nvals;
+    }
+
+    // Walk over union of tiles of `a` and `b` in each tile row, matched tiles are combined word by word
+    template<typename Op>
+    static void mergeTiles(const TileData& a, const TileData& b, TileData& out, bool copyA, bool copyB, Op&& op) {
+        uint64_t bufferA[TILE_SIZE];
+        uint64_t bufferB[TILE_SIZE];
+        uint64_t result[TILE_SIZE];
+
+        beginTiles(out);
+
+        for (index tileRow = 0; tileRow < out.tileRows(); tileRow++) {
+            size_t ta = a.tileRowOffsets[tileRow];
+            size_t tb = b.tileRowOffsets[tileRow];
+            size_t taEnd = a.tileRowOffsets[tileRow + 1];
+            size_t tbEnd = b.tileRowOffsets[tileRow + 1];
+
+            while (ta < taEnd || tb < tbEnd) {
+                if (tb == tbEnd || (ta < taEnd && a.tileCols[ta] < b.tileCols[tb])) {
+                    if (copyA)
+                        copyTile(out, a, ta);
+                    ta++;
+                }
+                else if (ta == taEnd || b.tileCols[tb] < a.tileCols[ta]) {
+                    if (copyB)
+                        copyTile(out, b, tb);
+                    tb++;
+                }
+                else {
+                    auto x = loadTile(a, ta, bufferA);
+                    auto y = loadTile(b, tb, bufferB);
+
+                    for (index r = 0; r < TILE_SIZE; r++)
+                        result[r] = op(x[r], y[r]);
+
+                    emitTile(out, a.tileCols[ta], result);
+                    ta++;
+                    tb++;
+                }
+            }
+
+            closeTileRow(out);
+        }
+    }
+
+    void sq_tiles_ewiseadd(const TileData& a, const TileData& b, TileData& out) {
+        mergeTiles(a, b, out, true, true, [](uint64_t x, uint64_t y) { return x | y; });
+    }
+
+    void sq_tiles_ewisemult(const TileData& a, const TileData& b, TileData& out) {
+        mergeTiles(a, b, out, false, false, [](uint64_t x, uint64_t y) { return x & y; });
+    }
+
+    void sq_tiles_ewisediff(const TileData& a, const TileData& b, TileData& out) {
+        mergeTiles(a, b, out, true, false, [](uint64_t x, uint64_t y) { return x & ~y; });
+    }
+
+    void sq_tiles_spgemm(const TileData& a, const TileData& b, TileData& out) {
+        const index none = std::numeric_limits<index>::max();
+
+        // Accumulated product tiles of the current tile row
+        std::vector<index> slots(out.tileColumns(), none);
+        std::vector<index> touched;
+        std::vector<uint64_t> accumulated;
+
+        uint64_t bufferA[TILE_SIZE];
+        uint64_t bufferB[TILE_SIZE];
+
+        beginTiles(out);
+
+        for (index tileRow = 0; tileRow < out.tileRows(); tileRow++) {
+            for (size_t ta = a.tileRowOffsets[tileRow]; ta < a.tileRowOffsets[tileRow + 1]; ta++) {
+                index k = a.tileCols[ta];
+                auto x = loadTile(a, ta, bufferA);
+
+                for (size_t tb = b.tileRowOffsets[k]; tb < b.tileRowOffsets[k + 1]; tb++) {
+                    index t = b.tileCols[tb];
+                    auto y = loadTile(b, tb, bufferB);
+
+                    if (slots[t] == none) {
+                        slots[t] = touched.size();
+                        touched.push_back(t);
+                        accumulated.resize(accumulated.size() + TILE_SIZE, 0);
+                    }
+
+                    uint64_t* z = accumulated.data() + slots[t] * TILE_SIZE;
+
+                    for (index r = 0; r < TILE_SIZE; r++) {
+                        uint64_t word = x[r];
+                        uint64_t row = 0;
+
+                        while (word) {
+                            row |= y[lowestBit(word)];
+                            word &= word - 1;
+                        }
+
+                        z[r] |= row;
+                    }
+                }
+            }
+
+            std::sort(touched.begin(), touched.end());
+
+            for (auto t: touched) {
+                emitTile(out, t, accumulated.data() + slots[t] * TILE_SIZE);
+                slots[t] = none;
+            }
+
+            touched.clear();
+            accumulated.clear();
+            closeTileRow(out);
+        }
+    }
+
+}
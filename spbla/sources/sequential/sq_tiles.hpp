@@ -0,0 +1,78 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_SQ_TILES_HPP
+#define SPBLA_SQ_TILES_HPP
+
+#include <sequential/sq_tiles_data.hpp>
+#include <sequential/sq_spgemm_dense.hpp>
+
+namespace spbla {
+
+    /*
+     * Kernels over tiled matrices.
+     * Each pair of tiles is processed as 64 x 64 bitmasks with word-wise AND/OR,
+     * sparse tiles are expanded into bitmask on the fly. Result dimensions must be set by caller.
+     */
+
+    /**
+     * @return True if the most of values of the csr matrix fall into dense tiles,
+     *         so the tiled storage takes less memory and time for element-wise ops and products
+     */
+    bool sq_csr_prefer_tiles(const CsrData& a);
+
+    /** @return True if the most of values of the tiled matrix are still in dense tiles */
+    bool sq_tiles_prefer(const TileData& a);
+
+    /** Convert csr storage to tiled one */
+    void sq_tiles_from_csr(const CsrData& a, TileData& out);
+
+    /** Convert tiled storage to csr one */
+    void sq_tiles_to_csr(const TileData& a, CsrData& out);
+
+    /** Convert dense bit matrix to tiled storage (tile column is the word of the bit matrix row) */
+    void sq_tiles_from_bits(const BitMatrix& a, TileData& out);
+
+    /** Element-wise out = a + b (tile-wise OR) */
+    void sq_tiles_ewiseadd(const TileData& a, const TileData& b, TileData& out);
+
+    /** Element-wise out = a * b (tile-wise AND) */
+    void sq_tiles_ewisemult(const TileData& a, const TileData& b, TileData& out);
+
+    /** Element-wise out = a - b (tile-wise AND NOT) */
+    void sq_tiles_ewisediff(const TileData& a, const TileData& b, TileData& out);
+
+    /**
+     * Matrix-matrix multiplication out = a x b.
+     * Row r of the product tile is OR of rows of `b` tile, selected by set bits of row r of `a` tile.
+     *
+     * @param a Input matrix
+     * @param b Input matrix
+     * @param[out] out Where to store result
+     */
+    void sq_tiles_spgemm(const TileData& a, const TileData& b, TileData& out);
+
+}
+
+#endif //SPBLA_SQ_TILES_HPP
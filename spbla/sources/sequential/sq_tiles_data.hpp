@@ -0,0 +1,71 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_SQ_TILES_DATA_HPP
+#define SPBLA_SQ_TILES_DATA_HPP
+
+#include <sequential/sq_csr_data.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace spbla {
+
+    /** Tile is TILE_SIZE x TILE_SIZE block of the matrix, row of the tile fits one 64-bit word */
+    static const index TILE_SIZE = 64;
+
+    /** Tile with at least this number of values is stored as bitmask (16-bit entries take the same memory) */
+    static const size_t TILE_DENSE_VALUES = 256;
+
+    /** Matrix with density below 1 / TILES_DENSITY_FACTOR is never stored as tiles */
+    static const size_t TILES_DENSITY_FACTOR = 64;
+
+    /**
+     * Tiled storage of the matrix: not empty tiles of each tile row, ordered by tile column.
+     * Tile t is either dense: words[wordOffsets[t], wordOffsets[t] + TILE_SIZE), where bit c of the word r
+     * is value (r, c) of the tile; or sparse: sorted entries[entryOffsets[t], entryOffsets[t + 1])
+     * of form r * TILE_SIZE + c. Tile is dense if wordOffsets[t] != wordOffsets[t + 1].
+     */
+    class TileData {
+    public:
+        std::vector<index> tileRowOffsets;
+        std::vector<index> tileCols;
+        std::vector<size_t> entryOffsets;
+        std::vector<size_t> wordOffsets;
+        std::vector<uint16_t> entries;
+        std::vector<uint64_t> words;
+        index nrows = 0;
+        index ncols = 0;
+        index nvals = 0;
+
+        /** @return Number of tile rows */
+        index tileRows() const { return (nrows + TILE_SIZE - 1) / TILE_SIZE; }
+        /** @return Number of tile columns */
+        index tileColumns() const { return (ncols + TILE_SIZE - 1) / TILE_SIZE; }
+        /** @return True if tile t is stored as bitmask */
+        bool isDense(size_t t) const { return wordOffsets[t] != wordOffsets[t + 1]; }
+    };
+
+}
+
+#endif //SPBLA_SQ_TILES_DATA_HPP
@@ -23,19 +23,25 @@
 /**********************************************************************************/
 
 #include <sequential/sq_transpose.hpp>
+#include <io/tracer.hpp>
 #include <utils/exclusive_scan.hpp>
 
 namespace spbla {
 
     void sq_transpose(const CsrData& a, CsrData& at) {
+        TraceScope trace("sq_transpose:histogram");
+        trace.arg("nnz", a.nvals);
+
         std::vector<index> offsets(a.ncols, 0);
 
         for (size_t k = 0; k < a.nvals; k++) {
             offsets[a.colIndices[k]]++;
         }
 
-        exclusive_scan(offsets.begin(), offsets.end(), 0);
+        trace.next("sq_transpose:scan");
+        exclusive_scan(offsets.begin(), offsets.end(), (index) 0);
 
+        trace.next("sq_transpose:scatter");
         at.rowOffsets.clear();
         at.rowOffsets.resize(a.ncols + 1, 0);
         at.colIndices.resize(a.nvals);
@@ -52,7 +58,7 @@ namespace spbla {
             }
         }
 
-        exclusive_scan(at.rowOffsets.begin(), at.rowOffsets.end(), 0);
+        exclusive_scan_offsets(at.rowOffsets.begin(), at.rowOffsets.end(), at.nrowsNotEmpty);
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,156 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <sequential/sq_vector.hpp>
+#include <sequential/sq_matrix.hpp>
+#include <sequential/sq_spmv.hpp>
+#include <sequential/sq_dcsr.hpp>
+#include <core/error.hpp>
+#include <algorithm>
+#include <cassert>
+
+namespace spbla {
+
+    SqVector::SqVector(size_t nrows) {
+        assert(nrows > 0);
+
+        mData.nrows = nrows;
+    }
+
+    void SqVector::build(const index *rows, size_t nvals, bool isSorted, bool noDuplicates) {
+        mData.indices.assign(rows, rows + nvals);
+
+        if (!isSorted)
+            std::sort(mData.indices.begin(), mData.indices.end());
+
+        if (!noDuplicates)
+            mData.indices.erase(std::unique(mData.indices.begin(), mData.indices.end()), mData.indices.end());
+
+        mData.nvals = mData.indices.size();
+    }
+
+    void SqVector::extract(index *rows, size_t &nvals) {
+        assert(nvals >= getNvals());
+        nvals = getNvals();
+
+        std::copy(mData.indices.begin(), mData.indices.end(), rows);
+    }
+
+    void SqVector::clone(const VectorBase &otherBase) {
+        auto other = dynamic_cast<const SqVector*>(&otherBase);
+
+        CHECK_RAISE_ERROR(other != nullptr, InvalidArgument, "Provided vector does not belongs to sequential vector class");
+        CHECK_RAISE_ERROR(other != this, InvalidArgument, "Vectors must differ");
+
+        assert(other->getNrows() == this->getNrows());
+
+        this->mData = other->mData;
+    }
+
+    void SqVector::multiplyMxV(const MatrixBase &mBase, const VectorBase &vBase, const VectorBase *maskBase, bool complement, bool checkTime) {
+        auto m = dynamic_cast<const SqMatrix*>(&mBase);
+        auto v = dynamic_cast<const SqVector*>(&vBase);
+        auto mask = dynamic_cast<const SqVector*>(maskBase);
+
+        CHECK_RAISE_ERROR(m != nullptr, InvalidArgument, "Provided matrix does not belongs to sequential matrix class");
+        CHECK_RAISE_ERROR(v != nullptr, InvalidArgument, "Provided vector does not belongs to sequential vector class");
+        CHECK_RAISE_ERROR(mask != nullptr || maskBase == nullptr, InvalidArgument, "Provided vector does not belongs to sequential vector class");
+
+        assert(m->getNcols() == v->getNrows());
+        assert(m->getNrows() == this->getNrows());
+
+        const VecData* maskData = mask? &mask->mData: nullptr;
+
+        VecData out;
+        out.nrows = this->getNrows();
+
+        // Hypersparse matrix is walked over its stored rows only
+        if (m->isHypersparse()) {
+            CsrData buffer;
+            sq_dcsr_spmv_pull(m->getRows(buffer), v->mData, maskData, complement, out);
+            this->mData = std::move(out);
+            return;
+        }
+
+        // Pull walks rows of m, push scatters rows of transposed m
+        size_t pushExtra = m->getTransposedCost();
+        CsrData buffer;
+
+        if (sq_spmv_prefer_pull(m->getNvals(), v->mData, out.nrows, maskData, complement, pushExtra, 0))
+            sq_spmv_pull(m->getData(buffer), v->mData, maskData, complement, out);
+        else
+            sq_spmv_push(m->getTransposed(buffer), v->mData, maskData, complement, out);
+
+        this->mData = std::move(out);
+    }
+
+    void SqVector::multiplyVxM(const VectorBase &vBase, const MatrixBase &mBase, const VectorBase *maskBase, bool complement, bool checkTime) {
+        auto v = dynamic_cast<const SqVector*>(&vBase);
+        auto m = dynamic_cast<const SqMatrix*>(&mBase);
+        auto mask = dynamic_cast<const SqVector*>(maskBase);
+
+        CHECK_RAISE_ERROR(v != nullptr, InvalidArgument, "Provided vector does not belongs to sequential vector class");
+        CHECK_RAISE_ERROR(m != nullptr, InvalidArgument, "Provided matrix does not belongs to sequential matrix class");
+        CHECK_RAISE_ERROR(mask != nullptr || maskBase == nullptr, InvalidArgument, "Provided vector does not belongs to sequential vector class");
+
+        assert(v->getNrows() == m->getNrows());
+        assert(m->getNcols() == this->getNrows());
+
+        const VecData* maskData = mask? &mask->mData: nullptr;
+
+        VecData out;
+        out.nrows = this->getNrows();
+
+        if (m->isHypersparse()) {
+            CsrData buffer;
+            sq_dcsr_spmv_push(m->getRows(buffer), v->mData, maskData, complement, out);
+            this->mData = std::move(out);
+            return;
+        }
+
+        // Push scatters rows of m, pull walks rows of transposed m
+        size_t pullExtra = m->getTransposedCost();
+        CsrData buffer;
+
+        if (sq_spmv_prefer_pull(m->getNvals(), v->mData, out.nrows, maskData, complement, 0, pullExtra))
+            sq_spmv_pull(m->getTransposed(buffer), v->mData, maskData, complement, out);
+        else
+            sq_spmv_push(m->getData(buffer), v->mData, maskData, complement, out);
+
+        this->mData = std::move(out);
+    }
+
+    index SqVector::getNrows() const {
+        return mData.nrows;
+    }
+
+    index SqVector::getNvals() const {
+        return mData.nvals;
+    }
+
+    const VecData &SqVector::getData() const {
+        return mData;
+    }
+
+}
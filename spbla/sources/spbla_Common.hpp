@@ -31,6 +31,7 @@
 #include <core/error.hpp>
 #include <core/library.hpp>
 #include <core/matrix.hpp>
+#include <core/vector.hpp>
 
 // State validation
 #define SPBLA_VALIDATE_LIBRARY                                                         \
@@ -44,7 +45,7 @@
     try {
 
 #define SPBLA_END_BODY }                                                               \
-    catch (const spbla::Error& err) {                                                  \
+    catch (const spbla::Exception& err) {                                              \
          spbla::Library::handleError(err);                                             \
          return err.getStatus();                                                        \
     }                                                                                   \
@@ -0,0 +1,44 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <spbla_Common.hpp>
+
+spbla_Status spbla_Matrix_BuildCsr(
+        spbla_Matrix matrix,
+        const spbla_Index *rowOffsets,
+        const spbla_Index *colIndices,
+        spbla_Index nvals,
+        spbla_Hints hints
+) {
+    SPBLA_BEGIN_BODY
+        SPBLA_VALIDATE_LIBRARY
+        SPBLA_ARG_NOT_NULL(matrix)
+        SPBLA_ARG_NOT_NULL(rowOffsets)
+        CHECK_RAISE_ERROR(colIndices != nullptr || nvals == 0, InvalidArgument, "Null ptr col indices array");
+        auto m = (spbla::Matrix *) matrix;
+        std::vector<spbla::index> offsets(rowOffsets, rowOffsets + m->getNrows() + 1);
+        std::vector<spbla::index> cols(colIndices, colIndices + nvals);
+        m->buildCsr(std::move(offsets), std::move(cols), hints & SPBLA_HINT_VALUES_SORTED, hints & SPBLA_HINT_NO_DUPLICATES);
+    SPBLA_END_BODY
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <spbla_Common.hpp>
+
+spbla_Status spbla_Matrix_EWiseDiff(
+        spbla_Matrix result,
+        spbla_Matrix left,
+        spbla_Matrix right,
+        spbla_Hints hints
+) {
+    SPBLA_BEGIN_BODY
+        SPBLA_VALIDATE_LIBRARY
+        SPBLA_ARG_NOT_NULL(result)
+        SPBLA_ARG_NOT_NULL(left)
+        SPBLA_ARG_NOT_NULL(right)
+        auto resultM = (spbla::Matrix *) result;
+        auto leftM = (spbla::Matrix *) left;
+        auto rightM = (spbla::Matrix *) right;
+        resultM->eWiseDiff(*leftM, *rightM, hints & SPBLA_HINT_TIME_CHECK);
+    SPBLA_END_BODY
+}
\ No newline at end of file
@@ -38,6 +38,10 @@ spbla_Status spbla_MxM(
         auto resultM = (spbla::Matrix *) result;
         auto leftM = (spbla::Matrix *) left;
         auto rightM = (spbla::Matrix *) right;
-        resultM->multiply(*leftM, *rightM, hints & SPBLA_HINT_ACCUMULATE, hints & SPBLA_HINT_TIME_CHECK);
+        resultM->multiplyTransposed(*leftM, *rightM,
+                                    hints & SPBLA_HINT_TRANSPOSE_LEFT,
+                                    hints & SPBLA_HINT_TRANSPOSE_RIGHT,
+                                    hints & SPBLA_HINT_ACCUMULATE,
+                                    hints & SPBLA_HINT_TIME_CHECK);
     SPBLA_END_BODY
 }
\ No newline at end of file
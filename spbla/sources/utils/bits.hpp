@@ -0,0 +1,72 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_BITS_HPP
+#define SPBLA_BITS_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace spbla {
+
+    /** @return Position of the lowest set bit of non-zero value */
+    inline size_t lowestBit(uint64_t value) {
+#ifdef _MSC_VER
+        unsigned long position;
+        _BitScanForward64(&position, value);
+        return (size_t) position;
+#else
+        return (size_t) __builtin_ctzll(value);
+#endif
+    }
+
+    /** @return Number of set bits of the value */
+    inline size_t popCount(uint64_t value) {
+#ifdef _MSC_VER
+        return (size_t) __popcnt64(value);
+#else
+        return (size_t) __builtin_popcountll(value);
+#endif
+    }
+
+    /** @return Number of bits up to the highest set bit of the value (0 for zero value) */
+    inline size_t significantBits(uint64_t value) {
+        if (value == 0)
+            return 0;
+#ifdef _MSC_VER
+        unsigned long position;
+        _BitScanReverse64(&position, value);
+        return (size_t) position + 1;
+#else
+        return (size_t) (64 - __builtin_clzll(value));
+#endif
+    }
+
+}
+
+#endif //SPBLA_BITS_HPP
@@ -24,18 +24,39 @@
 
 #include <utils/csr_utils.hpp>
 #include <utils/exclusive_scan.hpp>
+#include <utils/bits.hpp>
 #include <core/error.hpp>
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <utility>
 
 namespace spbla {
 
-    void CsrUtils::buildFromData(size_t nrows, size_t ncols,
-                                 const index *rows, const index *cols, size_t nvals,
-                                 std::vector<index> &rowOffsets, std::vector<index> &colIndices,
-                                 bool isSorted, bool noDuplicates) {
+    // Fallback of sortPairs for pairs, which do not fit single 64-bit key
+    static size_t sortWidePairs(index* rows, index* cols, size_t nvals) {
+        std::vector<std::pair<index, index>> pairs(nvals);
+
+        for (size_t k = 0; k < nvals; k++)
+            pairs[k] = {rows[k], cols[k]};
+
+        std::sort(pairs.begin(), pairs.end());
+        size_t unique = std::unique(pairs.begin(), pairs.end()) - pairs.begin();
+
+        for (size_t k = 0; k < unique; k++) {
+            rows[k] = pairs[k].first;
+            cols[k] = pairs[k].second;
+        }
+
+        return unique;
+    }
+
+    index CsrUtils::buildFromData(size_t nrows, size_t ncols,
+                                  const index *rows, const index *cols, size_t nvals,
+                                  std::vector<index> &rowOffsets, std::vector<index> &colIndices,
+                                  bool isSorted, bool noDuplicates) {
 
         rowOffsets.resize(nrows + 1, 0);
         colIndices.resize(nvals);
@@ -43,7 +64,7 @@ namespace spbla {
         std::fill(rowOffsets.begin(), rowOffsets.end(), 0);
 
         if (nvals == 0)
-            return;
+            return 0;
 
         assert(rows);
         assert(cols);
@@ -58,69 +79,81 @@ namespace spbla {
             rowOffsets[i]++;
         }
 
-        exclusive_scan(rowOffsets.begin(), rowOffsets.end(), 0);
+        index nrowsNotEmpty = 0;
+        exclusive_scan_offsets(rowOffsets.begin(), rowOffsets.end(), nrowsNotEmpty);
 
-        std::vector<size_t> writeOffset(nrows, 0);
+        // Scatter moves offset of each row to its end, so offsets are shifted back after it
         for (size_t k = 0; k < nvals; k++) {
-            auto i = rows[k];
-            auto j = cols[k];
+            colIndices[rowOffsets[rows[k]]++] = cols[k];
+        }
 
-            colIndices[rowOffsets[i] + writeOffset[i]] = j;
-            writeOffset[i] += 1;
+        for (size_t i = nrows; i > 0; i--) {
+            rowOffsets[i] = rowOffsets[i - 1];
         }
 
-        if (!isSorted) {
-            for (size_t i = 0; i < nrows; i++) {
-                auto begin = rowOffsets[i];
-                auto end = rowOffsets[i + 1];
+        rowOffsets[0] = 0;
 
-                // Sort col values within row
-                std::sort(colIndices.begin() + begin, colIndices.begin() + end, [](const index& a, const index& b) {
-                    return a < b;
-                });
-            }
-        }
+        // Bounds are already checked, so only sort and dedup rows in place.
+        // Dedup never empties a row, so the count stays valid.
+        compactRows(nrows, rowOffsets, colIndices, isSorted, noDuplicates);
 
-        if (!noDuplicates) {
-            size_t unique = 0;
-            for (size_t i = 0; i < nrows; i++) {
-                index prev = std::numeric_limits<index>::max();
+        return nrowsNotEmpty;
+    }
 
-                for (size_t k = rowOffsets[i]; k < rowOffsets[i + 1]; k++) {
-                    if (prev != colIndices[k]) {
-                        unique += 1;
-                    }
+    size_t CsrUtils::sortPairs(index *rows, index *cols, size_t nvals) {
+        if (nvals == 0)
+            return 0;
 
-                    prev = colIndices[k];
-                }
-            }
+        index maxRow = *std::max_element(rows, rows + nvals);
+        index maxCol = *std::max_element(cols, cols + nvals);
+        size_t colBits = significantBits(maxCol);
 
-            std::vector<index> rowOffsetsReduced;
-            rowOffsetsReduced.resize(nrows + 1, 0);
+        // Pair does not fit 64-bit key (possible only with 64-bit index)
+        if (significantBits(maxRow) + colBits > 64)
+            return sortWidePairs(rows, cols, nvals);
 
-            std::vector<index> colIndicesReduced;
-            colIndicesReduced.reserve(unique);
+        std::vector<uint64_t> keys(nvals);
+        uint64_t maxKey = 0;
+        uint64_t colMask = colBits < 64? ((uint64_t) 1 << colBits) - 1: ~(uint64_t) 0;
 
-            for (size_t i = 0; i < nrows; i++) {
-                index prev = std::numeric_limits<index>::max();
+        for (size_t k = 0; k < nvals; k++) {
+            keys[k] = colBits < 64? ((uint64_t) rows[k] << colBits) | (uint64_t) cols[k]: (uint64_t) cols[k];
+            maxKey = std::max(maxKey, keys[k]);
+        }
+
+        if (nvals < RADIX_SORT_THRESHOLD) {
+            std::sort(keys.begin(), keys.end());
+        }
+        else {
+            // Passes only over significant bits of the keys
+            size_t bits = significantBits(maxKey);
+            std::vector<uint64_t> tmp(nvals);
+            std::vector<size_t> offsets((size_t) 1 << RADIX_BITS);
+            uint64_t digitMask = ((uint64_t) 1 << RADIX_BITS) - 1;
 
-                for (size_t k = rowOffsets[i]; k < rowOffsets[i + 1]; k++) {
-                    if (prev != colIndices[k]) {
-                        rowOffsetsReduced[i] += 1;
-                        colIndicesReduced.push_back(colIndices[k]);
-                    }
+            for (size_t shift = 0; shift < bits; shift += RADIX_BITS) {
+                std::fill(offsets.begin(), offsets.end(), 0);
 
-                    prev = colIndices[k];
-                }
+                for (auto key: keys)
+                    offsets[(key >> shift) & digitMask]++;
+
+                exclusive_scan(offsets.begin(), offsets.end(), (size_t) 0);
+
+                for (auto key: keys)
+                    tmp[offsets[(key >> shift) & digitMask]++] = key;
+
+                std::swap(keys, tmp);
             }
+        }
 
-            // Exclusive scan to eval rows offsets
-            exclusive_scan(rowOffsetsReduced.begin(), rowOffsetsReduced.end(), 0);
+        size_t unique = std::unique(keys.begin(), keys.end()) - keys.begin();
 
-            // Now result in respective place
-            std::swap(rowOffsets, rowOffsetsReduced);
-            std::swap(colIndices, colIndicesReduced);
+        for (size_t k = 0; k < unique; k++) {
+            rows[k] = colBits < 64? (index) (keys[k] >> colBits): 0;
+            cols[k] = (index) (keys[k] & colMask);
         }
+
+        return unique;
     }
 
     void CsrUtils::extractData(size_t nrows, size_t ncols,
@@ -139,4 +172,99 @@ namespace spbla {
         }
     }
 
+    index CsrUtils::normalizeRows(size_t nrows, size_t ncols,
+                                  std::vector<index> &rowOffsets, std::vector<index> &colIndices,
+                                  bool isSorted, bool noDuplicates) {
+        assert(rowOffsets.size() == nrows + 1);
+
+        index nrowsNotEmpty = 0;
+        for (size_t i = 0; i < nrows; i++) {
+            nrowsNotEmpty += rowOffsets[i] != rowOffsets[i + 1];
+        }
+
+        if (isSorted && noDuplicates)
+            return nrowsNotEmpty;
+
+        for (size_t k = rowOffsets[0]; k < rowOffsets[nrows]; k++) {
+            CHECK_RAISE_ERROR(colIndices[k] < ncols, InvalidArgument, "Index out of matrix bounds");
+        }
+
+        compactRows(nrows, rowOffsets, colIndices, isSorted, noDuplicates);
+
+        return nrowsNotEmpty;
+    }
+
+    void CsrUtils::sortIndices(index *first, index *last, std::vector<index> &buffer) {
+        size_t count = last - first;
+
+        if (count < ROW_RADIX_SORT_THRESHOLD) {
+            std::sort(first, last);
+            return;
+        }
+
+        size_t bits = significantBits(*std::max_element(first, last));
+        size_t buckets = (size_t) 1 << ROW_RADIX_BITS;
+        index digitMask = (index) (buckets - 1);
+        size_t offsets[(size_t) 1 << ROW_RADIX_BITS];
+
+        buffer.resize(std::max(buffer.size(), count));
+
+        index* src = first;
+        index* dst = buffer.data();
+
+        for (size_t shift = 0; shift < bits; shift += ROW_RADIX_BITS) {
+            std::fill(offsets, offsets + buckets, 0);
+
+            for (size_t k = 0; k < count; k++)
+                offsets[(src[k] >> shift) & digitMask]++;
+
+            exclusive_scan(offsets, offsets + buckets, (size_t) 0);
+
+            for (size_t k = 0; k < count; k++)
+                dst[offsets[(src[k] >> shift) & digitMask]++] = src[k];
+
+            std::swap(src, dst);
+        }
+
+        // Odd number of passes leaves result in the buffer
+        if (src != first)
+            std::copy(src, src + count, first);
+    }
+
+    void CsrUtils::compactRows(size_t nrows,
+                               std::vector<index> &rowOffsets, std::vector<index> &colIndices,
+                               bool isSorted, bool noDuplicates) {
+        if (isSorted && noDuplicates)
+            return;
+
+        std::vector<index> buffer;
+
+        // Rows are compacted towards the beginning of the array, so write position never passes read one
+        size_t write = 0;
+        size_t begin = rowOffsets[0];
+
+        for (size_t i = 0; i < nrows; i++) {
+            size_t end = rowOffsets[i + 1];
+            index* first = colIndices.data() + begin;
+            index* last = colIndices.data() + end;
+
+            if (!isSorted)
+                sortIndices(first, last, buffer);
+
+            if (!noDuplicates)
+                last = std::unique(first, last);
+
+            rowOffsets[i] = write;
+
+            if (write != begin)
+                std::move(first, last, colIndices.data() + write);
+
+            write += last - first;
+            begin = end;
+        }
+
+        rowOffsets[nrows] = write;
+        colIndices.resize(write);
+    }
+
 }
\ No newline at end of file
@@ -32,7 +32,12 @@ namespace spbla {
 
     class CsrUtils {
     public:
-        static void buildFromData(size_t nrows, size_t ncols,
+        /**
+         * Build csr arrays from (possibly unsorted) pairs of indices.
+         *
+         * @return Number of not empty rows
+         */
+        static index buildFromData(size_t nrows, size_t ncols,
                                   const index* rows, const index* cols, size_t nvals,
                                   std::vector<index>& rowOffsets, std::vector<index>& colIndices,
                                   bool isSorted, bool noDuplicates);
@@ -40,6 +45,59 @@ namespace spbla {
         static void extractData(size_t nrows, size_t ncols,
                                 index* rows, index* cols, size_t nvals,
                                 const std::vector<index>& rowOffsets, const std::vector<index>& colIndices);
+
+        /**
+         * Sort column indices within rows and remove duplicates in place.
+         * Does nothing if values are already sorted and have no duplicates.
+         *
+         * @param nrows Number of matrix rows
+         * @param ncols Number of matrix columns
+         * @param[in,out] rowOffsets Row offsets array of nrows + 1 size
+         * @param[in,out] colIndices Column indices array
+         * @param isSorted True if column indices are sorted within rows
+         * @param noDuplicates True if rows have no duplicated column indices
+         *
+         * @return Number of not empty rows
+         */
+        static index normalizeRows(size_t nrows, size_t ncols,
+                                  std::vector<index>& rowOffsets, std::vector<index>& colIndices,
+                                  bool isSorted, bool noDuplicates);
+
+        /**
+         * Sort indices in ascending order.
+         * Long ranges are sorted by LSD radix sort over significant bits of the indices.
+         *
+         * @param first Begin of indices range
+         * @param last End of indices range
+         * @param buffer Temporary buffer (resized if required, may be reused between calls)
+         */
+        static void sortIndices(index* first, index* last, std::vector<index>& buffer);
+
+        /**
+         * Sort pairs in row-col order and remove duplicates.
+         * Pairs are packed into 64-bit keys and sorted by LSD radix sort.
+         *
+         * @param[in,out] rows Pairs row indices
+         * @param[in,out] cols Pairs column indices
+         * @param nvals Number of pairs
+         *
+         * @return Number of unique pairs, stored in the beginning of the arrays
+         */
+        static size_t sortPairs(index* rows, index* cols, size_t nvals);
+
+    private:
+        static void compactRows(size_t nrows,
+                                std::vector<index>& rowOffsets, std::vector<index>& colIndices,
+                                bool isSorted, bool noDuplicates);
+
+        /** Min number of pairs to prefer radix sort over comparison sort */
+        static const size_t RADIX_SORT_THRESHOLD = 256;
+        /** Number of key bits, sorted by single radix sort pass */
+        static const size_t RADIX_BITS = 16;
+        /** Min number of row values to prefer radix sort over comparison sort */
+        static const size_t ROW_RADIX_SORT_THRESHOLD = 512;
+        /** Number of index bits, sorted by single row radix sort pass */
+        static const size_t ROW_RADIX_BITS = 8;
     };
 
 }
@@ -25,6 +25,10 @@
 #ifndef SPBLA_EXCLUSIVE_SCAN_HPP
 #define SPBLA_EXCLUSIVE_SCAN_HPP
 
+#include <core/config.hpp>
+#include <core/error.hpp>
+#include <limits>
+
 namespace spbla {
 
     template <typename FirstT, typename LastT, typename T>
@@ -38,6 +42,40 @@ namespace spbla {
         }
     }
 
+    /**
+     * Exclusive scan of row sizes into row offsets of the csr result.
+     * Raises IndexOverflow if the total number of values does not fit index.
+     *
+     * @param firstT Begin of row sizes (followed by zero item, which receives the total)
+     * @param lastT End of row sizes
+     * @param[out] nrowsNotEmpty Number of not empty rows
+     *
+     * @return Total number of values
+     */
+    template <typename FirstT, typename LastT>
+    index exclusive_scan_offsets(FirstT firstT, LastT lastT, index &nrowsNotEmpty) {
+        const index maxIndex = std::numeric_limits<index>::max();
+        index sum = 0;
+        nrowsNotEmpty = 0;
+        while (firstT != lastT) {
+            index value = *firstT;
+            if (value > maxIndex - sum)
+                RAISE_ERROR(IndexOverflow, "Number of values of the result exceeds spbla_Index range");
+            nrowsNotEmpty += value != 0;
+            *firstT = sum;
+            sum += value;
+            firstT++;
+        }
+
+        return sum;
+    }
+
+    template <typename FirstT, typename LastT>
+    index exclusive_scan_offsets(FirstT firstT, LastT lastT) {
+        index nrowsNotEmpty;
+        return exclusive_scan_offsets(firstT, lastT, nrowsNotEmpty);
+    }
+
 }
 
 #endif //SPBLA_EXCLUSIVE_SCAN_HPP
@@ -0,0 +1,299 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <utils/graph_generator.hpp>
+#include <utils/csr_utils.hpp>
+#include <core/error.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace spbla {
+
+    namespace {
+
+        struct Random {
+            explicit Random(uint64_t seed) : state(seed) {}
+
+            // SplitMix64
+            uint64_t next() {
+                uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+                z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9ull;
+                z = (z ^ (z >> 27u)) * 0x94d049bb133111ebull;
+                return z ^ (z >> 31u);
+            }
+
+            /** @return Uniform value in [0, 1) */
+            double nextDouble() {
+                return (double) (next() >> 11u) * (1.0 / 9007199254740992.0);
+            }
+
+            /** @return Uniform value in [0, bound) */
+            uint64_t nextBounded(uint64_t bound) {
+                return std::min((uint64_t) (nextDouble() * (double) bound), bound - 1);
+            }
+
+            uint64_t state;
+        };
+
+        uint64_t getStreamSeed(uint64_t seed, uint64_t stream) {
+            Random random(seed ^ (stream * 0xd1b54a32d192ed03ull));
+            return random.next();
+        }
+
+        /**
+         * Fill `count` pairs starting from `offset` with `sample(random, i, j)`.
+         * Block k of the range uses random stream `firstStream + k`.
+         */
+        template<typename Sample>
+        void samplePairs(ThreadPool& pool, uint64_t seed, uint64_t firstStream, size_t offset, size_t count,
+                         std::vector<index>& rows, std::vector<index>& cols, Sample&& sample) {
+            size_t blocks = (count + GraphGenerator::BLOCK_SIZE - 1) / GraphGenerator::BLOCK_SIZE;
+
+            pool.parallelFor(0, blocks, 1, [&](size_t first, size_t last) {
+                for (size_t block = first; block < last; block++) {
+                    Random random(getStreamSeed(seed, firstStream + block));
+                    size_t begin = offset + block * GraphGenerator::BLOCK_SIZE;
+                    size_t end = offset + std::min(count, (block + 1) * GraphGenerator::BLOCK_SIZE);
+
+                    for (size_t k = begin; k < end; k++)
+                        sample(random, rows[k], cols[k]);
+                }
+            });
+        }
+
+        /** Walker alias table for O(1) sampling of index with given weights */
+        class AliasTable {
+        public:
+            explicit AliasTable(const std::vector<double>& weights) {
+                size_t n = weights.size();
+                double sum = 0.0;
+
+                for (auto w: weights)
+                    sum += w;
+
+                mProbs.resize(n);
+                mAliases.resize(n);
+
+                std::vector<double> scaled(n);
+                std::vector<index> small;
+                std::vector<index> large;
+
+                for (size_t i = 0; i < n; i++) {
+                    scaled[i] = weights[i] * (double) n / sum;
+                    (scaled[i] < 1.0? small: large).push_back((index) i);
+                }
+
+                while (!small.empty() && !large.empty()) {
+                    auto s = small.back(); small.pop_back();
+                    auto l = large.back(); large.pop_back();
+
+                    mProbs[s] = scaled[s];
+                    mAliases[s] = l;
+                    scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+                    (scaled[l] < 1.0? small: large).push_back(l);
+                }
+
+                // Remaining ones are equal to 1 up to rounding errors
+                for (auto i: small) { mProbs[i] = 1.0; mAliases[i] = i; }
+                for (auto i: large) { mProbs[i] = 1.0; mAliases[i] = i; }
+            }
+
+            index sample(Random& random) const {
+                auto i = (index) random.nextBounded(mProbs.size());
+                return random.nextDouble() < mProbs[i]? i: mAliases[i];
+            }
+
+        private:
+            std::vector<double> mProbs;
+            std::vector<index> mAliases;
+        };
+
+        void sortUnique(std::vector<index>& rows, std::vector<index>& cols) {
+            size_t unique = CsrUtils::sortPairs(rows.data(), cols.data(), rows.size());
+            rows.resize(unique);
+            cols.resize(unique);
+        }
+
+        void checkArgs(size_t nrows, size_t ncols, size_t nvals) {
+            CHECK_RAISE_ERROR(nvals == 0 || (nrows > 0 && ncols > 0), InvalidArgument, "Cannot generate values for empty matrix");
+        }
+
+    }
+
+    void GraphGenerator::erdosRenyi(ThreadPool &pool, size_t nrows, size_t ncols, size_t nvals, uint64_t seed,
+                                    std::vector<index> &rows, std::vector<index> &cols) {
+        checkArgs(nrows, ncols, nvals);
+
+        uint64_t total = (uint64_t) nrows * (uint64_t) ncols;
+        CHECK_RAISE_ERROR(nvals <= total, InvalidArgument, "Number of values exceeds matrix size");
+
+        rows.clear();
+        cols.clear();
+
+        if (nvals == 0)
+            return;
+
+        // Dense case: generate missing values and take the complement, so rejections do not slow down sampling
+        if (2 * (uint64_t) nvals > total) {
+            std::vector<index> missingRows;
+            std::vector<index> missingCols;
+            erdosRenyi(pool, nrows, ncols, (size_t) (total - nvals), seed, missingRows, missingCols);
+
+            rows.reserve(nvals);
+            cols.reserve(nvals);
+
+            size_t k = 0;
+            for (index i = 0; i < nrows; i++) {
+                for (index j = 0; j < ncols; j++) {
+                    if (k < missingRows.size() && missingRows[k] == i && missingCols[k] == j) {
+                        k += 1;
+                        continue;
+                    }
+
+                    rows.push_back(i);
+                    cols.push_back(j);
+                }
+            }
+
+            return;
+        }
+
+        auto sample = [&](Random& random, index& i, index& j) {
+            auto key = random.nextBounded(total);
+            i = (index) (key / ncols);
+            j = (index) (key % ncols);
+        };
+
+        // Sample with small excess until enough unique values are collected
+        size_t unique = 0;
+        uint64_t stream = 0;
+
+        while (unique < nvals) {
+            size_t need = nvals - unique;
+            size_t count = need + need / 8 + 16;
+
+            rows.resize(unique + count);
+            cols.resize(unique + count);
+
+            samplePairs(pool, seed, stream, unique, count, rows, cols, sample);
+            stream += (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+            sortUnique(rows, cols);
+            unique = rows.size();
+        }
+
+        // Drop uniformly selected excess values (Floyd's sampling of the positions to drop)
+        size_t excess = unique - nvals;
+
+        if (excess > 0) {
+            Random random(getStreamSeed(seed, stream));
+            std::vector<bool> dropped(unique, false);
+
+            for (size_t j = unique - excess; j < unique; j++) {
+                auto t = (size_t) random.nextBounded(j + 1);
+                dropped[dropped[t]? j: t] = true;
+            }
+
+            size_t write = 0;
+            for (size_t k = 0; k < unique; k++) {
+                if (!dropped[k]) {
+                    rows[write] = rows[k];
+                    cols[write] = cols[k];
+                    write += 1;
+                }
+            }
+
+            rows.resize(nvals);
+            cols.resize(nvals);
+        }
+    }
+
+    void GraphGenerator::rmat(ThreadPool &pool, size_t nrows, size_t ncols, size_t nvals, uint64_t seed,
+                              double a, double b, double c,
+                              std::vector<index> &rows, std::vector<index> &cols) {
+        checkArgs(nrows, ncols, nvals);
+        CHECK_RAISE_ERROR(a >= 0.0 && b >= 0.0 && c >= 0.0 && a + b + c <= 1.0 + 1e-6, InvalidArgument, "Invalid R-MAT quadrants probabilities");
+
+        rows.resize(nvals);
+        cols.resize(nvals);
+
+        // Recursion goes over power of two square, values out of the matrix bounds are sampled again
+        size_t scale = 0;
+        while (((size_t) 1 << scale) < std::max(nrows, ncols))
+            scale += 1;
+
+        double ab = a + b;
+        double abc = a + b + c;
+
+        samplePairs(pool, seed, 0, 0, nvals, rows, cols, [&](Random& random, index& i, index& j) {
+            do {
+                i = 0;
+                j = 0;
+
+                for (size_t level = 0; level < scale; level++) {
+                    auto r = random.nextDouble();
+                    i = (i << 1u) | (index) (r >= ab);
+                    j = (j << 1u) | (index) ((r >= a && r < ab) || r >= abc);
+                }
+            }
+            while (i >= nrows || j >= ncols);
+        });
+
+        sortUnique(rows, cols);
+    }
+
+    void GraphGenerator::powerLaw(ThreadPool &pool, size_t nrows, size_t ncols, size_t nvals, uint64_t seed,
+                                  double exponent,
+                                  std::vector<index> &rows, std::vector<index> &cols) {
+        checkArgs(nrows, ncols, nvals);
+        CHECK_RAISE_ERROR(exponent > 1.0, InvalidArgument, "Power law exponent must be greater than 1");
+
+        rows.resize(nvals);
+        cols.resize(nvals);
+
+        if (nvals == 0)
+            return;
+
+        auto makeTable = [&](size_t n) {
+            std::vector<double> weights(n);
+            double power = -1.0 / (exponent - 1.0);
+
+            for (size_t i = 0; i < n; i++)
+                weights[i] = std::pow((double) (i + 1), power);
+
+            return AliasTable(weights);
+        };
+
+        AliasTable rowsTable = makeTable(nrows);
+        AliasTable colsTable = makeTable(ncols);
+
+        samplePairs(pool, seed, 0, 0, nvals, rows, cols, [&](Random& random, index& i, index& j) {
+            i = rowsTable.sample(random);
+            j = colsTable.sample(random);
+        });
+
+        sortUnique(rows, cols);
+    }
+
+}
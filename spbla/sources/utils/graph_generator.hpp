@@ -0,0 +1,75 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_GRAPH_GENERATOR_HPP
+#define SPBLA_GRAPH_GENERATOR_HPP
+
+#include <core/config.hpp>
+#include <utils/thread_pool.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace spbla {
+
+    /**
+     * Synthetic sparse matrices (graphs adjacency) generators.
+     *
+     * Work of each generator is O(nvals): values are sampled in fixed-size blocks in parallel,
+     * each block uses own random stream derived from the seed and the block index,
+     * so the result depends only on the arguments (not on the number of threads).
+     * Generated pairs are returned sorted in row-col order without duplicates.
+     */
+    class GraphGenerator {
+    public:
+        /** Number of values sampled by single random stream */
+        static const size_t BLOCK_SIZE = 1u << 16u;
+
+        /**
+         * Uniform random matrix G(n, m) with exactly `nvals` values.
+         */
+        static void erdosRenyi(ThreadPool& pool, size_t nrows, size_t ncols, size_t nvals, uint64_t seed,
+                               std::vector<index>& rows, std::vector<index>& cols);
+
+        /**
+         * R-MAT (recursive matrix) graph: each value is placed by recursive descent into one of
+         * four quadrants with probabilities a, b, c and 1 - a - b - c.
+         * Samples `nvals` values, duplicates are removed.
+         */
+        static void rmat(ThreadPool& pool, size_t nrows, size_t ncols, size_t nvals, uint64_t seed,
+                         double a, double b, double c,
+                         std::vector<index>& rows, std::vector<index>& cols);
+
+        /**
+         * Chung-Lu graph with power-law expected degrees: weight of i-th row (column) is (i + 1)^(-1 / (exponent - 1)),
+         * so the degrees distribution has tail with the given exponent.
+         * Samples `nvals` values, duplicates are removed.
+         */
+        static void powerLaw(ThreadPool& pool, size_t nrows, size_t ncols, size_t nvals, uint64_t seed,
+                             double exponent,
+                             std::vector<index>& rows, std::vector<index>& cols);
+    };
+
+}
+
+#endif //SPBLA_GRAPH_GENERATOR_HPP
@@ -0,0 +1,153 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <utils/thread_pool.hpp>
+#include <algorithm>
+
+namespace spbla {
+
+    namespace {
+        thread_local size_t sWorkerId = 0;
+    }
+
+    ThreadPool::ThreadPool(size_t numThreads) {
+        mNumThreads = numThreads > 0? numThreads: getHardwareConcurrency();
+
+        mQueues.reserve(mNumThreads);
+        for (size_t i = 0; i < mNumThreads; i++)
+            mQueues.emplace_back(new Queue());
+
+        // Queue with id 0 is reserved for the external (caller) thread
+        mWorkers.reserve(mNumThreads - 1);
+        for (size_t i = 1; i < mNumThreads; i++)
+            mWorkers.emplace_back([this, i]() { workerLoop(i); });
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mWakeMutex);
+            mStop = true;
+        }
+
+        mWake.notify_all();
+
+        for (auto& worker: mWorkers)
+            worker.join();
+    }
+
+    size_t ThreadPool::getNumThreads() const {
+        return mNumThreads;
+    }
+
+    size_t ThreadPool::getWorkerId() {
+        return sWorkerId;
+    }
+
+    size_t ThreadPool::getHardwareConcurrency() {
+        return std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    void ThreadPool::push(size_t queueId, Task task) {
+        {
+            auto& queue = *mQueues[queueId];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.emplace_back(std::move(task));
+        }
+
+        {
+            // Lock to not lose wake up of the worker, which is going to sleep
+            std::lock_guard<std::mutex> lock(mWakeMutex);
+            mPending.fetch_add(1, std::memory_order_release);
+        }
+
+        mWake.notify_one();
+    }
+
+    bool ThreadPool::tryPop(size_t queueId, Task &task) {
+        // Own tasks first (lifo for cache locality)
+        {
+            auto& queue = *mQueues[queueId];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                mPending.fetch_sub(1, std::memory_order_acq_rel);
+                return true;
+            }
+        }
+
+        // Steal from others (fifo to grab larger amount of work)
+        for (size_t k = 1; k < mNumThreads; k++) {
+            auto& queue = *mQueues[(queueId + k) % mNumThreads];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                mPending.fetch_sub(1, std::memory_order_acq_rel);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ThreadPool::wait(Join &join) {
+        size_t id = getWorkerId();
+
+        // Help to process tasks, while waiting for our ones
+        while (join.remaining.load(std::memory_order_acquire) > 0) {
+            Task task;
+
+            if (tryPop(id, task))
+                task();
+            else
+                std::this_thread::yield();
+        }
+
+        if (join.error)
+            std::rethrow_exception(join.error);
+    }
+
+    void ThreadPool::workerLoop(size_t workerId) {
+        sWorkerId = workerId;
+
+        while (true) {
+            Task task;
+
+            if (tryPop(workerId, task)) {
+                task();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mWakeMutex);
+            mWake.wait(lock, [this]() { return mStop || mPending.load(std::memory_order_acquire) > 0; });
+
+            if (mStop && mPending.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+
+}
@@ -0,0 +1,172 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_THREAD_POOL_HPP
+#define SPBLA_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spbla {
+
+    /**
+     * Work-stealing thread pool for Cpu side parallel computations.
+     *
+     * Each worker owns a tasks deque. Worker pops tasks from the back of its own deque
+     * and steals from the front of the other deques, when its own deque is empty.
+     * The thread, which submits the work, is also used for computations while it waits.
+     *
+     * @note Pool is driven by one external thread at a time (library is not thread-safe).
+     */
+    class ThreadPool {
+    public:
+        using Task = std::function<void()>;
+
+        /** Default number of chunks per thread for parallel for (gives stealing room) */
+        static const size_t CHUNKS_PER_THREAD = 4;
+
+        /**
+         * Creates pool with total `numThreads` threads of execution.
+         * Actually `numThreads - 1` worker threads are spawned, the caller thread is the last one.
+         *
+         * @param numThreads Total number of threads; 0 means hardware concurrency
+         */
+        explicit ThreadPool(size_t numThreads);
+        ThreadPool(const ThreadPool& other) = delete;
+        ThreadPool(ThreadPool&& other) noexcept = delete;
+        ~ThreadPool();
+
+        /**
+         * Run `body(first, last)` for disjoint sub-ranges of [begin, end) in parallel.
+         * Blocks until all sub-ranges are processed. Rethrows first caught exception.
+         *
+         * @param begin First index of the range
+         * @param end Index past the last index of the range
+         * @param grainSize Min size of the sub-range processed by single task
+         * @param body Functor to process sub-range
+         */
+        template<typename Body>
+        void parallelFor(size_t begin, size_t end, size_t grainSize, Body&& body) {
+            if (begin >= end)
+                return;
+
+            size_t count = end - begin;
+            size_t grain = grainSize > 0? grainSize: 1;
+            size_t chunks = std::min((count + grain - 1) / grain, mNumThreads * CHUNKS_PER_THREAD);
+
+            // Not worth to split
+            if (chunks <= 1 || mNumThreads <= 1) {
+                body(begin, end);
+                return;
+            }
+
+            size_t step = (count + chunks - 1) / chunks;
+            chunks = (count + step - 1) / step;
+
+            auto join = std::make_shared<Join>(chunks);
+
+            for (size_t chunk = 0; chunk < chunks; chunk++) {
+                size_t first = begin + chunk * step;
+                size_t last = std::min(first + step, end);
+
+                push(chunk % mNumThreads, [join, first, last, &body]() {
+                    try {
+                        body(first, last);
+                    }
+                    catch (...) {
+                        join->setError(std::current_exception());
+                    }
+
+                    join->remaining.fetch_sub(1, std::memory_order_acq_rel);
+                });
+            }
+
+            wait(*join);
+        }
+
+        /**
+         * Run `body(i)` for each i in [0, count) in parallel as separate tasks.
+         * Useful when work is already split into balanced parts.
+         */
+        template<typename Body>
+        void parallelForEach(size_t count, Body&& body) {
+            parallelFor(0, count, 1, [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; i++)
+                    body(i);
+            });
+        }
+
+        /** @return Total number of threads of execution (including caller) */
+        size_t getNumThreads() const;
+
+        /** @return Id of current thread in [0, getNumThreads()); 0 for external thread */
+        static size_t getWorkerId();
+
+        /** @return Default number of threads in the system */
+        static size_t getHardwareConcurrency();
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        struct Join {
+            explicit Join(size_t count) : remaining(count) {}
+
+            void setError(std::exception_ptr e) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) error = std::move(e);
+            }
+
+            std::atomic<size_t> remaining;
+            std::exception_ptr error;
+            std::mutex mutex;
+        };
+
+        void push(size_t queueId, Task task);
+        bool tryPop(size_t queueId, Task& task);
+        void wait(Join& join);
+        void workerLoop(size_t workerId);
+
+        std::vector<std::unique_ptr<Queue>> mQueues;
+        std::vector<std::thread> mWorkers;
+        std::mutex mWakeMutex;
+        std::condition_variable mWake;
+        std::atomic<size_t> mPending{0};
+        bool mStop = false;
+        size_t mNumThreads = 1;
+    };
+
+}
+
+#endif //SPBLA_THREAD_POOL_HPP
@@ -26,6 +26,7 @@
 #define SPBLA_TIMER_HPP
 
 #include <chrono>
+#include <cstdint>
 
 namespace spbla {
 
@@ -39,6 +40,11 @@ namespace spbla {
             mEnd = clock::now();
         }
 
+        uint64_t getElapsedTimeNs() const {
+            using namespace std::chrono;
+            return (uint64_t) duration_cast<nanoseconds>(mEnd - mStart).count();
+        }
+
         double getElapsedTimeMs() const {
             using namespace std::chrono;
             return (double) duration_cast<nanoseconds>(mEnd - mStart).count() / (double) 1.0e6;
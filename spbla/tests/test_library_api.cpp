@@ -24,6 +24,8 @@
 
 #include <gtest/gtest.h>
 #include <testing/testing.hpp>
+#include <algorithm>
+#include <fstream>
 
 // Query library version info
 TEST(spblaVersion, Query) {
@@ -121,6 +123,42 @@ TEST(spbla, Logger) {
     ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
 }
 
+TEST(spbla, LoggerAsync) {
+    const char* logFileName = "testLogAsync.txt";
+
+    spbla_Matrix A = nullptr;
+    spbla_Matrix R = nullptr;
+
+    spbla_Index n = 100;
+    testing::Matrix ta = testing::Matrix::generateSparse(n , n, 0.1);
+
+    ASSERT_EQ(spbla_SetupLogging(logFileName, SPBLA_HINT_LOG_ALL | SPBLA_HINT_LOG_ASYNC), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Initialize(SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&A, n, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&R, n, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(A, ta.rowsIndex.data(), ta.colsIndex.data(), ta.nvals, SPBLA_HINT_TIME_CHECK), SPBLA_STATUS_SUCCESS);
+
+    for (size_t i = 0; i < 10; i++)
+        ASSERT_EQ(spbla_MxM(R, A, A, SPBLA_HINT_TIME_CHECK), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_Matrix_Free(A), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(R), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+
+    // All queued messages are written on finalize
+    std::ifstream file(logFileName);
+    std::string line;
+    std::vector<std::string> lines;
+
+    while (std::getline(file, line))
+        lines.push_back(line);
+
+    ASSERT_FALSE(lines.empty());
+    EXPECT_NE(lines.front().find("*** spbla::Logger file ***"), std::string::npos);
+    EXPECT_NE(lines.back().find("Finalize"), std::string::npos);
+    EXPECT_EQ(std::count_if(lines.begin(), lines.end(), [](const std::string& l) { return l.find("Time: ") != std::string::npos; }), 10);
+}
+
 TEST(spbla, DeviceCaps) {
     spbla_DeviceCaps caps;
 
@@ -141,4 +179,159 @@ TEST(spbla, DeviceCaps) {
     ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
 }
 
+TEST(spbla, Stats) {
+    spbla_Matrix A = nullptr;
+    spbla_Matrix R = nullptr;
+    spbla_OperationStats stats[SPBLA_OPERATION_COUNT];
+
+    spbla_Index n = 100;
+    testing::Matrix ta = testing::Matrix::generateSparse(n , n, 0.1);
+
+    ASSERT_EQ(spbla_ResetStats(), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Initialize(SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&A, n, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&R, n, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(A, ta.rowsIndex.data(), ta.colsIndex.data(), ta.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+
+    for (size_t i = 0; i < 3; i++)
+        ASSERT_EQ(spbla_MxM(R, A, A, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    spbla_Index nvals;
+    ASSERT_EQ(spbla_Matrix_Nvals(R, &nvals), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_GetStats(stats, SPBLA_OPERATION_COUNT), SPBLA_STATUS_SUCCESS);
+
+    const auto& build = stats[SPBLA_OPERATION_BUILD];
+    EXPECT_EQ(build.calls, 1);
+    EXPECT_EQ(build.nnzIn, ta.nvals);
+    EXPECT_EQ(build.flops, 0);
+    EXPECT_EQ(build.nnzOut, ta.nvals);
+
+    const auto& mxm = stats[SPBLA_OPERATION_MXM];
+    EXPECT_EQ(mxm.calls, 3);
+    EXPECT_EQ(mxm.nnzIn, 3 * 2 * ta.nvals);
+    EXPECT_EQ(mxm.nnzOut, 3 * nvals);
+    EXPECT_GT(mxm.flops, 0);
+    EXPECT_GE(mxm.bytesAllocated, 3 * sizeof(spbla_Index) * nvals);
+    EXPECT_LE(mxm.timeMinNs, mxm.timeMaxNs);
+    EXPECT_LE(mxm.timeMaxNs, mxm.timeTotalNs);
+
+    EXPECT_EQ(stats[SPBLA_OPERATION_KRONECKER].calls, 0);
+    EXPECT_EQ(stats[SPBLA_OPERATION_KRONECKER].timeMinNs, 0);
+
+    ASSERT_EQ(spbla_ResetStats(), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_GetStats(stats, SPBLA_OPERATION_COUNT), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(stats[SPBLA_OPERATION_MXM].calls, 0);
+    EXPECT_EQ(stats[SPBLA_OPERATION_MXM].timeTotalNs, 0);
+
+    ASSERT_NE(spbla_GetStats(nullptr, SPBLA_OPERATION_COUNT), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_Matrix_Free(A), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(R), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+}
+
+TEST(spbla, Tracing) {
+    const char* traceFileName = "testTrace.json";
+
+    spbla_Matrix A = nullptr;
+    spbla_Matrix R = nullptr;
+
+    spbla_Index n = 100;
+    testing::Matrix ta = testing::Matrix::generateSparse(n , n, 0.1);
+
+    ASSERT_EQ(spbla_SetupTracing(traceFileName, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Initialize(SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&A, n, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&R, n, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_SetMarker(A, "a \"quoted\" marker"), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(A, ta.rowsIndex.data(), ta.colsIndex.data(), ta.nvals, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_MxM(R, A, A, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Transpose(R, A, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(A), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(R), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+
+    std::ifstream file(traceFileName);
+    std::string trace((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0);
+    EXPECT_NE(trace.find("\"name\":\"Matrix::build\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"Matrix::multiply\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"Matrix::transpose\""), std::string::npos);
+    EXPECT_NE(trace.find("spgemm:numeric\""), std::string::npos);
+    EXPECT_NE(trace.find("a \\\"quoted\\\" marker"), std::string::npos);
+    EXPECT_EQ(trace.substr(trace.size() - 3), "]}\n");
+
+    ASSERT_NE(spbla_SetupTracing(nullptr, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+}
+
+// Number of trace events which name ends with the suffix
+static size_t countTraceEvents(const std::string& trace, const std::string& suffix) {
+    size_t count = 0;
+
+    for (size_t pos = trace.find(suffix + "\""); pos != std::string::npos; pos = trace.find(suffix + "\"", pos + 1))
+        count += 1;
+
+    return count;
+}
+
+void testKeepTransposed(spbla_Hints setup) {
+    const char* traceFileName = "testTrace.json";
+
+    spbla_Matrix A = nullptr;
+    spbla_Matrix B = nullptr;
+    spbla_Vector v = nullptr;
+    spbla_Vector r = nullptr;
+
+    spbla_Index n = 1000;
+    spbla_Index row = 7;
+    testing::Matrix ta = testing::Matrix::generateSparse(n , n, 0.01);
+
+    ASSERT_EQ(spbla_SetupTracing(traceFileName, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_NewWithHints(&A, n, n, SPBLA_HINT_KEEP_TRANSPOSED), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&B, n, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_New(&v, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_New(&r, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(A, ta.rowsIndex.data(), ta.colsIndex.data(), ta.nvals, SPBLA_HINT_VALUES_SORTED), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(B, ta.rowsIndex.data(), ta.colsIndex.data(), ta.nvals, SPBLA_HINT_VALUES_SORTED), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_Build(v, &row, 1, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    // Sparse frontier is pushed through the kept transposed storage, it is built once and reused
+    ASSERT_EQ(spbla_MxV(r, A, v, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_MxV(r, A, v, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    // Matrix without hint pulls rows, transposing it is not worth it for one product
+    ASSERT_EQ(spbla_MxV(r, B, v, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_MxV(r, B, v, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    // Kept storage is dropped on write and built again on next use
+    ASSERT_EQ(spbla_Matrix_Build(A, ta.rowsIndex.data(), ta.colsIndex.data(), ta.nvals, SPBLA_HINT_VALUES_SORTED), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_MxV(r, A, v, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_Matrix_Free(A), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(B), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_Free(v), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_Free(r), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+
+    std::ifstream file(traceFileName);
+    std::string trace((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    EXPECT_EQ(countTraceEvents(trace, "_matrix:transposed"), 2);
+    EXPECT_EQ(countTraceEvents(trace, "Vector::multiplyMxV"), 5);
+}
+
+#ifdef SPBLA_WITH_SEQUENTIAL
+TEST(spbla, KeepTransposedFallback) {
+    testKeepTransposed(SPBLA_HINT_CPU_BACKEND);
+}
+#endif
+
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla, KeepTransposedParallel) {
+    testKeepTransposed(SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
 SPBLA_GTEST_MAIN
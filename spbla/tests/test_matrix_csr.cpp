@@ -0,0 +1,173 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <testing/testing.hpp>
+#include <algorithm>
+
+void testMatrixBuildCsr(spbla_Index m, spbla_Index n, float density) {
+    spbla_Matrix matrix = nullptr;
+
+    testing::Matrix tmatrix = std::move(testing::Matrix::generateSparse(m, n, density));
+    tmatrix.computeRowOffsets();
+
+    ASSERT_EQ(spbla_Matrix_New(&matrix, m, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_BuildCsr(matrix, tmatrix.rowOffsets.data(), tmatrix.colsIndex.data(), (spbla_Index) tmatrix.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+
+    // Compare test matrix and library one
+    ASSERT_TRUE(tmatrix.areEqual(matrix));
+
+    // Remember to release resources
+    ASSERT_EQ(spbla_Matrix_Free(matrix), SPBLA_STATUS_SUCCESS);
+}
+
+void testMatrixBuildCsrUnsorted(spbla_Index m, spbla_Index n, float density) {
+    spbla_Matrix matrix = nullptr;
+
+    testing::Matrix tmatrix = std::move(testing::Matrix::generateSparse(m, n, density));
+    tmatrix.computeRowOffsets();
+
+    std::default_random_engine engine(std::chrono::system_clock::now().time_since_epoch().count());
+
+    // Shuffle values within rows and duplicate every third value of the row
+    std::vector<spbla_Index> rowOffsets(m + 1, 0);
+    std::vector<spbla_Index> colIndices;
+
+    for (spbla_Index i = 0; i < m; i++) {
+        auto first = tmatrix.colsIndex.begin() + tmatrix.rowOffsets[i];
+        auto last = tmatrix.colsIndex.begin() + tmatrix.rowOffsets[i + 1];
+        std::vector<spbla_Index> row(first, last);
+
+        for (size_t k = 0; k < row.size(); k += 3) {
+            row.push_back(row[k]);
+        }
+
+        std::shuffle(row.begin(), row.end(), engine);
+        colIndices.insert(colIndices.end(), row.begin(), row.end());
+        rowOffsets[i + 1] = colIndices.size();
+    }
+
+    ASSERT_EQ(spbla_Matrix_New(&matrix, m, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_BuildCsr(matrix, rowOffsets.data(), colIndices.data(), (spbla_Index) colIndices.size(), SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    // Compare test matrix and library one
+    ASSERT_TRUE(tmatrix.areEqual(matrix));
+
+    // Remember to release resources
+    ASSERT_EQ(spbla_Matrix_Free(matrix), SPBLA_STATUS_SUCCESS);
+}
+
+void testMatrixExtractCsr(spbla_Index m, spbla_Index n, float density) {
+    spbla_Matrix matrix = nullptr;
+
+    testing::Matrix tmatrix = std::move(testing::Matrix::generateSparse(m, n, density));
+    tmatrix.computeRowOffsets();
+
+    ASSERT_EQ(spbla_Matrix_New(&matrix, m, n), SPBLA_STATUS_SUCCESS);
+
+    // Values are set through cache, so view must reflect committed state
+    for (size_t k = 0; k < tmatrix.nvals; k++) {
+        ASSERT_EQ(spbla_Matrix_SetElement(matrix, tmatrix.rowsIndex[k], tmatrix.colsIndex[k]), SPBLA_STATUS_SUCCESS);
+    }
+
+    const spbla_Index* rowOffsets = nullptr;
+    const spbla_Index* colIndices = nullptr;
+    spbla_Index nvals = 0;
+
+    ASSERT_EQ(spbla_Matrix_ExtractCsr(matrix, &rowOffsets, &colIndices, &nvals), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(nvals, tmatrix.nvals);
+    ASSERT_TRUE(std::equal(tmatrix.rowOffsets.begin(), tmatrix.rowOffsets.end(), rowOffsets));
+    ASSERT_TRUE(std::equal(tmatrix.colsIndex.begin(), tmatrix.colsIndex.end(), colIndices));
+
+    // Remember to release resources
+    ASSERT_EQ(spbla_Matrix_Free(matrix), SPBLA_STATUS_SUCCESS);
+}
+
+void testMatrixBuildCsrInvalid(spbla_Index m, spbla_Index n) {
+    spbla_Matrix matrix = nullptr;
+
+    std::vector<spbla_Index> rowOffsets(m + 1, 1);
+    std::vector<spbla_Index> colIndices = { n - 1 };
+    rowOffsets[0] = 0;
+
+    ASSERT_EQ(spbla_Matrix_New(&matrix, m, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_BuildCsr(matrix, rowOffsets.data(), colIndices.data(), 1, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    // Decreasing offsets
+    rowOffsets[1] = 2;
+    ASSERT_NE(spbla_Matrix_BuildCsr(matrix, rowOffsets.data(), colIndices.data(), 1, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    // Column index out of bounds
+    rowOffsets[1] = 1;
+    colIndices[0] = n;
+    ASSERT_NE(spbla_Matrix_BuildCsr(matrix, rowOffsets.data(), colIndices.data(), 1, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    // Remember to release resources
+    ASSERT_EQ(spbla_Matrix_Free(matrix), SPBLA_STATUS_SUCCESS);
+}
+
+void testRun(spbla_Index m, spbla_Index n, spbla_Hints setup) {
+    ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
+
+    for (size_t i = 0; i < 5; i++) {
+        testMatrixBuildCsr(m, n, 0.001f + (0.05f) * ((float) i));
+    }
+
+    for (size_t i = 0; i < 5; i++) {
+        testMatrixBuildCsrUnsorted(m, n, 0.001f + (0.05f) * ((float) i));
+    }
+
+    for (size_t i = 0; i < 5; i++) {
+        testMatrixExtractCsr(m, n, 0.001f + (0.05f) * ((float) i));
+    }
+
+    testMatrixBuildCsrInvalid(m, n);
+
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+}
+
+#ifdef SPBLA_WITH_SEQUENTIAL
+TEST(spbla_Matrix, CsrSmallFallback) {
+    spbla_Index m = 60, n = 100;
+    testRun(m, n, SPBLA_HINT_CPU_BACKEND);
+}
+
+TEST(spbla_Matrix, CsrMediumFallback) {
+    spbla_Index m = 500, n = 1000;
+    testRun(m, n, SPBLA_HINT_CPU_BACKEND);
+}
+#endif
+
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, CsrSmallParallel) {
+    spbla_Index m = 60, n = 100;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, CsrMediumParallel) {
+    spbla_Index m = 500, n = 1000;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
+SPBLA_GTEST_MAIN
@@ -0,0 +1,171 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <testing/testing.hpp>
+
+void buildMatrix(spbla_Matrix& matrix, const testing::Matrix& source) {
+    ASSERT_EQ(spbla_Matrix_New(&matrix, source.nrows, source.ncols), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(matrix, source.rowsIndex.data(), source.colsIndex.data(), source.nvals, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+}
+
+void testDeferredFusion(spbla_Index m, spbla_Index t, spbla_Index n, float density) {
+    spbla_Matrix a, b, c, d, aT, bT, p, q, r, s, x, y;
+
+    auto ta = testing::Matrix::generateSparse(m, t, density);
+    auto tb = testing::Matrix::generateSparse(t, n, density);
+    auto tc = testing::Matrix::generateSparse(m, n, density);
+    auto td = testing::Matrix::generateSparse(m, n, density);
+    auto tEmpty = testing::Matrix::generateSparse(m, n, 0.0f);
+
+    buildMatrix(a, ta);
+    buildMatrix(b, tb);
+    buildMatrix(c, tc);
+    buildMatrix(d, td);
+    buildMatrix(aT, ta.transpose());
+    buildMatrix(bT, tb.transpose());
+
+    testing::MatrixMultiplyFunctor multiply;
+    testing::MatrixEWiseAddFunctor add;
+    auto tab = multiply(ta, tb, tEmpty, false);
+
+    ASSERT_EQ(spbla_Matrix_New(&p, m, t), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&q, t, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&r, m, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&s, m / 2, n / 2), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&x, m, 1), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&y, m, n), SPBLA_STATUS_SUCCESS);
+
+    // Transposed arguments of the product: r = (aT)T x (bT)T
+    ASSERT_EQ(spbla_Matrix_Transpose(p, aT, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Transpose(q, bT, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_MxM(r, p, q, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(tab.areEqual(r), true);
+    ASSERT_EQ(ta.areEqual(p), true);
+
+    // Reduce and sub-matrix of the pending product
+    ASSERT_EQ(spbla_MxM(y, a, b, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Reduce(x, y, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_ExtractSubMatrix(s, y, m / 4, n / 3, m / 2, n / 2, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(y), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Wait(), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(tab.reduce().areEqual(x), true);
+    ASSERT_EQ(tab.subMatrix(m / 4, n / 3, m / 2, n / 2).areEqual(s), true);
+
+    // Chain of additions and accumulated products: y = c + d + a x b, r += a x b
+    ASSERT_EQ(spbla_Matrix_New(&y, m, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_EWiseAdd(y, c, d, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_MxM(y, a, b, SPBLA_HINT_ACCUMULATE), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_EWiseAdd(y, y, c, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Wait(y), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(add(add(tc, td), tab).areEqual(y), true);
+
+    ASSERT_EQ(spbla_Matrix_EWiseAdd(r, c, d, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_MxM(r, a, b, SPBLA_HINT_ACCUMULATE), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_MxM(r, a, b, SPBLA_HINT_ACCUMULATE), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(add(add(tc, td), tab).areEqual(r), true);
+
+    // Pending value is evaluated with the previous values of the changed arguments
+    ASSERT_EQ(spbla_MxM(r, a, b, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_EWiseAdd(y, r, c, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(a, tEmpty.rowsIndex.data(), tEmpty.colsIndex.data(), 0, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_SetElement(c, 0, 0), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(tab.areEqual(r), true);
+    ASSERT_EQ(add(tab, tc).areEqual(y), true);
+
+    ASSERT_EQ(spbla_Matrix_Free(a), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(b), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(c), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(d), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(aT), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(bT), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(p), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(q), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(s), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(x), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(y), SPBLA_STATUS_SUCCESS);
+}
+
+void testDeferredSelfReference(spbla_Index n, float density) {
+    spbla_Matrix a, r;
+
+    auto ta = testing::Matrix::generateSparse(n, n, density);
+    auto tEmpty = testing::Matrix::generateSparse(n, n, 0.0f);
+
+    buildMatrix(a, ta);
+    buildMatrix(r, ta);
+
+    testing::MatrixMultiplyFunctor multiply;
+    auto taa = multiply(ta, ta, tEmpty, false);
+
+    // r = rT, r = rT x r, r += r x a
+    ASSERT_EQ(spbla_Matrix_Transpose(r, r, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Transpose(r, r, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(ta.areEqual(r), true);
+
+    ASSERT_EQ(spbla_MxM(r, r, r, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(taa.areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_Build(r, ta.rowsIndex.data(), ta.colsIndex.data(), ta.nvals, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_MxM(r, r, a, SPBLA_HINT_ACCUMULATE), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(multiply(ta, ta, ta, true).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_Free(a), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
+}
+
+void testRun(spbla_Index m, spbla_Index t, spbla_Index n, spbla_Hints setup) {
+    // Setup library
+    ASSERT_EQ(spbla_Initialize(setup | SPBLA_HINT_DEFERRED), SPBLA_STATUS_SUCCESS);
+
+    for (size_t i = 0; i < 4; i++) {
+        testDeferredFusion(m, t, n, 0.05f + (0.05f) * ((float) i));
+        testDeferredSelfReference(t, 0.05f + (0.05f) * ((float) i));
+    }
+
+    // Finalize library
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+}
+
+#ifdef SPBLA_WITH_SEQUENTIAL
+TEST(spbla_Matrix, DeferredSmallFallback) {
+    testRun(60, 100, 80, SPBLA_HINT_CPU_BACKEND);
+}
+
+TEST(spbla_Matrix, DeferredMediumFallback) {
+    testRun(300, 600, 400, SPBLA_HINT_CPU_BACKEND);
+}
+#endif
+
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, DeferredSmallParallel) {
+    testRun(60, 100, 80, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, DeferredMediumParallel) {
+    testRun(300, 600, 400, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
+SPBLA_GTEST_MAIN
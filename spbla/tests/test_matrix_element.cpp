@@ -23,6 +23,8 @@
 /**********************************************************************************/
 
 #include <testing/testing.hpp>
+#include <algorithm>
+#include <numeric>
 
 // Fills sparse matrix with random data and tests whether the transfer works correctly
 void testMatrixSetElement(spbla_Index m, spbla_Index n, float density) {
@@ -120,6 +122,55 @@ void testMatrixPostAppendElement(spbla_Index m, spbla_Index n, float density) {
     ASSERT_EQ(spbla_Matrix_Free(duplicated), SPBLA_STATUS_SUCCESS);
 }
 
+void testMatrixStreamElement(spbla_Index m, spbla_Index n, float density) {
+    spbla_Matrix matrix = nullptr;
+
+    testing::Matrix tmatrix = std::move(testing::Matrix::generateSparse(m, n, density));
+
+    if (tmatrix.nvals < 2)
+        return;
+
+    // Build matrix from even entries, stream odd ones (and some repeats) in small batches
+    std::vector<spbla_Index> I;
+    std::vector<spbla_Index> J;
+    std::vector<spbla_Index> streamI;
+    std::vector<spbla_Index> streamJ;
+
+    for (size_t k = 0; k < tmatrix.nvals; k++) {
+        auto& rows = k % 2 ? streamI : I;
+        auto& cols = k % 2 ? streamJ : J;
+        rows.push_back(tmatrix.rowsIndex[k]);
+        cols.push_back(tmatrix.colsIndex[k]);
+    }
+
+    std::vector<size_t> order(streamI.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::default_random_engine(std::chrono::system_clock::now().time_since_epoch().count()));
+
+    ASSERT_EQ(spbla_Matrix_New(&matrix, m, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(matrix, I.data(), J.data(), (spbla_Index) I.size(), SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+
+    const size_t batch = 7;
+
+    for (size_t k = 0; k < order.size(); k++) {
+        ASSERT_EQ(spbla_Matrix_SetElement(matrix, streamI[order[k]], streamJ[order[k]]), SPBLA_STATUS_SUCCESS);
+        ASSERT_EQ(spbla_Matrix_SetElement(matrix, I[k % I.size()], J[k % J.size()]), SPBLA_STATUS_SUCCESS);
+
+        // Force commit of small batches, so the values go through the delta buffer
+        if ((k + 1) % batch == 0) {
+            spbla_Index nvals;
+            ASSERT_EQ(spbla_Matrix_Nvals(matrix, &nvals), SPBLA_STATUS_SUCCESS);
+            ASSERT_EQ(nvals, I.size() + k + 1);
+        }
+    }
+
+    // Compare test matrix and library one
+    ASSERT_TRUE(tmatrix.areEqual(matrix));
+
+    // Remember to release resources
+    ASSERT_EQ(spbla_Matrix_Free(matrix), SPBLA_STATUS_SUCCESS);
+}
+
 void testRun(spbla_Index m, spbla_Index n, spbla_Hints setup) {
     ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
 
@@ -135,6 +186,10 @@ void testRun(spbla_Index m, spbla_Index n, spbla_Hints setup) {
         testMatrixPostAppendElement(m, n, 0.001f + (0.05f) * ((float) i));
     }
 
+    for (size_t i = 0; i < 5; i++) {
+        testMatrixStreamElement(m, n, 0.001f + (0.05f) * ((float) i));
+    }
+
     ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
 }
 
@@ -189,4 +244,21 @@ TEST(spbla_Matrix, SetElementLargeFallback) {
 }
 #endif
 
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, SetElementSmallParallel) {
+    spbla_Index m = 60, n = 100;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, SetElementMediumParallel) {
+    spbla_Index m = 500, n = 1000;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, SetElementLargeParallel) {
+    spbla_Index m = 1000, n = 2000;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
 SPBLA_GTEST_MAIN
\ No newline at end of file
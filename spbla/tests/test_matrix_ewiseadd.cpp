@@ -118,4 +118,21 @@ TEST(spbla_Matrix, EWiseAddLargeFallback) {
 }
 #endif
 
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, EWiseAddSmallParallel) {
+    spbla_Index m = 60, n = 80;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, EWiseAddMediumParallel) {
+    spbla_Index m = 500, n = 800;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, EWiseAddLargeParallel) {
+    spbla_Index m = 2500, n = 1500;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
 SPBLA_GTEST_MAIN
\ No newline at end of file
@@ -124,4 +124,24 @@ TEST(spbla_Matrix, SubMatrixExtractLargeFallback) {
 }
 #endif
 
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, SubMatrixExtractSmallParallel) {
+    spbla_Index m = 100, n = 200;
+    float step = 0.05f;
+    testRun(m, n, step, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, SubMatrixExtractMediumParallel) {
+    spbla_Index m = 400, n = 700;
+    float step = 0.05f;
+    testRun(m, n, step, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, SubMatrixExtractLargeParallel) {
+    spbla_Index m = 2000, n = 4000;
+    float step = 0.01f;
+    testRun(m, n, step, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
 SPBLA_GTEST_MAIN
\ No newline at end of file
@@ -0,0 +1,159 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <testing/testing.hpp>
+
+spbla_Index getMaxRowNvals(const testing::Matrix& matrix) {
+    matrix.computeRowOffsets();
+
+    spbla_Index maxNvals = 0;
+    for (size_t i = 0; i < matrix.nrows; i++)
+        maxNvals = std::max(maxNvals, matrix.rowOffsets[i + 1] - matrix.rowOffsets[i]);
+
+    return maxNvals;
+}
+
+void checkSortedInBounds(const testing::Matrix& matrix) {
+    for (size_t k = 0; k < matrix.nvals; k++) {
+        ASSERT_LT(matrix.rowsIndex[k], matrix.nrows);
+        ASSERT_LT(matrix.colsIndex[k], matrix.ncols);
+    }
+
+    for (size_t k = 1; k < matrix.nvals; k++) {
+        ASSERT_TRUE(testing::PairCmp()(testing::Pair{matrix.rowsIndex[k - 1], matrix.colsIndex[k - 1]}, testing::Pair{matrix.rowsIndex[k], matrix.colsIndex[k]}));
+    }
+}
+
+void testMatrixGenerate(spbla_Index m, spbla_Index n, spbla_Generator generator, size_t nvals) {
+    ASSERT_EQ(spbla_ResetStats(), SPBLA_STATUS_SUCCESS);
+    auto first = testing::Matrix::generate(m, n, generator, nvals, 42);
+
+    // Generation is counted once as build of the generated entries
+    spbla_OperationStats stats[SPBLA_OPERATION_COUNT];
+    ASSERT_EQ(spbla_GetStats(stats, SPBLA_OPERATION_COUNT), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(stats[SPBLA_OPERATION_BUILD].calls, 1);
+    EXPECT_EQ(stats[SPBLA_OPERATION_BUILD].nnzOut, first.nvals);
+
+    auto same = testing::Matrix::generate(m, n, generator, nvals, 42);
+    auto other = testing::Matrix::generate(m, n, generator, nvals, 43);
+
+    checkSortedInBounds(first);
+
+    if (generator == SPBLA_GENERATOR_ERDOS_RENYI)
+        ASSERT_EQ(first.nvals, nvals);
+    else
+        ASSERT_LE(first.nvals, nvals);
+
+    ASSERT_GT(first.nvals, 0);
+
+    // Same seed gives same matrix, other seed gives other one
+    ASSERT_EQ(first.rowsIndex, same.rowsIndex);
+    ASSERT_EQ(first.colsIndex, same.colsIndex);
+    ASSERT_TRUE(first.rowsIndex != other.rowsIndex || first.colsIndex != other.colsIndex);
+
+    // Result does not depend on number of threads
+    ASSERT_EQ(spbla_SetNumThreads(1), SPBLA_STATUS_SUCCESS);
+    auto single = testing::Matrix::generate(m, n, generator, nvals, 42);
+    ASSERT_EQ(spbla_SetNumThreads(0), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(first.rowsIndex, single.rowsIndex);
+    ASSERT_EQ(first.colsIndex, single.colsIndex);
+}
+
+void testMatrixGenerateDegrees(spbla_Index n, size_t nvals) {
+    // Skewed generators have rows much longer than the average one
+    auto uniform = testing::Matrix::generateErdosRenyi(n, n, nvals, 1);
+    auto rmat = testing::Matrix::generateRmat(n, n, nvals, 1);
+    auto powerLaw = testing::Matrix::generatePowerLaw(n, n, nvals, 1);
+
+    ASSERT_GT(getMaxRowNvals(rmat), 2 * getMaxRowNvals(uniform));
+    ASSERT_GT(getMaxRowNvals(powerLaw), 2 * getMaxRowNvals(uniform));
+}
+
+void testMatrixGenerateDense(spbla_Index m, spbla_Index n) {
+    // Dense matrices are generated as complement of the sparse ones
+    size_t total = (size_t) m * n;
+
+    for (auto nvals: {total, total - 1, total * 3 / 4}) {
+        auto matrix = testing::Matrix::generateErdosRenyi(m, n, nvals, 7);
+        checkSortedInBounds(matrix);
+        ASSERT_EQ(matrix.nvals, nvals);
+    }
+}
+
+void testMatrixGenerateErrors(spbla_Index m, spbla_Index n) {
+    spbla_Matrix matrix = nullptr;
+    spbla_GeneratorParams params;
+    params.rmatA = 0.6f;
+    params.rmatB = 0.3f;
+    params.rmatC = 0.3f;
+    params.powerLawExponent = 1.0f;
+
+    ASSERT_EQ(spbla_Matrix_New(&matrix, m, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_NE(spbla_Matrix_Generate(matrix, SPBLA_GENERATOR_ERDOS_RENYI, m * n + 1, 0, nullptr, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_NE(spbla_Matrix_Generate(matrix, SPBLA_GENERATOR_RMAT, 10, 0, &params, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_NE(spbla_Matrix_Generate(matrix, SPBLA_GENERATOR_POWER_LAW, 10, 0, &params, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_NE(spbla_Matrix_Generate(matrix, (spbla_Generator) 100, 10, 0, nullptr, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(matrix), SPBLA_STATUS_SUCCESS);
+}
+
+void testRun(spbla_Index m, spbla_Index n, spbla_Hints setup) {
+    ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
+
+    for (auto generator: {SPBLA_GENERATOR_ERDOS_RENYI, SPBLA_GENERATOR_RMAT, SPBLA_GENERATOR_POWER_LAW}) {
+        testMatrixGenerate(m, n, generator, (size_t) m * n / 20);
+    }
+
+    testMatrixGenerateDegrees(m, (size_t) m * 8);
+    testMatrixGenerateDense(std::min<spbla_Index>(m, 100), std::min<spbla_Index>(n, 100));
+    testMatrixGenerateErrors(m, n);
+
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+}
+
+#ifdef SPBLA_WITH_SEQUENTIAL
+TEST(spbla_Matrix, GenerateSmallFallback) {
+    spbla_Index m = 60, n = 100;
+    testRun(m, n, SPBLA_HINT_CPU_BACKEND);
+}
+
+TEST(spbla_Matrix, GenerateMediumFallback) {
+    spbla_Index m = 5000, n = 4000;
+    testRun(m, n, SPBLA_HINT_CPU_BACKEND);
+}
+#endif
+
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, GenerateSmallParallel) {
+    spbla_Index m = 60, n = 100;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, GenerateMediumParallel) {
+    spbla_Index m = 5000, n = 4000;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
+SPBLA_GTEST_MAIN
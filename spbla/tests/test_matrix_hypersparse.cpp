@@ -0,0 +1,284 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <testing/testing.hpp>
+#include <set>
+
+// Places values of the matrix with the given stride, so only few rows of the large matrix are not empty
+static testing::Matrix spread(const testing::Matrix& source, spbla_Index strideRows, spbla_Index strideCols) {
+    testing::Matrix result;
+    result.nrows = source.nrows * strideRows;
+    result.ncols = source.ncols * strideCols;
+    result.nvals = source.nvals;
+
+    for (size_t k = 0; k < source.nvals; k++) {
+        result.rowsIndex.push_back(source.rowsIndex[k] * strideRows);
+        result.colsIndex.push_back(source.colsIndex[k] * strideCols);
+    }
+
+    return result;
+}
+
+static void buildMatrix(spbla_Matrix& matrix, const testing::Matrix& source) {
+    ASSERT_EQ(spbla_Matrix_New(&matrix, source.nrows, source.ncols), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(matrix, source.rowsIndex.data(), source.colsIndex.data(), source.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+}
+
+static std::vector<spbla_Index> extractVector(spbla_Vector v) {
+    spbla_Index nvals;
+    EXPECT_EQ(spbla_Vector_Nvals(v, &nvals), SPBLA_STATUS_SUCCESS);
+
+    std::vector<spbla_Index> rows(nvals);
+    EXPECT_EQ(spbla_Vector_ExtractValues(v, rows.data(), &nvals), SPBLA_STATUS_SUCCESS);
+
+    return rows;
+}
+
+// Reference a x v (or v x a) evaluated over the pairs of the matrix
+static std::vector<spbla_Index> evalReference(const testing::Matrix& a, const std::vector<spbla_Index>& v, bool mxv) {
+    std::set<spbla_Index> frontier(v.begin(), v.end());
+    std::set<spbla_Index> result;
+
+    for (size_t k = 0; k < a.nvals; k++) {
+        spbla_Index i = mxv? a.colsIndex[k]: a.rowsIndex[k];
+        spbla_Index j = mxv? a.rowsIndex[k]: a.colsIndex[k];
+
+        if (frontier.count(i))
+            result.insert(j);
+    }
+
+    return std::vector<spbla_Index>(result.begin(), result.end());
+}
+
+void testHypersparseOperations(spbla_Index k, spbla_Index stride, float density) {
+    spbla_Matrix a, b, c, mask, r, x;
+    spbla_Vector v, w;
+
+    spbla_Index n = k * stride;
+
+    // Reference results are evaluated on the compact matrices and spread afterwards
+    auto ta = testing::Matrix::generateSparse(k, k, density);
+    auto tb = testing::Matrix::generateSparse(k, k, density);
+    auto tc = testing::Matrix::generateSparse(k, k, density);
+    auto tmask = testing::Matrix::generateSparse(k, k, 0.5f);
+    auto tEmpty = testing::Matrix::empty(k, k);
+
+    testing::MatrixMultiplyFunctor multiply;
+    testing::MatrixEWiseAddFunctor add;
+    testing::MatrixEWiseMultFunctor mult;
+    testing::MatrixEWiseDiffFunctor diff;
+
+    buildMatrix(a, spread(ta, stride, stride));
+    buildMatrix(b, spread(tb, stride, stride));
+    buildMatrix(c, spread(tc, stride, stride));
+    buildMatrix(mask, spread(tmask, stride, stride));
+    ASSERT_EQ(spbla_Matrix_New(&r, n, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spread(ta, stride, stride).areEqual(a), true);
+
+    ASSERT_EQ(spbla_Matrix_Transpose(r, a, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spread(ta.transpose(), stride, stride).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_EWiseAdd(r, a, b, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spread(add(ta, tb), stride, stride).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_EWiseMult(r, a, b, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spread(mult(ta, tb), stride, stride).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_EWiseDiff(r, a, b, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spread(diff(ta, tb), stride, stride).areEqual(r), true);
+
+    ASSERT_EQ(spbla_MxM(r, a, b, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spread(multiply(ta, tb, tEmpty, false), stride, stride).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_Duplicate(c, &x), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_MxM(x, a, b, SPBLA_HINT_ACCUMULATE), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spread(multiply(ta, tb, tc, true), stride, stride).areEqual(x), true);
+    ASSERT_EQ(spbla_Matrix_Free(x), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_MxM(r, a, b, SPBLA_HINT_TRANSPOSE_LEFT | SPBLA_HINT_TRANSPOSE_RIGHT), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spread(multiply(ta.transpose(), tb.transpose(), tEmpty, false), stride, stride).areEqual(r), true);
+
+    ASSERT_EQ(spbla_MxM_Masked(r, mask, a, b, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spread(multiply(ta, tb, tEmpty, false).masked(tmask, false), stride, stride).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_Duplicate(c, &x), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_MxM_Masked(x, mask, a, b, SPBLA_HINT_MASK_COMPLEMENT | SPBLA_HINT_ACCUMULATE), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spread(add(tc, multiply(ta, tb, tEmpty, false).masked(tmask, true)), stride, stride).areEqual(x), true);
+    ASSERT_EQ(spbla_Matrix_Free(x), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_Matrix_New(&x, n, 1), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Reduce(x, a, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spread(ta.reduce(), stride, 1).areEqual(x), true);
+    ASSERT_EQ(spbla_Matrix_Free(x), SPBLA_STATUS_SUCCESS);
+
+    // Sub-matrix bounds are not aligned to the stride
+    spbla_Index i = n / 4 + 1, j = n / 3, m = n / 2, t = n / 2 + 3;
+    ASSERT_EQ(spbla_Matrix_New(&x, m, t), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_ExtractSubMatrix(x, a, i, j, m, t, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spread(ta, stride, stride).subMatrix(i, j, m, t).areEqual(x), true);
+    ASSERT_EQ(spbla_Matrix_Free(x), SPBLA_STATUS_SUCCESS);
+
+    // Values inserted into the hypersparse storage
+    ASSERT_EQ(spbla_Matrix_Duplicate(a, &x), SPBLA_STATUS_SUCCESS);
+    for (size_t id = 0; id < tb.nvals; id++)
+        ASSERT_EQ(spbla_Matrix_SetElement(x, tb.rowsIndex[id] * stride, tb.colsIndex[id] * stride), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spread(add(ta, tb), stride, stride).areEqual(x), true);
+    ASSERT_EQ(spbla_Matrix_Free(x), SPBLA_STATUS_SUCCESS);
+
+    // Vector products walk only the stored rows of the matrix
+    std::vector<spbla_Index> values;
+    for (spbla_Index id = 0; id < k; id += 2)
+        values.push_back(id * stride);
+
+    auto tas = spread(ta, stride, stride);
+    ASSERT_EQ(spbla_Vector_New(&v, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_New(&w, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_Build(v, values.data(), values.size(), SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_MxV(w, a, v, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(extractVector(w), evalReference(tas, values, true));
+
+    ASSERT_EQ(spbla_VxM(w, v, a, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(extractVector(w), evalReference(tas, values, false));
+
+    ASSERT_EQ(spbla_Vector_Free(v), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_Free(w), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_Matrix_Free(a), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(b), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(c), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(mask), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
+}
+
+void testHypersparseMixed(spbla_Index k, spbla_Index stride, float density) {
+    spbla_Matrix a, b, r;
+
+    spbla_Index n = k * stride;
+
+    // Hypersparse matrix with the regular one, result storage is selected by its rows count
+    auto ta = spread(testing::Matrix::generateSparse(k, k, density), stride, stride);
+    auto tb = testing::Matrix::generateSparse(n, n, 4.0f / (float) n);
+    auto tEmpty = testing::Matrix::empty(n, n);
+
+    testing::MatrixMultiplyFunctor multiply;
+    testing::MatrixEWiseAddFunctor add;
+    testing::MatrixEWiseMultFunctor mult;
+
+    buildMatrix(a, ta);
+    buildMatrix(b, tb);
+    ASSERT_EQ(spbla_Matrix_New(&r, n, n), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_MxM(r, a, b, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(multiply(ta, tb, tEmpty, false).areEqual(r), true);
+
+    ASSERT_EQ(spbla_MxM(r, b, a, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(multiply(tb, ta, tEmpty, false).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_EWiseAdd(r, a, b, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(add(ta, tb).areEqual(r), true);
+
+    ASSERT_EQ(spbla_MxM(r, a, b, SPBLA_HINT_ACCUMULATE), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(multiply(ta, tb, add(ta, tb), true).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_EWiseMult(r, a, b, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(mult(ta, tb).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_Free(a), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(b), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
+}
+
+void testHypersparseKronecker(spbla_Index k, spbla_Index stride, float density) {
+    spbla_Matrix a, b, r;
+
+    auto ta = spread(testing::Matrix::generateSparse(k, k, density), stride, stride);
+    auto tb = testing::Matrix::generateSparse(k, k, density);
+
+    testing::MatrixKroneckerFunctor kronecker;
+
+    buildMatrix(a, ta);
+    buildMatrix(b, tb);
+    ASSERT_EQ(spbla_Matrix_New(&r, ta.nrows * tb.nrows, ta.ncols * tb.ncols), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_Kronecker(r, a, b, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(kronecker(ta, tb).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Kronecker(r, b, a, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(kronecker(tb, ta).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_Free(a), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(b), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
+}
+
+void testRun(spbla_Index k, spbla_Index stride, spbla_Hints setup) {
+    // Setup library
+    ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
+
+    for (size_t i = 0; i < 4; i++) {
+        float density = 0.05f + (0.1f) * ((float) i);
+
+        testHypersparseOperations(k, stride, density);
+        testHypersparseMixed(k, stride, density);
+        testHypersparseKronecker(k / 4, stride / 20, density);
+    }
+
+    // Finalize library
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+}
+
+void testRunLarge(spbla_Index k, spbla_Index stride, spbla_Hints setup) {
+    // Setup library
+    ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
+
+    for (size_t i = 0; i < 4; i++) {
+        testHypersparseOperations(k, stride, 0.05f + (0.1f) * ((float) i));
+    }
+
+    // Finalize library
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+}
+
+#ifdef SPBLA_WITH_SEQUENTIAL
+TEST(spbla_Matrix, HypersparseSmallFallback) {
+    testRun(40, 500, SPBLA_HINT_CPU_BACKEND);
+}
+
+TEST(spbla_Matrix, HypersparseLargeFallback) {
+    testRunLarge(40, 1u << 24, SPBLA_HINT_CPU_BACKEND);
+}
+#endif
+
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, HypersparseSmallParallel) {
+    testRun(40, 500, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, HypersparseLargeParallel) {
+    testRunLarge(40, 1u << 24, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
+SPBLA_GTEST_MAIN
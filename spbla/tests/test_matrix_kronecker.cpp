@@ -67,6 +67,51 @@ void testRun(spbla_Index m, spbla_Index n, spbla_Index k, spbla_Index t, float s
     ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
 }
 
+void testMatrixKroneckerOverflow(spbla_Hints setup) {
+    spbla_Matrix r, a, b;
+    spbla_Index nvals;
+
+    ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
+
+    // Number of result rows wraps around to the size of `r`
+    spbla_Index half = (spbla_Index) 1 << 16;
+    EXPECT_EQ(spbla_Matrix_New(&a, half, 1), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Matrix_New(&b, half + 1, 1), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Matrix_New(&r, half, 1), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Kronecker(r, a, b, SPBLA_HINT_NO), SPBLA_STATUS_INDEX_OVERFLOW);
+    EXPECT_EQ(spbla_Matrix_Free(a), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Matrix_Free(b), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
+
+    // Result size fits index, but its number of values does not
+    spbla_Index m = 256, n = 256, k = 257, t = 256;
+    std::vector<spbla_Index> rows, cols;
+
+    for (spbla_Index i = 0; i < k; i++) {
+        for (spbla_Index j = 0; j < t; j++) {
+            rows.push_back(i);
+            cols.push_back(j);
+        }
+    }
+
+    EXPECT_EQ(spbla_Matrix_New(&a, m, n), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Matrix_New(&b, k, t), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Matrix_New(&r, m * k, n * t), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Matrix_Build(a, rows.data(), cols.data(), m * n, SPBLA_HINT_VALUES_SORTED), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Matrix_Build(b, rows.data(), cols.data(), k * t, SPBLA_HINT_VALUES_SORTED), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Kronecker(r, a, b, SPBLA_HINT_NO), SPBLA_STATUS_INDEX_OVERFLOW);
+
+    // Result is left untouched
+    EXPECT_EQ(spbla_Matrix_Nvals(r, &nvals), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(nvals, 0);
+
+    EXPECT_EQ(spbla_Matrix_Free(a), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Matrix_Free(b), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+}
+
 #ifdef SPBLA_WITH_CUDA
 TEST(spbla_Matrix, KroneckerSmallCuda) {
     spbla_Index m = 10, n = 20;
@@ -134,6 +179,41 @@ TEST(spbla_Matrix, KroneckerLargeFallback) {
     float step = 0.001f;
     testRun(m, n, k, t, step, SPBLA_HINT_CPU_BACKEND);
 }
+
+#ifndef SPBLA_WITH_INDEX64
+TEST(spbla_Matrix, KroneckerOverflowFallback) {
+    testMatrixKroneckerOverflow(SPBLA_HINT_CPU_BACKEND);
+}
+#endif
+#endif
+
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, KroneckerSmallParallel) {
+    spbla_Index m = 10, n = 20;
+    spbla_Index k = 5, t = 15;
+    float step = 0.05f;
+    testRun(m, n, k, t, step, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, KroneckerMediumParallel) {
+    spbla_Index m = 100, n = 40;
+    spbla_Index k = 30, t = 80;
+    float step = 0.02f;
+    testRun(m, n, k, t, step, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, KroneckerLargeParallel) {
+    spbla_Index m = 1000, n = 400;
+    spbla_Index k = 300, t = 800;
+    float step = 0.001f;
+    testRun(m, n, k, t, step, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+#ifndef SPBLA_WITH_INDEX64
+TEST(spbla_Matrix, KroneckerOverflowParallel) {
+    testMatrixKroneckerOverflow(SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
 #endif
 
 SPBLA_GTEST_MAIN
\ No newline at end of file
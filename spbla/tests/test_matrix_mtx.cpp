@@ -0,0 +1,183 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <testing/testing.hpp>
+#include <cstdio>
+#include <fstream>
+
+static const char* MTX_FILE_PATH = "test_matrix_mtx.mtx";
+
+void writeFile(const char* content) {
+    std::ofstream file(MTX_FILE_PATH, std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+void checkImported(spbla_Index m, spbla_Index n, const std::vector<spbla_Index> &I, const std::vector<spbla_Index> &J) {
+    spbla_Matrix matrix = nullptr;
+    ASSERT_EQ(spbla_Matrix_ImportMtx(MTX_FILE_PATH, &matrix, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    spbla_Index nrows, ncols, nvals;
+    ASSERT_EQ(spbla_Matrix_Nrows(matrix, &nrows), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Ncols(matrix, &ncols), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Nvals(matrix, &nvals), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(nrows, m);
+    ASSERT_EQ(ncols, n);
+    ASSERT_EQ(nvals, I.size());
+
+    std::vector<spbla_Index> rows(nvals), cols(nvals);
+    ASSERT_EQ(spbla_Matrix_ExtractPairs(matrix, rows.data(), cols.data(), &nvals), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(rows, I);
+    ASSERT_EQ(cols, J);
+
+    ASSERT_EQ(spbla_Matrix_Free(matrix), SPBLA_STATUS_SUCCESS);
+}
+
+void testMatrixExportImport(spbla_Index m, spbla_Index n, float density) {
+    spbla_Matrix matrix = nullptr;
+    spbla_Matrix imported = nullptr;
+
+    testing::Matrix tmatrix = std::move(testing::Matrix::generateSparse(m, n, density));
+
+    ASSERT_EQ(spbla_Matrix_New(&matrix, m, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(matrix, tmatrix.rowsIndex.data(), tmatrix.colsIndex.data(), tmatrix.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_ExportMtx(matrix, MTX_FILE_PATH), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_ImportMtx(MTX_FILE_PATH, &imported, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    spbla_Index nrows, ncols;
+    ASSERT_EQ(spbla_Matrix_Nrows(imported, &nrows), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Ncols(imported, &ncols), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(nrows, m);
+    ASSERT_EQ(ncols, n);
+
+    // Compare test matrix and library one
+    ASSERT_TRUE(tmatrix.areEqual(imported));
+
+    // Remember to release resources
+    ASSERT_EQ(spbla_Matrix_Free(matrix), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(imported), SPBLA_STATUS_SUCCESS);
+
+    std::remove(MTX_FILE_PATH);
+}
+
+void testMatrixImportFormats() {
+    // Banner, comments, values and symmetric expansion
+    writeFile("%%MatrixMarket matrix coordinate real symmetric\n"
+              "% comment line\n"
+              "\n"
+              "4 4 4\n"
+              "1 1 0.5\n"
+              "3 1 -1.0\n"
+              "% comment between entries\n"
+              "4 2 2e3\r\n"
+              "4 3 1");
+    checkImported(4, 4, {0, 0, 1, 2, 2, 3, 3}, {0, 2, 3, 0, 3, 1, 2});
+
+    // Duplicated entries of general matrix
+    writeFile("%%MatrixMarket matrix coordinate pattern general\n"
+              "2 3 3\n"
+              "2 3\n"
+              "1 2\n"
+              "2 3\n");
+    checkImported(2, 3, {0, 1}, {1, 2});
+
+    // Legacy file without banner uses 0-based indices
+    writeFile("# pyspbla sparse boolean matrix\n"
+              "3 2 3\n"
+              "0 1\n"
+              "2 0\n"
+              "1 1\n");
+    checkImported(3, 2, {0, 1, 2}, {1, 1, 0});
+
+    spbla_Matrix matrix = nullptr;
+
+    // Number of entries does not match header
+    writeFile("%%MatrixMarket matrix coordinate pattern general\n"
+              "2 2 3\n"
+              "1 1\n"
+              "2 2\n");
+    ASSERT_NE(spbla_Matrix_ImportMtx(MTX_FILE_PATH, &matrix, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    // Index out of bounds and zero index in 1-based file
+    writeFile("%%MatrixMarket matrix coordinate pattern general\n"
+              "2 2 1\n"
+              "3 1\n");
+    ASSERT_NE(spbla_Matrix_ImportMtx(MTX_FILE_PATH, &matrix, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    writeFile("%%MatrixMarket matrix coordinate pattern general\n"
+              "2 2 1\n"
+              "0 1\n");
+    ASSERT_NE(spbla_Matrix_ImportMtx(MTX_FILE_PATH, &matrix, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    // Dense array format is not supported
+    writeFile("%%MatrixMarket matrix array real general\n"
+              "1 1\n"
+              "1.0\n");
+    ASSERT_NE(spbla_Matrix_ImportMtx(MTX_FILE_PATH, &matrix, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    // Malformed entry
+    writeFile("%%MatrixMarket matrix coordinate pattern general\n"
+              "2 2 1\n"
+              "1x 1\n");
+    ASSERT_NE(spbla_Matrix_ImportMtx(MTX_FILE_PATH, &matrix, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    std::remove(MTX_FILE_PATH);
+}
+
+void testRun(spbla_Index m, spbla_Index n, spbla_Hints setup) {
+    ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
+
+    for (size_t i = 0; i < 5; i++) {
+        testMatrixExportImport(m, n, 0.0f + (0.05f) * ((float) i));
+    }
+
+    testMatrixImportFormats();
+
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+}
+
+#ifdef SPBLA_WITH_SEQUENTIAL
+TEST(spbla_Matrix, MtxSmallFallback) {
+    spbla_Index m = 60, n = 100;
+    testRun(m, n, SPBLA_HINT_CPU_BACKEND);
+}
+
+TEST(spbla_Matrix, MtxMediumFallback) {
+    spbla_Index m = 500, n = 1000;
+    testRun(m, n, SPBLA_HINT_CPU_BACKEND);
+}
+#endif
+
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, MtxSmallParallel) {
+    spbla_Index m = 60, n = 100;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, MtxMediumParallel) {
+    spbla_Index m = 500, n = 1000;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
+SPBLA_GTEST_MAIN
@@ -58,6 +58,30 @@ void testMatrixMultiplyAdd(spbla_Index m, spbla_Index t, spbla_Index n, float de
     ASSERT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
 }
 
+void testMatrixMultiplyAddSelf(spbla_Index n, float density, spbla_Hints flags) {
+    spbla_Matrix r;
+
+    // Generate test data with specified density
+    testing::Matrix tr = testing::Matrix::generateSparse(n, n, density);
+
+    // Allocate matrix and fill with input data
+    ASSERT_EQ(spbla_Matrix_New(&r, n, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(r, tr.rowsIndex.data(), tr.colsIndex.data(), tr.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+
+    // Evaluate naive r += r x r on the cpu to compare results
+    testing::MatrixMultiplyFunctor functor;
+    tr = functor(tr, tr, tr, true);
+
+    // Evaluate r += r x r (closure step pattern, all operands are the same matrix)
+    ASSERT_EQ(spbla_MxM(r, r, r, SPBLA_HINT_ACCUMULATE | flags), SPBLA_STATUS_SUCCESS);
+
+    // Compare results
+    ASSERT_EQ(tr.areEqual(r), true);
+
+    // Deallocate matrices
+    ASSERT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
+}
+
 void testMatrixMultiply(spbla_Index m, spbla_Index t, spbla_Index n, float density, spbla_Hints flags) {
     spbla_Matrix a, b, r;
 
@@ -91,6 +115,54 @@ void testMatrixMultiply(spbla_Index m, spbla_Index t, spbla_Index n, float densi
     ASSERT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
 }
 
+void testMatrixMultiplyTransposed(spbla_Index m, spbla_Index t, spbla_Index n, float density, bool accumulate, spbla_Hints flags) {
+    spbla_Matrix a, b, r;
+
+    bool transposeLeft = flags & SPBLA_HINT_TRANSPOSE_LEFT;
+    bool transposeRight = flags & SPBLA_HINT_TRANSPOSE_RIGHT;
+
+    // Operands are stored transposed, product uses them as m x t and t x n matrices
+    testing::Matrix sa = testing::Matrix::generateSparse(transposeLeft? t: m, transposeLeft? m: t, density);
+    testing::Matrix sb = testing::Matrix::generateSparse(transposeRight? n: t, transposeRight? t: n, density);
+    testing::Matrix tr = accumulate? testing::Matrix::generateSparse(m, n, density): testing::Matrix::empty(m, n);
+
+    testing::Matrix ta = transposeLeft? sa.transpose(): sa;
+    testing::Matrix tb = transposeRight? sb.transpose(): sb;
+
+    // Allocate input matrices and fill with input data
+    ASSERT_EQ(spbla_Matrix_New(&a, sa.nrows, sa.ncols), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&b, sb.nrows, sb.ncols), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&r, m, n), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_Matrix_Build(a, sa.rowsIndex.data(), sa.colsIndex.data(), sa.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(b, sb.rowsIndex.data(), sb.colsIndex.data(), sb.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(r, tr.rowsIndex.data(), tr.colsIndex.data(), tr.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+
+    // Evaluate naive r (+)= op(a) x op(b) on the cpu to compare results
+    testing::MatrixMultiplyFunctor functor;
+    tr = functor(ta, tb, tr, accumulate);
+
+    // Evaluate r (+)= op(a) x op(b) without explicit transpose
+    ASSERT_EQ(spbla_MxM(r, a, b, flags | (accumulate? SPBLA_HINT_ACCUMULATE: SPBLA_HINT_NO)), SPBLA_STATUS_SUCCESS);
+
+    // Compare results
+    ASSERT_EQ(tr.areEqual(r), true);
+
+    // Deallocate matrices
+    ASSERT_EQ(spbla_Matrix_Free(a), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(b), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
+}
+
+void testMatrixMultiplyTransposedAll(spbla_Index m, spbla_Index t, spbla_Index n, float density) {
+    spbla_Hints transposeFlags[] = { SPBLA_HINT_TRANSPOSE_LEFT, SPBLA_HINT_TRANSPOSE_RIGHT, SPBLA_HINT_TRANSPOSE_LEFT | SPBLA_HINT_TRANSPOSE_RIGHT };
+
+    for (auto flags: transposeFlags) {
+        testMatrixMultiplyTransposed(m, t, n, density, false, flags);
+        testMatrixMultiplyTransposed(m, t, n, density, true, flags);
+    }
+}
+
 void testRun(spbla_Index m, spbla_Index t, spbla_Index n, spbla_Hints setup) {
     // Setup library
     ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
@@ -103,6 +175,27 @@ void testRun(spbla_Index m, spbla_Index t, spbla_Index n, spbla_Hints setup) {
         testMatrixMultiply(m, t, n, 0.1f + (0.05f) * ((float) i), SPBLA_HINT_NO);
     }
 
+    for (size_t i = 0; i < 5; i++) {
+        testMatrixMultiplyAddSelf(m, 0.01f + (0.02f) * ((float) i), SPBLA_HINT_NO);
+    }
+
+    for (size_t i = 0; i < 5; i++) {
+        testMatrixMultiplyTransposedAll(m, t, n, 0.01f + (0.05f) * ((float) i));
+    }
+
+    // Finalize library
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+}
+
+void testRunSparse(spbla_Index m, spbla_Index t, spbla_Index n, float density, spbla_Hints setup) {
+    // Setup library
+    ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
+
+    // Very sparse operands with wide result rows (exercise short rows accumulators)
+    testMatrixMultiplyAdd(m, t, n, density, SPBLA_HINT_NO);
+    testMatrixMultiply(m, t, n, density, SPBLA_HINT_NO);
+    testMatrixMultiplyTransposedAll(m, t, n, density);
+
     // Finalize library
     ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
 }
@@ -141,6 +234,21 @@ TEST(spbla_Matrix, MultiplyLargeOpenCL) {
 }
 #endif
 
+void testRunDense(spbla_Index m, spbla_Index t, spbla_Index n, spbla_Hints setup) {
+    // Setup library
+    ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
+
+    // Dense operands with sizes not aligned to words (exercise bit matrix kernel)
+    for (size_t i = 0; i < 4; i++) {
+        testMatrixMultiplyAdd(m, t, n, 0.3f + (0.2f) * ((float) i), SPBLA_HINT_NO);
+        testMatrixMultiply(m, t, n, 0.3f + (0.2f) * ((float) i), SPBLA_HINT_NO);
+        testMatrixMultiplyAddSelf(m, 0.3f + (0.2f) * ((float) i), SPBLA_HINT_NO);
+    }
+
+    // Finalize library
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+}
+
 #ifdef SPBLA_WITH_SEQUENTIAL
 TEST(spbla_Matrix, MultiplySmallFallback) {
     spbla_Index m = 60, t = 100, n = 80;
@@ -156,6 +264,50 @@ TEST(spbla_Matrix, MultiplyLargeFallback) {
     spbla_Index m = 1000, t = 2000, n = 500;
     testRun(m, t, n, SPBLA_HINT_CPU_BACKEND);
 }
+
+TEST(spbla_Matrix, MultiplyDenseFallback) {
+    testRunDense(67, 131, 93, SPBLA_HINT_CPU_BACKEND);
+    testRunDense(150, 317, 250, SPBLA_HINT_CPU_BACKEND);
+}
+
+TEST(spbla_Matrix, MultiplySparseFallback) {
+    testRunSparse(500, 10000, 10000, 0.001f, SPBLA_HINT_CPU_BACKEND);
+    testRunSparse(200, 5000, 100000, 0.002f, SPBLA_HINT_CPU_BACKEND);
+}
+#endif
+
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, MultiplySmallParallel) {
+    spbla_Index m = 60, t = 100, n = 80;
+    testRun(m, t, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, MultiplyMediumParallel) {
+    spbla_Index m = 500, t = 1000, n = 800;
+    testRun(m, t, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, MultiplyLargeParallel) {
+    spbla_Index m = 1000, t = 2000, n = 500;
+    testRun(m, t, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, MultiplyDenseParallel) {
+    testRunDense(67, 131, 93, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+    testRunDense(150, 317, 250, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, MultiplySparseParallel) {
+    testRunSparse(500, 10000, 10000, 0.001f, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+    testRunSparse(200, 5000, 100000, 0.002f, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, MultiplyMediumParallelThreads) {
+    spbla_Index m = 500, t = 1000, n = 800;
+    ASSERT_EQ(spbla_SetNumThreads(4), SPBLA_STATUS_SUCCESS);
+    testRun(m, t, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+    ASSERT_EQ(spbla_SetNumThreads(0), SPBLA_STATUS_SUCCESS);
+}
 #endif
 
 SPBLA_GTEST_MAIN
\ No newline at end of file
@@ -0,0 +1,109 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <testing/testing.hpp>
+
+void testMatrixMultiplyMasked(spbla_Index m, spbla_Index t, spbla_Index n, float density, bool complement, bool accumulate, spbla_Hints flags) {
+    spbla_Matrix a, b, mask, r;
+
+    // Generate test data with specified density
+    testing::Matrix ta = testing::Matrix::generateSparse(m, t, density);
+    testing::Matrix tb = testing::Matrix::generateSparse(t, n, density);
+    testing::Matrix tmask = testing::Matrix::generateSparse(m, n, 0.5f);
+    testing::Matrix tr = accumulate? testing::Matrix::generateSparse(m, n, density): testing::Matrix::empty(m, n);
+
+    // Allocate input matrices and resize to fill with input data
+    ASSERT_EQ(spbla_Matrix_New(&a, m, t), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&b, t, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&mask, m, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&r, m, n), SPBLA_STATUS_SUCCESS);
+
+    // Transfer input data into input matrices
+    ASSERT_EQ(spbla_Matrix_Build(a, ta.rowsIndex.data(), ta.colsIndex.data(), ta.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(b, tb.rowsIndex.data(), tb.colsIndex.data(), tb.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(mask, tmask.rowsIndex.data(), tmask.colsIndex.data(), tmask.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(r, tr.rowsIndex.data(), tr.colsIndex.data(), tr.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+
+    // Evaluate naive r (+)= (a x b)<mask> on the cpu to compare results
+    testing::MatrixMultiplyFunctor multiplyFunctor;
+    testing::MatrixEWiseAddFunctor addFunctor;
+    testing::Matrix product = multiplyFunctor(ta, tb, testing::Matrix::empty(m, n), false).masked(tmask, complement);
+    tr = accumulate? addFunctor(tr, product): std::move(product);
+
+    // Evaluate r (+)= (a x b)<mask>
+    spbla_Hints hints = flags | (complement? SPBLA_HINT_MASK_COMPLEMENT: 0) | (accumulate? SPBLA_HINT_ACCUMULATE: 0);
+    ASSERT_EQ(spbla_MxM_Masked(r, mask, a, b, hints), SPBLA_STATUS_SUCCESS);
+
+    // Compare results
+    ASSERT_EQ(tr.areEqual(r), true);
+
+    // Deallocate matrices
+    ASSERT_EQ(spbla_Matrix_Free(a), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(b), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(mask), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
+}
+
+void testRun(spbla_Index m, spbla_Index t, spbla_Index n, spbla_Hints setup) {
+    // Setup library
+    ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
+
+    for (size_t i = 0; i < 5; i++) {
+        float density = 0.01f + (0.05f) * ((float) i);
+
+        testMatrixMultiplyMasked(m, t, n, density, false, false, SPBLA_HINT_NO);
+        testMatrixMultiplyMasked(m, t, n, density, true, false, SPBLA_HINT_NO);
+        testMatrixMultiplyMasked(m, t, n, density, false, true, SPBLA_HINT_NO);
+        testMatrixMultiplyMasked(m, t, n, density, true, true, SPBLA_HINT_NO);
+    }
+
+    // Finalize library
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+}
+
+#ifdef SPBLA_WITH_SEQUENTIAL
+TEST(spbla_Matrix, MultiplyMaskedSmallFallback) {
+    spbla_Index m = 60, t = 100, n = 80;
+    testRun(m, t, n, SPBLA_HINT_CPU_BACKEND);
+}
+
+TEST(spbla_Matrix, MultiplyMaskedMediumFallback) {
+    spbla_Index m = 500, t = 1000, n = 800;
+    testRun(m, t, n, SPBLA_HINT_CPU_BACKEND);
+}
+#endif
+
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, MultiplyMaskedSmallParallel) {
+    spbla_Index m = 60, t = 100, n = 80;
+    testRun(m, t, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, MultiplyMaskedMediumParallel) {
+    spbla_Index m = 500, t = 1000, n = 800;
+    testRun(m, t, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
+SPBLA_GTEST_MAIN
@@ -0,0 +1,164 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <testing/testing.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <utility>
+
+static const char* MATRIX_FILE_PATH = "test_matrix_save_load.bin";
+
+void testMatrixSaveLoad(spbla_Index m, spbla_Index n, float density) {
+    spbla_Matrix matrix = nullptr;
+    spbla_Matrix loaded = nullptr;
+
+    testing::Matrix tmatrix = std::move(testing::Matrix::generateSparse(m, n, density));
+
+    ASSERT_EQ(spbla_Matrix_New(&matrix, m, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(matrix, tmatrix.rowsIndex.data(), tmatrix.colsIndex.data(), tmatrix.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Save(matrix, MATRIX_FILE_PATH), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_ResetStats(), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Load(MATRIX_FILE_PATH, &loaded, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    // Load is not counted as build
+    spbla_OperationStats stats[SPBLA_OPERATION_COUNT];
+    ASSERT_EQ(spbla_GetStats(stats, SPBLA_OPERATION_COUNT), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(stats[SPBLA_OPERATION_LOAD].calls, 1);
+    EXPECT_EQ(stats[SPBLA_OPERATION_LOAD].nnzOut, tmatrix.nvals);
+    EXPECT_EQ(stats[SPBLA_OPERATION_BUILD].calls, 0);
+
+    spbla_Index nrows, ncols;
+    ASSERT_EQ(spbla_Matrix_Nrows(loaded, &nrows), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Ncols(loaded, &ncols), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(nrows, m);
+    ASSERT_EQ(ncols, n);
+
+    // Compare test matrix and library one
+    ASSERT_TRUE(tmatrix.areEqual(loaded));
+
+    // Remember to release resources
+    ASSERT_EQ(spbla_Matrix_Free(matrix), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(loaded), SPBLA_STATUS_SUCCESS);
+
+    std::remove(MATRIX_FILE_PATH);
+}
+
+void testMatrixLoadCorrupted(spbla_Index m, spbla_Index n, float density) {
+    spbla_Matrix matrix = nullptr;
+    spbla_Matrix loaded = nullptr;
+
+    testing::Matrix tmatrix = std::move(testing::Matrix::generateSparse(m, n, density));
+
+    ASSERT_EQ(spbla_Matrix_New(&matrix, m, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(matrix, tmatrix.rowsIndex.data(), tmatrix.colsIndex.data(), tmatrix.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Save(matrix, MATRIX_FILE_PATH), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(matrix), SPBLA_STATUS_SUCCESS);
+
+    std::vector<char> content;
+    {
+        std::ifstream file(MATRIX_FILE_PATH, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    // Flip last byte of column indices
+    {
+        std::vector<char> corrupted = content;
+        corrupted.back() ^= 0x1;
+        std::ofstream file(MATRIX_FILE_PATH, std::ios::binary | std::ios::trunc);
+        file.write(corrupted.data(), corrupted.size());
+    }
+
+    ASSERT_NE(spbla_Matrix_Load(MATRIX_FILE_PATH, &loaded, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    // Truncate file
+    {
+        std::ofstream file(MATRIX_FILE_PATH, std::ios::binary | std::ios::trunc);
+        file.write(content.data(), content.size() - 1);
+    }
+
+    ASSERT_NE(spbla_Matrix_Load(MATRIX_FILE_PATH, &loaded, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    // Header fields: nrows at 24, ncols at 32, nvals at 40, column indices offset at 56
+    auto writeHeader = [&](std::vector<char> corrupted, std::initializer_list<std::pair<size_t, uint64_t>> fields, size_t size) {
+        for (auto& field: fields)
+            std::memcpy(corrupted.data() + field.first, &field.second, sizeof(uint64_t));
+        corrupted.resize(size);
+        std::ofstream file(MATRIX_FILE_PATH, std::ios::binary | std::ios::trunc);
+        file.write(corrupted.data(), corrupted.size());
+    };
+
+    // Truncated header
+    writeHeader(content, {}, 40);
+    ASSERT_EQ(spbla_Matrix_Load(MATRIX_FILE_PATH, &loaded, SPBLA_HINT_NO), SPBLA_STATUS_INVALID_ARGUMENT);
+
+    // Huge rows count, sections bounds math must not overflow
+    writeHeader(content, {{24, (uint64_t) 1 << 62}, {40, 0}, {56, 192}}, 192);
+    ASSERT_EQ(spbla_Matrix_Load(MATRIX_FILE_PATH, &loaded, SPBLA_HINT_NO), SPBLA_STATUS_INVALID_ARGUMENT);
+
+    // Header is covered by checksum
+    writeHeader(content, {{32, (uint64_t) n + 1}}, content.size());
+    ASSERT_EQ(spbla_Matrix_Load(MATRIX_FILE_PATH, &loaded, SPBLA_HINT_NO), SPBLA_STATUS_INVALID_ARGUMENT);
+
+    std::remove(MATRIX_FILE_PATH);
+}
+
+void testRun(spbla_Index m, spbla_Index n, spbla_Hints setup) {
+    ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
+
+    for (size_t i = 0; i < 5; i++) {
+        testMatrixSaveLoad(m, n, 0.0f + (0.05f) * ((float) i));
+    }
+
+    testMatrixLoadCorrupted(m, n, 0.1f);
+
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+}
+
+#ifdef SPBLA_WITH_SEQUENTIAL
+TEST(spbla_Matrix, SaveLoadSmallFallback) {
+    spbla_Index m = 60, n = 100;
+    testRun(m, n, SPBLA_HINT_CPU_BACKEND);
+}
+
+TEST(spbla_Matrix, SaveLoadMediumFallback) {
+    spbla_Index m = 500, n = 1000;
+    testRun(m, n, SPBLA_HINT_CPU_BACKEND);
+}
+#endif
+
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, SaveLoadSmallParallel) {
+    spbla_Index m = 60, n = 100;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, SaveLoadMediumParallel) {
+    spbla_Index m = 500, n = 1000;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
+SPBLA_GTEST_MAIN
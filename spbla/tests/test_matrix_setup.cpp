@@ -23,6 +23,8 @@
 /**********************************************************************************/
 
 #include <testing/testing.hpp>
+#include <algorithm>
+#include <numeric>
 
 TEST(spbla_Matrix, CreateDestroy) {
     spbla_Matrix matrix = nullptr;
@@ -51,6 +53,39 @@ void testMatrixFilling(spbla_Index m, spbla_Index n, float density) {
     ASSERT_EQ(spbla_Matrix_Free(matrix), SPBLA_STATUS_SUCCESS);
 }
 
+void testMatrixFillingUnsorted(spbla_Index m, spbla_Index n, float density) {
+    spbla_Matrix matrix = nullptr;
+
+    testing::Matrix tmatrix = std::move(testing::Matrix::generateSparse(m, n, density));
+
+    // Shuffle pairs and duplicate every fourth one
+    std::vector<size_t> order(tmatrix.nvals);
+    std::iota(order.begin(), order.end(), 0);
+
+    for (size_t k = 0; k < tmatrix.nvals; k += 4) {
+        order.push_back(k);
+    }
+
+    std::shuffle(order.begin(), order.end(), std::default_random_engine(std::chrono::system_clock::now().time_since_epoch().count()));
+
+    std::vector<spbla_Index> rows(order.size());
+    std::vector<spbla_Index> cols(order.size());
+
+    for (size_t k = 0; k < order.size(); k++) {
+        rows[k] = tmatrix.rowsIndex[order[k]];
+        cols[k] = tmatrix.colsIndex[order[k]];
+    }
+
+    ASSERT_EQ(spbla_Matrix_New(&matrix, m, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(matrix, rows.data(), cols.data(), rows.size(), SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    // Compare test matrix and library one
+    ASSERT_EQ(tmatrix.areEqual(matrix), true);
+
+    // Remember to release resources
+    ASSERT_EQ(spbla_Matrix_Free(matrix), SPBLA_STATUS_SUCCESS);
+}
+
 void testRun(spbla_Index m, spbla_Index n, spbla_Hints setup) {
     ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
 
@@ -58,6 +93,10 @@ void testRun(spbla_Index m, spbla_Index n, spbla_Hints setup) {
         testMatrixFilling(m, n, 0.001f + (0.05f) * ((float) i));
     }
 
+    for (size_t i = 0; i < 10; i++) {
+        testMatrixFillingUnsorted(m, n, 0.001f + (0.05f) * ((float) i));
+    }
+
     ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
 }
 
@@ -112,4 +151,21 @@ TEST(spbla_Matrix, FillingLargeFallback) {
 }
 #endif
 
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, FillingSmallParallel) {
+    spbla_Index m = 60, n = 100;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, FillingMediumParallel) {
+    spbla_Index m = 500, n = 1000;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, FillingLargeParallel) {
+    spbla_Index m = 1000, n = 2000;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
 SPBLA_GTEST_MAIN
\ No newline at end of file
@@ -0,0 +1,217 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <testing/testing.hpp>
+#include <set>
+
+// Matrix with dense blocks of 64 x 64 values in random positions and sparse values around
+static testing::Matrix generateBlocks(spbla_Index m, spbla_Index n, float blockDensity, float density) {
+    std::default_random_engine engine(std::chrono::system_clock::now().time_since_epoch().count());
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::set<testing::Pair, testing::PairCmp> values;
+
+    for (spbla_Index bi = 0; bi < m; bi += 64) {
+        for (spbla_Index bj = 0; bj < n; bj += 64) {
+            if (dist(engine) > 0.5f)
+                continue;
+
+            for (spbla_Index i = bi; i < std::min(m, bi + 64); i++) {
+                for (spbla_Index j = bj; j < std::min(n, bj + 64); j++) {
+                    if (dist(engine) <= blockDensity)
+                        values.insert(testing::Pair{i, j});
+                }
+            }
+        }
+    }
+
+    auto noise = testing::Matrix::generateSparse(m, n, density);
+    for (size_t k = 0; k < noise.nvals; k++)
+        values.insert(testing::Pair{noise.rowsIndex[k], noise.colsIndex[k]});
+
+    testing::Matrix result;
+    result.nrows = m;
+    result.ncols = n;
+    result.nvals = values.size();
+
+    for (auto& p: values) {
+        result.rowsIndex.push_back(p.i);
+        result.colsIndex.push_back(p.j);
+    }
+
+    return result;
+}
+
+static void buildMatrix(spbla_Matrix& matrix, const testing::Matrix& source) {
+    ASSERT_EQ(spbla_Matrix_New(&matrix, source.nrows, source.ncols), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(matrix, source.rowsIndex.data(), source.colsIndex.data(), source.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+}
+
+void testTilesOperations(spbla_Index m, spbla_Index t, spbla_Index n, float blockDensity) {
+    spbla_Matrix a, b, c, d, s, r, x;
+
+    auto ta = generateBlocks(m, t, blockDensity, 0.01f);
+    auto tb = generateBlocks(t, n, blockDensity, 0.01f);
+    auto tc = generateBlocks(m, n, blockDensity, 0.01f);
+    auto td = generateBlocks(m, t, blockDensity, 0.01f);
+    auto ts = testing::Matrix::generateSparse(m, t, 0.01f);
+
+    testing::MatrixMultiplyFunctor multiply;
+    testing::MatrixEWiseAddFunctor add;
+    testing::MatrixEWiseMultFunctor mult;
+    testing::MatrixEWiseDiffFunctor diff;
+
+    buildMatrix(a, ta);
+    buildMatrix(b, tb);
+    buildMatrix(c, tc);
+    buildMatrix(d, td);
+    buildMatrix(s, ts);
+    ASSERT_EQ(spbla_Matrix_New(&r, m, t), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(ta.areEqual(a), true);
+
+    // Tiles of both operands
+    ASSERT_EQ(spbla_Matrix_EWiseAdd(r, a, d, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(add(ta, td).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_EWiseMult(r, a, d, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(mult(ta, td).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_EWiseDiff(r, a, d, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(diff(ta, td).areEqual(r), true);
+
+    // Tiles with sparse operand
+    ASSERT_EQ(spbla_Matrix_EWiseAdd(r, s, a, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(add(ts, ta).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_EWiseMult(r, a, s, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(mult(ta, ts).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_EWiseDiff(r, s, a, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(diff(ts, ta).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_New(&r, m, n), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_MxM(r, a, b, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(multiply(ta, tb, testing::Matrix::empty(m, n), false).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_Duplicate(c, &x), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_MxM(x, a, b, SPBLA_HINT_ACCUMULATE), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(multiply(ta, tb, tc, true).areEqual(x), true);
+    ASSERT_EQ(spbla_Matrix_Free(x), SPBLA_STATUS_SUCCESS);
+
+    // Operations without tile kernels read operands through temporary csr, operands keep their storage
+    ASSERT_EQ(spbla_MxM(r, s, b, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(multiply(ts, tb, testing::Matrix::empty(m, n), false).areEqual(r), true);
+
+    ASSERT_EQ(spbla_Matrix_New(&x, t, m), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Transpose(x, a, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(ta.transpose().areEqual(x), true);
+    ASSERT_EQ(spbla_Matrix_Free(x), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_Matrix_New(&x, m, 1), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Reduce(x, c, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(tc.reduce().areEqual(x), true);
+    ASSERT_EQ(spbla_Matrix_Free(x), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_Matrix_New(&x, m / 2, n / 2), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_ExtractSubMatrix(x, c, m / 3, n / 5, m / 2, n / 2, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(tc.subMatrix(m / 3, n / 5, m / 2, n / 2).areEqual(x), true);
+    ASSERT_EQ(spbla_Matrix_Free(x), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(ta.areEqual(a), true);
+    ASSERT_EQ(tc.areEqual(c), true);
+
+    // Values inserted into the tiled matrix
+    ASSERT_EQ(spbla_Matrix_Duplicate(a, &x), SPBLA_STATUS_SUCCESS);
+    for (size_t k = 0; k < ts.nvals; k++)
+        ASSERT_EQ(spbla_Matrix_SetElement(x, ts.rowsIndex[k], ts.colsIndex[k]), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(add(ta, ts).areEqual(x), true);
+    ASSERT_EQ(spbla_Matrix_Free(x), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_Matrix_Free(a), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(b), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(c), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(d), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(s), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
+}
+
+void testTilesClosure(spbla_Index n, float blockDensity) {
+    spbla_Matrix a, r;
+
+    auto ta = generateBlocks(n, n, blockDensity, 0.005f);
+
+    testing::MatrixMultiplyFunctor multiply;
+    testing::Matrix tr = ta;
+
+    // Closure makes the matrix denser on each iteration, so storage changes between steps
+    buildMatrix(a, ta);
+    buildMatrix(r, ta);
+
+    for (size_t i = 0; i < 3; i++) {
+        tr = multiply(tr, ta, tr, true);
+        ASSERT_EQ(spbla_MxM(r, r, a, SPBLA_HINT_ACCUMULATE), SPBLA_STATUS_SUCCESS);
+        ASSERT_EQ(tr.areEqual(r), true);
+    }
+
+    ASSERT_EQ(spbla_Matrix_Free(a), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
+}
+
+void testRun(spbla_Index m, spbla_Index t, spbla_Index n, spbla_Hints setup) {
+    // Setup library
+    ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
+
+    for (size_t i = 0; i < 4; i++) {
+        float blockDensity = 0.1f + (0.25f) * ((float) i);
+
+        testTilesOperations(m, t, n, blockDensity);
+        testTilesClosure(t, blockDensity);
+    }
+
+    // Finalize library
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+}
+
+#ifdef SPBLA_WITH_SEQUENTIAL
+TEST(spbla_Matrix, TilesSmallFallback) {
+    testRun(130, 200, 150, SPBLA_HINT_CPU_BACKEND);
+}
+
+TEST(spbla_Matrix, TilesMediumFallback) {
+    testRun(500, 700, 600, SPBLA_HINT_CPU_BACKEND);
+}
+#endif
+
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, TilesSmallParallel) {
+    testRun(130, 200, 150, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, TilesMediumParallel) {
+    testRun(500, 700, 600, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
+SPBLA_GTEST_MAIN
@@ -0,0 +1,111 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <testing/testing.hpp>
+
+void testMatrixTransitiveClosure(spbla_Index n, float density, bool inplace) {
+    spbla_Matrix a, t;
+
+    // Generate test data with specified density
+    testing::Matrix ta = testing::Matrix::generateSparse(n, n, density);
+
+    // Allocate input matrix and fill with input data
+    ASSERT_EQ(spbla_Matrix_New(&a, n, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(a, ta.rowsIndex.data(), ta.colsIndex.data(), ta.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+
+    // Evaluate naive closure t += t x t on the cpu to compare results
+    testing::Matrix tr = ta;
+    size_t total;
+
+    do {
+        total = tr.nvals;
+
+        testing::MatrixMultiplyFunctor functor;
+        tr = functor(tr, tr, tr, true);
+    }
+    while (tr.nvals != total);
+
+    // Evaluate closure in place or into separate matrix
+    if (inplace) {
+        t = a;
+    }
+    else {
+        ASSERT_EQ(spbla_Matrix_New(&t, n, n), SPBLA_STATUS_SUCCESS);
+    }
+
+    ASSERT_EQ(spbla_Matrix_TransitiveClosure(t, a, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+
+    // Compare results
+    ASSERT_EQ(tr.areEqual(t), true);
+
+    // Source matrix must remain unchanged
+    if (!inplace) {
+        ASSERT_EQ(ta.areEqual(a), true);
+        ASSERT_EQ(spbla_Matrix_Free(t), SPBLA_STATUS_SUCCESS);
+    }
+
+    // Deallocate matrices
+    ASSERT_EQ(spbla_Matrix_Free(a), SPBLA_STATUS_SUCCESS);
+}
+
+void testRun(spbla_Index n, spbla_Hints setup) {
+    // Setup library
+    ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
+
+    for (size_t i = 0; i < 5; i++) {
+        float density = (0.5f + (float) i) / (float) n;
+
+        testMatrixTransitiveClosure(n, density, false);
+        testMatrixTransitiveClosure(n, density, true);
+    }
+
+    // Finalize library
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+}
+
+#ifdef SPBLA_WITH_SEQUENTIAL
+TEST(spbla_Matrix, TransitiveClosureSmallFallback) {
+    spbla_Index n = 60;
+    testRun(n, SPBLA_HINT_CPU_BACKEND);
+}
+
+TEST(spbla_Matrix, TransitiveClosureMediumFallback) {
+    spbla_Index n = 500;
+    testRun(n, SPBLA_HINT_CPU_BACKEND);
+}
+#endif
+
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, TransitiveClosureSmallParallel) {
+    spbla_Index n = 60;
+    testRun(n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, TransitiveClosureMediumParallel) {
+    spbla_Index n = 500;
+    testRun(n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
+SPBLA_GTEST_MAIN
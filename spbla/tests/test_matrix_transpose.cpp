@@ -50,6 +50,47 @@ void testMatrixTranspose(spbla_Index m, spbla_Index n, float density, spbla_Hint
     EXPECT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
 }
 
+void testMatrixTransposeKept(spbla_Index m, spbla_Index n, float density) {
+    spbla_Matrix a, r, c;
+
+    testing::Matrix ta = testing::Matrix::generateSparse(m, n, density);
+    testing::Matrix tb = testing::Matrix::generateSparse(m, n, density);
+    spbla_Index columns = n / 10 + 1;
+
+    // Matrices keep transposed storage, it is built on first use
+    EXPECT_EQ(spbla_Matrix_NewWithHints(&a, m, n, SPBLA_HINT_KEEP_TRANSPOSED), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Matrix_NewWithHints(&r, n, m, SPBLA_HINT_KEEP_TRANSPOSED), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Matrix_New(&c, m, columns), SPBLA_STATUS_SUCCESS);
+
+    EXPECT_EQ(spbla_Matrix_Build(a, ta.rowsIndex.data(), ta.colsIndex.data(), ta.nvals, SPBLA_HINT_VALUES_SORTED), SPBLA_STATUS_SUCCESS);
+
+    // Transpose twice, second one reuses stored data
+    for (size_t k = 0; k < 2; k++) {
+        EXPECT_EQ(spbla_Matrix_Transpose(r, a, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+        EXPECT_EQ(ta.transpose().areEqual(r), true);
+    }
+
+    // Narrow columns range is extracted from the transposed storage
+    EXPECT_EQ(spbla_Matrix_ExtractSubMatrix(c, a, 0, n / 2, m, columns, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(ta.subMatrix(0, n / 2, m, columns).areEqual(c), true);
+
+    // Transposed storage is dropped on write
+    EXPECT_EQ(spbla_Matrix_Build(a, tb.rowsIndex.data(), tb.colsIndex.data(), tb.nvals, SPBLA_HINT_VALUES_SORTED), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Matrix_Transpose(r, a, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(tb.transpose().areEqual(r), true);
+
+    EXPECT_EQ(spbla_Matrix_ExtractSubMatrix(c, a, 0, n / 2, m, columns, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(tb.subMatrix(0, n / 2, m, columns).areEqual(c), true);
+
+    // Result of the transpose has source values as transposed storage
+    EXPECT_EQ(spbla_Matrix_Transpose(a, r, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(tb.areEqual(a), true);
+
+    EXPECT_EQ(spbla_Matrix_Free(a), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Matrix_Free(r), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(spbla_Matrix_Free(c), SPBLA_STATUS_SUCCESS);
+}
+
 void testRun(spbla_Index m, spbla_Index n, spbla_Hints setup) {
     // Setup library
     ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
@@ -58,6 +99,10 @@ void testRun(spbla_Index m, spbla_Index n, spbla_Hints setup) {
         testMatrixTranspose(m, n, 0.1f + (0.05f) * ((float) i), SPBLA_HINT_NO);
     }
 
+    for (size_t i = 0; i < 5; i++) {
+        testMatrixTransposeKept(m, n, 0.1f + (0.05f) * ((float) i));
+    }
+
     // Finalize library
     ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
 }
@@ -113,4 +158,21 @@ TEST(spbla_Matrix, TransposeLargeFallback) {
 }
 #endif
 
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Matrix, TransposeSmallParallel) {
+    spbla_Index m = 60, n = 80;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, TransposeMediumParallel) {
+    spbla_Index m = 500, n = 800;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Matrix, TransposeLargeParallel) {
+    spbla_Index m = 2500, n = 1500;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
 SPBLA_GTEST_MAIN
@@ -0,0 +1,244 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include <testing/testing.hpp>
+#include <algorithm>
+#include <chrono>
+
+static std::vector<spbla_Index> generateVector(spbla_Index nrows, float density) {
+    std::vector<spbla_Index> rows;
+    std::default_random_engine engine(std::chrono::system_clock::now().time_since_epoch().count());
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+
+    for (spbla_Index i = 0; i < nrows; i++) {
+        if (distribution(engine) <= density)
+            rows.push_back(i);
+    }
+
+    return rows;
+}
+
+static std::vector<spbla_Index> extractVector(spbla_Vector v) {
+    spbla_Index nvals;
+    EXPECT_EQ(spbla_Vector_Nvals(v, &nvals), SPBLA_STATUS_SUCCESS);
+
+    std::vector<spbla_Index> rows(nvals);
+    EXPECT_EQ(spbla_Vector_ExtractValues(v, rows.data(), &nvals), SPBLA_STATUS_SUCCESS);
+    EXPECT_EQ(nvals, rows.size());
+
+    return rows;
+}
+
+// Reference r<mask> = v x a (or a x v, if mxv flag is set) on the cpu
+static std::vector<spbla_Index> evalReference(const testing::Matrix& a, const std::vector<spbla_Index>& v, bool mxv,
+                                              const std::vector<spbla_Index>* mask, bool complement) {
+    spbla_Index nrows = mxv? a.nrows: a.ncols;
+    std::vector<bool> frontier(mxv? a.ncols: a.nrows, false);
+    std::vector<bool> result(nrows, false);
+    std::vector<bool> allowed(nrows, mask == nullptr || complement);
+
+    for (auto i: v)
+        frontier[i] = true;
+
+    if (mask) {
+        for (auto i: *mask)
+            allowed[i] = !complement;
+    }
+
+    for (size_t k = 0; k < a.nvals; k++) {
+        spbla_Index i = mxv? a.colsIndex[k]: a.rowsIndex[k];
+        spbla_Index j = mxv? a.rowsIndex[k]: a.colsIndex[k];
+
+        if (frontier[i] && allowed[j])
+            result[j] = true;
+    }
+
+    std::vector<spbla_Index> rows;
+    for (spbla_Index i = 0; i < nrows; i++) {
+        if (result[i])
+            rows.push_back(i);
+    }
+
+    return rows;
+}
+
+void testVectorBuildExtract(spbla_Index n, float density) {
+    spbla_Vector v, d;
+
+    auto values = generateVector(n, density);
+    auto unsorted = values;
+
+    // Shuffle and duplicate values to check sort and reduction of the build
+    unsorted.insert(unsorted.end(), values.begin(), values.end());
+    std::reverse(unsorted.begin(), unsorted.end());
+
+    ASSERT_EQ(spbla_Vector_New(&v, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_Build(v, unsorted.data(), unsorted.size(), SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(extractVector(v), values);
+
+    ASSERT_EQ(spbla_Vector_Duplicate(v, &d), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(extractVector(d), values);
+
+    spbla_Index nrows;
+    ASSERT_EQ(spbla_Vector_Nrows(d, &nrows), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(nrows, n);
+
+    ASSERT_EQ(spbla_Vector_Free(v), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_Free(d), SPBLA_STATUS_SUCCESS);
+}
+
+void testMultiplyVector(spbla_Index m, spbla_Index n, float density, float frontierDensity, bool mxv, bool masked, bool complement) {
+    spbla_Matrix a;
+    spbla_Vector v, mask, r;
+
+    spbla_Index inputSize = mxv? n: m;
+    spbla_Index resultSize = mxv? m: n;
+
+    testing::Matrix ta = testing::Matrix::generateSparse(m, n, density);
+    auto tv = generateVector(inputSize, frontierDensity);
+    auto tmask = generateVector(resultSize, 0.5f);
+
+    ASSERT_EQ(spbla_Matrix_New(&a, m, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_New(&v, inputSize), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_New(&mask, resultSize), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_New(&r, resultSize), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(spbla_Matrix_Build(a, ta.rowsIndex.data(), ta.colsIndex.data(), ta.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_Build(v, tv.data(), tv.size(), SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_Build(mask, tmask.data(), tmask.size(), SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+
+    auto expected = evalReference(ta, tv, mxv, masked? &tmask: nullptr, complement);
+
+    spbla_Hints hints = complement? SPBLA_HINT_MASK_COMPLEMENT: SPBLA_HINT_NO;
+
+    if (mxv && masked)
+        ASSERT_EQ(spbla_MxV_Masked(r, mask, a, v, hints), SPBLA_STATUS_SUCCESS);
+    else if (mxv)
+        ASSERT_EQ(spbla_MxV(r, a, v, hints), SPBLA_STATUS_SUCCESS);
+    else if (masked)
+        ASSERT_EQ(spbla_VxM_Masked(r, mask, v, a, hints), SPBLA_STATUS_SUCCESS);
+    else
+        ASSERT_EQ(spbla_VxM(r, v, a, hints), SPBLA_STATUS_SUCCESS);
+
+    ASSERT_EQ(extractVector(r), expected);
+
+    ASSERT_EQ(spbla_Matrix_Free(a), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_Free(v), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_Free(mask), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_Free(r), SPBLA_STATUS_SUCCESS);
+}
+
+void testReachability(spbla_Index n, float density) {
+    spbla_Matrix a;
+    spbla_Vector front, visited;
+
+    testing::Matrix ta = testing::Matrix::generateSparse(n, n, density);
+
+    ASSERT_EQ(spbla_Matrix_New(&a, n, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_New(&front, n), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Matrix_Build(a, ta.rowsIndex.data(), ta.colsIndex.data(), ta.nvals, SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+
+    // Reference traversal from the vertex 0
+    std::vector<spbla_Index> expected{0};
+    std::vector<spbla_Index> reference{0};
+
+    while (!reference.empty()) {
+        reference = evalReference(ta, reference, false, &expected, true);
+        expected.insert(expected.end(), reference.begin(), reference.end());
+        std::sort(expected.begin(), expected.end());
+    }
+
+    // Traversal: front = (front x a)<!visited>, visited += front
+    spbla_Index source = 0;
+    ASSERT_EQ(spbla_Vector_Build(front, &source, 1, SPBLA_HINT_NO), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_Duplicate(front, &visited), SPBLA_STATUS_SUCCESS);
+
+    auto reached = extractVector(visited);
+
+    while (true) {
+        ASSERT_EQ(spbla_VxM_Masked(front, visited, front, a, SPBLA_HINT_MASK_COMPLEMENT), SPBLA_STATUS_SUCCESS);
+
+        auto found = extractVector(front);
+        if (found.empty())
+            break;
+
+        reached.insert(reached.end(), found.begin(), found.end());
+        std::sort(reached.begin(), reached.end());
+        ASSERT_EQ(spbla_Vector_Build(visited, reached.data(), reached.size(), SPBLA_HINT_VALUES_SORTED | SPBLA_HINT_NO_DUPLICATES), SPBLA_STATUS_SUCCESS);
+    }
+
+    ASSERT_EQ(reached, expected);
+
+    ASSERT_EQ(spbla_Matrix_Free(a), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_Free(front), SPBLA_STATUS_SUCCESS);
+    ASSERT_EQ(spbla_Vector_Free(visited), SPBLA_STATUS_SUCCESS);
+}
+
+void testRun(spbla_Index m, spbla_Index n, spbla_Hints setup) {
+    // Setup library
+    ASSERT_EQ(spbla_Initialize(setup), SPBLA_STATUS_SUCCESS);
+
+    testVectorBuildExtract(m, 0.1f);
+    testVectorBuildExtract(n, 0.7f);
+
+    // Sparse frontier prefers push, dense one prefers pull
+    for (float frontierDensity: {0.001f, 0.01f, 0.2f, 0.9f}) {
+        for (bool mxv: {false, true}) {
+            testMultiplyVector(m, n, 0.01f, frontierDensity, mxv, false, false);
+            testMultiplyVector(m, n, 0.01f, frontierDensity, mxv, true, false);
+            testMultiplyVector(m, n, 0.01f, frontierDensity, mxv, true, true);
+        }
+    }
+
+    testReachability(m, 2.0f / (float) m);
+
+    // Finalize library
+    ASSERT_EQ(spbla_Finalize(), SPBLA_STATUS_SUCCESS);
+}
+
+#ifdef SPBLA_WITH_SEQUENTIAL
+TEST(spbla_Vector, MultiplySmallFallback) {
+    spbla_Index m = 60, n = 80;
+    testRun(m, n, SPBLA_HINT_CPU_BACKEND);
+}
+
+TEST(spbla_Vector, MultiplyMediumFallback) {
+    spbla_Index m = 1000, n = 2000;
+    testRun(m, n, SPBLA_HINT_CPU_BACKEND);
+}
+#endif
+
+#ifdef SPBLA_WITH_PARALLEL
+TEST(spbla_Vector, MultiplySmallParallel) {
+    spbla_Index m = 60, n = 80;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+
+TEST(spbla_Vector, MultiplyMediumParallel) {
+    spbla_Index m = 1000, n = 2000;
+    testRun(m, n, SPBLA_HINT_CPU_PARALLEL_BACKEND);
+}
+#endif
+
+SPBLA_GTEST_MAIN
@@ -137,6 +137,32 @@ namespace testing {
             return std::move(result);
         }
 
+        Matrix masked(const Matrix& mask, bool complement) const {
+            Matrix result;
+            result.nrows = nrows;
+            result.ncols = ncols;
+
+            std::unordered_set<Pair,PairHash,PairEq> maskIndices;
+
+            for (size_t id = 0; id < mask.nvals; id++) {
+                maskIndices.emplace(Pair{mask.rowsIndex[id], mask.colsIndex[id]});
+            }
+
+            for (size_t id = 0; id < nvals; id++) {
+                auto r = rowsIndex[id];
+                auto c = colsIndex[id];
+                bool inMask = maskIndices.find(Pair{r, c}) != maskIndices.end();
+
+                if (inMask != complement) {
+                    result.rowsIndex.push_back(r);
+                    result.colsIndex.push_back(c);
+                    result.nvals += 1;
+                }
+            }
+
+            return std::move(result);
+        }
+
         bool areEqual(spbla_Matrix matrix) const {
             spbla_Index extNvals;
 
@@ -218,6 +244,46 @@ namespace testing {
             return std::move(matrix);
         }
 
+        /**
+         * Generates matrix with library O(nvals) generator (library must be initialized).
+         * Result depends only on the arguments, so it is reproducible between runs.
+         */
+        static Matrix generate(size_t nrows, size_t ncols, spbla_Generator generator, size_t nvals, uint64_t seed,
+                               const spbla_GeneratorParams* params = nullptr) {
+            Matrix matrix;
+            matrix.nrows = nrows;
+            matrix.ncols = ncols;
+
+            spbla_Matrix handle = nullptr;
+            spbla_Index count = 0;
+
+            if (spbla_Matrix_New(&handle, nrows, ncols) != SPBLA_STATUS_SUCCESS)
+                return matrix;
+
+            if (spbla_Matrix_Generate(handle, generator, nvals, seed, params, SPBLA_HINT_NO) == SPBLA_STATUS_SUCCESS &&
+                spbla_Matrix_Nvals(handle, &count) == SPBLA_STATUS_SUCCESS) {
+                matrix.rowsIndex.resize(count);
+                matrix.colsIndex.resize(count);
+                spbla_Matrix_ExtractPairs(handle, matrix.rowsIndex.data(), matrix.colsIndex.data(), &count);
+                matrix.nvals = count;
+            }
+
+            spbla_Matrix_Free(handle);
+            return matrix;
+        }
+
+        static Matrix generateErdosRenyi(size_t nrows, size_t ncols, size_t nvals, uint64_t seed) {
+            return generate(nrows, ncols, SPBLA_GENERATOR_ERDOS_RENYI, nvals, seed);
+        }
+
+        static Matrix generateRmat(size_t nrows, size_t ncols, size_t nvals, uint64_t seed) {
+            return generate(nrows, ncols, SPBLA_GENERATOR_RMAT, nvals, seed);
+        }
+
+        static Matrix generatePowerLaw(size_t nrows, size_t ncols, size_t nvals, uint64_t seed) {
+            return generate(nrows, ncols, SPBLA_GENERATOR_POWER_LAW, nvals, seed);
+        }
+
         static Matrix empty(size_t nrows, size_t ncols) {
             Matrix out;
             out.nrows = nrows;
@@ -0,0 +1,63 @@
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2020, 2021 JetBrains-Research                                    */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPBLA_TESTING_MATRIXEWISEMULT_HPP
+#define SPBLA_TESTING_MATRIXEWISEMULT_HPP
+
+#include <testing/matrix.hpp>
+#include <algorithm>
+#include <iterator>
+
+namespace testing {
+
+    struct MatrixEWiseMultFunctor {
+        Matrix operator()(const Matrix& a, const Matrix& b) {
+            assert(a.nrows == b.nrows);
+            assert(a.ncols == b.ncols);
+
+            a.computeRowOffsets();
+            b.computeRowOffsets();
+
+            Matrix out;
+            out.nrows = a.nrows;
+            out.ncols = a.ncols;
+
+            for (spbla_Index i = 0; i < a.nrows; i++) {
+                // Values of the row are sorted, so set operations are applicable
+                std::set_intersection(a.colsIndex.begin() + a.rowOffsets[i], a.colsIndex.begin() + a.rowOffsets[i + 1],
+                        b.colsIndex.begin() + b.rowOffsets[i], b.colsIndex.begin() + b.rowOffsets[i + 1],
+                        std::back_inserter(out.colsIndex));
+
+                out.rowsIndex.resize(out.colsIndex.size(), i);
+            }
+
+            out.nvals = out.colsIndex.size();
+
+            return out;
+        }
+    };
+
+}
+
+#endif //SPBLA_TESTING_MATRIXEWISEMULT_HPP